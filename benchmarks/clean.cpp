@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+template<FaceMeshConcept MeshType>
+void BM_RemoveDuplicatedVertices(benchmark::State& state)
+{
+    const MeshType soup = bench::triangleSoup<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = soup;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(removeDuplicatedVertices(m));
+    }
+    bench::setFaceCounters(state, soup);
+}
+
+// merges the vertices closer than 1e-6 times the diagonal of the soup
+template<FaceMeshConcept MeshType>
+void BM_WeldVertices(benchmark::State& state)
+{
+    MeshType soup = bench::triangleSoup<MeshType>(state.range(0));
+    updateBoundingBox(soup);
+
+    const double epsilon = soup.boundingBox().diagonal() * 1e-6;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = soup;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(removeDuplicatedVertices(m, epsilon));
+    }
+    bench::setFaceCounters(state, soup);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_RemoveDuplicatedFaces(benchmark::State& state)
+{
+    MeshType base = bench::sphereMesh<MeshType>(state.range(0));
+    // duplicate every face once
+    uint fn = base.faceNumber();
+    for (uint i = 0; i < fn; ++i) {
+        uint v0 = base.face(i).vertexIndex(0);
+        uint v1 = base.face(i).vertexIndex(1);
+        uint v2 = base.face(i).vertexIndex(2);
+        base.addFace(v2, v0, v1);
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = base;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(removeDuplicatedFaces(m));
+    }
+    bench::setFaceCounters(state, base);
+}
+
+// compaction of a triangle soup after the removal of its duplicated vertices:
+// two thirds of the vertices are deleted, and all the vertex pointers of the
+// faces must be updated
+template<FaceMeshConcept MeshType>
+void BM_CompactAfterClean(benchmark::State& state)
+{
+    MeshType soup = bench::triangleSoup<MeshType>(state.range(0));
+    removeDuplicatedVertices(soup);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = soup;
+        state.ResumeTiming();
+
+        m.compact();
+        benchmark::DoNotOptimize(m);
+    }
+    bench::setFaceCounters(state, soup);
+}
+
+} // namespace
+
+BENCHMARK(BM_RemoveDuplicatedVertices<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_RemoveDuplicatedVertices<vcl::PolyMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_WeldVertices<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_RemoveDuplicatedFaces<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_RemoveDuplicatedFaces<vcl::PolyMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_CompactAfterClean<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_CompactAfterClean<vcl::PolyMesh>)
+    ->Apply(vcl::bench::sphereSizes);
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_BENCHMARKS_COMMON_H
+#define VCL_BENCHMARKS_COMMON_H
+
+#include <vclib/algorithms.h>
+#include <vclib/meshes.h>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+
+namespace vcl::bench {
+
+/*
+ * All the benchmarks run on synthetic meshes generated with the functions of
+ * the algorithms/mesh/create module, so that results are reproducible across
+ * machines and do not depend on external files. The size of the input is
+ * the number of subdivisions of an icosahedron sphere, that generates
+ * 20 * 4^d faces: 4 -> 5120, 5 -> 20480, 6 -> 81920, 7 -> 327680.
+ */
+
+inline constexpr uint RANDOM_SEED = 42;
+
+/**
+ * @brief Returns a reference to a unit sphere mesh obtained subdividing an
+ * icosahedron `divisions` times.
+ *
+ * Meshes are generated once and cached, in order to exclude their generation
+ * from the measured time.
+ */
+template<FaceMeshConcept MeshType>
+const MeshType& sphereMesh(uint divisions)
+{
+    static std::map<uint, MeshType> cache;
+
+    auto it = cache.find(divisions);
+    if (it == cache.end()) {
+        MeshType m = createSphereIcosahedron<MeshType>(
+            Sphere<typename MeshType::VertexType::PositionType::ScalarType>(
+                {0, 0, 0}, 1),
+            divisions);
+        updatePerFaceNormals(m);
+        updatePerVertexNormals(m);
+        updateBoundingBox(m);
+        it = cache.emplace(divisions, std::move(m)).first;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Returns a copy of the sphere mesh with the given divisions in which
+ * each face references its own three vertices (a "triangle soup"), as it
+ * happens when loading formats like STL.
+ */
+template<FaceMeshConcept MeshType>
+MeshType triangleSoup(uint divisions)
+{
+    const MeshType& sphere = sphereMesh<MeshType>(divisions);
+
+    MeshType m;
+    m.reserveVertices(sphere.faceNumber() * 3);
+    m.reserveFaces(sphere.faceNumber());
+    for (const auto& f : sphere.faces()) {
+        uint v0 = m.addVertices(
+            f.vertex(0)->position(),
+            f.vertex(1)->position(),
+            f.vertex(2)->position());
+        m.addFace(v0, v0 + 1, v0 + 2);
+    }
+    return m;
+}
+
+/**
+ * @brief Generates n random points in the given box, with a fixed seed.
+ */
+template<Box3Concept BoxType>
+auto randomPoints(uint n, const BoxType& bbox)
+{
+    using ScalarType = BoxType::PointType::ScalarType;
+    using DistrType  = std::uniform_real_distribution<ScalarType>;
+
+    std::vector<Point3<ScalarType>> points(n);
+
+    std::mt19937 gen(RANDOM_SEED);
+    DistrType    disX(bbox.min().x(), bbox.max().x());
+    DistrType    disY(bbox.min().y(), bbox.max().y());
+    DistrType    disZ(bbox.min().z(), bbox.max().z());
+
+    for (uint i = 0; i < n; i++)
+        points[i] = Point3<ScalarType>(disX(gen), disY(gen), disZ(gen));
+
+    return points;
+}
+
+/**
+ * @brief Sets the sphere subdivisions used as argument of a benchmark, and
+ * the counters that report the number of faces of the input mesh.
+ */
+inline void sphereSizes(benchmark::internal::Benchmark* b)
+{
+    b->ArgName("divisions");
+    for (uint d = 4; d <= 6; ++d)
+        b->Arg(d);
+    b->Unit(benchmark::kMillisecond);
+}
+
+template<FaceMeshConcept MeshType>
+void setFaceCounters(benchmark::State& state, const MeshType& m)
+{
+    state.counters["faces"] = m.faceNumber();
+    state.SetItemsProcessed(state.iterations() * m.faceNumber());
+}
+
+} // namespace vcl::bench
+
+#endif // VCL_BENCHMARKS_COMMON_H
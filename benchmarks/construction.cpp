@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+// Builds a copy of the sphere mesh adding one vertex and one face at a time,
+// as done by the algorithms that generate meshes incrementally. With
+// contiguous containers, each reallocation of the vertex (face) container
+// requires to update all the vertex (face) pointers stored in the mesh;
+// chunked containers never move their elements.
+template<FaceMeshConcept MeshType, bool ADJ>
+void BM_IncrementalConstruction(benchmark::State& state)
+{
+    // the vertex indices of the faces must be the ones of a compact mesh
+    TriMesh sphere = bench::sphereMesh<TriMesh>(state.range(0));
+    sphere.compact();
+
+    for (auto _ : state) {
+        MeshType m;
+        if constexpr (ADJ)
+            m.enablePerVertexAdjacentFaces();
+
+        for (const auto& v : sphere.vertices())
+            m.addVertex(v.position());
+        for (const auto& f : sphere.faces()) {
+            uint fi = m.addFace(
+                f.vertexIndex(0), f.vertexIndex(1), f.vertexIndex(2));
+            if constexpr (ADJ) {
+                for (auto* v : m.face(fi).vertices())
+                    v->pushAdjFace(&m.face(fi));
+            }
+        }
+        benchmark::DoNotOptimize(m);
+    }
+    bench::setFaceCounters(state, sphere);
+}
+
+// Cost of the access to the elements of a chunked container
+template<FaceMeshConcept MeshType>
+void BM_FaceTraversal(benchmark::State& state)
+{
+    MeshType m;
+    m.importFrom(bench::sphereMesh<TriMesh>(state.range(0)));
+
+    for (auto _ : state) {
+        double s = 0;
+        for (const auto& f : m.faces())
+            s += f.vertex(0)->position().x();
+        benchmark::DoNotOptimize(s);
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_IncrementalConstruction<vcl::TriMesh, false>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_IncrementalConstruction<vcl::TriMeshChunked, false>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_IncrementalConstruction<vcl::TriMesh, true>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_IncrementalConstruction<vcl::TriMeshChunked, true>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_FaceTraversal<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_FaceTraversal<vcl::TriMeshChunked>)
+    ->Apply(vcl::bench::sphereSizes);
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+#include <vclib/algorithms/mesh/convex_hull.h>
+
+namespace {
+
+using namespace vcl;
+
+using HullMesh = TriMesh;
+
+// convex hull of the vertices of a sphere: all the points lie on the hull
+void BM_ConvexHullSphere(benchmark::State& state)
+{
+    const TriMesh& sphere = bench::sphereMesh<TriMesh>(state.range(0));
+
+    std::vector<TriMesh::VertexType::PositionType> points;
+    points.reserve(sphere.vertexNumber());
+    for (const auto& v : sphere.vertices())
+        points.push_back(v.position());
+
+    for (auto _ : state) {
+        HullMesh hull = convexHull<HullMesh>(points, true);
+        benchmark::DoNotOptimize(hull.faceNumber());
+    }
+    state.counters["points"] = points.size();
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+// convex hull of random points in a box: most of the points are discarded
+void BM_ConvexHullRandom(benchmark::State& state)
+{
+    const auto points =
+        bench::randomPoints(state.range(0), Box3d({-1, -1, -1}, {1, 1, 1}));
+
+    for (auto _ : state) {
+        HullMesh hull = convexHull<HullMesh>(points, true);
+        benchmark::DoNotOptimize(hull.faceNumber());
+    }
+    state.counters["points"] = points.size();
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_ConvexHullSphere)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConvexHullRandom)
+    ->ArgName("points")
+    ->RangeMultiplier(10)
+    ->Range(10000, 10000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+// PCA curvature on a sphere of radius 1, with a neighborhood of radius 0.1
+template<FaceMeshConcept MeshType, bool MONTECARLO>
+void BM_UpdatePrincipalCurvaturePCA(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexPrincipalCurvature();
+
+    for (auto _ : state) {
+        updatePrincipalCurvaturePCA(m, 0.1, MONTECARLO);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_UpdatePrincipalCurvatureTaubin95(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexPrincipalCurvature();
+    m.enablePerVertexAdjacentFaces();
+    m.enablePerFaceAdjacentFaces();
+    updatePerVertexAdjacentFaces(m);
+    updatePerFaceAdjacentFaces(m);
+
+    for (auto _ : state) {
+        updatePrincipalCurvatureTaubin95(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+// incremental update after moving 1% of the vertices
+template<FaceMeshConcept MeshType>
+void BM_UpdatePrincipalCurvatureTaubin95Incremental(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexPrincipalCurvature();
+    m.enablePerVertexAdjacentFaces();
+    m.enablePerFaceAdjacentFaces();
+    updatePerVertexAdjacentFaces(m);
+    updatePerFaceAdjacentFaces(m);
+
+    std::vector<uint> moved;
+    for (uint i = 0; i < m.vertexNumber(); i += 100)
+        moved.push_back(i);
+
+    for (auto _ : state) {
+        updatePrincipalCurvatureTaubin95(m, moved);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdatePrincipalCurvaturePCA<vcl::TriMesh, true>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePrincipalCurvaturePCA<vcl::TriMesh, false>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePrincipalCurvatureTaubin95<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePrincipalCurvatureTaubin95Incremental<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
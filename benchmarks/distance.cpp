@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+template<HausdorffSamplingMethod METHOD>
+void BM_HausdorffDistance(benchmark::State& state)
+{
+    const TriMesh& m1 = bench::sphereMesh<TriMesh>(state.range(0));
+    // the second mesh is a coarser version of the same sphere
+    const TriMesh& m2 = bench::sphereMesh<TriMesh>(state.range(0) - 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hausdorffDistance(
+            m1, m2, nullLogger, METHOD, m2.vertexNumber(), true));
+    }
+    bench::setFaceCounters(state, m1);
+}
+
+// Hausdorff distance between quad meshes, where the distance between a sample
+// and a face uses the triangulation of the polygonal faces
+template<HausdorffSpatialIndex INDEX>
+void BM_PolyHausdorffDistance(benchmark::State& state)
+{
+    const uint d = 1 << state.range(0);
+
+    const Sphered s({0, 0, 0}, 1);
+
+    PolyMesh m1 = createSphereNormalizedCube<PolyMesh>(s, d);
+    PolyMesh m2 = createSphereNormalizedCube<PolyMesh>(s, d / 2);
+    updateBoundingBox(m1);
+    updateBoundingBox(m2);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hausdorffDistance(
+            m1,
+            m2,
+            nullLogger,
+            HAUSDORFF_MONTECARLO,
+            m1.faceNumber(),
+            true,
+            INDEX));
+    }
+    bench::setFaceCounters(state, m1);
+}
+
+} // namespace
+
+BENCHMARK(BM_HausdorffDistance<vcl::HAUSDORFF_VERTEX_UNIFORM>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_HausdorffDistance<vcl::HAUSDORFF_MONTECARLO>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_PolyHausdorffDistance<vcl::HAUSDORFF_STATIC_GRID>)
+    ->ArgName("log2divisions")
+    ->DenseRange(5, 7)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PolyHausdorffDistance<vcl::HAUSDORFF_BVH>)
+    ->ArgName("log2divisions")
+    ->DenseRange(5, 7)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,45 @@
+#*****************************************************************************
+#* VCLib                                                                     *
+#* Visual Computing Library                                                  *
+#*                                                                           *
+#* Copyright(C) 2021-2025                                                    *
+#* Visual Computing Lab                                                      *
+#* ISTI - Italian National Research Council                                  *
+#*                                                                           *
+#* All rights reserved.                                                      *
+#*                                                                           *
+#* This program is free software; you can redistribute it and/or modify      *
+#* it under the terms of the Mozilla Public License Version 2.0 as published *
+#* by the Mozilla Foundation; either version 2 of the License, or            *
+#* (at your option) any later version.                                       *
+#*                                                                           *
+#* This program is distributed in the hope that it will be useful,           *
+#* but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+#* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+#* Mozilla Public License Version 2.0                                        *
+#* (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+#****************************************************************************/
+
+include(FetchContent)
+
+find_package(benchmark QUIET)
+
+if(VCLIB_ALLOW_SYSTEM_GOOGLE_BENCHMARK AND TARGET benchmark::benchmark_main)
+    message(STATUS "- Google Benchmark - using system-provided library")
+elseif (VCLIB_ALLOW_DOWNLOAD_GOOGLE_BENCHMARK)
+    message(STATUS "- Google Benchmark - using downloaded source")
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+    FetchContent_Declare(benchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG        v1.8.3)
+
+    FetchContent_MakeAvailable(benchmark)
+else()
+    message(
+        FATAL_ERROR
+        "Google Benchmark is required to build benchmarks - VCLIB_ALLOW_DOWNLOAD_GOOGLE_BENCHMARK must be enabled and found.")
+endif()
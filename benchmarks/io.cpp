@@ -0,0 +1,146 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+#include <vclib/io.h>
+
+#include <sstream>
+
+namespace {
+
+using namespace vcl;
+
+enum class Format { PLY_ASCII, PLY_BINARY, OBJ, OFF, STL_BINARY };
+
+template<typename MeshType>
+void saveToStream(const MeshType& m, std::ostream& os, Format format)
+{
+    SaveSettings settings;
+    settings.binary = format == Format::PLY_BINARY ||
+                      format == Format::STL_BINARY;
+
+    switch (format) {
+    case Format::PLY_ASCII:
+    case Format::PLY_BINARY: savePly(m, os, settings); break;
+    case Format::OBJ: saveObj(m, os, settings); break;
+    case Format::OFF: saveOff(m, os, settings); break;
+    case Format::STL_BINARY: saveStl(m, os, settings); break;
+    }
+}
+
+template<typename MeshType>
+void loadFromStream(MeshType& m, std::istream& is, Format format)
+{
+    switch (format) {
+    case Format::PLY_ASCII:
+    case Format::PLY_BINARY: loadPly(m, is); break;
+    case Format::OBJ: loadObj(m, is, {}); break;
+    case Format::OFF: loadOff(m, is); break;
+    case Format::STL_BINARY: loadStl(m, is); break;
+    }
+}
+
+template<Format FORMAT>
+void BM_Load(benchmark::State& state)
+{
+    const TriMesh& sphere = bench::sphereMesh<TriMesh>(state.range(0));
+
+    std::stringstream ss;
+    saveToStream(sphere, ss, FORMAT);
+    const std::string data = ss.str();
+
+    for (auto _ : state) {
+        std::istringstream is(data);
+        TriMesh            m;
+        loadFromStream(m, is, FORMAT);
+        benchmark::DoNotOptimize(m.vertexNumber());
+    }
+    bench::setFaceCounters(state, sphere);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+/*
+ * Quad meshes loaded in a polygonal mesh, where the faces are stored in
+ * parallel, and in a triangle mesh, where each quad is split into two
+ * triangles. With 256 divisions, the obj file is about 20 MB, that is parsed in
+ * several chunks.
+ */
+template<Format FORMAT, typename MeshType>
+void BM_LoadQuads(benchmark::State& state)
+{
+    const PolyMesh quads = createSphereNormalizedCube<PolyMesh>(
+        Sphered({0, 0, 0}, 1), state.range(0));
+
+    std::stringstream ss;
+    saveToStream(quads, ss, FORMAT);
+    const std::string data = ss.str();
+
+    for (auto _ : state) {
+        std::istringstream is(data);
+        MeshType           m;
+        loadFromStream(m, is, FORMAT);
+        benchmark::DoNotOptimize(m.faceNumber());
+    }
+    bench::setFaceCounters(state, quads);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void quadSizes(benchmark::internal::Benchmark* b)
+{
+    b->ArgName("divisions")->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+}
+
+template<Format FORMAT>
+void BM_Save(benchmark::State& state)
+{
+    const TriMesh& sphere = bench::sphereMesh<TriMesh>(state.range(0));
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::ostringstream os;
+        saveToStream(sphere, os, FORMAT);
+        bytes = os.tellp();
+        benchmark::DoNotOptimize(bytes);
+    }
+    bench::setFaceCounters(state, sphere);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+} // namespace
+
+BENCHMARK(BM_Load<Format::PLY_ASCII>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Load<Format::PLY_BINARY>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Load<Format::OBJ>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Load<Format::OFF>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Load<Format::STL_BINARY>)->Apply(vcl::bench::sphereSizes);
+
+BENCHMARK(BM_LoadQuads<Format::OBJ, PolyMesh>)->Apply(quadSizes);
+BENCHMARK(BM_LoadQuads<Format::OBJ, TriMesh>)->Apply(quadSizes);
+BENCHMARK(BM_LoadQuads<Format::OFF, PolyMesh>)->Apply(quadSizes);
+BENCHMARK(BM_LoadQuads<Format::OFF, TriMesh>)->Apply(quadSizes);
+
+BENCHMARK(BM_Save<Format::PLY_ASCII>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Save<Format::PLY_BINARY>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Save<Format::OBJ>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Save<Format::OFF>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Save<Format::STL_BINARY>)->Apply(vcl::bench::sphereSizes);
@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+enum class Weight { NONE, FACE_NORMALS, ANGLE, NELSON_MAX };
+
+template<FaceMeshConcept MeshType, Weight WEIGHT>
+void BM_UpdatePerVertexNormals(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (WEIGHT == Weight::NONE)
+            updatePerVertexNormals(m);
+        else if constexpr (WEIGHT == Weight::FACE_NORMALS)
+            updatePerVertexNormalsFromFaceNormals(m);
+        else if constexpr (WEIGHT == Weight::ANGLE)
+            updatePerVertexNormalsAngleWeighted(m);
+        else
+            updatePerVertexNormalsNelsonMaxWeighted(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+// vertex normals gathered in parallel through the per-vertex adjacent faces
+template<FaceMeshConcept MeshType, Weight WEIGHT>
+void BM_UpdatePerVertexNormalsAdjFaces(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexAdjacentFaces();
+    updatePerVertexAdjacentFaces(m);
+
+    for (auto _ : state) {
+        if constexpr (WEIGHT == Weight::NONE)
+            updatePerVertexNormals(m, true, nullLogger, true);
+        else
+            updatePerVertexNormalsAngleWeighted(m, true, nullLogger, true);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+// incremental update after moving 1% of the vertices
+template<FaceMeshConcept MeshType>
+void BM_UpdatePerVertexNormalsIncremental(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexAdjacentFaces();
+    updatePerVertexAdjacentFaces(m);
+
+    std::vector<uint> moved;
+    for (uint i = 0; i < m.vertexNumber(); i += 100)
+        moved.push_back(i);
+
+    for (auto _ : state) {
+        updatePerVertexNormals(m, moved);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_UpdatePerFaceNormals(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        updatePerFaceNormals(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdatePerFaceNormals<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormals<vcl::TriMesh, Weight::NONE>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormals<vcl::TriMesh, Weight::FACE_NORMALS>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormals<vcl::TriMesh, Weight::ANGLE>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormals<vcl::TriMesh, Weight::NELSON_MAX>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormals<vcl::PolyMesh, Weight::NONE>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormalsAdjFaces<vcl::TriMesh, Weight::NONE>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormalsAdjFaces<vcl::TriMesh, Weight::ANGLE>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexNormalsIncremental<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
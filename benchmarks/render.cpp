@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+#include <vclib/opengl2/drawable/mesh/mesh_render_vectors.h>
+
+namespace {
+
+using namespace vcl;
+
+// MeshRenderVectors is the CPU-only implementation of MeshRenderData: it
+// allows to measure the cost of MeshRenderData::update without a GPU context
+template<FaceMeshConcept MeshType>
+void BM_MeshRenderDataUpdate(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexColor();
+    for (auto& v : m.vertices())
+        v.color() = Color::Gray;
+
+    MeshRenderVectors<MeshType> mrv(m);
+
+    for (auto _ : state) {
+        mrv.update(m);
+        benchmark::DoNotOptimize(mrv.vertexBufferData());
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_MeshRenderDataUpdate<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_MeshRenderDataUpdate<vcl::PolyMesh>)
+    ->Apply(vcl::bench::sphereSizes);
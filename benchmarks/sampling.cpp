@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+using SamplerType = PointSampler<Point3d>;
+
+void BM_MontecarloPointSampling(benchmark::State& state)
+{
+    const TriMesh& m = bench::sphereMesh<TriMesh>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(montecarloPointSampling<SamplerType>(
+            m, m.faceNumber() * 10, true));
+    }
+    bench::setFaceCounters(state, m);
+}
+
+void BM_PoissonDiskPointSampling(benchmark::State& state)
+{
+    const TriMesh& m = bench::sphereMesh<TriMesh>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poissonDiskPointSampling<SamplerType>(
+            m, m.faceNumber(), true));
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_MontecarloPointSampling)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_PoissonDiskPointSampling)->Apply(vcl::bench::sphereSizes);
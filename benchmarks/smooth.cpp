@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+inline constexpr uint SMOOTHING_STEPS = 3;
+
+template<FaceMeshConcept MeshType>
+void BM_LaplacianSmoothing(benchmark::State& state)
+{
+    const bool      cotangent = state.range(1);
+    const MeshType& sphere    = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = sphere;
+        state.ResumeTiming();
+
+        laplacianSmoothing(m, SMOOTHING_STEPS, false, cotangent);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, sphere);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_TaubinSmoothing(benchmark::State& state)
+{
+    const MeshType& sphere = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshType m = sphere;
+        state.ResumeTiming();
+
+        taubinSmoothing(m, SMOOTHING_STEPS, 0.5, -0.53);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, sphere);
+}
+
+void smoothingArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"divisions", "cotangent"});
+    for (uint d = 4; d <= 6; ++d) {
+        b->Args({d, 0});
+        b->Args({d, 1});
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_LaplacianSmoothing<vcl::TriMesh>)->Apply(smoothingArgs);
+BENCHMARK(BM_TaubinSmoothing<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+#include <vclib/space.h>
+#include <vclib/views.h>
+
+namespace {
+
+using namespace vcl;
+
+inline constexpr uint N_QUERIES = 10000;
+inline constexpr uint K_NEAREST = 8;
+
+template<FaceMeshConcept MeshType>
+void BM_KDTreeBuild(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        KDTree tree(m);
+        benchmark::DoNotOptimize(tree);
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_KDTreeNearest(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    KDTree     tree(m);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    for (auto _ : state) {
+        for (const auto& p : points)
+            benchmark::DoNotOptimize(tree.nearestNeighborIndex(p));
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_KDTreeKNearest(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    KDTree     tree(m);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    for (auto _ : state) {
+        for (const auto& p : points)
+            benchmark::DoNotOptimize(
+                tree.kNearestNeighborsIndices(p, K_NEAREST));
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_KDTreeKNearestBulk(benchmark::State& state)
+{
+    using ScalarType = MeshType::VertexType::PositionType::ScalarType;
+
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    KDTree     tree(m);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    std::vector<uint>       offsets, indices;
+    std::vector<ScalarType> distances;
+    for (auto _ : state) {
+        tree.kNearestNeighborsIndices(
+            points, K_NEAREST, offsets, indices, distances);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_StaticGridBuild(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        StaticGrid3<const typename MeshType::FaceType*> grid(
+            m.faces() | views::constAddrOf);
+        benchmark::DoNotOptimize(grid);
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_StaticGridClosest(benchmark::State& state)
+{
+    using ScalarType = MeshType::VertexType::PositionType::ScalarType;
+
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    StaticGrid3<const typename MeshType::FaceType*> grid(
+        m.faces() | views::constAddrOf);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            ScalarType dist;
+            benchmark::DoNotOptimize(grid.closestValue(p, dist));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_StaticGridKClosest(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    using GridType = StaticGrid3<const typename MeshType::FaceType*>;
+    using Iter     = GridType::ConstIterator;
+
+    GridType   grid(m.faces() | views::constAddrOf);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    // the output and the candidates buffers are reused by all the queries
+    auto dist = [](const auto& p, const auto& f) { return distance(p, f); };
+    std::vector<Iter>                                    vec;
+    typename GridType::template KClosestCandidates<Iter> cand;
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            grid.kClosestValues(p, K_NEAREST, dist, vec, cand);
+            benchmark::DoNotOptimize(vec.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_BVHBuild(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        BVH bvh(m.faces() | views::constAddrOf);
+        benchmark::DoNotOptimize(bvh);
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_BVHClosest(benchmark::State& state)
+{
+    using ScalarType = MeshType::VertexType::PositionType::ScalarType;
+
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    BVH        bvh(m.faces() | views::constAddrOf);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            ScalarType dist = std::numeric_limits<ScalarType>::max();
+            benchmark::DoNotOptimize(bvh.closestValue(p, dist));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template<FaceMeshConcept MeshType>
+void BM_BVHRay(benchmark::State& state)
+{
+    using PointType = MeshType::VertexType::PositionType;
+
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    BVH        bvh(m.faces() | views::constAddrOf);
+    const auto points = bench::randomPoints(N_QUERIES, m.boundingBox());
+    const auto center = m.boundingBox().center();
+
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            PointType dir = center - p;
+            benchmark::DoNotOptimize(bvh.rayIntersection(p, dir));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_KDTreeBuild<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_KDTreeNearest<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_KDTreeKNearest<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_KDTreeKNearestBulk<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+
+BENCHMARK(BM_StaticGridBuild<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_StaticGridClosest<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_StaticGridKClosest<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+
+BENCHMARK(BM_BVHBuild<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_BVHClosest<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_BVHRay<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
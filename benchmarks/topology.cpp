@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+template<FaceMeshConcept MeshType>
+void BM_UpdatePerFaceAdjacentFaces(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerFaceAdjacentFaces();
+
+    for (auto _ : state) {
+        updatePerFaceAdjacentFaces(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_UpdatePerVertexAdjacentFaces(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexAdjacentFaces();
+
+    for (auto _ : state) {
+        updatePerVertexAdjacentFaces(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_UpdatePerVertexAdjacentVertices(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+    m.enablePerVertexAdjacentVertices();
+
+    for (auto _ : state) {
+        updatePerVertexAdjacentVertices(m);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+// Connected components of a sphere (a single component) and of a triangle soup
+// (a component for each face).
+template<bool SOUP>
+void BM_ConnectedComponents(benchmark::State& state)
+{
+    TriMesh m = SOUP ? bench::triangleSoup<TriMesh>(state.range(0)) :
+                       bench::sphereMesh<TriMesh>(state.range(0));
+    m.enablePerFaceAdjacentFaces();
+    updatePerFaceAdjacentFaces(m);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(faceConnectedComponents(m));
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<bool SOUP>
+void BM_ConnectedComponentsSets(benchmark::State& state)
+{
+    TriMesh m = SOUP ? bench::triangleSoup<TriMesh>(state.range(0)) :
+                       bench::sphereMesh<TriMesh>(state.range(0));
+    m.enablePerFaceAdjacentFaces();
+    updatePerFaceAdjacentFaces(m);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(connectedComponents(m));
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<bool SOUP>
+void BM_ConnectedComponentsByVertices(benchmark::State& state)
+{
+    TriMesh m = SOUP ? bench::triangleSoup<TriMesh>(state.range(0)) :
+                       bench::sphereMesh<TriMesh>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(faceConnectedComponentsByVertices(m));
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdatePerFaceAdjacentFaces<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerFaceAdjacentFaces<vcl::PolyMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexAdjacentFaces<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_UpdatePerVertexAdjacentVertices<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponents<false>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponents<true>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponentsSets<false>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponentsSets<true>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponentsByVertices<false>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ConnectedComponentsByVertices<true>)
+    ->Apply(vcl::bench::sphereSizes);
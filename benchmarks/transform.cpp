@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include "common.h"
+
+namespace {
+
+using namespace vcl;
+
+// TriMeshVertical stores positions, normals and flags in contiguous arrays:
+// these kernels touch only the positions (and the normals)
+
+template<FaceMeshConcept MeshType>
+void BM_BoundingBox(benchmark::State& state)
+{
+    const MeshType& m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        auto bb = boundingBox(m);
+        benchmark::DoNotOptimize(bb);
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_Translate(benchmark::State& state)
+{
+    using PositionType = MeshType::VertexType::PositionType;
+
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+
+    for (auto _ : state) {
+        translate(m, PositionType(1e-3, 0, 0));
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+template<FaceMeshConcept MeshType>
+void BM_ApplyTransformMatrix(benchmark::State& state)
+{
+    MeshType m = bench::sphereMesh<MeshType>(state.range(0));
+
+    Matrix44d mat = Matrix44d::Identity();
+    mat(0, 3)     = 1e-3;
+
+    for (auto _ : state) {
+        applyTransformMatrix(m, mat);
+        benchmark::ClobberMemory();
+    }
+    bench::setFaceCounters(state, m);
+}
+
+} // namespace
+
+BENCHMARK(BM_BoundingBox<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_BoundingBox<vcl::TriMeshVertical>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Translate<vcl::TriMesh>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_Translate<vcl::TriMeshVertical>)->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ApplyTransformMatrix<vcl::TriMesh>)
+    ->Apply(vcl::bench::sphereSizes);
+BENCHMARK(BM_ApplyTransformMatrix<vcl::TriMeshVertical>)
+    ->Apply(vcl::bench::sphereSizes);
@@ -88,6 +88,7 @@ class CustomBDistWheel(bdist_wheel):
         super().run()
 
 inst_req = [
+    "numpy",
     "pyqt6==6.8"
 ]
 
@@ -20,6 +20,8 @@
  * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
  ****************************************************************************/
 
+#include <vclib/algorithms/mesh/stat/bounding_box.h>
+#include <vclib/algorithms/mesh/update/transform.h>
 #include <vclib/meshes.h>
 
 #include <catch2/catch_template_test_macros.hpp>
@@ -31,7 +33,11 @@ TEMPLATE_TEST_CASE(
     vcl::TriMesh,
     vcl::TriMeshf,
     vcl::TriMeshIndexed,
-    vcl::TriMeshIndexedf)
+    vcl::TriMeshIndexedf,
+    vcl::TriMeshVertical,
+    vcl::TriMeshVerticalf,
+    vcl::TriMeshChunked,
+    vcl::TriMeshChunkedf)
 {
     using TriMesh = TestType;
 
@@ -230,7 +236,11 @@ TEMPLATE_TEST_CASE(
     vcl::TriMesh,
     vcl::TriMeshf,
     vcl::TriMeshIndexed,
-    vcl::TriMeshIndexedf)
+    vcl::TriMeshIndexedf,
+    vcl::TriMeshVertical,
+    vcl::TriMeshVerticalf,
+    vcl::TriMeshChunked,
+    vcl::TriMeshChunkedf)
 {
     using TriMesh = TestType;
 
@@ -291,3 +301,314 @@ TEMPLATE_TEST_CASE(
         REQUIRE(m.face(3).indexOfEdge(3, 4) == 2);
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Test a TriMesh with vertical components",
+    "",
+    vcl::TriMeshVertical,
+    vcl::TriMeshVerticalf)
+{
+    using TriMesh = TestType;
+    using PointT  = TriMesh::VertexType::PositionType;
+
+    TriMesh m;
+    m.addVertices(
+        PointT(0, 0, 0), PointT(1, 0, 0), PointT(0, 1, 0), PointT(0, 0, 1));
+    m.addFace(0, 1, 2);
+    m.addFace(0, 3, 1);
+    m.addFace(0, 2, 3);
+    m.addFace(1, 3, 2);
+
+    m.vertex(1).selected() = true;
+    m.vertex(2).normal()   = PointT(0, 0, 1);
+    m.face(2).normal()     = PointT(1, 0, 0);
+
+    THEN("The components are stored in contiguous arrays")
+    {
+        auto positions = m.template verticalComponentData<
+            vcl::ElemId::VERTEX,
+            vcl::CompId::POSITION>();
+        auto normals = m.template verticalComponentData<
+            vcl::ElemId::VERTEX,
+            vcl::CompId::NORMAL>();
+
+        REQUIRE(positions.size() == 4);
+        for (vcl::uint i = 0; i < 4; ++i)
+            REQUIRE(&positions[i] == &m.vertex(i).position());
+        REQUIRE(normals[2] == PointT(0, 0, 1));
+
+        auto faceNormals = m.template verticalComponentData<
+            vcl::ElemId::FACE,
+            vcl::CompId::NORMAL>();
+        REQUIRE(faceNormals.size() == 4);
+        REQUIRE(faceNormals[2] == PointT(1, 0, 0));
+    }
+
+    THEN("The mesh can be imported from and to a horizontal mesh")
+    {
+        vcl::TriMesh h;
+        h.importFrom(m);
+
+        TriMesh v;
+        v.importFrom(h);
+
+        for (const auto* mesh : {&m, &v}) {
+            REQUIRE(h.vertexNumber() == mesh->vertexNumber());
+            REQUIRE(h.faceNumber() == mesh->faceNumber());
+            for (vcl::uint i = 0; i < 4; ++i) {
+                REQUIRE(
+                    h.vertex(i).position() ==
+                    mesh->vertex(i).position().template cast<double>());
+                REQUIRE(
+                    h.vertex(i).selected() == mesh->vertex(i).selected());
+                REQUIRE(
+                    h.face(i).vertexIndex(2) == mesh->face(i).vertexIndex(2));
+            }
+        }
+        REQUIRE(v.vertex(1).selected());
+        REQUIRE(v.vertex(2).normal() == PointT(0, 0, 1));
+        REQUIRE(v.face(2).normal() == PointT(1, 0, 0));
+    }
+
+    THEN("The geometry kernels use the contiguous arrays")
+    {
+        vcl::translate(m, PointT(1, 2, 3));
+        REQUIRE(m.vertex(3).position() == PointT(1, 2, 4));
+
+        auto bb = vcl::boundingBox(m);
+        REQUIRE(bb.min() == PointT(1, 2, 3));
+        REQUIRE(bb.max() == PointT(2, 3, 4));
+
+        // deleted vertices are not part of the bounding box
+        m.deleteFace(1);
+        m.deleteFace(2);
+        m.deleteFace(3);
+        m.deleteVertex(3);
+        bb = vcl::boundingBox(m);
+        REQUIRE(bb.max() == PointT(2, 3, 3));
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Test a TriMesh with chunked containers",
+    "",
+    vcl::TriMeshChunked,
+    vcl::TriMeshChunkedf)
+{
+    using TriMesh    = TestType;
+    using VertexType = TriMesh::VertexType;
+    using PointT     = VertexType::PositionType;
+
+    // enough vertices to fill some chunks
+    const vcl::uint n = 3 * vcl::ChunkedVector<VertexType>::CHUNK_SIZE + 7;
+
+    TriMesh m;
+    m.enablePerVertexAdjacentFaces();
+
+    m.addVertex(PointT(0, 0, 0));
+    const VertexType* v0 = &m.vertex(0);
+
+    // a fan of triangles around the first vertex, built one element at a time
+    for (vcl::uint i = 1; i < n; ++i) {
+        m.addVertex(PointT(i, 1, 0));
+        if (i > 1) {
+            vcl::uint fi = m.addFace(0, i - 1, i);
+            m.vertex(i).pushAdjFace(&m.face(fi));
+        }
+    }
+
+    THEN("The elements never move when the mesh grows")
+    {
+        REQUIRE(m.vertexNumber() == n);
+        REQUIRE(m.faceNumber() == n - 2);
+        REQUIRE(&m.vertex(0) == v0);
+        for (vcl::uint i = 0; i < m.faceNumber(); ++i) {
+            REQUIRE(m.face(i).vertex(0) == v0);
+            REQUIRE(m.face(i).vertexIndex(1) == i + 1);
+            REQUIRE(m.face(i).vertexIndex(2) == i + 2);
+            REQUIRE(m.index(m.vertex(i + 2).adjFace(0)) == i);
+        }
+    }
+
+    THEN("Copy and append update the references")
+    {
+        TriMesh c = m;
+        c.append(m);
+
+        REQUIRE(c.vertexNumber() == 2 * n);
+        REQUIRE(c.faceNumber() == 2 * (n - 2));
+        for (vcl::uint i = 0; i < c.faceNumber(); ++i) {
+            vcl::uint b = i < n - 2 ? 0 : n;
+            vcl::uint j = i < n - 2 ? i : i - n + 2;
+            REQUIRE(c.face(i).vertex(0) == &c.vertex(b));
+            REQUIRE(c.face(i).vertex(2) == &c.vertex(b + j + 2));
+            REQUIRE(c.vertex(b + j + 2).adjFace(0) == &c.face(i));
+        }
+    }
+
+    THEN("Compaction updates the references")
+    {
+        // delete the first half of the fan, and its vertices (but the first)
+        const vcl::uint h = n / 2;
+        for (vcl::uint i = 0; i < h; ++i) {
+            m.deleteFace(i);
+            m.deleteVertex(i + 1);
+        }
+        m.compact();
+
+        REQUIRE(m.vertexNumber() == n - h);
+        REQUIRE(m.faceNumber() == n - 2 - h);
+        REQUIRE(&m.vertex(0) == v0);
+        for (vcl::uint i = 0; i < m.faceNumber(); ++i) {
+            const auto& f = m.face(i);
+            REQUIRE(f.vertex(0) == v0);
+            REQUIRE(f.vertexIndex(1) == i + 1);
+            REQUIRE(f.vertex(2)->position().x() == h + i + 2);
+            REQUIRE(f.vertex(2)->adjFace(0) == &f);
+        }
+        // the only adjacent face of the vertex has been deleted
+        REQUIRE(m.vertex(1).adjFace(0) == nullptr);
+    }
+
+    THEN("The mesh can be imported from and to a contiguous mesh")
+    {
+        vcl::TriMesh t;
+        t.importFrom(m);
+
+        TriMesh c;
+        c.importFrom(t);
+
+        REQUIRE(c.faceNumber() == m.faceNumber());
+        for (vcl::uint i = 0; i < m.faceNumber(); ++i) {
+            REQUIRE(t.face(i).vertexIndex(2) == i + 2);
+            REQUIRE(c.face(i).vertex(2) == &c.vertex(i + 2));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Compact a large TriMesh",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshIndexed,
+    vcl::TriMeshChunked)
+{
+    using TriMesh = TestType;
+    using PointT  = TriMesh::VertexType::PositionType;
+
+    // enough vertices to be compacted in parallel
+    const vcl::uint n = 3 * vcl::COMPACTNESS_VALUES_PER_CHUNK + 5;
+
+    TriMesh m;
+    m.enablePerVertexAdjacentFaces();
+
+    // a strip of triangles (i, i + 1, i + 2)
+    for (vcl::uint i = 0; i < n; ++i)
+        m.addVertex(PointT(i, 0, 0));
+    for (vcl::uint i = 0; i + 2 < n; ++i) {
+        vcl::uint fi = m.addFace(i, i + 1, i + 2);
+        for (vcl::uint j = 0; j < 3; ++j)
+            m.vertex(i + j).pushAdjFace(fi);
+    }
+
+    // delete the vertices 4k + 3, and the faces that reference them: only the
+    // faces (4k, 4k + 1, 4k + 2) survive
+    for (vcl::uint i = 0; i + 2 < n; ++i) {
+        if (i % 4 != 0)
+            m.deleteFace(i);
+    }
+    for (vcl::uint i = 3; i < n; i += 4)
+        m.deleteVertex(i);
+
+    const vcl::uint nv = m.vertexNumber();
+    const vcl::uint nf = m.faceNumber();
+
+    std::vector<vcl::uint> vi = m.vertexCompactIndices();
+    REQUIRE(vi[4] == 3);
+    REQUIRE(vi[7] == vcl::UINT_NULL);
+
+    m.compact();
+
+    REQUIRE(m.vertexContainerSize() == nv);
+    REQUIRE(m.faceContainerSize() == nf);
+
+    for (vcl::uint k = 0; k < nf; ++k) {
+        for (vcl::uint j = 0; j < 3; ++j)
+            REQUIRE(m.face(k).vertexIndex(j) == 3 * k + j);
+    }
+
+    for (vcl::uint i = 0; i < nv; ++i) {
+        const auto& v = m.vertex(i);
+        REQUIRE(v.position().x() == i / 3 * 4 + i % 3);
+
+        // the only adjacent face left is the one that survived
+        vcl::uint cnt = 0;
+        for (vcl::uint j = 0; j < v.adjFacesNumber(); ++j) {
+            if (v.adjFaceIndex(j) != vcl::UINT_NULL) {
+                REQUIRE(v.adjFaceIndex(j) == i / 3);
+                ++cnt;
+            }
+        }
+        REQUIRE(cnt == (i / 3 < nf ? 1 : 0));
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Compact vectors in parallel",
+    "",
+    std::vector<vcl::uint>,
+    std::vector<std::string>,
+    vcl::ChunkedVector<vcl::uint>)
+{
+    using VecType   = TestType;
+    using ValueType = VecType::value_type;
+
+    auto value = [](vcl::uint i) {
+        if constexpr (std::is_same_v<ValueType, std::string>)
+            return std::to_string(i);
+        else
+            return i;
+    };
+
+    // several chunks, with a whole chunk of deleted values
+    const vcl::uint n = 3 * vcl::COMPACTNESS_VALUES_PER_CHUNK + 5;
+
+    auto isDeleted = [](vcl::uint i) {
+        return i % 4 == 3 || (i >= vcl::COMPACTNESS_VALUES_PER_CHUNK &&
+                              i < 2 * vcl::COMPACTNESS_VALUES_PER_CHUNK);
+    };
+
+    // the parallel path is forced, also on a single hardware thread
+    const std::vector<vcl::uint> seqIndices =
+        vcl::detail::compactIndices(n, isDeleted, false);
+    const std::vector<vcl::uint> newIndices =
+        vcl::detail::compactIndices(n, isDeleted, true);
+    REQUIRE(newIndices == seqIndices);
+
+    vcl::uint newSize = 0;
+    for (vcl::uint i = 0; i < n; ++i) {
+        if (isDeleted(i)) {
+            REQUIRE(newIndices[i] == vcl::UINT_NULL);
+        }
+        else {
+            REQUIRE(newIndices[i] == newSize++);
+        }
+    }
+
+    for (bool keepStorage : {false, true}) {
+        VecType vec(n);
+        for (vcl::uint i = 0; i < n; ++i)
+            vec[i] = value(i);
+        const ValueType* storage = &vec[0];
+
+        vcl::detail::compactVector(vec, newIndices, keepStorage, true);
+
+        REQUIRE(vec.size() == newSize);
+        if (keepStorage)
+            REQUIRE(&vec[0] == storage);
+        for (vcl::uint i = 0; i < n; ++i) {
+            if (!isDeleted(i))
+                REQUIRE(vec[newIndices[i]] == value(i));
+        }
+    }
+}
@@ -790,3 +790,99 @@ TEMPLATE_TEST_CASE(
         REQUIRE(facesToReassign.size() == nV);
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Topology of a mesh split in several parallel chunks",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshIndexed,
+    vcl::PolyMesh)
+{
+    using MeshType   = TestType;
+    using VertexType = MeshType::VertexType;
+    using FaceType   = MeshType::FaceType;
+
+    MeshType m = vcl::createSphereIcosahedron<MeshType>(
+        vcl::Sphere<double>({0, 0, 0}, 1), 5);
+
+    // a face on an existing edge makes the edge non-manifold
+    const vcl::uint v0 = m.face(0).vertexIndex(0);
+    const vcl::uint v1 = m.face(0).vertexIndex(1);
+    m.addVertex(vcl::Point3d(2, 2, 2));
+    m.addFace(v0, v1, m.vertexNumber() - 1);
+
+    m.deleteFace(100);
+    m.deleteFace(5000);
+
+    REQUIRE(m.faceNumber() * 3 > vcl::SORT_VALUES_PER_CHUNK);
+
+    THEN("Test Per Vertex Adjacent Faces")
+    {
+        m.enablePerVertexAdjacentFaces();
+        vcl::updatePerVertexAdjacentFaces(m);
+
+        std::vector<std::vector<const FaceType*>> expected(
+            m.vertexContainerSize());
+        for (const FaceType& f : m.faces())
+            for (const VertexType* v : f.vertices())
+                expected[m.index(v)].push_back(&f);
+
+        for (const VertexType& v : m.vertices()) {
+            std::vector<const FaceType*> adj(
+                v.adjFaces().begin(), v.adjFaces().end());
+            REQUIRE(adj == expected[m.index(v)]);
+        }
+    }
+
+    THEN("Test Per Vertex Adjacent Vertices")
+    {
+        m.enablePerVertexAdjacentVertices();
+        vcl::updatePerVertexAdjacentVertices(m);
+
+        std::vector<std::set<const VertexType*>> expected(
+            m.vertexContainerSize());
+        for (const FaceType& f : m.faces()) {
+            for (vcl::uint i = 0; i < f.vertexNumber(); ++i) {
+                expected[m.index(f.vertex(i))].insert(f.vertexMod(i + 1));
+                expected[m.index(f.vertexMod(i + 1))].insert(f.vertex(i));
+            }
+        }
+
+        for (const VertexType& v : m.vertices()) {
+            std::vector<const VertexType*> adj(
+                v.adjVertices().begin(), v.adjVertices().end());
+            const auto& exp = expected[m.index(v)];
+            REQUIRE(
+                adj == std::vector<const VertexType*>(exp.begin(), exp.end()));
+        }
+    }
+
+    THEN("Test Per Face Adjacent Faces")
+    {
+        m.enablePerFaceAdjacentFaces();
+        vcl::updatePerFaceAdjacentFaces(m);
+
+        vcl::uint borderEdges      = 0;
+        vcl::uint nonManifoldEdges = 0;
+        for (const FaceType& f : m.faces()) {
+            for (vcl::uint i = 0; i < f.vertexNumber(); ++i) {
+                const FaceType* af = f.adjFace(i);
+                if (af == nullptr) {
+                    ++borderEdges;
+                    continue;
+                }
+                REQUIRE(af != &f);
+                REQUIRE(!af->deleted());
+                vcl::uint ai =
+                    af->indexOfEdge(f.vertex(i), f.vertexMod(i + 1));
+                REQUIRE(ai != vcl::UINT_NULL);
+                if (af->adjFace(ai) != &f)
+                    ++nonManifoldEdges;
+            }
+        }
+        // the edges of the two deleted faces are now on the border
+        REQUIRE(borderEdges == 6 + 2);
+        // the three faces on the non-manifold edge are linked in a cycle
+        REQUIRE(nonManifoldEdges == 3);
+    }
+}
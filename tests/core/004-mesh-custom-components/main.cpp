@@ -28,6 +28,14 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <iostream>
+#include <memory>
+
+// a custom component type that cannot be serialized
+struct NonSerializable
+{
+    int    a = 0;
+    double b = 0;
+};
 
 TEMPLATE_TEST_CASE(
     "Test Custom Components and Handles",
@@ -69,7 +77,72 @@ TEMPLATE_TEST_CASE(
     REQUIRE(tmp == 8);
     REQUIRE(m.vertex(9).template customComponent<int>("flag") == 8);
 
+    m.template addPerVertexCustomComponent<bool>("visited");
+
+    vcl::CustomComponentVectorHandle<bool> b =
+        m.template perVertexCustomComponentVectorHandle<bool>("visited");
+
+    REQUIRE(b.size() == 10);
+    for (uint i = 0; i < b.size(); i += 2) {
+        b[i] = true;
+    }
+
+    REQUIRE(m.vertex(4).template customComponent<bool>("visited"));
+    REQUIRE(!m.vertex(5).template customComponent<bool>("visited"));
+
+    m.deleteVertex(0u);
+    m.compact();
+
+    const TriMesh& cm = m;
+
+    vcl::ConstCustomComponentVectorHandle<bool> cb =
+        cm.template perVertexCustomComponentVectorHandle<const bool>(
+            "visited");
+
+    REQUIRE(cb.size() == 9);
+    REQUIRE(!cb[0]);
+    REQUIRE(cb[1]);
+    REQUIRE(m.vertex(0).template customComponent<int>("flag") == 2);
+
     m.deletePerVertexCustomComponent("flag");
 
     REQUIRE(!m.hasPerVertexCustomComponent("flag"));
 }
+
+TEMPLATE_TEST_CASE(
+    "Test Custom Components of non serializable types",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshIndexed)
+{
+    using TriMesh = TestType;
+
+    TriMesh m;
+    m.addVertices(10);
+
+    m.template addPerVertexCustomComponent<NonSerializable>("ns");
+    m.template addPerVertexCustomComponent<std::shared_ptr<int>>("ptr");
+
+    for (typename TriMesh::Vertex& v : m.vertices()) {
+        v.template customComponent<NonSerializable>("ns") = {
+            (int) v.index(), v.index() * 0.5};
+        v.template customComponent<std::shared_ptr<int>>("ptr") =
+            std::make_shared<int>(v.index());
+    }
+
+    m.deleteVertex(0u);
+    m.compact();
+
+    TriMesh c = m;
+
+    REQUIRE(c.vertexNumber() == 9);
+    for (const auto& v : c.vertices()) {
+        const NonSerializable& ns =
+            v.template customComponent<NonSerializable>("ns");
+        REQUIRE(ns.a == v.index() + 1);
+        REQUIRE(ns.b == (v.index() + 1) * 0.5);
+        REQUIRE(
+            *v.template customComponent<std::shared_ptr<int>>("ptr") ==
+            v.index() + 1);
+    }
+}
@@ -268,3 +268,120 @@ TEMPLATE_TEST_CASE(
         REQUIRE(info.hasEdges());
     }
 }
+
+TEST_CASE("Load malformed OBJ")
+{
+    vcl::TriMesh tm;
+
+    SECTION("Malformed number")
+    {
+        std::istringstream ss(
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 0 1x 0\n"
+            "f 1 2 3\n");
+        REQUIRE_THROWS_AS(
+            vcl::loadObj(tm, ss, {}), vcl::MalformedFileException);
+    }
+
+    SECTION("Missing coordinate")
+    {
+        std::istringstream ss(
+            "v 0 0 0\n"
+            "v 1 0\n");
+        REQUIRE_THROWS_AS(
+            vcl::loadObj(tm, ss, {}), vcl::MalformedFileException);
+    }
+
+    SECTION("Face referencing a vertex read after it")
+    {
+        std::istringstream ss(
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "f 1 2 3\n"
+            "v 0 1 0\n");
+        REQUIRE_THROWS_AS(
+            vcl::loadObj(tm, ss, {}), vcl::MalformedFileException);
+    }
+}
+
+// an obj larger than a chunk of text, with a material change every 1000 quads
+// and faces interleaved with the vertices they reference
+std::string objQuadStrip(uint nQuads)
+{
+    std::string s = "usemtl red\nv 0 0 0\nv 0 1 0\n";
+    for (uint i = 0; i < nQuads; ++i) {
+        if (i % 1000 == 0)
+            s += (i / 1000) % 2 ? "usemtl red\n" : "usemtl green\n";
+        s += "v " + std::to_string(i + 1) + " 0 0\n";
+        s += "v " + std::to_string(i + 1) + " 1 0\n";
+        const uint v = i * 2 + 1; // 1-based index of the first vertex
+        s += "f " + std::to_string(v) + " " + std::to_string(v + 2) + " " +
+             std::to_string(v + 3) + " " + std::to_string(v + 1) + "\n";
+    }
+    return s;
+}
+
+TEST_CASE("Load OBJ parsed in several chunks")
+{
+    const uint        nQuads = 50000;
+    const std::string obj    = objQuadStrip(nQuads);
+    REQUIRE(obj.size() > 2 * vcl::detail::TEXT_CHUNK_BYTES);
+
+    std::istringstream mtl(
+        "newmtl red\nKd 1 0 0\n"
+        "newmtl green\nKd 0 1 0\n");
+
+    SECTION("PolyMesh")
+    {
+        vcl::PolyMesh      pm;
+        vcl::MeshInfo      info;
+        std::istringstream ss(obj);
+        vcl::loadObj(pm, ss, {&mtl}, info);
+
+        REQUIRE(pm.vertexNumber() == nQuads * 2 + 2);
+        REQUIRE(pm.faceNumber() == nQuads);
+        REQUIRE(info.isQuadMesh());
+        REQUIRE(info.hasPerFaceColor());
+        REQUIRE(info.hasPerVertexColor());
+
+        for (const auto& f : pm.faces()) {
+            const uint i = f.index();
+            REQUIRE(f.vertexNumber() == 4);
+            REQUIRE(pm.index(f.vertex(0)) == i * 2);
+            REQUIRE(pm.index(f.vertex(2)) == i * 2 + 3);
+            REQUIRE(
+                f.color() ==
+                ((i / 1000) % 2 ? vcl::Color::Red : vcl::Color::Green));
+        }
+        // the first two vertices are read with the red material, then each
+        // vertex has the material of the quad that follows it
+        REQUIRE(pm.vertex(0).color() == vcl::Color::Red);
+        REQUIRE(pm.vertex(2).color() == vcl::Color::Green);
+        REQUIRE(pm.vertex(2002).color() == vcl::Color::Red);
+        REQUIRE(pm.vertex(2 * nQuads + 1).position().x() == nQuads);
+    }
+
+    SECTION("TriMesh")
+    {
+        vcl::TriMesh       tm;
+        std::istringstream ss(obj);
+        vcl::loadObj(tm, ss, {&mtl});
+
+        REQUIRE(tm.vertexNumber() == nQuads * 2 + 2);
+        REQUIRE(tm.faceNumber() == nQuads * 2);
+        for (const auto& f : tm.faces()) {
+            REQUIRE(
+                f.color() ==
+                ((f.index() / 2000) % 2 ? vcl::Color::Red : vcl::Color::Green));
+        }
+    }
+
+    SECTION("Malformed number in the last chunk")
+    {
+        vcl::PolyMesh      pm;
+        std::istringstream ss(obj + "v 0 0 zero\n");
+        REQUIRE_THROWS_AS(
+            vcl::loadObj(pm, ss, {}), vcl::MalformedFileException);
+    }
+}
@@ -224,3 +224,106 @@ TEMPLATE_TEST_CASE(
         REQUIRE(line == "4 2 3 1 0 ");
     }
 }
+
+TEST_CASE("Load malformed OFF")
+{
+    vcl::TriMesh tm;
+
+    SECTION("Malformed number")
+    {
+        std::istringstream ss(
+            "OFF\n"
+            "3 1 0\n"
+            "0 0 0\n"
+            "1 0 0\n"
+            "0 1e 0\n"
+            "3 0 1 2\n");
+        REQUIRE_THROWS_AS(vcl::loadOff(tm, ss), vcl::MalformedFileException);
+    }
+
+    SECTION("Bad vertex index")
+    {
+        std::istringstream ss(
+            "OFF\n"
+            "3 1 0\n"
+            "0 0 0\n"
+            "1 0 0\n"
+            "0 1 0\n"
+            "3 0 1 3\n");
+        REQUIRE_THROWS_AS(vcl::loadOff(tm, ss), vcl::MalformedFileException);
+    }
+
+    SECTION("Missing faces")
+    {
+        std::istringstream ss(
+            "OFF\n"
+            "3 2 0\n"
+            "0 0 0\n"
+            "1 0 0\n"
+            "0 1 0\n"
+            "3 0 1 2\n");
+        REQUIRE_THROWS_AS(vcl::loadOff(tm, ss), vcl::MalformedFileException);
+    }
+}
+
+// an off file larger than a chunk of text, with a color for each quad and some
+// empty lines
+std::string offQuadStrip(uint nQuads)
+{
+    std::string s = "OFF\n" + std::to_string(nQuads * 2 + 2) + " " +
+                    std::to_string(nQuads) + " 0\n";
+    for (uint i = 0; i <= nQuads; ++i) {
+        s += std::to_string(i) + " 0 0\n";
+        s += std::to_string(i) + " 1 0\n\n";
+    }
+    for (uint i = 0; i < nQuads; ++i) {
+        const uint v = i * 2;
+        s += "4 " + std::to_string(v) + " " + std::to_string(v + 2) + " " +
+             std::to_string(v + 3) + " " + std::to_string(v + 1) +
+             (i % 2 ? " 255 0 0\n" : " 0 0 255\n");
+    }
+    return s;
+}
+
+TEST_CASE("Load OFF parsed in several chunks")
+{
+    const uint        nQuads = 50000;
+    const std::string off    = offQuadStrip(nQuads);
+    REQUIRE(off.size() > 2 * vcl::detail::TEXT_CHUNK_BYTES);
+
+    SECTION("PolyMesh")
+    {
+        vcl::PolyMesh      pm;
+        vcl::MeshInfo      info;
+        std::istringstream ss(off);
+        vcl::loadOff(pm, ss, info);
+
+        REQUIRE(pm.vertexNumber() == nQuads * 2 + 2);
+        REQUIRE(pm.faceNumber() == nQuads);
+        REQUIRE(info.isQuadMesh());
+        REQUIRE(info.hasPerFaceColor());
+
+        for (const auto& f : pm.faces()) {
+            const uint i = f.index();
+            REQUIRE(pm.index(f.vertex(0)) == i * 2);
+            REQUIRE(pm.index(f.vertex(2)) == i * 2 + 3);
+            REQUIRE(f.color() == (i % 2 ? vcl::Color::Red : vcl::Color::Blue));
+        }
+        REQUIRE(pm.vertex(2 * nQuads + 1).position().x() == nQuads);
+    }
+
+    SECTION("TriMesh")
+    {
+        vcl::TriMesh       tm;
+        std::istringstream ss(off);
+        vcl::loadOff(tm, ss);
+
+        REQUIRE(tm.vertexNumber() == nQuads * 2 + 2);
+        REQUIRE(tm.faceNumber() == nQuads * 2);
+        for (const auto& f : tm.faces()) {
+            REQUIRE(
+                f.color() ==
+                ((f.index() / 2) % 2 ? vcl::Color::Red : vcl::Color::Blue));
+        }
+    }
+}
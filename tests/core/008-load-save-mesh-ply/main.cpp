@@ -20,6 +20,7 @@
  * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
  ****************************************************************************/
 
+#include <vclib/algorithms.h>
 #include <vclib/io.h>
 #include <vclib/meshes.h>
 
@@ -216,3 +217,94 @@ TEMPLATE_TEST_CASE(
         REQUIRE(pm.edgeNumber() == 4);
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Save and load binary PLY",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh,
+    vcl::PolyMeshf)
+{
+    using MeshType = TestType;
+
+    MeshType m = vcl::loadPly<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bone.ply");
+
+    m.enablePerVertexColor();
+    for (auto& v : m.vertices()) {
+        v.color() = vcl::Color(v.index() % 256, 0, 255 - v.index() % 256);
+    }
+    vcl::updatePerVertexNormals(m);
+
+    vcl::SaveSettings settings;
+    settings.binary = true;
+
+    std::stringstream ss;
+    vcl::savePly(m, ss, settings);
+
+    MeshType mb;
+    vcl::loadPly(mb, ss);
+
+    REQUIRE(mb.vertexNumber() == m.vertexNumber());
+    REQUIRE(mb.faceNumber() == m.faceNumber());
+    REQUIRE(mb.isPerVertexColorEnabled());
+
+    for (uint i = 0; i < m.vertexNumber(); ++i) {
+        REQUIRE(mb.vertex(i).position() == m.vertex(i).position());
+        REQUIRE(mb.vertex(i).normal() == m.vertex(i).normal());
+        REQUIRE(mb.vertex(i).color() == m.vertex(i).color());
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Save and load PLY per-vertex custom components",
+    "",
+    vcl::TriMesh,
+    vcl::PolyMesh)
+{
+    using MeshType = TestType;
+
+    MeshType m = vcl::loadPly<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bone.ply");
+
+    m.template addPerVertexCustomComponent<int>("cc_int");
+    m.template addPerVertexCustomComponent<float>("cc_float");
+    m.template addPerVertexCustomComponent<unsigned char>("cc_uchar");
+    for (auto& v : m.vertices()) {
+        const int i = v.index();
+        v.template customComponent<int>("cc_int")             = i * 7 - 1000;
+        v.template customComponent<float>("cc_float")         = i * 0.25f;
+        v.template customComponent<unsigned char>("cc_uchar") = i % 256;
+    }
+
+    // binary files are read by the vertex block decoder, ascii files by the
+    // per-vertex reader
+    for (bool binary : {true, false}) {
+        vcl::SaveSettings settings;
+        settings.binary = binary;
+
+        std::stringstream ss;
+        vcl::savePly(m, ss, settings);
+
+        // the custom components are not created by the loader
+        MeshType mb;
+        mb.template addPerVertexCustomComponent<int>("cc_int");
+        mb.template addPerVertexCustomComponent<float>("cc_float");
+        mb.template addPerVertexCustomComponent<unsigned char>("cc_uchar");
+        vcl::loadPly(mb, ss);
+
+        REQUIRE(mb.vertexNumber() == m.vertexNumber());
+        for (const auto& v : m.vertices()) {
+            const auto& vb = mb.vertex(v.index());
+            REQUIRE(vb.position() == v.position());
+            REQUIRE(
+                vb.template customComponent<int>("cc_int") ==
+                v.template customComponent<int>("cc_int"));
+            REQUIRE(
+                vb.template customComponent<float>("cc_float") ==
+                v.template customComponent<float>("cc_float"));
+            REQUIRE(
+                vb.template customComponent<unsigned char>("cc_uchar") ==
+                v.template customComponent<unsigned char>("cc_uchar"));
+        }
+    }
+}
@@ -27,6 +27,8 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <set>
+
 template<vcl::FaceMeshConcept MeshType>
 void populateTriMesh(MeshType& tm)
 {
@@ -153,9 +155,31 @@ TEMPLATE_TEST_CASE(
 
         unsigned int nr = vcl::removeDuplicatedFaces(pm);
 
-        REQUIRE(nr == 3);
+        // faces 3 and 4 have the vertices of faces 1 and 2 in another cycle
+        REQUIRE(nr == 1);
         REQUIRE(pm.vertexNumber() == 5);
-        REQUIRE(pm.faceNumber() == 3);
+        REQUIRE(pm.faceNumber() == 5);
+    }
+
+    SECTION("PolyMesh with polygons having the same vertices in another order")
+    {
+        PolyMesh pm;
+
+        populatePolyMesh(pm);
+
+        pm.addFace(3, 2, 1, 0); // dup of 1 (opposite orientation)
+        pm.addFace(1, 2, 4, 0); // dup of 2 (different first vertex)
+
+        unsigned int nr = vcl::removeDuplicatedFaces(pm);
+
+        // (0, 2, 1, 3) has the same vertices of (0, 1, 2, 3), but different
+        // edges: it is not a duplicate
+        REQUIRE(nr == 3);
+        REQUIRE(pm.faceNumber() == 5);
+        REQUIRE(!pm.face(3).deleted());
+        REQUIRE(!pm.face(4).deleted());
+        REQUIRE(pm.face(6).deleted());
+        REQUIRE(pm.face(7).deleted());
     }
 }
 
@@ -274,3 +298,207 @@ TEMPLATE_TEST_CASE(
         REQUIRE(t.vertexNumber() == 18844 - nv);
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Duplicated Vertices and Faces of a triangle soup",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType     = TestType;
+    using PositionType = MeshType::VertexType::PositionType;
+
+    MeshType m = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bone.ply");
+    vcl::updateBoundingBox(m);
+
+    const double epsilon = m.boundingBox().diagonal() * 1e-4;
+
+    // number of distinct positions of the vertices referenced by the faces
+    std::set<PositionType> positions;
+    for (const auto& f : m.faces()) {
+        for (const auto* v : f.vertices())
+            positions.insert(v->position());
+    }
+    const vcl::uint nDuplicated = 6 * m.faceNumber() - positions.size();
+
+    // each face of the soup has its own vertices, and each face of the mesh
+    // is added twice, the second time with opposite orientation; if jitter
+    // is true, the copies of each vertex are moved by less than epsilon
+    auto triangleSoup = [&](bool jitter) {
+        MeshType soup;
+        soup.reserveVertices(6 * m.faceNumber());
+        for (vcl::uint k = 0; k < 2; ++k) {
+            for (const auto& f : m.faces()) {
+                for (vcl::uint i = 0; i < 3; ++i) {
+                    vcl::uint    j = k == 0 ? i : 2 - i;
+                    PositionType p = f.vertex(j)->position();
+                    if (jitter) {
+                        p += PositionType(1, -1, 1) *
+                             (epsilon * 0.25 * ((soup.vertexNumber() % 3)));
+                    }
+                    soup.addVertex(p);
+                }
+                vcl::uint n = soup.vertexNumber();
+                soup.addFace(n - 3, n - 2, n - 1);
+            }
+        }
+        return soup;
+    };
+
+    SECTION("Exact duplicates")
+    {
+        MeshType soup = triangleSoup(false);
+
+        vcl::uint nv = vcl::removeDuplicatedVertices(soup);
+        REQUIRE(nv == nDuplicated);
+        REQUIRE(soup.vertexNumber() == positions.size());
+
+        // the faces refer only to the remaining vertices
+        for (const auto& f : soup.faces()) {
+            for (const auto* v : f.vertices())
+                REQUIRE(!v->deleted());
+        }
+
+        vcl::uint nf = vcl::removeDuplicatedFaces(soup);
+        REQUIRE(nf == m.faceNumber());
+        REQUIRE(soup.faceNumber() == m.faceNumber());
+
+        // the first faces, that keep their orientation, are not deleted
+        for (vcl::uint i = 0; i < m.faceNumber(); ++i)
+            REQUIRE(!soup.face(i).deleted());
+    }
+
+    SECTION("Duplicates within epsilon")
+    {
+        MeshType soup = triangleSoup(true);
+
+        // only the copies that have not been moved are exact duplicates
+        REQUIRE(vcl::removeDuplicatedVertices(soup) < nDuplicated);
+
+        soup = triangleSoup(true);
+
+        REQUIRE(vcl::removeDuplicatedVertices(soup, epsilon) == nDuplicated);
+        REQUIRE(vcl::removeDuplicatedFaces(soup) == m.faceNumber());
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Connected Components rangemap.ply",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshIndexed)
+{
+    using TriMesh = TestType;
+
+    TriMesh t = vcl::load<TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/rangemap.ply");
+
+    t.enablePerFaceAdjacentFaces();
+    vcl::updatePerFaceAdjacentFaces(t);
+
+    vcl::ConnectedComponents cc = vcl::faceConnectedComponents(t);
+
+    SECTION("Test face connected components")
+    {
+        REQUIRE(cc.componentNumber() == 25);
+        REQUIRE(vcl::numberConnectedComponents(t) == 25);
+        REQUIRE(cc.elementNumber() == t.faceContainerSize());
+
+        vcl::uint nFaces = 0;
+        for (vcl::uint c = 0; c < cc.componentNumber(); ++c) {
+            auto faces = cc.elements(c);
+            REQUIRE(faces.size() == cc.componentSize(c));
+            REQUIRE(std::is_sorted(faces.begin(), faces.end()));
+            // components are numbered in the order of their first face
+            if (c > 0)
+                REQUIRE(cc.elements(c - 1).front() < faces.front());
+            for (vcl::uint fi : faces) {
+                REQUIRE(cc.component(fi) == c);
+                for (vcl::uint afi : t.face(fi).adjFaceIndices()) {
+                    if (afi != vcl::UINT_NULL)
+                        REQUIRE(cc.component(afi) == c);
+                }
+            }
+            nFaces += faces.size();
+        }
+        REQUIRE(nFaces == t.faceNumber());
+    }
+
+    SECTION("Test connected components as sets")
+    {
+        std::vector<std::set<vcl::uint>> sets = vcl::connectedComponents(t);
+
+        REQUIRE(sets.size() == cc.componentNumber());
+        for (vcl::uint c = 0; c < sets.size(); ++c) {
+            REQUIRE(std::equal(
+                sets[c].begin(),
+                sets[c].end(),
+                cc.elements(c).begin(),
+                cc.elements(c).end()));
+        }
+    }
+
+    SECTION("Test connected components by vertices")
+    {
+        t.disablePerFaceAdjacentFaces();
+
+        vcl::ConnectedComponents vcc =
+            vcl::faceConnectedComponentsByVertices(t);
+
+        // adjacent faces share a vertex: each component is a union of
+        // components computed with the adjacent faces
+        REQUIRE(vcc.componentNumber() <= cc.componentNumber());
+        for (vcl::uint c = 0; c < cc.componentNumber(); ++c) {
+            vcl::uint vc = vcc.component(cc.elements(c).front());
+            for (vcl::uint fi : cc.elements(c))
+                REQUIRE(vcc.component(fi) == vc);
+        }
+
+        // all the faces incident to a vertex are in the same component
+        std::vector<vcl::uint> vertComp(
+            t.vertexContainerSize(), vcl::UINT_NULL);
+        for (const auto& f : t.faces()) {
+            for (vcl::uint vi : f.vertexIndices()) {
+                if (vertComp[vi] == vcl::UINT_NULL)
+                    vertComp[vi] = vcc.component(t.index(f));
+                REQUIRE(vertComp[vi] == vcc.component(t.index(f)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Connected Components with deleted faces")
+{
+    using Point = vcl::TriMesh::VertexType::PositionType;
+
+    vcl::TriMesh t;
+
+    // two triangles that share only the vertex 2, and an isolated triangle
+    t.addVertices(
+        Point(0, 0, 0),
+        Point(1, 0, 0),
+        Point(1, 1, 0),
+        Point(2, 1, 0),
+        Point(2, 2, 0),
+        Point(5, 5, 0),
+        Point(6, 5, 0),
+        Point(6, 6, 0));
+    t.addFace(0, 1, 2);
+    t.addFace(2, 3, 4);
+    t.addFace(5, 6, 7);
+    t.addFace(0, 1, 2);
+    t.deleteFace(3);
+
+    t.enablePerFaceAdjacentFaces();
+    vcl::updatePerFaceAdjacentFaces(t);
+
+    vcl::ConnectedComponents cc  = vcl::faceConnectedComponents(t);
+    vcl::ConnectedComponents vcc = vcl::faceConnectedComponentsByVertices(t);
+
+    REQUIRE(cc.componentNumber() == 3);
+    REQUIRE(cc.labels() == std::vector<vcl::uint> {0, 1, 2, vcl::UINT_NULL});
+
+    REQUIRE(vcc.componentNumber() == 2);
+    REQUIRE(vcc.labels() == std::vector<vcl::uint> {0, 0, 1, vcl::UINT_NULL});
+    REQUIRE(vcc.componentSize(0) == 2);
+}
@@ -20,6 +20,7 @@
  * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
  ****************************************************************************/
 
+#include <vclib/algorithms.h>
 #include <vclib/io.h>
 #include <vclib/meshes.h>
 #include <vclib/space/complex/kd_tree.h>
@@ -57,3 +58,85 @@ TEMPLATE_TEST_CASE(
         getKNearestNeighbors<TriMesh>(p, 5) ==
         std::vector<unsigned int> {1558, 1613, 1720, 1576, 163});
 }
+
+TEMPLATE_TEST_CASE(
+    "KD-Tree bulk queries in bone.ply",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf)
+{
+    using TriMesh = TestType;
+
+    using PointType  = TriMesh::VertexType::PositionType;
+    using ScalarType = PointType::ScalarType;
+
+    TriMesh m = vcl::loadPly<TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/bone.ply");
+    vcl::updateBoundingBox(m);
+
+    vcl::KDTree tree(m);
+
+    // query points: the vertices of the mesh plus a regular grid of points
+    // around the mesh
+    std::vector<PointType> points;
+    for (const auto& v : m.vertices())
+        points.push_back(v.position());
+    const auto& bb = m.boundingBox();
+    for (unsigned int i = 0; i < 1000; ++i) {
+        PointType t(i % 10, (i / 10) % 10, i / 100);
+        points.push_back(bb.min() + (bb.max() - bb.min()).cwiseProduct(t / 9));
+    }
+
+    std::vector<unsigned int> offsets, indices;
+    std::vector<ScalarType>   distances;
+
+    SECTION("Nearest neighbor")
+    {
+        tree.nearestNeighborsIndices(points, indices, distances);
+        REQUIRE(indices.size() == points.size());
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            ScalarType dist;
+            REQUIRE(tree.nearestNeighborIndex(points[i], dist) == indices[i]);
+            REQUIRE(dist == distances[i]);
+        }
+    }
+
+    SECTION("K nearest neighbors")
+    {
+        const unsigned int K = 8;
+        tree.kNearestNeighborsIndices(points, K, offsets, indices, distances);
+        REQUIRE(offsets.size() == points.size() + 1);
+        REQUIRE(indices.size() == points.size() * K);
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            std::vector<ScalarType>   dists;
+            std::vector<unsigned int> res =
+                tree.kNearestNeighborsIndices(points[i], K, dists);
+            REQUIRE(offsets[i + 1] - offsets[i] == K);
+            REQUIRE(std::equal(
+                res.begin(), res.end(), indices.begin() + offsets[i]));
+            REQUIRE(std::equal(
+                dists.begin(), dists.end(), distances.begin() + offsets[i]));
+            REQUIRE(std::is_sorted(dists.begin(), dists.end()));
+        }
+    }
+
+    SECTION("Neighbors in distance")
+    {
+        const ScalarType radius = bb.diagonal() * 0.02;
+        tree.neighborsIndicesInDistance(
+            points, radius, offsets, indices, distances);
+        REQUIRE(offsets.size() == points.size() + 1);
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            std::vector<unsigned int> res =
+                tree.neighborsIndicesInDistance(points[i], radius);
+            REQUIRE(offsets[i + 1] - offsets[i] == res.size());
+            REQUIRE(std::equal(
+                res.begin(), res.end(), indices.begin() + offsets[i]));
+            for (unsigned int j = offsets[i]; j < offsets[i + 1]; ++j) {
+                REQUIRE(distances[j] < radius);
+                REQUIRE(vcl::epsilonEquals(
+                    points[i].dist(m.vertex(indices[j]).position()),
+                    distances[j]));
+            }
+        }
+    }
+}
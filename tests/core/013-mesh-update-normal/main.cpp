@@ -202,3 +202,100 @@ TEMPLATE_TEST_CASE(
             vcl::epsilonEquals(tem.vertex(6).normal(), VNormalType(1, 1, 1)));
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Parallel and Incremental Vertex Normals",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType     = TestType;
+    using PositionType = MeshType::VertexType::PositionType;
+
+    MeshType m = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    m.enablePerVertexAdjacentFaces();
+    vcl::updatePerVertexAdjacentFaces(m);
+
+    std::vector<vcl::uint> moved;
+    for (vcl::uint i = 0; i < m.vertexNumber(); i += 37)
+        moved.push_back(i);
+
+    // moves some vertices of m: the normals updated incrementally on m must be
+    // exactly the same of the ones updated in parallel on the whole mesh (using
+    // the adjacent faces of the vertices), and equal (up to the normalization,
+    // that is applied more than once by the serial update) to the ones updated
+    // serially, that do not use the adjacent faces unless asked
+    MeshType parallel, serial;
+
+    auto moveVertices = [&]() {
+        for (vcl::uint i : moved)
+            m.vertex(i).position() += PositionType(0.001, -0.002, 0.003);
+        parallel = m;
+        serial   = m;
+    };
+
+    auto checkNormals = [&]() {
+        for (const auto& v : m.vertices()) {
+            REQUIRE(v.normal() == parallel.vertex(v.index()).normal());
+            REQUIRE(vcl::epsilonEquals(
+                v.normal(), serial.vertex(v.index()).normal()));
+        }
+    };
+
+    THEN("Area Weighted")
+    {
+        vcl::updatePerVertexNormals(m, true, vcl::nullLogger, true);
+        moveVertices();
+
+        vcl::updatePerVertexNormals(m, moved);
+        vcl::updatePerVertexNormals(parallel, true, vcl::nullLogger, true);
+        vcl::updatePerVertexNormals(serial);
+
+        checkNormals();
+    }
+
+    THEN("Angle Weighted")
+    {
+        vcl::updatePerVertexNormalsAngleWeighted(
+            m, true, vcl::nullLogger, true);
+        moveVertices();
+
+        vcl::updatePerVertexNormalsAngleWeighted(m, moved);
+        vcl::updatePerVertexNormalsAngleWeighted(
+            parallel, true, vcl::nullLogger, true);
+        vcl::updatePerVertexNormalsAngleWeighted(serial);
+
+        checkNormals();
+    }
+
+    THEN("Nelson Max Weighted")
+    {
+        vcl::updatePerVertexNormalsNelsonMaxWeighted(
+            m, false, vcl::nullLogger, true);
+        moveVertices();
+
+        vcl::updatePerVertexNormalsNelsonMaxWeighted(m, moved, false);
+        vcl::updatePerVertexNormalsNelsonMaxWeighted(
+            parallel, false, vcl::nullLogger, true);
+        vcl::updatePerVertexNormalsNelsonMaxWeighted(serial, false);
+
+        checkNormals();
+    }
+
+    THEN("Adjacent faces are used only when asked")
+    {
+        // the adjacent faces of stale are enabled but never computed
+        MeshType stale = m;
+        stale.disablePerVertexAdjacentFaces();
+        stale.enablePerVertexAdjacentFaces();
+        serial = m;
+        serial.disablePerVertexAdjacentFaces();
+
+        vcl::updatePerVertexNormals(stale);
+        vcl::updatePerVertexNormals(serial);
+
+        for (const auto& v : stale.vertices())
+            REQUIRE(v.normal() == serial.vertex(v.index()).normal());
+    }
+}
@@ -31,7 +31,11 @@ TEMPLATE_TEST_CASE(
     vcl::PolyMesh,
     vcl::PolyMeshf,
     vcl::PolyMeshIndexed,
-    vcl::PolyMeshIndexedf)
+    vcl::PolyMeshIndexedf,
+    vcl::PolyMeshVertical,
+    vcl::PolyMeshVerticalf,
+    vcl::PolyMeshChunked,
+    vcl::PolyMeshChunkedf)
 {
     using PolyMesh = TestType;
 
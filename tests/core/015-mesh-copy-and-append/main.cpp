@@ -38,7 +38,9 @@ TEMPLATE_TEST_CASE(
     vcl::TriMeshIndexed,
     vcl::TriMeshIndexedf,
     vcl::PolyMeshIndexed,
-    vcl::PolyMeshIndexedf)
+    vcl::PolyMeshIndexedf,
+    vcl::TriMeshChunked,
+    vcl::PolyMeshChunked)
 {
     using Mesh = TestType;
 
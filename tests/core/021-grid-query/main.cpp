@@ -224,3 +224,117 @@ TEMPLATE_TEST_CASE(
         }
     }
 }
+
+TEMPLATE_TEST_CASE(
+    "Grid queries with lambdas and reused output vectors...",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf)
+{
+    using TriMesh    = TestType;
+    using PointType  = TriMesh::VertexType::PositionType;
+    using ScalarType = PointType::ScalarType;
+    using FaceType   = TriMesh::FaceType;
+
+    const vcl::uint K_NEAREST = 5;
+
+    TriMesh tm = vcl::load<TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    vcl::updateBoundingBox(tm);
+
+    std::vector<PointType> points =
+        randomPoints(N_POINTS_TEST, tm.boundingBox());
+    auto spheres = randomSpheres(N_POINTS_TEST, tm);
+
+    auto grid = computeGrid<vcl::StaticGrid3>(tm);
+
+    auto lambdaDist = [](const PointType& p, const FaceType& f) {
+        return vcl::distance(p, f);
+    };
+    std::function<ScalarType(const PointType&, const FaceType&)> stdFunDist =
+        lambdaDist;
+
+    using GridType = decltype(grid);
+
+    std::vector<typename GridType::ConstIterator> vec, vecBuf;
+    typename GridType::template KClosestCandidates<
+        typename GridType::ConstIterator>
+        cand;
+
+    for (vcl::uint i = 0; i < N_POINTS_TEST; ++i) {
+        ScalarType d1, d2;
+        auto       it1 = grid.closestValue(points[i], lambdaDist, d1);
+        auto       it2 = grid.closestValue(points[i], stdFunDist, d2);
+        REQUIRE(it1 == it2);
+        REQUIRE(d1 == d2);
+
+        auto kc = grid.kClosestValues(points[i], K_NEAREST);
+        grid.kClosestValues(points[i], K_NEAREST, lambdaDist, vec);
+        REQUIRE(kc == vec);
+        grid.kClosestValues(points[i], K_NEAREST, lambdaDist, vecBuf, cand);
+        REQUIRE(kc == vecBuf);
+
+        auto vs = grid.valuesInSphere(spheres[i]);
+        grid.valuesInSphere(spheres[i], vec);
+        REQUIRE(vs == vec);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "StaticGrid built from a range and with insert and build...",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf)
+{
+    using TriMesh    = TestType;
+    using ScalarType = TriMesh::VertexType::PositionType::ScalarType;
+    using FaceType   = TriMesh::FaceType;
+    using GridType   = vcl::StaticGrid3<const FaceType*, ScalarType>;
+
+    TriMesh tm = vcl::load<TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    vcl::updateBoundingBox(tm);
+
+    GridType grid(tm.faces() | vcl::views::addrOf);
+
+    // same grid, filled in two steps
+    GridType incGrid((const vcl::RegularGrid3<ScalarType>&) grid);
+    vcl::uint half = tm.faceNumber() / 2;
+    for (vcl::uint i = 0; i < half; ++i)
+        incGrid.insert(&tm.face(i));
+    incGrid.build();
+    for (vcl::uint i = half; i < tm.faceNumber(); ++i)
+        incGrid.insert(&tm.face(i));
+    incGrid.build();
+    // nothing has been inserted since the last build: the grid is unchanged
+    incGrid.build();
+
+    REQUIRE(grid.nonEmptyCells() == incGrid.nonEmptyCells());
+
+    std::size_t count = 0;
+    for (const auto& cell : grid.nonEmptyCells()) {
+        REQUIRE(grid.countInCell(cell) == incGrid.countInCell(cell));
+
+        auto [b1, e1] = grid.valuesInCell(cell);
+        auto [b2, e2] = incGrid.valuesInCell(cell);
+        const FaceType* prev = nullptr;
+        for (; b1 != e1; ++b1, ++b2) {
+            REQUIRE(b1->first == cell);
+            REQUIRE(b1->second == b2->second);
+            // values are stored in insertion order inside each cell
+            REQUIRE(prev < b1->second);
+            prev = b1->second;
+        }
+        count += grid.countInCell(cell);
+    }
+
+    // iterating over the whole grid visits each value with its cell
+    std::size_t total = 0;
+    for (const auto& [cell, f] : grid) {
+        REQUIRE(!grid.cellEmpty(cell));
+        bool found = false;
+        for (auto [b, e] = grid.valuesInCell(cell); b != e; ++b)
+            found |= b->second == f;
+        REQUIRE(found);
+        ++total;
+    }
+    REQUIRE(total == count);
+}
@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include <vclib/algorithms.h>
+#include <vclib/io.h>
+#include <vclib/meshes.h>
+#include <vclib/space/complex/bvh.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <set>
+
+static const vcl::uint N_QUERIES_TEST = 200;
+
+template<typename PointType, typename BoxType>
+std::vector<PointType> randomPoints(vcl::uint n, const BoxType& bb)
+{
+    using ScalarType = PointType::ScalarType;
+
+    std::mt19937                               gen(42);
+    std::uniform_real_distribution<ScalarType> dist(0, 1);
+
+    // points in a box that is larger than the bounding box of the mesh
+    PointType size = bb.size();
+    PointType min  = bb.min() - size * 0.25;
+
+    std::vector<PointType> points(n);
+    for (auto& p : points) {
+        for (vcl::uint i = 0; i < 3; ++i)
+            p[i] = min[i] + dist(gen) * size[i] * 1.5;
+    }
+    return points;
+}
+
+TEMPLATE_TEST_CASE(
+    "BVH queries on bunny.obj faces",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType   = TestType;
+    using FaceType   = MeshType::FaceType;
+    using PointType  = MeshType::VertexType::PositionType;
+    using ScalarType = PointType::ScalarType;
+
+    MeshType m = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    vcl::updateBoundingBox(m);
+
+    vcl::BVH bvh(m.faces() | vcl::views::addrOf);
+
+    REQUIRE(bvh.size() == m.faceNumber());
+
+    std::vector<PointType> points =
+        randomPoints<PointType>(N_QUERIES_TEST, m.boundingBox());
+
+    SECTION("Closest face")
+    {
+        for (const PointType& p : points) {
+            ScalarType bruteDist = std::numeric_limits<ScalarType>::max();
+            for (const FaceType& f : m.faces())
+                bruteDist = std::min(bruteDist, vcl::distance(p, f));
+
+            ScalarType dist = std::numeric_limits<ScalarType>::max();
+            auto       it   = bvh.closestValue(p, dist);
+
+            REQUIRE(it != bvh.end());
+            REQUIRE(vcl::epsilonEquals(dist, bruteDist));
+        }
+    }
+
+    SECTION("Faces in sphere")
+    {
+        const ScalarType radius = m.boundingBox().diagonal() / 10;
+
+        std::vector<typename decltype(bvh)::ConstIterator> res;
+        for (const PointType& p : points) {
+            vcl::Sphere<ScalarType> s(p, radius);
+
+            std::vector<const FaceType*> brute;
+            for (const FaceType& f : m.faces()) {
+                if (s.intersects(vcl::boundingBox(f)))
+                    brute.push_back(&f);
+            }
+
+            bvh.valuesInSphere(s, res);
+            std::vector<const FaceType*> found;
+            for (const auto& it : res)
+                found.push_back(*it);
+            std::sort(found.begin(), found.end());
+
+            REQUIRE(found == brute);
+        }
+    }
+
+    SECTION("Ray intersection")
+    {
+        for (const PointType& p : points) {
+            // ray from the query point towards the barycenter of a face
+            const FaceType& f = m.face(m.faceNumber() / 2);
+            PointType       dir = vcl::faceBarycenter(f) - p;
+
+            ScalarType t  = std::numeric_limits<ScalarType>::max();
+            auto       it = bvh.rayIntersection(p, dir, t);
+
+            REQUIRE(it != bvh.end());
+            // the first hit cannot be farther than the barycenter
+            REQUIRE(t <= 1 + 1e-4);
+            // the hit point lies on the intersected face
+            PointType hit = p + dir * t;
+            REQUIRE(vcl::distance(hit, **it) < 1e-4);
+        }
+    }
+}
+
+TEST_CASE("BVH ray intersection with polygonal faces")
+{
+    using PointType = vcl::PolyMesh::VertexType::PositionType;
+
+    vcl::PolyMesh m = vcl::createCube<vcl::PolyMesh>();
+    vcl::updateBoundingBox(m);
+
+    vcl::BVH bvh(m.faces() | vcl::views::addrOf);
+
+    double t  = std::numeric_limits<double>::max();
+    auto   it = bvh.rayIntersection(PointType(0, 0, -5), PointType(0, 0, 1), t);
+
+    REQUIRE(it != bvh.end());
+    REQUIRE(vcl::epsilonEquals(t, m.boundingBox().min().z() + 5));
+
+    // ray that misses the cube
+    it = bvh.rayIntersection(PointType(0, 5, -5), PointType(0, 0, 1));
+    REQUIRE(it == bvh.end());
+}
+
+TEST_CASE("Distance and intersection with a precomputed FaceTriangulation")
+{
+    using PointType = vcl::PolyMesh::VertexType::PositionType;
+
+    vcl::PolyMesh m =
+        vcl::load<vcl::PolyMesh>(VCLIB_EXAMPLE_MESHES_PATH "/greek_helmet.obj");
+    vcl::updateBoundingBox(m);
+
+    // a deleted face has no triangles
+    m.deleteFace(1);
+
+    vcl::FaceTriangulation tri(m);
+
+    REQUIRE(tri.faceNumber() == m.faceContainerSize());
+    REQUIRE(tri.triangleNumber(1) == 0);
+
+    vcl::uint nTris = 0;
+    for (const auto& f : m.faces()) {
+        REQUIRE(tri.triangleNumber(f.index()) == f.vertexNumber() - 2);
+        nTris += f.vertexNumber() - 2;
+    }
+    REQUIRE(tri.triangleNumber() == nTris);
+
+    std::vector<PointType> points =
+        randomPoints<PointType>(20, m.boundingBox());
+
+    const double maxDist = std::numeric_limits<double>::max();
+    for (const auto& p : points) {
+        for (const auto& f : m.faces()) {
+            PointType c1, c2;
+            double    d1 = vcl::boundedDistance(p, f, maxDist, c1);
+            double    d2 = vcl::boundedDistance(p, f, tri, maxDist, c2);
+            REQUIRE(d1 == d2);
+            REQUIRE(c1 == c2);
+
+            vcl::Box3d b(p, p + m.boundingBox().size() * 0.1);
+            REQUIRE(vcl::intersect(f, b) == vcl::intersect(f, tri, b));
+        }
+    }
+
+    // a BVH that copies the triangles from tri gives the same intersections
+    // of a BVH that triangulates the faces
+    vcl::BVH bvh(m.faces() | vcl::views::addrOf);
+    vcl::BVH bvhTri(m.faces() | vcl::views::addrOf, tri);
+    for (const auto& p : points) {
+        const PointType dir = m.boundingBox().center() - p;
+
+        double t1 = std::numeric_limits<double>::max();
+        double t2 = std::numeric_limits<double>::max();
+        auto   it1 = bvh.rayIntersection(p, dir, t1);
+        auto   it2 = bvhTri.rayIntersection(p, dir, t2);
+        REQUIRE((it1 == bvh.end()) == (it2 == bvhTri.end()));
+        if (it1 != bvh.end()) {
+            REQUIRE(*it1 == *it2);
+            REQUIRE(t1 == t2);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Hausdorff distance with BVH and StaticGrid",
+    "",
+    vcl::TriMesh,
+    vcl::PolyMesh)
+{
+    using MeshType = TestType;
+
+    MeshType m1 = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    MeshType m2 = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bone.ply");
+    vcl::updateBoundingBox(m1);
+    vcl::updateBoundingBox(m2);
+
+    auto resGrid = vcl::hausdorffDistance(
+        m1, m2, vcl::nullLogger, vcl::HAUSDORFF_VERTEX_UNIFORM, 0, true);
+    auto resBVH = vcl::hausdorffDistance(
+        m1,
+        m2,
+        vcl::nullLogger,
+        vcl::HAUSDORFF_VERTEX_UNIFORM,
+        0,
+        true,
+        vcl::HAUSDORFF_BVH);
+
+    REQUIRE(vcl::epsilonEquals(resGrid.maxDist, resBVH.maxDist));
+    REQUIRE(vcl::epsilonEquals(resGrid.minDist, resBVH.minDist));
+    REQUIRE(vcl::epsilonEquals(resGrid.meanDist, resBVH.meanDist));
+}
+
+TEST_CASE("Mesh-sphere intersection with BVH")
+{
+    using FaceType = vcl::TriMesh::FaceType;
+
+    vcl::TriMesh m =
+        vcl::load<vcl::TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    vcl::updateBoundingBox(m);
+
+    vcl::BVH bvh(m.faces() | vcl::views::addrOf);
+
+    vcl::Sphere<double> s(
+        m.boundingBox().center(), m.boundingBox().diagonal() / 4);
+
+    // the candidates found by the BVH contain all the faces in the sphere
+    std::set<const FaceType*> candidates;
+    for (const auto& it : bvh.valuesInSphere(s))
+        candidates.insert(*it);
+    for (const FaceType& f : m.faces()) {
+        if (vcl::distance(s.center(), f) <= s.radius())
+            REQUIRE(candidates.contains(&f));
+    }
+
+    vcl::TriMesh r1 = vcl::intersection(m, s, 1e-3);
+    vcl::TriMesh r2 = vcl::intersection(m, s, bvh, 1e-3);
+
+    REQUIRE(r2.faceNumber() > 0);
+    REQUIRE(r2.faceNumber() <= r1.faceNumber());
+}
@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include <vclib/algorithms.h>
+#include <vclib/io.h>
+#include <vclib/meshes.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+static const vcl::uint N_SAMPLES_TEST = 20000;
+
+TEST_CASE("Philox4x32 generator")
+{
+    vcl::Philox4x32 g1(42, 7), g2(42, 7), g3(42, 8);
+
+    std::vector<vcl::uint> v1(10), v2(10), v3(10);
+    for (vcl::uint i = 0; i < 10; ++i) {
+        v1[i] = g1();
+        v2[i] = g2();
+        v3[i] = g3();
+    }
+
+    // the same seed and stream generate the same values
+    REQUIRE(v1 == v2);
+    // different streams generate different values
+    REQUIRE(v1 != v3);
+
+    vcl::Philox4x32 g4(42, 7);
+    g4.discard(5);
+    REQUIRE(g4() == v1[5]);
+}
+
+TEMPLATE_TEST_CASE(
+    "Montecarlo point sampling",
+    "",
+    vcl::TriMesh,
+    vcl::PolyMesh)
+{
+    using MeshType  = TestType;
+    using PointType = MeshType::VertexType::PositionType;
+
+    MeshType m = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    // deleted faces must not be sampled
+    m.deleteFace(3);
+    m.deleteFace(1000);
+
+    SECTION("Montecarlo")
+    {
+        std::vector<vcl::uint> birth1, birth2;
+
+        auto s1 = vcl::montecarloPointSampling<vcl::PointSampler<PointType>>(
+            m, N_SAMPLES_TEST, birth1, true);
+        auto s2 = vcl::montecarloPointSampling<vcl::PointSampler<PointType>>(
+            m, N_SAMPLES_TEST, birth2, true);
+
+        REQUIRE(s1.size() == N_SAMPLES_TEST);
+        REQUIRE(birth1.size() == N_SAMPLES_TEST);
+
+        // deterministic sampling is reproducible
+        REQUIRE(s1.samples() == s2.samples());
+        REQUIRE(birth1 == birth2);
+
+        for (vcl::uint i = 0; i < N_SAMPLES_TEST; ++i) {
+            const auto& f = m.face(birth1[i]);
+            REQUIRE(!f.deleted());
+            REQUIRE(vcl::distance(s1.sample(i), f) < 1e-6);
+        }
+
+        // the MeshSampler stores the birth faces as custom component
+        using MSampler = vcl::MeshSampler<MeshType>;
+
+        std::vector<vcl::uint> birth3;
+
+        auto ms = vcl::montecarloPointSampling<MSampler>(
+            m, N_SAMPLES_TEST, birth3, true);
+
+        REQUIRE(birth3 == birth1);
+        for (const auto& v : ms.samples().vertices()) {
+            REQUIRE(v.position() == s1.sample(v.index()));
+            REQUIRE(
+                v.template customComponent<vcl::uint>("birthFace") ==
+                birth1[v.index()]);
+        }
+    }
+
+    SECTION("Stratified Montecarlo")
+    {
+        auto s1 = vcl::stratifiedMontecarloPointSampling<
+            vcl::PointSampler<PointType>>(m, N_SAMPLES_TEST, true);
+        auto s2 = vcl::stratifiedMontecarloPointSampling<
+            vcl::PointSampler<PointType>>(m, N_SAMPLES_TEST, true);
+
+        // the total number of samples may lose one sample due to rounding
+        REQUIRE(s1.size() <= N_SAMPLES_TEST);
+        REQUIRE(s1.size() >= N_SAMPLES_TEST - 1);
+        REQUIRE(s1.samples() == s2.samples());
+    }
+
+    SECTION("Montecarlo Poisson")
+    {
+        auto s1 = vcl::montecarloPoissonPointSampling<
+            vcl::PointSampler<PointType>>(m, N_SAMPLES_TEST, true);
+        auto s2 = vcl::montecarloPoissonPointSampling<
+            vcl::PointSampler<PointType>>(m, N_SAMPLES_TEST, true);
+
+        REQUIRE(s1.size() > N_SAMPLES_TEST * 0.95);
+        REQUIRE(s1.size() < N_SAMPLES_TEST * 1.05);
+        REQUIRE(s1.samples() == s2.samples());
+    }
+
+    SECTION("MeshSampler with leading faces without samples")
+    {
+        // the first sample does not belong to the first chunk of faces: the
+        // birth custom component must be created before the parallel phase
+        const vcl::uint nDeleted = vcl::POINT_SAMPLING_ELEMENTS_PER_CHUNK + 10;
+        for (vcl::uint i = 0; i < nDeleted; ++i) {
+            if (!m.face(i).deleted())
+                m.deleteFace(i);
+        }
+
+        using MSampler = vcl::MeshSampler<MeshType>;
+
+        auto checkBirthFaces = [&](const MSampler& ms) {
+            REQUIRE(ms.size() > 0);
+            for (const auto& v : ms.samples().vertices()) {
+                const vcl::uint fi =
+                    v.template customComponent<vcl::uint>("birthFace");
+                REQUIRE(fi >= nDeleted);
+                REQUIRE(vcl::distance(v.position(), m.face(fi)) < 1e-6);
+            }
+        };
+
+        checkBirthFaces(vcl::stratifiedMontecarloPointSampling<MSampler>(
+            m, N_SAMPLES_TEST, true));
+        checkBirthFaces(vcl::montecarloPoissonPointSampling<MSampler>(
+            m, N_SAMPLES_TEST, true));
+    }
+}
+
+TEST_CASE("PointHashGrid")
+{
+    using PointType = vcl::Point3d;
+
+    vcl::TriMesh m =
+        vcl::load<vcl::TriMesh>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+    vcl::updateBoundingBox(m);
+
+    std::vector<PointType> points;
+    for (const auto& v : m.vertices())
+        points.push_back(v.position());
+
+    const double cellSize = m.boundingBox().diagonal() / 50;
+
+    vcl::PointHashGrid<double> grid(points, cellSize);
+
+    REQUIRE(grid.pointNumber() == points.size());
+
+    // each point is stored in its cell, and each cell stores sorted indices
+    vcl::uint n = 0;
+    for (vcl::uint c = 0; c < grid.cellNumber(); ++c) {
+        auto pts = grid.cellPoints(c);
+        REQUIRE(!pts.empty());
+        REQUIRE(std::is_sorted(pts.begin(), pts.end()));
+        for (vcl::uint i : pts) {
+            REQUIRE(grid.cell(points[i]) == grid.cellPosition(c));
+            REQUIRE(grid.cellIndex(grid.cell(points[i])) == c);
+        }
+        n += pts.size();
+    }
+    REQUIRE(n == points.size());
+
+    REQUIRE(grid.cellIndex(vcl::Point3i(-1, 0, 0)) == vcl::UINT_NULL);
+
+    // all the points closer than cellSize are found by forEachPointNear
+    const PointType& q     = points[points.size() / 2];
+    vcl::uint        brute = 0, found = 0;
+    for (const auto& p : points)
+        brute += p.dist(q) < cellSize;
+    grid.forEachPointNear(q, cellSize, [&](vcl::uint i) {
+        found += points[i].dist(q) < cellSize;
+    });
+    REQUIRE(found == brute);
+
+    // the packed cell keys cannot store more than 2^21 cells per axis
+    std::vector<PointType> far = {PointType(0, 0, 0), PointType(1, 0, 0)};
+    REQUIRE_NOTHROW(vcl::PointHashGrid<double>(far, 1e-3));
+    REQUIRE_THROWS_AS(
+        vcl::PointHashGrid<double>(far, 1e-7), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        vcl::PointHashGrid<double>(far, 0), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE(
+    "Poisson disk point sampling",
+    "",
+    vcl::TriMesh,
+    vcl::PolyMesh)
+{
+    using MeshType  = TestType;
+    using PointType = MeshType::VertexType::PositionType;
+    using Sampler   = vcl::PointSampler<PointType>;
+
+    MeshType m = vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/bunny.obj");
+
+    // minimum distance between two samples, using a grid of the samples
+    auto minDistance = [](const Sampler& s, double radius) {
+        vcl::PointHashGrid<double> g(s.samples(), radius);
+
+        double minDist = std::numeric_limits<double>::max();
+        for (vcl::uint i = 0; i < s.size(); ++i) {
+            g.forEachPointNear(s.sample(i), radius, [&](vcl::uint j) {
+                if (i != j)
+                    minDist = std::min(minDist, s.sample(i).dist(s.sample(j)));
+            });
+        }
+        return minDist;
+    };
+
+    SECTION("Number of samples")
+    {
+        const vcl::uint n = 2000;
+
+        std::vector<vcl::uint> birth1, birth2;
+
+        Sampler s1 =
+            vcl::poissonDiskPointSampling<Sampler>(m, n, birth1, true);
+        Sampler s2 =
+            vcl::poissonDiskPointSampling<Sampler>(m, n, birth2, true);
+
+        REQUIRE(s1.size() > n * 0.95);
+        REQUIRE(s1.size() < n * 1.05);
+        REQUIRE(birth1.size() == s1.size());
+        REQUIRE(s1.samples() == s2.samples());
+        REQUIRE(birth1 == birth2);
+
+        for (vcl::uint i = 0; i < s1.size(); ++i)
+            REQUIRE(vcl::distance(s1.sample(i), m.face(birth1[i])) < 1e-6);
+    }
+
+    SECTION("Radius")
+    {
+        const double radius = vcl::boundingBox(m).diagonal() / 100;
+
+        Sampler s =
+            vcl::poissonDiskRadiusPointSampling<Sampler>(m, radius, true);
+
+        REQUIRE(s.size() > 0);
+        REQUIRE(minDistance(s, radius) >= radius);
+
+        // the samples cover the pool: no montecarlo sample is farther than
+        // 2 * radius from a poisson disk sample
+        Sampler mc = vcl::montecarloPointSampling<Sampler>(m, 1000, true);
+        vcl::PointHashGrid<double> g(s.samples(), 2 * radius);
+        for (const auto& p : mc) {
+            bool covered = false;
+            g.forEachPointNear(p, 2 * radius, [&](vcl::uint j) {
+                covered |= p.dist(s.sample(j)) < 2 * radius;
+            });
+            REQUIRE(covered);
+        }
+    }
+
+    SECTION("Radius bounded by the grid")
+    {
+        // two small triangles far apart: the radius needed for the requested
+        // number of samples would require too many cells of the hash grid,
+        // therefore it is not refined below the minimum allowed radius
+        MeshType t;
+        t.addVertices(
+            PointType(0, 0, 0),
+            PointType(1e-3, 0, 0),
+            PointType(0, 1e-3, 0),
+            PointType(1e4, 0, 0),
+            PointType(1e4 + 1e-3, 0, 0),
+            PointType(1e4, 1e-3, 0));
+        t.addFace(0, 1, 2);
+        t.addFace(3, 4, 5);
+
+        Sampler s;
+        REQUIRE_NOTHROW(
+            s = vcl::poissonDiskPointSampling<Sampler>(t, 1000, true));
+
+        REQUIRE(s.size() > 0);
+        REQUIRE(s.size() < 1000);
+
+        const double minRadius = 1e4 / ((1 << 21) - 1);
+        for (vcl::uint i = 0; i < s.size(); ++i) {
+            for (vcl::uint j = i + 1; j < s.size(); ++j)
+                REQUIRE(s.sample(i).dist(s.sample(j)) >= minRadius * 0.99);
+        }
+    }
+}
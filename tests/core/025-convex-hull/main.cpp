@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include <vclib/algorithms.h>
+#include <vclib/algorithms/mesh/convex_hull.h>
+#include <vclib/meshes.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+template<typename MeshType, typename PointType>
+void checkConvexHull(const MeshType& hull, const std::vector<PointType>& points)
+{
+    using FaceType = MeshType::FaceType;
+
+    // closed surface of genus 0
+    REQUIRE(hull.faceNumber() == 2 * hull.vertexNumber() - 4);
+
+    for (const FaceType& f : hull.faces()) {
+        // adjacencies are reciprocal
+        for (const FaceType* adj : f.adjFaces()) {
+            REQUIRE(adj != nullptr);
+            REQUIRE(adj->indexOfAdjFace(&f) != vcl::UINT_NULL);
+        }
+
+        // no point lies outside of the plane of the face
+        const auto n       = vcl::faceNormal(f).normalized();
+        const auto o       = f.vertex(0)->position();
+        double     maxDist = 0;
+        for (const auto& p : points)
+            maxDist = std::max<double>(maxDist, n.dot(p - o));
+        REQUIRE(maxDist <= 1e-6);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Convex hull of points",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType  = TestType;
+    using PointType = MeshType::VertexType::PositionType;
+
+    SECTION("Random points in a cube")
+    {
+        std::mt19937                     gen(42);
+        std::uniform_real_distribution<> dist(-1, 1);
+
+        std::vector<PointType> points(20000);
+        for (auto& p : points)
+            p = PointType(dist(gen), dist(gen), dist(gen));
+
+        MeshType hull = vcl::convexHull<MeshType>(points);
+
+        REQUIRE(hull.vertexNumber() > 4);
+        REQUIRE(hull.vertexNumber() < points.size());
+        checkConvexHull(hull, points);
+
+        // the result does not depend on the order of the points
+        std::shuffle(points.begin(), points.end(), gen);
+        MeshType hull2 = vcl::convexHull<MeshType>(points);
+        REQUIRE(hull2.vertexNumber() == hull.vertexNumber());
+    }
+
+    SECTION("Vertices of a sphere")
+    {
+        MeshType sphere = vcl::createSphereIcosahedron<MeshType>(
+            vcl::Sphere<typename PointType::ScalarType>({0, 0, 0}, 1), 4);
+
+        std::vector<PointType> points;
+        for (const auto& v : sphere.vertices())
+            points.push_back(v.position());
+
+        // all the vertices of the sphere lie on the hull
+        MeshType hull = vcl::convexHull<MeshType>(points);
+        REQUIRE(hull.vertexNumber() == sphere.vertexNumber());
+        checkConvexHull(hull, points);
+    }
+
+    SECTION("Grid of points")
+    {
+        // the points on the faces and the edges of the cube are coplanar and
+        // collinear: only the corners are vertices of the hull
+        std::vector<PointType> points;
+        for (int i = 0; i <= 10; ++i) {
+            for (int j = 0; j <= 10; ++j) {
+                for (int k = 0; k <= 10; ++k)
+                    points.push_back(PointType(i, j, k) * 0.1);
+            }
+        }
+
+        MeshType hull = vcl::convexHull<MeshType>(points);
+        REQUIRE(hull.vertexNumber() == 8);
+        checkConvexHull(hull, points);
+    }
+
+    SECTION("Almost coplanar points")
+    {
+        // the points of the grid on the faces of the cube are moved by less
+        // than the tolerance: the hull must be a closed surface anyway
+        std::mt19937                     gen(42);
+        std::uniform_real_distribution<> jitter(-1e-15, 1e-15);
+
+        std::vector<PointType> points;
+        for (int i = 0; i <= 20; ++i) {
+            for (int j = 0; j <= 20; ++j) {
+                for (int k = 0; k <= 20; ++k) {
+                    if (i % 20 != 0 && j % 20 != 0 && k % 20 != 0)
+                        continue;
+                    PointType p(i, j, k);
+                    p *= 0.05;
+                    for (uint c = 0; c < 3; ++c)
+                        p[c] += jitter(gen);
+                    points.push_back(p);
+                }
+            }
+        }
+
+        MeshType hull = vcl::convexHull<MeshType>(points);
+        checkConvexHull(hull, points);
+    }
+
+    SECTION("Degenerate sets of points")
+    {
+        std::vector<PointType> points;
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j)
+                points.push_back(PointType(i, j, 0));
+        }
+        REQUIRE_THROWS(vcl::convexHull<MeshType>(points));
+
+        points.resize(3);
+        REQUIRE_THROWS(vcl::convexHull<MeshType>(points));
+    }
+}
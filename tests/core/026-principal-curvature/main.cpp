@@ -0,0 +1,250 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include <vclib/algorithms.h>
+#include <vclib/meshes.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// square grid of side 2 centered in the origin, in the z = 0 plane, made of
+// n x n cells split in two triangles (or quads for polygonal meshes)
+template<typename MeshType>
+MeshType planarGrid(vcl::uint n)
+{
+    using PointType = MeshType::VertexType::PositionType;
+
+    MeshType m;
+    for (vcl::uint i = 0; i <= n; ++i) {
+        for (vcl::uint j = 0; j <= n; ++j)
+            m.addVertex(PointType(-1 + 2.0 * j / n, -1 + 2.0 * i / n, 0));
+    }
+    for (vcl::uint i = 0; i < n; ++i) {
+        for (vcl::uint j = 0; j < n; ++j) {
+            vcl::uint v = i * (n + 1) + j;
+            if constexpr (vcl::HasTriangles<MeshType>) {
+                m.addFace(v, v + 1, v + n + 2);
+                m.addFace(v, v + n + 2, v + n + 1);
+            }
+            else {
+                m.addFace(v, v + 1, v + n + 2, v + n + 1);
+            }
+        }
+    }
+    return m;
+}
+
+// the same grid of planarGrid, where each 2 x 2 block of cells is split in a
+// square and a concave L-shaped octagon, whose first vertex does not see all
+// the other ones
+template<typename MeshType>
+MeshType concavePlanarGrid(vcl::uint n)
+{
+    using PointType = MeshType::VertexType::PositionType;
+
+    MeshType m;
+    for (vcl::uint i = 0; i <= n; ++i) {
+        for (vcl::uint j = 0; j <= n; ++j)
+            m.addVertex(PointType(-1 + 2.0 * j / n, -1 + 2.0 * i / n, 0));
+    }
+    auto v = [&](vcl::uint i, vcl::uint j) {
+        return i * (n + 1) + j;
+    };
+    for (vcl::uint i = 0; i < n; i += 2) {
+        for (vcl::uint j = 0; j < n; j += 2) {
+            m.addFace(
+                v(i + 1, j + 2),
+                v(i + 1, j + 1),
+                v(i + 2, j + 1),
+                v(i + 2, j),
+                v(i + 1, j),
+                v(i, j),
+                v(i, j + 1),
+                v(i, j + 2));
+            m.addFace(
+                v(i + 1, j + 1),
+                v(i + 1, j + 2),
+                v(i + 2, j + 2),
+                v(i + 2, j + 1));
+        }
+    }
+    return m;
+}
+
+// mean over the vertices of the mean curvature
+template<typename MeshType>
+double meanCurvature(const MeshType& m)
+{
+    double sum = 0;
+    for (const auto& v : m.vertices())
+        sum += v.principalCurvature().maxValue() +
+               v.principalCurvature().minValue();
+    return sum / (2 * m.vertexNumber());
+}
+
+TEMPLATE_TEST_CASE(
+    "PCA principal curvature",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType   = TestType;
+    using ScalarType = MeshType::VertexType::PositionType::ScalarType;
+
+    SECTION("Integration over a plane")
+    {
+        const double r = 0.3;
+
+        MeshType m = planarGrid<MeshType>(20);
+        m.enablePerVertexPrincipalCurvature();
+
+        vcl::updatePrincipalCurvaturePCA(m, r, false);
+
+        // the neighborhood of the central vertex is a disk, whose covariance
+        // has eigenvalues pi * r^4 / 4 (tangent) and 0 (normal)
+        const double k = 2.0 / 5.0 * (4 * r - 7.5) / (r * r);
+        const auto&  c = m.vertex(m.vertexNumber() / 2).principalCurvature();
+
+        REQUIRE(std::abs(c.maxValue() - k) <= 1e-3 * std::abs(k));
+        REQUIRE(std::abs(c.minValue() - k) <= 1e-3 * std::abs(k));
+    }
+
+    SECTION("Integration over a sphere")
+    {
+        const vcl::Sphere<ScalarType> s({0, 0, 0}, 1);
+
+        MeshType m3 = vcl::createSphereIcosahedron<MeshType>(s, 3);
+        MeshType m4 = vcl::createSphereIcosahedron<MeshType>(s, 4);
+        m3.enablePerVertexPrincipalCurvature();
+        m4.enablePerVertexPrincipalCurvature();
+
+        vcl::updatePrincipalCurvaturePCA(m3, 0.2, false);
+        vcl::updatePrincipalCurvaturePCA(m4, 0.2, false);
+
+        // the faces are clipped exactly by the sphere: the curvature is
+        // isotropic and does not depend on the resolution of the mesh
+        for (const auto& v : m3.vertices()) {
+            const auto& c = v.principalCurvature();
+            REQUIRE(
+                std::abs(c.maxValue() - c.minValue()) <=
+                1e-2 * std::abs(c.maxValue()));
+        }
+        const double k3 = meanCurvature(m3);
+        REQUIRE(std::abs(k3 - meanCurvature(m4)) <= 1e-2 * std::abs(k3));
+    }
+
+    SECTION("Montecarlo sampling")
+    {
+        MeshType m = vcl::createSphereIcosahedron<MeshType>(
+            vcl::Sphere<ScalarType>({0, 0, 0}, 1), 3);
+        m.enablePerVertexPrincipalCurvature();
+
+        // deleted vertices are skipped
+        m.deleteVertex(vcl::uint(0));
+
+        vcl::updatePrincipalCurvaturePCA(m, 0.2, true);
+
+        for (const auto& v : m.vertices()) {
+            const auto& c = v.principalCurvature();
+            REQUIRE(std::isfinite(c.maxValue()));
+            REQUIRE(c.maxValue() >= c.minValue());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "PCA principal curvature of concave polygons",
+    "",
+    vcl::PolyMesh,
+    vcl::PolyMeshf)
+{
+    using MeshType = TestType;
+
+    const double r = 0.3;
+
+    MeshType m = concavePlanarGrid<MeshType>(20);
+    m.enablePerVertexPrincipalCurvature();
+
+    vcl::updatePrincipalCurvaturePCA(m, r, false);
+
+    // the concave faces are integrated over their triangulation, and the
+    // neighborhood of the central vertex is a disk as in the convex grid
+    const double k = 2.0 / 5.0 * (4 * r - 7.5) / (r * r);
+    const auto&  c = m.vertex(m.vertexNumber() / 2).principalCurvature();
+
+    REQUIRE(std::abs(c.maxValue() - k) <= 1e-3 * std::abs(k));
+    REQUIRE(std::abs(c.minValue() - k) <= 1e-3 * std::abs(k));
+}
+
+TEMPLATE_TEST_CASE(
+    "Taubin95 principal curvature",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType   = TestType;
+    using ScalarType = MeshType::VertexType::PositionType::ScalarType;
+
+    MeshType m = vcl::createSphereIcosahedron<MeshType>(
+        vcl::Sphere<ScalarType>({0, 0, 0}, 1), 4);
+    m.enablePerVertexPrincipalCurvature();
+    m.enablePerVertexAdjacentFaces();
+    m.enablePerFaceAdjacentFaces();
+    vcl::updatePerVertexAdjacentFaces(m);
+    vcl::updatePerFaceAdjacentFaces(m);
+
+    vcl::updatePrincipalCurvatureTaubin95(m);
+
+    // the curvature of the unit sphere is 1
+    REQUIRE(std::abs(meanCurvature(m) - 1) <= 1e-2);
+    for (const auto& v : m.vertices()) {
+        const auto& c = v.principalCurvature();
+        REQUIRE(c.maxValue() >= c.minValue());
+    }
+
+    SECTION("Incremental update")
+    {
+        // stretch the sphere along the y axis, and then move some vertices
+        for (auto& v : m.vertices())
+            v.position().y() *= 2;
+        vcl::updatePrincipalCurvatureTaubin95(m);
+
+        std::vector<vcl::uint> moved;
+        for (vcl::uint i = 0; i < m.vertexNumber(); i += 50) {
+            m.vertex(i).position() *= 1.05;
+            moved.push_back(i);
+        }
+
+        MeshType full = m;
+        vcl::updatePrincipalCurvatureTaubin95(full);
+        vcl::updatePrincipalCurvatureTaubin95(m, moved);
+
+        for (vcl::uint i = 0; i < m.vertexNumber(); ++i) {
+            const auto& c1 = m.vertex(i).principalCurvature();
+            const auto& c2 = full.vertex(i).principalCurvature();
+            REQUIRE(std::abs(c1.maxValue() - c2.maxValue()) <= 1e-6);
+            REQUIRE(std::abs(c1.minValue() - c2.minValue()) <= 1e-6);
+        }
+    }
+}
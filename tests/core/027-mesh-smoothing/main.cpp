@@ -0,0 +1,211 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#include <vclib/algorithms.h>
+#include <vclib/io.h>
+#include <vclib/meshes.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+// reference implementation of the Laplacian smoothing, that accumulates the
+// neighbors of the vertices with serial loops over the faces at each step
+template<typename MeshType>
+auto referenceLaplacianSums(const MeshType& m, bool cotangent)
+{
+    using PositionType = MeshType::VertexType::PositionType;
+    using ScalarType   = PositionType::ScalarType;
+
+    const vcl::uint nv = m.vertexContainerSize();
+
+    std::vector<PositionType> sum(nv, PositionType(0, 0, 0));
+    std::vector<ScalarType>   cnt(nv, 0);
+
+    for (const auto& f : m.faces()) {
+        for (vcl::uint j = 0; j < f.vertexNumber(); ++j) {
+            if (!f.edgeOnBorder(j)) {
+                const PositionType& p0 = f.vertex(j)->position();
+                const PositionType& p1 = f.vertexMod(j + 1)->position();
+                const PositionType& p2 = f.vertexMod(j + 2)->position();
+
+                ScalarType w = 1;
+                if (cotangent) {
+                    ScalarType angle = PositionType(p1 - p2).angle(p0 - p2);
+                    w                = std::tan((M_PI * 0.5) - angle);
+                }
+                sum[f.vertexIndex(j)] += p1 * w;
+                sum[f.vertexIndexMod(j + 1)] += p0 * w;
+                cnt[f.vertexIndex(j)] += w;
+                cnt[f.vertexIndexMod(j + 1)] += w;
+            }
+        }
+    }
+    // vertices on the border are averaged only with their border neighbors
+    for (const auto& f : m.faces()) {
+        for (vcl::uint j = 0; j < f.vertexNumber(); ++j) {
+            if (f.edgeOnBorder(j)) {
+                for (vcl::uint k = 0; k < 2; ++k) {
+                    vcl::uint vi = f.vertexIndexMod(j + k);
+                    sum[vi]      = m.vertex(vi).position();
+                    cnt[vi]      = 1;
+                }
+            }
+        }
+    }
+    for (const auto& f : m.faces()) {
+        for (vcl::uint j = 0; j < f.vertexNumber(); ++j) {
+            if (f.edgeOnBorder(j)) {
+                sum[f.vertexIndex(j)] += f.vertexMod(j + 1)->position();
+                sum[f.vertexIndexMod(j + 1)] += f.vertex(j)->position();
+                ++cnt[f.vertexIndex(j)];
+                ++cnt[f.vertexIndexMod(j + 1)];
+            }
+        }
+    }
+    return std::make_pair(sum, cnt);
+}
+
+template<typename MeshType>
+void referenceLaplacianSmoothing(
+    MeshType& m,
+    vcl::uint step,
+    bool      smoothSelected,
+    bool      cotangent)
+{
+    for (vcl::uint i = 0; i < step; ++i) {
+        auto [sum, cnt] = referenceLaplacianSums(m, cotangent);
+        for (auto& v : m.vertices()) {
+            vcl::uint vi = m.index(v);
+            if (cnt[vi] > 0 && (!smoothSelected || v.selected()))
+                v.position() = (v.position() + sum[vi]) / (cnt[vi] + 1);
+        }
+    }
+}
+
+template<typename MeshType>
+void referenceTaubinSmoothing(
+    MeshType& m,
+    vcl::uint step,
+    float     lambda,
+    float     mu,
+    bool      smoothSelected)
+{
+    using PositionType = MeshType::VertexType::PositionType;
+
+    auto taubinStep = [&](float factor) {
+        auto [sum, cnt] = referenceLaplacianSums(m, false);
+        for (auto& v : m.vertices()) {
+            vcl::uint vi = m.index(v);
+            if (cnt[vi] > 0 && (!smoothSelected || v.selected())) {
+                PositionType delta = sum[vi] / cnt[vi] - v.position();
+                v.position()       = v.position() + delta * factor;
+            }
+        }
+    };
+
+    for (vcl::uint i = 0; i < step; ++i) {
+        taubinStep(lambda);
+        taubinStep(mu);
+    }
+}
+
+// sets the border flags of the face edges that have no adjacent face
+template<typename MeshType>
+void setBorderFlags(MeshType& m)
+{
+    m.enablePerFaceAdjacentFaces();
+    vcl::updatePerFaceAdjacentFaces(m);
+    for (auto& f : m.faces()) {
+        for (vcl::uint j = 0; j < f.vertexNumber(); ++j)
+            f.edgeOnBorder(j) = f.adjFace(j) == nullptr;
+    }
+    m.disablePerFaceAdjacentFaces();
+}
+
+template<typename MeshType>
+void checkSameSmoothing(const MeshType& m)
+{
+    auto requireSamePositions = [](const MeshType& m1, const MeshType& m2) {
+        for (const auto& v : m1.vertices())
+            REQUIRE(v.position() == m2.vertex(m1.index(v)).position());
+    };
+
+    // with selection, only one vertex every three is smoothed
+    MeshType sel = m;
+    for (auto& v : sel.vertices())
+        v.selected() = sel.index(v) % 3 == 0;
+
+    for (bool selected : {false, true}) {
+        const MeshType& m0 = selected ? sel : m;
+        for (bool cotangent : {false, true}) {
+            MeshType m1 = m0, m2 = m0;
+            vcl::laplacianSmoothing(m1, 5, selected, cotangent);
+            referenceLaplacianSmoothing(m2, 5, selected, cotangent);
+            requireSamePositions(m1, m2);
+        }
+
+        MeshType m1 = m0, m2 = m0;
+        vcl::taubinSmoothing(m1, 5, 0.5, -0.53, selected);
+        referenceTaubinSmoothing(m2, 5, 0.5, -0.53, selected);
+        requireSamePositions(m1, m2);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Laplacian and Taubin smoothing on a mesh with borders",
+    "",
+    vcl::TriMesh,
+    vcl::TriMeshf,
+    vcl::PolyMesh)
+{
+    using MeshType = TestType;
+
+    MeshType m =
+        vcl::load<MeshType>(VCLIB_EXAMPLE_MESHES_PATH "/rangemap.ply");
+
+    setBorderFlags(m);
+    bool hasBorders = false;
+    for (const auto& f : m.faces()) {
+        for (vcl::uint j = 0; j < f.vertexNumber(); ++j)
+            hasBorders |= f.edgeOnBorder(j);
+    }
+    REQUIRE(hasBorders);
+
+    checkSameSmoothing(m);
+}
+
+TEST_CASE("Laplacian and Taubin smoothing on a polygonal mesh")
+{
+    vcl::PolyMesh m =
+        vcl::load<vcl::PolyMesh>(VCLIB_EXAMPLE_MESHES_PATH "/greek_helmet.obj");
+    setBorderFlags(m);
+
+    bool hasPolygons = false;
+    for (const auto& f : m.faces())
+        hasPolygons |= f.vertexNumber() > 3;
+    REQUIRE(hasPolygons);
+
+    checkSameSmoothing(m);
+}
@@ -0,0 +1,535 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_BINDINGS_CORE_MESH_CONTAINERS_COMPONENT_ARRAYS_H
+#define VCL_BINDINGS_CORE_MESH_CONTAINERS_COMPONENT_ARRAYS_H
+
+#include <vclib/concepts/mesh.h>
+#include <vclib/mesh/requirements.h>
+#include <vclib/space/core.h>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace vcl::bind {
+
+namespace detail {
+
+// scalar type and number of columns of the numpy array that stores a value
+// of type T for each element (one column for scalar values)
+template<typename T>
+struct ArrayTraits
+{
+    using ScalarType              = T;
+    static constexpr uint COLUMNS = 1;
+};
+
+template<typename T>
+    requires requires {
+        typename T::ScalarType;
+        T::DIM;
+    }
+struct ArrayTraits<T>
+{
+    using ScalarType              = T::ScalarType;
+    static constexpr uint COLUMNS = T::DIM;
+};
+
+template<typename T>
+using ArrayOf = pybind11::array_t<
+    typename ArrayTraits<T>::ScalarType,
+    pybind11::array::c_style | pybind11::array::forcecast>;
+
+// types of the custom components that can be read and written as arrays
+using CustomComponentArrayTypes =
+    TypeWrapper<double, float, int, uint, Point3d, Point3f>;
+
+/*
+ * Returns the shape of the array that stores a value of type T for each one
+ * of the n elements.
+ */
+template<typename T>
+std::vector<pybind11::ssize_t> arrayShape(uint n)
+{
+    using ssize_t = pybind11::ssize_t;
+
+    if constexpr (ArrayTraits<T>::COLUMNS == 1)
+        return {ssize_t(n)};
+    else
+        return {ssize_t(n), ssize_t(ArrayTraits<T>::COLUMNS)};
+}
+
+template<typename T>
+void checkArrayShape(const pybind11::array& a, uint n)
+{
+    using ssize_t = pybind11::ssize_t;
+
+    if (a.ndim() != (ArrayTraits<T>::COLUMNS == 1 ? 1 : 2) ||
+        a.shape(0) != ssize_t(n) ||
+        (a.ndim() == 2 && a.shape(1) != ssize_t(ArrayTraits<T>::COLUMNS))) {
+        throw pybind11::value_error(
+            "The array must have " + std::to_string(n) + " rows and " +
+            std::to_string(ArrayTraits<T>::COLUMNS) + " columns.");
+    }
+}
+
+/*
+ * Returns a numpy array that stores a copy of the component returned by
+ * getComp of all the elements of the container (including the deleted ones).
+ * The array is read-only, since writing it would not modify the mesh.
+ */
+template<uint ELEM_ID, MeshConcept MeshType, typename GetComponent>
+pybind11::array componentArrayCopy(MeshType& t, GetComponent&& getComp)
+{
+    using ElementType = MeshType::template ElementType<ELEM_ID>;
+    using ValueType =
+        std::remove_cvref_t<decltype(getComp(std::declval<ElementType&>()))>;
+
+    constexpr uint COLUMNS = ArrayTraits<ValueType>::COLUMNS;
+
+    const uint n = t.template containerSize<ELEM_ID>();
+
+    ArrayOf<ValueType> a(arrayShape<ValueType>(n));
+    auto*              r = a.mutable_data();
+    for (uint i = 0; i < n; ++i) {
+        const ValueType& v = getComp(t.template element<ELEM_ID>(i));
+        if constexpr (COLUMNS == 1) {
+            r[i] = v;
+        }
+        else {
+            for (uint j = 0; j < COLUMNS; ++j)
+                r[i * COLUMNS + j] = v[j];
+        }
+    }
+    a.attr("setflags")(pybind11::arg("write") = false);
+    return a;
+}
+
+/*
+ * Returns a numpy array that views, without copying, the component returned
+ * by getComp of all the elements of the container (including the deleted
+ * ones).
+ *
+ * The stride between two rows is the distance between the components of two
+ * consecutive elements: the size of the component if it is stored vertically
+ * (in a contiguous vector), the size of the element otherwise. The array
+ * keeps the mesh alive, but it is invalidated when the container is resized,
+ * compacted or when the component is disabled.
+ *
+ * When the container has stable element addresses, the elements are stored
+ * in separate chunks and the components cannot be viewed with a constant
+ * stride: in this case, a read-only copy is returned (see componentArrayCopy).
+ */
+template<uint ELEM_ID, MeshConcept MeshType, typename GetComponent>
+pybind11::array componentArrayView(
+    MeshType&      t,
+    GetComponent&& getComp,
+    bool           readOnly)
+{
+    namespace py = pybind11;
+
+    using ElementType = MeshType::template ElementType<ELEM_ID>;
+    using ValueType =
+        std::remove_cvref_t<decltype(getComp(std::declval<ElementType&>()))>;
+    using ScalarType = ArrayTraits<ValueType>::ScalarType;
+    using Container  = MeshType::template ContainerType<ELEM_ID>;
+
+    if constexpr (Container::STABLE_ADDRESSES) {
+        return componentArrayCopy<ELEM_ID>(t, getComp);
+    }
+
+    const uint n = t.template containerSize<ELEM_ID>();
+
+    py::ssize_t stride = sizeof(ValueType);
+    void*       data   = nullptr;
+    if (n > 0) {
+        data = &getComp(t.template element<ELEM_ID>(0));
+        if (n > 1) {
+            stride = reinterpret_cast<char*>(
+                         &getComp(t.template element<ELEM_ID>(1))) -
+                     reinterpret_cast<char*>(data);
+        }
+    }
+
+    std::vector<py::ssize_t> strides = {stride};
+    if constexpr (ArrayTraits<ValueType>::COLUMNS > 1)
+        strides.push_back(sizeof(ScalarType));
+
+    py::array arr;
+    if (data != nullptr) {
+        arr = py::array(
+            py::dtype::of<ScalarType>(),
+            arrayShape<ValueType>(n),
+            strides,
+            data,
+            py::cast(t, py::return_value_policy::reference));
+    }
+    else {
+        arr = py::array(py::dtype::of<ScalarType>(), arrayShape<ValueType>(0));
+    }
+
+    if (readOnly)
+        arr.attr("setflags")(py::arg("write") = false);
+    return arr;
+}
+
+/*
+ * Sets the component returned by getComp of all the elements of the
+ * container from the rows of the given array.
+ */
+template<uint ELEM_ID, MeshConcept MeshType, typename GetComponent, typename A>
+void setComponentFromArray(MeshType& t, GetComponent&& getComp, const A& a)
+{
+    using ElementType = MeshType::template ElementType<ELEM_ID>;
+    using ValueType =
+        std::remove_cvref_t<decltype(getComp(std::declval<ElementType&>()))>;
+    using ScalarType = ArrayTraits<ValueType>::ScalarType;
+
+    constexpr uint COLUMNS = ArrayTraits<ValueType>::COLUMNS;
+
+    const uint n = t.template containerSize<ELEM_ID>();
+    checkArrayShape<ValueType>(a, n);
+
+    const ScalarType* r = a.data();
+    for (uint i = 0; i < n; ++i) {
+        ValueType& v = getComp(t.template element<ELEM_ID>(i));
+        if constexpr (COLUMNS == 1) {
+            v = r[i];
+        }
+        else {
+            for (uint j = 0; j < COLUMNS; ++j)
+                v[j] = r[i * COLUMNS + j];
+        }
+    }
+}
+
+/*
+ * Defines the functions "<name>_array", that returns a numpy view of the
+ * component, and "set_<name>", that sets the component from an array.
+ */
+template<
+    uint ELEM_ID,
+    uint COMP_ID,
+    MeshConcept MeshType,
+    typename GetComponent>
+void defComponentArray(
+    pybind11::class_<MeshType>& c,
+    const std::string&          name,
+    GetComponent                getComp)
+{
+    namespace py = pybind11;
+
+    using ElementType = MeshType::template ElementType<ELEM_ID>;
+    using ValueType =
+        std::remove_cvref_t<decltype(getComp(std::declval<ElementType&>()))>;
+
+    c.def(
+        (name + "_array").c_str(),
+        [getComp](MeshType& t, bool readOnly) {
+            requirePerElementComponent<ELEM_ID, COMP_ID>(t);
+            return componentArrayView<ELEM_ID>(t, getComp, readOnly);
+        },
+        py::arg("read_only") = false);
+
+    c.def(
+        ("set_" + name).c_str(),
+        [getComp](MeshType& t, const ArrayOf<ValueType>& a) {
+            requirePerElementComponent<ELEM_ID, COMP_ID>(t);
+            setComponentFromArray<ELEM_ID>(t, getComp, a);
+        });
+}
+
+template<uint ELEM_ID, typename K, MeshConcept MeshType>
+bool customComponentToArray(
+    MeshType&          t,
+    const std::string& name,
+    pybind11::array&   arr)
+{
+    if (!t.template isPerElementCustomComponentOfType<ELEM_ID, K>(name))
+        return false;
+
+    constexpr uint COLUMNS = ArrayTraits<K>::COLUMNS;
+
+    auto h =
+        t.template perElementCustomComponentVectorHandle<ELEM_ID, K>(name);
+
+    ArrayOf<K> a(arrayShape<K>(h.size()));
+    auto*      r = a.mutable_data();
+    for (uint i = 0; i < h.size(); ++i) {
+        if constexpr (COLUMNS == 1) {
+            r[i] = h[i];
+        }
+        else {
+            for (uint j = 0; j < COLUMNS; ++j)
+                r[i * COLUMNS + j] = h[i][j];
+        }
+    }
+    arr = a;
+    return true;
+}
+
+template<uint ELEM_ID, typename K, MeshConcept MeshType>
+bool setCustomComponentFromArray(
+    MeshType&              t,
+    const std::string&     name,
+    const pybind11::array& arr)
+{
+    namespace py = pybind11;
+
+    using ScalarType = ArrayTraits<K>::ScalarType;
+
+    constexpr uint COLUMNS = ArrayTraits<K>::COLUMNS;
+
+    if (t.template hasPerElementCustomComponent<ELEM_ID>(name)) {
+        if (!t.template isPerElementCustomComponentOfType<ELEM_ID, K>(name))
+            return false;
+    }
+    else {
+        // a new custom component takes the type of the array
+        if (!py::isinstance<py::array_t<ScalarType>>(arr) ||
+            arr.ndim() != (COLUMNS == 1 ? 1 : 2))
+            return false;
+        t.template addPerElementCustomComponent<ELEM_ID, K>(name);
+    }
+
+    ArrayOf<K> a = ArrayOf<K>::ensure(arr);
+    if (!a)
+        throw py::error_already_set();
+
+    auto h =
+        t.template perElementCustomComponentVectorHandle<ELEM_ID, K>(name);
+    checkArrayShape<K>(a, h.size());
+
+    const ScalarType* r = a.data();
+    for (uint i = 0; i < h.size(); ++i) {
+        if constexpr (COLUMNS == 1) {
+            h[i] = r[i];
+        }
+        else {
+            for (uint j = 0; j < COLUMNS; ++j)
+                h[i][j] = r[i * COLUMNS + j];
+        }
+    }
+    return true;
+}
+
+template<uint ELEM_ID, MeshConcept MeshType, typename... K>
+void defCustomComponentArrays(
+    pybind11::class_<MeshType>& c,
+    const std::string&          name,
+    TypeWrapper<K...>)
+{
+    namespace py = pybind11;
+
+    c.def(
+        ("has_per_" + name + "_custom_component").c_str(),
+        [](const MeshType& t, const std::string& n) {
+            return t.template hasPerElementCustomComponent<ELEM_ID>(n);
+        });
+
+    c.def(
+        ("per_" + name + "_custom_component_names").c_str(),
+        [](const MeshType& t) {
+            return t.template perElementCustomComponentNames<ELEM_ID>();
+        });
+
+    c.def(
+        ("delete_per_" + name + "_custom_component").c_str(),
+        [](MeshType& t, const std::string& n) {
+            t.template deletePerElementCustomComponent<ELEM_ID>(n);
+        });
+
+    c.def(
+        ("per_" + name + "_custom_component_array").c_str(),
+        [](MeshType& t, const std::string& n) {
+            if (!t.template hasPerElementCustomComponent<ELEM_ID>(n))
+                throw py::key_error(n);
+            py::array arr;
+            if (!(customComponentToArray<ELEM_ID, K>(t, n, arr) || ...)) {
+                throw py::type_error(
+                    "The custom component " + n +
+                    " has a type that cannot be stored in an array.");
+            }
+            return arr;
+        });
+
+    c.def(
+        ("set_per_" + name + "_custom_component").c_str(),
+        [](MeshType& t, const std::string& n, const py::array& arr) {
+            if (!(setCustomComponentFromArray<ELEM_ID, K>(t, n, arr) || ...)) {
+                throw py::type_error(
+                    "The array cannot be stored in the custom component " +
+                    n + ".");
+            }
+        });
+}
+
+} // namespace detail
+
+/**
+ * @brief Defines the functions that allow to read and write, as numpy arrays,
+ * the components of all the elements of the container having the given name.
+ *
+ * For each one of the position, normal, color and quality components, the
+ * functions "<name>_<component>_array(read_only=False)" and
+ * "set_<name>_<component>(array)" are defined (e.g. "vertex_positions_array"
+ * and "set_vertex_positions"):
+ * - the former returns a numpy view (no copy is made) of the component of all
+ * the elements of the container, including the deleted ones: rows are
+ * strided if the component is not stored in a contiguous vector, and the view
+ * is invalidated when the container is resized or compacted;
+ * - the latter copies the rows of an (N, k) array (N must be the container
+ * size) in the component, without per-element python calls.
+ *
+ * For elements having a static number of vertex references, the vertex
+ * indices of all the elements are returned by "<name>_vertex_indices_array"
+ * as an (N, k) array (deleted elements have all indices equal to UINT_NULL),
+ * and set from an array with "set_<name>_vertex_indices". The overload
+ * "add_<namePlural>(array)" adds an element for each row of the array. Both
+ * raise a ValueError, without modifying the mesh, if an index is neither
+ * UINT_NULL nor a valid vertex index.
+ *
+ * Custom components of type double, float, int, uint, Point3d and Point3f
+ * can be copied to an array with "per_<name>_custom_component_array(name)"
+ * and set from an array with "set_per_<name>_custom_component(name, array)",
+ * that adds the custom component if it does not exist.
+ */
+template<ElementConcept Element, MeshConcept MeshType>
+void initComponentArrays(
+    pybind11::class_<MeshType>& c,
+    const std::string&          name,
+    const std::string&          namePlural)
+{
+    namespace py = pybind11;
+
+    static const uint ELEM_ID = Element::ELEMENT_ID;
+
+    if constexpr (comp::HasPosition<Element>) {
+        detail::defComponentArray<ELEM_ID, CompId::POSITION>(
+            c, name + "_positions", [](Element& e) -> auto& {
+                return e.position();
+            });
+    }
+    if constexpr (comp::HasNormal<Element>) {
+        detail::defComponentArray<ELEM_ID, CompId::NORMAL>(
+            c, name + "_normals", [](Element& e) -> auto& {
+                return e.normal();
+            });
+    }
+    if constexpr (comp::HasColor<Element>) {
+        detail::defComponentArray<ELEM_ID, CompId::COLOR>(
+            c, name + "_colors", [](Element& e) -> auto& {
+                return e.color();
+            });
+    }
+    if constexpr (comp::HasQuality<Element>) {
+        detail::defComponentArray<ELEM_ID, CompId::QUALITY>(
+            c, name + "_quality", [](Element& e) -> auto& {
+                return e.quality();
+            });
+    }
+
+    if constexpr (comp::HasVertexReferences<Element>) {
+        if constexpr (Element::VERTEX_NUMBER > 0) {
+            constexpr uint N = Element::VERTEX_NUMBER;
+
+            using IndexArray = py::
+                array_t<uint, py::array::c_style | py::array::forcecast>;
+
+            auto setIndices =
+                [](MeshType& t, uint first, const uint* r, uint n) {
+                    for (uint i = 0; i < n; ++i) {
+                        Element& e = t.template element<ELEM_ID>(first + i);
+                        for (uint j = 0; j < N; ++j)
+                            e.setVertex(j, r[i * N + j]);
+                    }
+                };
+
+            // checks the shape and the values of the array before writing
+            // anything: indices must be UINT_NULL or valid vertex indices
+            auto checkArray = [](const MeshType& t, const IndexArray& a) {
+                if (a.ndim() != 2 || a.shape(1) != py::ssize_t(N)) {
+                    throw py::value_error(
+                        "The array must have " + std::to_string(N) +
+                        " columns.");
+                }
+                const uint  nv = t.vertexContainerSize();
+                const uint* r  = a.data();
+                for (py::ssize_t i = 0; i < a.size(); ++i) {
+                    if (r[i] != UINT_NULL && r[i] >= nv) {
+                        throw py::value_error(
+                            "Vertex index " + std::to_string(r[i]) +
+                            " out of range: the vertex container has size " +
+                            std::to_string(nv) + ".");
+                    }
+                }
+            };
+
+            c.def((name + "_vertex_indices_array").c_str(), [](MeshType& t) {
+                const uint n = t.template containerSize<ELEM_ID>();
+
+                IndexArray a({py::ssize_t(n), py::ssize_t(N)});
+                uint*      r = a.mutable_data();
+                for (uint i = 0; i < n; ++i) {
+                    const Element& e = t.template element<ELEM_ID>(i);
+                    for (uint j = 0; j < N; ++j) {
+                        r[i * N + j] =
+                            e.deleted() ? UINT_NULL : e.vertexIndex(j);
+                    }
+                }
+                return a;
+            });
+
+            c.def(
+                ("set_" + name + "_vertex_indices").c_str(),
+                [=](MeshType& t, const IndexArray& a) {
+                    checkArray(t, a);
+                    const uint n = t.template containerSize<ELEM_ID>();
+                    if (a.shape(0) != py::ssize_t(n)) {
+                        throw py::value_error(
+                            "The array must have " + std::to_string(n) +
+                            " rows.");
+                    }
+                    setIndices(t, 0, a.data(), n);
+                });
+
+            c.def(
+                ("add_" + namePlural).c_str(),
+                [=](MeshType& t, const IndexArray& a) {
+                    checkArray(t, a);
+                    uint first = t.template add<ELEM_ID>(a.shape(0));
+                    setIndices(t, first, a.data(), a.shape(0));
+                    return first;
+                });
+        }
+    }
+
+    if constexpr (comp::HasCustomComponents<Element>) {
+        detail::defCustomComponentArrays<ELEM_ID>(
+            c, name, detail::CustomComponentArrayTypes());
+    }
+}
+
+} // namespace vcl::bind
+
+#endif // VCL_BINDINGS_CORE_MESH_CONTAINERS_COMPONENT_ARRAYS_H
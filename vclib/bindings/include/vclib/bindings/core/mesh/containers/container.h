@@ -23,6 +23,8 @@
 #ifndef VCL_BINDINGS_CORE_MESH_CONTAINERS_CONTAINER_H
 #define VCL_BINDINGS_CORE_MESH_CONTAINERS_CONTAINER_H
 
+#include "component_arrays.h"
+
 #include <vclib/concepts/mesh.h>
 
 #include <pybind11/pybind11.h>
@@ -164,6 +166,10 @@ void initContainer(
 
     detail::addOptionalComponentFunctions<ELEM_ID, CompId::WEDGE_TEX_COORDS>(
         c, name, "wedge_tex_coords");
+
+    // numpy arrays of the components
+
+    initComponentArrays<Element>(c, name, namePlural);
 }
 
 } // namespace vcl::bind
@@ -47,6 +47,24 @@ void initVertexContainer(pybind11::class_<MeshType>& ct)
     ct.def("add_vertices", [](MeshType& t, const std::vector<Point3d>& v) {
         return t.addVertices(v);
     });
+
+    // adds a vertex for each row of an (N, 3) array of positions
+    ct.def(
+        "add_vertices",
+        [](MeshType& t, const detail::ArrayOf<Point3d>& a) {
+            if (a.ndim() != 2 || a.shape(1) != 3)
+                throw py::value_error("The array must have 3 columns.");
+
+            const uint  n     = a.shape(0);
+            const uint  first = t.addVertices(n);
+            const auto* r     = a.data();
+            for (uint i = 0; i < n; ++i) {
+                auto& p = t.vertex(first + i).position();
+                for (uint j = 0; j < 3; ++j)
+                    p[j] = r[i * 3 + j];
+            }
+            return first;
+        });
 }
 
 } // namespace vcl::bind
@@ -0,0 +1,97 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_BINDINGS_CORE_MISC_CALLBACK_LOGGER_H
+#define VCL_BINDINGS_CORE_MISC_CALLBACK_LOGGER_H
+
+#include <vclib/misc/logger.h>
+
+#include <pybind11/pybind11.h>
+
+#include <sstream>
+
+namespace vcl::bind {
+
+/**
+ * @brief The CallbackLogger class is a Logger that forwards each printed line
+ * to a python callable, called as `callback(percentage, message)`.
+ *
+ * The logger can be used by functions that run while the GIL is released:
+ * the GIL is acquired only for the duration of each call to the callback.
+ */
+class CallbackLogger : public Logger<std::ostream>
+{
+    pybind11::object mCallback;
+
+    mutable std::ostringstream mStream;
+
+public:
+    CallbackLogger(pybind11::object callback) : mCallback(std::move(callback))
+    {
+        // the percentage is passed to the callback as a separate argument
+        disablePrintPercentage();
+        disableIndentation();
+    }
+
+protected:
+    std::ostream* levelStream(LogLevel) const override { return &mStream; }
+
+    void flush(std::ostream&) const override
+    {
+        std::string msg = mStream.str();
+        mStream.str("");
+        while (!msg.empty() && msg.back() == '\n')
+            msg.pop_back();
+
+        pybind11::gil_scoped_acquire acquire;
+        mCallback(percentage(), msg);
+    }
+};
+
+/**
+ * @brief Calls `f(log)` with the GIL released, and returns its result.
+ *
+ * If the given python callback is None, `log` is the vcl::nullLogger;
+ * otherwise, it is a CallbackLogger that forwards the messages to the
+ * callback. Arguments and results of `f` must not be python objects.
+ *
+ * @param[in] callback: a python callable or None.
+ * @param[in] f: a function that takes a logger as argument.
+ * @return the result of f.
+ */
+template<typename F>
+auto callWithLogger(const pybind11::object& callback, F&& f)
+{
+    if (callback.is_none()) {
+        pybind11::gil_scoped_release release;
+        return f(nullLogger);
+    }
+
+    CallbackLogger log(callback);
+
+    pybind11::gil_scoped_release release;
+    return f(log);
+}
+
+} // namespace vcl::bind
+
+#endif // VCL_BINDINGS_CORE_MISC_CALLBACK_LOGGER_H
@@ -36,54 +36,87 @@ void initStatAlgorithms(pybind11::module& m)
 
     auto fAllMeshes =
         []<MeshConcept MeshType>(pybind11::module& m, MeshType = MeshType()) {
-            m.def("barycenter", [](const MeshType& m) {
-                return vcl::barycenter(m);
-            });
-
-            m.def("quality_weighted_barycenter", [](const MeshType& m) {
-                return vcl::qualityWeightedBarycenter(m);
-            });
-
-            m.def("bounding_box", [](const MeshType& m) {
-                return vcl::boundingBox(m);
-            });
-
-            m.def("covariance_matrix_of_point_cloud", [](const MeshType& m) {
-                return vcl::covarianceMatrixOfPointCloud(m);
-            });
-
-            m.def("vertex_quality_min_max", [](const MeshType& m) {
-                return vcl::vertexQualityMinMax(m);
-            });
-
-            m.def("vertex_quality_average", [](const MeshType& m) {
-                return vcl::vertexQualityAverage(m);
-            });
+            m.def(
+                "barycenter",
+                [](const MeshType& m) {
+                    return vcl::barycenter(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
+
+            m.def(
+                "quality_weighted_barycenter",
+                [](const MeshType& m) {
+                    return vcl::qualityWeightedBarycenter(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
+
+            m.def(
+                "bounding_box",
+                [](const MeshType& m) {
+                    return vcl::boundingBox(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
+
+            m.def(
+                "covariance_matrix_of_point_cloud",
+                [](const MeshType& m) {
+                    return vcl::covarianceMatrixOfPointCloud(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
+
+            m.def(
+                "vertex_quality_min_max",
+                [](const MeshType& m) {
+                    return vcl::vertexQualityMinMax(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
+
+            m.def(
+                "vertex_quality_average",
+                [](const MeshType& m) {
+                    return vcl::vertexQualityAverage(m);
+                },
+                py::call_guard<py::gil_scoped_release>());
         };
 
     defForAllMeshTypes(m, fAllMeshes);
 
     auto fFaceMeshes = []<FaceMeshConcept MeshType>(
                            pybind11::module& m, MeshType = MeshType()) {
-        m.def("shell_barycenter", [](const MeshType& m) {
-            return vcl::shellBarycenter(m);
-        });
+        m.def(
+            "shell_barycenter",
+            [](const MeshType& m) {
+                return vcl::shellBarycenter(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
-        m.def("volume", [](const MeshType& m) {
-            return vcl::volume(m);
-        });
+        m.def(
+            "volume",
+            [](const MeshType& m) {
+                return vcl::volume(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
-        m.def("surface_area", [](const MeshType& m) {
-            return vcl::surfaceArea(m);
-        });
+        m.def(
+            "surface_area",
+            [](const MeshType& m) {
+                return vcl::surfaceArea(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
-        m.def("border_length", [](const MeshType& m) {
-            return vcl::borderLength(m);
-        });
+        m.def(
+            "border_length",
+            [](const MeshType& m) {
+                return vcl::borderLength(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
-        m.def("covariance_matrix_of_mesh", [](const MeshType& m) {
-            return vcl::covarianceMatrixOfMesh(m);
-        });
+        m.def(
+            "covariance_matrix_of_mesh",
+            [](const MeshType& m) {
+                return vcl::covarianceMatrixOfMesh(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
         m.def(
             "crease_face_edges",
@@ -94,18 +127,25 @@ void initStatAlgorithms(pybind11::module& m)
                 return vcl::creaseFaceEdges(
                     m, angleRadNeg, angleRadPos, alsoBorderEdges);
             },
+            py::call_guard<py::gil_scoped_release>(),
             py::arg("mesh"),
             py::arg("angle_rad_neg"),
             py::arg("angle_rad_pos"),
             py::arg("also_border_edges") = false);
 
-        m.def("face_quality_min_max", [](const MeshType& m) {
-            return vcl::faceQualityMinMax(m);
-        });
+        m.def(
+            "face_quality_min_max",
+            [](const MeshType& m) {
+                return vcl::faceQualityMinMax(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
 
-        m.def("face_quality_average", [](const MeshType& m) {
-            return vcl::faceQualityAverage(m);
-        });
+        m.def(
+            "face_quality_average",
+            [](const MeshType& m) {
+                return vcl::faceQualityAverage(m);
+            },
+            py::call_guard<py::gil_scoped_release>());
     };
 
     defForAllMeshTypes(m, fFaceMeshes);
@@ -21,6 +21,7 @@
  ****************************************************************************/
 
 #include <vclib/bindings/core/io/mesh/load.h>
+#include <vclib/bindings/core/misc/callback_logger.h>
 #include <vclib/bindings/utils.h>
 
 #include <vclib/algorithms/mesh/type_name.h>
@@ -41,17 +42,21 @@ void initLoadMesh(pybind11::module& m)
                const std::string& filename,
                MeshInfo&          loadedInfo,
                bool               enableOptionalComponents,
-               bool               loadTextureImages) {
+               bool               loadTextureImages,
+               const py::object&  progressCallback) {
                 LoadSettings settings;
                 settings.enableOptionalComponents = enableOptionalComponents;
                 settings.loadTextureImages        = loadTextureImages;
-                vcl::load(m, filename, loadedInfo, settings);
+                callWithLogger(progressCallback, [&](auto& log) {
+                    vcl::load(m, filename, loadedInfo, log, settings);
+                });
             },
             py::arg("m"),
             py::arg("filename"),
             py::arg("loaded_info")                = MeshInfo(),
             py::arg("enable_optional_components") = true,
-            py::arg("load_texture_images")        = false);
+            py::arg("load_texture_images")        = false,
+            py::arg("progress_callback")          = py::none());
     };
 
     defForAllMeshTypes(m, fLoad);
@@ -65,13 +70,22 @@ void initLoadMesh(pybind11::module& m)
                 [](const std::string& filename,
                    MeshInfo&          loadedInfo,
                    bool               enableOptionalComponents,
-                   bool               loadTextureImages) {
-                    return vcl::load<MeshType>(filename);
+                   bool               loadTextureImages,
+                   const py::object&  progressCallback) {
+                    LoadSettings settings;
+                    settings.enableOptionalComponents =
+                        enableOptionalComponents;
+                    settings.loadTextureImages = loadTextureImages;
+                    return callWithLogger(progressCallback, [&](auto& log) {
+                        return vcl::load<MeshType>(
+                            filename, loadedInfo, log, settings);
+                    });
                 },
                 py::arg("filename"),
                 py::arg("loaded_info")                = MeshInfo(),
                 py::arg("enable_optional_components") = true,
-                py::arg("load_texture_images")        = false);
+                py::arg("load_texture_images")        = false,
+                py::arg("progress_callback")          = py::none());
         };
 
     defForAllMeshTypes(m, fNameLoad);
@@ -21,6 +21,7 @@
  ****************************************************************************/
 
 #include <vclib/bindings/core/io/mesh/save.h>
+#include <vclib/bindings/core/misc/callback_logger.h>
 #include <vclib/bindings/utils.h>
 
 #include <vclib/io/mesh/save.h>
@@ -41,21 +42,25 @@ void initSaveMesh(pybind11::module& m)
                    bool               binary,
                    bool               saveTextureImages,
                    bool               magicsMode,
-                   const MeshInfo&    info) {
+                   const MeshInfo&    info,
+                   const py::object&  progressCallback) {
                     SaveSettings settings;
                     settings.binary            = binary;
                     settings.saveTextureImages = saveTextureImages;
                     settings.magicsMode        = magicsMode;
                     settings.info              = info;
 
-                    vcl::save(m, filename, settings);
+                    callWithLogger(progressCallback, [&](auto& log) {
+                        vcl::save(m, filename, log, settings);
+                    });
                 },
                 py::arg("m"),
                 py::arg("filename"),
                 py::arg("binary")              = true,
                 py::arg("save_texture_images") = false,
                 py::arg("magics_mode")         = false,
-                py::arg("info")                = MeshInfo());
+                py::arg("info")                = MeshInfo(),
+                py::arg("progress_callback")   = py::none());
         };
 
     defForAllMeshTypes(m, f);
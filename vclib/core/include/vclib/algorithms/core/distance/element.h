@@ -29,10 +29,56 @@
 #include <vclib/algorithms/core/polygon.h>
 #include <vclib/concepts/mesh.h>
 #include <vclib/math/min_max.h>
+#include <vclib/space/complex/face_triangulation.h>
 #include <vclib/space/core/triangle_wrapper.h>
 
 namespace vcl {
 
+namespace detail {
+
+/*
+ * Computes the distance between a 3D point and the triangles of a polygonal
+ * face, given as a list of positions of vertices in the face (each group of
+ * three positions represents a triangle).
+ */
+template<
+    Point3Concept PointType,
+    FaceConcept   FaceType,
+    Range         R,
+    typename ScalarType>
+ScalarType boundedDistanceToTriangles(
+    const PointType& p,
+    const FaceType&  f,
+    R&&              tris,
+    ScalarType       maxDist,
+    PointType&       closest,
+    bool             signedDist)
+{
+    ScalarType minDist = maxDist;
+
+    for (uint i = 0; i < std::ranges::size(tris); i += 3) {
+        PointType  w;
+        ScalarType d = boundedDistance(
+            p,
+            TriangleWrapper(
+                f.vertex(tris[i])->position(),
+                f.vertex(tris[i + 1])->position(),
+                f.vertex(tris[i + 2])->position()),
+            minDist,
+            w,
+            signedDist);
+
+        if (std::abs(d) < minDist) {
+            minDist = std::abs(d);
+            closest = w;
+        }
+    }
+
+    return minDist;
+}
+
+} // namespace detail
+
 /**
  * @brief Computes the distance between a Vertex and a 3D point.
  *
@@ -132,31 +178,79 @@ auto boundedDistance(
             return boundedDistance(p, tw, maxDist, closest, signedDist);
         }
 
-        ScalarType minDist = maxDist;
-
-        std::vector<uint> tris = earCut(f);
-        for (uint i = 0; i < tris.size(); i += 3) {
-            PointType  w;
-            ScalarType d = boundedDistance(
-                p,
-                TriangleWrapper(
-                    f.vertex(tris[i])->position(),
-                    f.vertex(tris[i + 1])->position(),
-                    f.vertex(tris[i + 2])->position()),
-                minDist,
-                w,
-                signedDist);
-
-            if (std::abs(d) < minDist) {
-                minDist = std::abs(d);
-                closest = w;
-            }
-        }
+        return detail::boundedDistanceToTriangles(
+            p, f, earCut(f), maxDist, closest, signedDist);
+    }
+}
+
+/**
+ * @brief Compute the distance between a 3D point and a face, using the
+ * precomputed triangulation of the face.
+ *
+ * This function behaves like vcl::boundedDistance(const PointType&, const
+ * FaceType&, ScalarType, PointType&, bool), but polygonal faces are not
+ * triangulated at each call: their triangles are taken from the given
+ * FaceTriangulation, that must have been built on the mesh of the face.
+ *
+ * @tparam PointType: The type of point. Must satisfy the Point3Concept.
+ * @tparam FaceType: The type of face. Must satisfy the FaceConcept.
+ *
+ * @param[in] p: The point to calculate the distance from.
+ * @param[in] f: The face to calculate the distance to.
+ * @param[in] triangulation: The triangulation of the faces of the mesh of f.
+ * @param[in] maxDist: The maximum distance to consider. If the distance is
+ * greater than this value, the function returns immediately.
+ * @param[out] closest: The closest point on the face to the given point.
+ * @param[in] signedDist: Whether to calculate the signed distance. Default is
+ * false.
+ * @return The distance between the point and the face.
+ *
+ * @ingroup core_distance
+ */
+template<Point3Concept PointType, FaceConcept FaceType, typename ScalarType>
+auto boundedDistance(
+    const PointType&         p,
+    const FaceType&          f,
+    const FaceTriangulation& triangulation,
+    ScalarType               maxDist,
+    PointType&               closest,
+    bool                     signedDist = false)
+{
+    if constexpr (TriangleFaceConcept<FaceType>) {
+        return boundedDistance(p, f, maxDist, closest, signedDist);
+    }
+    else {
+        if (f.vertexNumber() == 3)
+            return boundedDistance(p, f, maxDist, closest, signedDist);
 
-        return minDist;
+        return detail::boundedDistanceToTriangles(
+            p,
+            f,
+            triangulation.triangles(f.index()),
+            maxDist,
+            closest,
+            signedDist);
     }
 }
 
+/**
+ * @copydoc vcl::boundedDistance(const PointType&, const FaceType&, const
+ * FaceTriangulation&, ScalarType, PointType&, bool)
+ *
+ * @ingroup core_distance
+ */
+template<Point3Concept PointType, FaceConcept FaceType, typename ScalarType>
+auto boundedDistance(
+    const PointType&         p,
+    const FaceType&          f,
+    const FaceTriangulation& triangulation,
+    ScalarType               maxDist,
+    bool                     signedDist = false)
+{
+    PointType closest;
+    return boundedDistance(p, f, triangulation, maxDist, closest, signedDist);
+}
+
 /**
  * @brief Compute the distance between a 3D point and a face.
  *
@@ -27,12 +27,79 @@
 
 #include <vclib/algorithms/core/polygon.h>
 #include <vclib/concepts/mesh/elements/face.h>
+#include <vclib/space/complex/face_triangulation.h>
 #include <vclib/space/core/box.h>
 #include <vclib/space/core/sphere.h>
 #include <vclib/space/core/triangle_wrapper.h>
 
 namespace vcl {
 
+namespace detail {
+
+/*
+ * Checks if the triangles of a polygonal face, given as a list of positions
+ * of vertices in the face, intersect a box.
+ */
+template<FaceConcept FaceType, Range R, PointConcept PointType>
+bool intersectTriangles(
+    const FaceType&       f,
+    R&&                   tris,
+    const Box<PointType>& box)
+{
+    bool b = false;
+    for (uint i = 0; i < std::ranges::size(tris) && !b; i += 3) {
+        b |= intersect(
+            TriangleWrapper(
+                f.vertex(tris[i])->position(),
+                f.vertex(tris[i + 1])->position(),
+                f.vertex(tris[i + 2])->position()),
+            box);
+    }
+    return b;
+}
+
+/*
+ * Computes the intersection between the triangles of a polygonal face, given
+ * as a list of positions of vertices in the face, and a sphere.
+ */
+template<
+    FaceConcept  FaceType,
+    Range        R,
+    PointConcept PointType,
+    typename SScalar>
+bool intersectTriangles(
+    const FaceType&              f,
+    R&&                          tris,
+    const Sphere<SScalar>&       sphere,
+    PointType&                   witness,
+    std::pair<SScalar, SScalar>& res)
+{
+    res.first = std::numeric_limits<SScalar>::max();
+    std::pair<SScalar, SScalar> r;
+
+    bool      b = false;
+    PointType w;
+
+    for (uint i = 0; i < std::ranges::size(tris) && !b; i += 3) {
+        b |= intersect(
+            TriangleWrapper(
+                f.vertex(tris[i])->position(),
+                f.vertex(tris[i + 1])->position(),
+                f.vertex(tris[i + 2])->position()),
+            sphere,
+            w,
+            r);
+
+        if (r.first < res.first) {
+            res     = r;
+            witness = w;
+        }
+    }
+    return b;
+}
+
+} // namespace detail
+
 /**
  * @brief Checks if a face intersects a box.
  *
@@ -65,18 +132,38 @@ bool intersect(const FaceType& f, const Box<PointType>& box)
             box);
     }
     else {
-        bool b = false;
+        return detail::intersectTriangles(f, earCut(f), box);
+    }
+}
 
-        std::vector<uint> tris = earCut(f);
-        for (uint i = 0; i < tris.size() && !b; i += 3) {
-            b |= intersect(
-                TriangleWrapper(
-                    f.vertex(tris[i])->position(),
-                    f.vertex(tris[i + 1])->position(),
-                    f.vertex(tris[i + 2])->position()),
-                box);
-        }
-        return b;
+/**
+ * @brief Checks if a face intersects a box, using the precomputed
+ * triangulation of the face.
+ *
+ * This function behaves like vcl::intersect(const FaceType&, const
+ * Box<PointType>&), but polygonal faces are not triangulated at each call:
+ * their triangles are taken from the given FaceTriangulation, that must have
+ * been built on the mesh of the face.
+ *
+ * @param[in] f: The input face.
+ * @param[in] triangulation: The triangulation of the faces of the mesh of f.
+ * @param[in] box: The input box.
+ * @return True if the face intersects the box, false otherwise.
+ *
+ * @ingroup core_intersection
+ */
+template<FaceConcept FaceType, PointConcept PointType>
+bool intersect(
+    const FaceType&          f,
+    const FaceTriangulation& triangulation,
+    const Box<PointType>&    box)
+{
+    if constexpr (TriangleFaceConcept<FaceType>) {
+        return intersect(f, box);
+    }
+    else {
+        return detail::intersectTriangles(
+            f, triangulation.triangles(f.index()), box);
     }
 }
 
@@ -140,33 +227,50 @@ bool intersect(
                 res);
         }
         else {
-            res.first = std::numeric_limits<SScalar>::max();
-            std::pair<SScalar, SScalar> r;
-
-            bool      b = false;
-            PointType w;
-
-            std::vector<uint> tris = earCut(f);
-            for (uint i = 0; i < tris.size() && !b; i += 3) {
-                b |= intersect(
-                    TriangleWrapper(
-                        f.vertex(tris[i])->position(),
-                        f.vertex(tris[i + 1])->position(),
-                        f.vertex(tris[i + 2])->position()),
-                    sphere,
-                    w,
-                    r);
-
-                if (r.first < res.first) {
-                    res     = r;
-                    witness = w;
-                }
-            }
-            return b;
+            return detail::intersectTriangles(
+                f, earCut(f), sphere, witness, res);
         }
     }
 }
 
+/**
+ * @brief Compute the intersection between a sphere and a face, using the
+ * precomputed triangulation of the face.
+ *
+ * This function behaves like vcl::intersect(const FaceType&, const
+ * Sphere<SScalar>&, PointType&, std::pair<SScalar, SScalar>&), but polygonal
+ * faces are not triangulated at each call: their triangles are taken from the
+ * given FaceTriangulation, that must have been built on the mesh of the face.
+ *
+ * @param[in] f: the input face
+ * @param[in] triangulation: the triangulation of the faces of the mesh of f
+ * @param[in] sphere: the input sphere
+ * @param[out] witness: the point on the face nearest to the center of the
+ * sphere (even when there isn't intersection)
+ * @param[out] res: in the first item is stored the minimum distance between
+ * the face and the sphere, while in the second item is stored the penetration
+ * depth
+ * @return true iff there is an intersection between the sphere and the face
+ *
+ * @ingroup core_intersection
+ */
+template<FaceConcept FaceType, PointConcept PointType, typename SScalar>
+bool intersect(
+    const FaceType&              f,
+    const FaceTriangulation&     triangulation,
+    const Sphere<SScalar>&       sphere,
+    PointType&                   witness,
+    std::pair<SScalar, SScalar>& res)
+{
+    if constexpr (TriangleFaceConcept<FaceType>) {
+        return intersect(f, sphere, witness, res);
+    }
+    else {
+        return detail::intersectTriangles(
+            f, triangulation.triangles(f.index()), sphere, witness, res);
+    }
+}
+
 /**
  * @brief Compute the intersection between a sphere and a face, that may be also
  * polygonal.
@@ -201,6 +305,28 @@ bool intersect(const Sphere<SScalar>& sphere, const FaceType& f)
     return intersect(f, sphere);
 }
 
+/**
+ * @brief Checks if a face intersects a sphere, using the precomputed
+ * triangulation of the face.
+ *
+ * @param[in] f: the input face
+ * @param[in] triangulation: the triangulation of the faces of the mesh of f
+ * @param[in] sphere: the input sphere
+ * @return true iff there is an intersection between the sphere and the face
+ *
+ * @ingroup core_intersection
+ */
+template<FaceConcept FaceType, typename SScalar>
+bool intersect(
+    const FaceType&          f,
+    const FaceTriangulation& triangulation,
+    const Sphere<SScalar>&   sphere)
+{
+    Point3<SScalar>             witness;
+    std::pair<SScalar, SScalar> res;
+    return intersect(f, triangulation, sphere, witness, res);
+}
+
 } // namespace vcl
 
 #endif // VCL_ALGORITHMS_CORE_INTERSECTION_ELEMENT_H
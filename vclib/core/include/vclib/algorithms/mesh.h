@@ -29,6 +29,7 @@
 #include "mesh/face_topology.h"
 #include "mesh/filter.h"
 #include "mesh/import_export.h"
+#include "mesh/intersection.h"
 #include "mesh/point_sampling.h"
 #include "mesh/shuffle.h"
 #include "mesh/smooth.h"
@@ -27,7 +27,9 @@
 #include <vclib/algorithms/mesh/sort.h>
 #include <vclib/algorithms/mesh/stat/topology.h>
 #include <vclib/mesh/requirements.h>
+#include <vclib/space/complex/grid/point_hash_grid.h>
 #include <vclib/space/complex/mesh_pos.h>
+#include <vclib/space/complex/union_find.h>
 
 #include <vector>
 
@@ -50,87 +52,156 @@ namespace vcl {
 
 namespace detail {
 
-/* classe di confronto per l'algoritmo di eliminazione vertici duplicati*/
-template<typename VertexPointer>
-class VertPositionComparator
+/*
+ * Mixes the bits of the given value (splitmix64 finalizer).
+ */
+inline uint64_t mixHashBits(uint64_t h)
 {
-public:
-    inline bool operator()(const VertexPointer& a, const VertexPointer& b)
-    {
-        return (a->position() == b->position()) ?
-                   (a < b) :
-                   (a->position() < b->position());
-    }
-};
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
 
-/**
- * @brief The SortedIndexContainer class stores a sorted container of indices of
- * type IndexType, plus a Sentinel value.
- *
- * The size of the container can be specified at compile time, or left
- * unspecified with the -1 value (in this case, the container is dynamically
- * allocated).
+/*
+ * Returns, for each point, the index of the representative of the set of the
+ * points having the same position, that is its point having the smallest
+ * index.
  *
- * The container provides the operator < and ==, that allow to sort and compare
- * two containers. Two containers with same indices but different Sentinel
- * values are considered equal.
+ * The [hash of the position, point index] pairs are sorted in parallel with a
+ * radix sort: points having the same position lie in the same cluster of the
+ * sorted vector (the hash is truncated, therefore a cluster may contain also
+ * points having different positions).
  */
-template<typename IndexType, typename SentinelType, int N>
-class SortedIndexContainer
+template<typename ScalarType>
+std::vector<uint> duplicatedPointRepresentatives(
+    const std::vector<Point3<ScalarType>>& points)
 {
-public:
-    SortedIndexContainer() {}
-
-    template<Range RangeType>
-    SortedIndexContainer(SentinelType s, RangeType rng) : s(s), v(rng)
-    {
-        std::sort(v.begin(), v.end());
-    }
-
-    bool operator<(const SortedIndexContainer& s) const
-    {
-        if constexpr (N >= 0) {
-            for (uint i = 0; i < N; ++i) {
-                if (v[i] != s.v[i])
-                    return v[i] < s.v[i];
+    using BitsType = std::conditional_t<
+        sizeof(ScalarType) == sizeof(uint64_t),
+        uint64_t,
+        uint32_t>;
+
+    const uint n    = points.size();
+    const uint bits = std::min(64u, indexBitWidth(n) + 8);
+
+    const uint nChunks =
+        (n + SORT_VALUES_PER_CHUNK - 1) / SORT_VALUES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    std::vector<std::pair<uint64_t, uint>> vec(n);
+    parallelFor(chunks, [&](uint c) {
+        uint end = std::min(n, (c + 1) * SORT_VALUES_PER_CHUNK);
+        for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+            uint64_t h = 0;
+            for (uint k = 0; k < 3; ++k) {
+                // adding zero maps -0 to +0, that compare equal
+                ScalarType x = points[i][k] + 0;
+                h = mixHashBits(h ^ std::bit_cast<BitsType>(x));
             }
-            return false;
+            vec[i] = {h >> (64 - bits), i};
         }
-        else {
-            for (uint i = 0; i < v.size() && i < s.v.size(); ++i) {
-                if (v[i] != s.v[i])
-                    return v[i] < s.v[i];
+    });
+
+    radixSortByKey(vec, bits);
+
+    std::vector<uint> reps(n);
+    parallelForEachCluster(
+        vec,
+        [](uint64_t k) {
+            return k;
+        },
+        [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const uint pi = vec[i].second;
+                reps[pi]      = pi;
+                for (std::size_t j = b; j < i; ++j) {
+                    const uint pj = vec[j].second;
+                    if (reps[pj] == pj && points[pj] == points[pi]) {
+                        reps[pi] = pj;
+                        break;
+                    }
+                }
             }
-            return v.size() < s.v.size();
+        });
+    return reps;
+}
+
+/*
+ * Returns, for each point, the index of the representative of its cluster,
+ * where the clusters are the connected components of the graph that links
+ * the points having distance less or equal than epsilon. The representative
+ * of a cluster is its point having the smallest index.
+ *
+ * The points having the same position are grouped first, and only the
+ * representatives of the groups are bucketed in a PointHashGrid having cells
+ * of edge at least epsilon: the points close to a point lie in its cell and
+ * in the adjacent ones. Then, each point is linked in parallel with the close
+ * points having smaller index, using a concurrent union-find whose roots are
+ * the smallest indices of the sets.
+ */
+template<typename ScalarType>
+std::vector<uint> weldedPointRepresentatives(
+    const std::vector<Point3<ScalarType>>& points,
+    ScalarType                             epsilon)
+{
+    std::vector<uint> reps = duplicatedPointRepresentatives(points);
+
+    // indices of the distinct points, and position of each of them in the
+    // vector of the distinct points
+    std::vector<uint> distinct;
+    std::vector<uint> slots(points.size(), UINT_NULL);
+    for (uint i = 0; i < points.size(); ++i) {
+        if (reps[i] == i) {
+            slots[i] = distinct.size();
+            distinct.push_back(i);
         }
     }
 
-    bool operator==(const SortedIndexContainer& s) const
-    {
-        if constexpr (N >= 0) {
-            for (uint i = 0; i < N; ++i) {
-                if (v[i] != s.v[i])
-                    return false;
-            }
-            return true;
-        }
-        else {
-            if (v.size() != s.v.size())
-                return false;
-            for (uint i = 0; i < v.size(); ++i) {
-                if (v[i] != s.v[i])
-                    return false;
-            }
-            return true;
-        }
+    const uint n = distinct.size();
+
+    const uint nChunks =
+        (n + SORT_VALUES_PER_CHUNK - 1) / SORT_VALUES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    std::vector<Point3<ScalarType>> pts(n);
+    Box3<ScalarType>                bb;
+    for (uint i = 0; i < n; ++i) {
+        pts[i] = points[distinct[i]];
+        bb.add(pts[i]);
     }
 
-    SentinelType sentinel() const { return s; }
+    // the grid can store up to 2^21 cells for each axis
+    ScalarType cellSize = std::max(epsilon, bb.size().maxCoeff() / (1 << 20));
+    if (cellSize <= 0)
+        cellSize = 1;
+
+    const PointHashGrid<ScalarType> grid(pts, cellSize);
 
-private:
-    Vector<IndexType, N> v;
-    SentinelType         s;
-};
+    const ScalarType sqEpsilon = epsilon * epsilon;
+
+    ConcurrentUnionFind uf(n);
+    parallelFor(chunks, [&](uint c) {
+        uint end = std::min(n, (c + 1) * SORT_VALUES_PER_CHUNK);
+        for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+            grid.forEachPointNear(pts[i], epsilon, [&](uint j) {
+                if (j < i && pts[i].squaredDist(pts[j]) <= sqEpsilon)
+                    uf.unite(i, j);
+            });
+        }
+    });
+
+    // the distinct points are sorted by index: the root of each set is the
+    // distinct point having the smallest index
+    parallelFor(reps, [&](uint& r) {
+        r = distinct[uf.find(slots[r])];
+    });
+    return reps;
+}
 
 } // namespace detail
 
@@ -193,67 +264,77 @@ uint removeUnreferencedVertices(MeshType& m)
  * at their spatial positions.
  *
  * This function marks as deleted all vertices in the input mesh that have the
- * same spatial position as another vertex in the mesh. The comparison of vertex
- * positions is based on the `position()` function of the vertex type, which
- * must return a 3D point representing the vertex position.
+ * same spatial position as another vertex in the mesh, or, if epsilon is
+ * greater than zero, that are closer than epsilon to another vertex (the
+ * merge is transitive: chains of vertices closer than epsilon are merged in a
+ * single vertex). The comparison of vertex positions is based on the
+ * `position()` function of the vertex type, which must return a 3D point
+ * representing the vertex position.
+ *
+ * Among each set of merged vertices, the one having the smallest index is
+ * kept (its position is not changed), and all the references to the other
+ * vertices are updated to refer to it.
+ *
+ * The vertices having the same position are grouped sorting in parallel the
+ * hashes of their positions. When epsilon is greater than zero, the distinct
+ * positions are then bucketed in parallel in a flat spatial hash (see
+ * PointHashGrid), and the close ones are merged in parallel using a
+ * concurrent union-find.
+ * The function scales therefore to large triangle soups, in which each vertex
+ * is duplicated for each incident triangle.
  *
  * @tparam MeshType The type of the input Mesh. It must satisfy the MeshConcept.
  *
  * @param[in,out] m: The input mesh for which to remove duplicate vertices. This
  * mesh will be modified in place, with all duplicate vertices being marked as
  * deleted.
+ * @param[in] epsilon: the maximum distance between two vertices that are
+ * merged. If zero (default), only vertices having the same position are
+ * merged.
  * @return The number of duplicated vertices that were marked as deleted.
  *
  * @ingroup clean
  */
 template<MeshConcept MeshType>
-uint removeDuplicatedVertices(MeshType& m)
+uint removeDuplicatedVertices(MeshType& m, double epsilon = 0)
 {
-    using VertexType    = MeshType::VertexType;
-    using VertexPointer = MeshType::VertexType*;
+    using VertexType   = MeshType::VertexType;
+    using PositionType = VertexType::PositionType;
+    using ScalarType   = PositionType::ScalarType;
+
+    assert(epsilon >= 0);
 
     if (m.vertexNumber() == 0)
         return 0;
 
+    // positions of the non-deleted vertices, and their indices
+    std::vector<uint> indices;
+    indices.reserve(m.vertexNumber());
+    for (const VertexType& v : m.vertices())
+        indices.push_back(m.index(v));
+
+    std::vector<Point3<ScalarType>> positions(indices.size());
+    parallelFor(indices, [&](const uint& vi) {
+        positions[&vi - indices.data()] = m.vertex(vi).position();
+    });
+
+    const std::vector<uint> reps =
+        epsilon > 0 ?
+            detail::weldedPointRepresentatives(positions, ScalarType(epsilon)) :
+            detail::duplicatedPointRepresentatives(positions);
+
     // a map that will be used to keep track of deleted vertices and their
-    // corresponding pointers.
-    std::vector<uint> newVertexIndices(m.vertexNumber());
-    // assigning each vertex index to itself.
+    // corresponding indices: each vertex is mapped to the representative
+    std::vector<uint> newVertexIndices(m.vertexContainerSize());
     std::iota(newVertexIndices.begin(), newVertexIndices.end(), 0);
 
     uint deleted = 0;
-
-    std::vector<VertexPointer> perm(m.vertexNumber());
-
-    // put all the vertices into a vector for sorting.
-    uint k = 0;
-    for (VertexType& v : m.vertices())
-        perm[k++] = &v;
-
-    // sort the vector based on the vertices' spatial positions.
-    std::sort(
-        std::execution::par_unseq,
-        perm.begin(),
-        perm.end(),
-        detail::VertPositionComparator<VertexPointer>());
-
-    uint i = 0;
-
-    // compare the i-th position with the next ones while they are equal to the
-    // i-th.
-    while (i < perm.size() - 1) {
-        uint j = i + 1;
-        while (j < perm.size() && perm[i]->position() == perm[j]->position()) {
-            // j will be deleted, so we map its pointer to the i-th vertex's
-            // pointer.
-            newVertexIndices[m.index(perm[j])] = m.index(perm[i]); // map j -> i
-            m.deleteVertex(m.index(perm[j]));
-            j++;
+    for (uint i = 0; i < indices.size(); ++i) {
+        if (reps[i] != i) {
+            newVertexIndices[indices[i]] = indices[reps[i]];
+            m.deleteVertex(indices[i]);
             deleted++;
         }
-        // here perm[i] != perm[j], so we need to check perm[j] with the next
-        // vertex.
-        i = j;
     }
 
     // update the vertex pointers to point to the correct vertices, in every
@@ -269,20 +350,27 @@ uint removeDuplicatedVertices(MeshType& m)
  * @brief Removes all duplicate faces of the mesh by looking only at their
  * vertex references.
  *
- * This function removes all faces in the input mesh that have the same vertex
- * references as another face in the mesh. The comparison of face vertex
- * references is based on the indices of the face vertices, so it assumes that
- * the mesh's vertices have already been unified.
- *
- * @note This function currently only works for triangle meshes. It should be
- * made more general to work for polygonal meshes as well.
+ * This function removes all faces in the input mesh that have the same cycle
+ * of vertex references as another face in the mesh, regardless of the first
+ * vertex of the cycle and of its orientation (faces having the same vertices
+ * with opposite orientations are considered duplicates). Polygons having the
+ * same set of vertices in a different cyclic order are not duplicates, since
+ * they have different edges. The comparison of face vertex references is
+ * based on the indices of the face vertices, so it assumes that the mesh's
+ * vertices have already been unified. Among each set of duplicated faces, the
+ * one having the smallest index is kept. The function works both for triangle
+ * and polygonal meshes.
+ *
+ * The faces are grouped in parallel by a hash of their canonical vertex
+ * indices (the smallest rotation of the cycle, in any of the two orientations)
+ * using a radix sort, and only the faces of the same group are compared.
  *
  * @note This function does not update any topology relation that could be
  * affected by the removal of duplicate faces, such as the VF or FF relation.
  * Therefore, it is usually performed before building any topology information.
  *
  * @tparam MeshType: The type of the input Mesh. It must satisfy the
- * TriangleMeshConcept.
+ * FaceMeshConcept.
  *
  * @param[in,out] m: The input mesh for which to remove duplicate faces. This
  * mesh will be modified in place, with all duplicate faces being marked as
@@ -294,30 +382,114 @@ uint removeDuplicatedVertices(MeshType& m)
 template<FaceMeshConcept MeshType>
 uint removeDuplicatedFaces(MeshType& m)
 {
-    using VertexType = MeshType::VertexType;
-    using FaceType   = MeshType::FaceType;
-
-    // create a vector of sorted tuples of indices, where each tuple represents
-    // a face's vertices and a pointer to the face.
-    std::vector<detail::SortedIndexContainer<
-        VertexType*,
-        FaceType*,
-        FaceType::VERTEX_NUMBER>>
-        fvec;
+    using FaceType = MeshType::FaceType;
 
-    for (FaceType& f : m.faces()) {
-        fvec.emplace_back(&f, f.vertices());
-    }
+    constexpr int N = FaceType::VERTEX_NUMBER;
+
+    // the canonical vertex indices of a face; when the number of vertices of
+    // the faces is static, they are stored in the sorted vector together with
+    // the face index, in order to compare the faces without accessing the mesh
+    using CanonicalIndices = Vector<uint, N>;
+    using Value =
+        std::conditional_t<(N > 0), std::pair<uint, CanonicalIndices>, uint>;
+
+    // the lexicographically smallest rotation of the vertex cycle of the face,
+    // in any of the two orientations; for triangles, it is the sorted cycle
+    auto canonicalVertexIndices = [](const FaceType& f) {
+        CanonicalIndices vi(f.vertexIndices());
+        if constexpr (N == 3) {
+            std::sort(vi.begin(), vi.end());
+            return vi;
+        }
+        else {
+            // only the rotations starting from the smallest index are tried
+            const uint       n   = vi.size();
+            const uint       min = *std::min_element(vi.begin(), vi.end());
+            CanonicalIndices best = vi, rot = vi;
+            for (uint s = 0; s < n; ++s) {
+                if (vi[s] != min)
+                    continue;
+                for (bool reverse : {false, true}) {
+                    for (uint k = 0; k < n; ++k)
+                        rot[k] = vi[reverse ? (s + n - k) % n : (s + k) % n];
+                    if (std::ranges::lexicographical_compare(rot, best))
+                        best = rot;
+                }
+            }
+            return best;
+        }
+    };
+
+    auto faceIndex = [](const Value& v) {
+        if constexpr (N > 0)
+            return v.first;
+        else
+            return v;
+    };
+
+    auto faceVertexIndices = [&](const Value& v) {
+        if constexpr (N > 0)
+            return v.second;
+        else
+            return canonicalVertexIndices(m.face(v));
+    };
+
+    const uint bits = std::min(64u, indexBitWidth(m.faceContainerSize()) + 8);
+
+    // [hash of the canonical vertex indices, face] pairs, sorted by hash:
+    // duplicated faces lie in the same cluster, ordered by face index (the
+    // hash is truncated, therefore a cluster may contain also faces that are
+    // not duplicated)
+    std::vector<std::pair<uint64_t, Value>> vec =
+        detail::fillPerFaceKeyVector<MeshType, Value>(
+            m,
+            [](const FaceType&) {
+                return 1;
+            },
+            [&](const FaceType& f, std::pair<uint64_t, Value>* out) {
+                const CanonicalIndices vi = canonicalVertexIndices(f);
+
+                uint64_t h = 0;
+                for (uint i : vi)
+                    h = detail::mixHashBits(h ^ i);
+                out->first = h >> (64 - bits);
+
+                if constexpr (N > 0)
+                    out->second = {m.index(f), vi};
+                else
+                    out->second = m.index(f);
+            });
+
+    radixSortByKey(vec, bits);
+
+    // vector<char> instead of vector<bool>: flags are written concurrently
+    std::vector<char> duplicated(m.faceContainerSize(), false);
+
+    detail::parallelForEachCluster(
+        vec,
+        [](uint64_t k) {
+            return k;
+        },
+        [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b + 1; i < e; ++i) {
+                const CanonicalIndices vi = faceVertexIndices(vec[i].second);
+                for (std::size_t j = b; j < i; ++j) {
+                    if (duplicated[faceIndex(vec[j].second)])
+                        continue;
+                    if (std::ranges::equal(
+                            vi, faceVertexIndices(vec[j].second))) {
+                        duplicated[faceIndex(vec[i].second)] = true;
+                        break;
+                    }
+                }
+            }
+        });
 
-    // sort the vector based on the face vertex indices.
-    std::sort(std::execution::par_unseq, fvec.begin(), fvec.end());
     uint total = 0;
-
-    // iterate over the sorted vector, and mark any duplicate faces as deleted.
-    for (uint i = 0; i < fvec.size() - 1; ++i) {
-        if (fvec[i] == fvec[i + 1]) {
+    for (uint i = 0; i < duplicated.size(); ++i) {
+        if (duplicated[i]) {
+            m.deleteFace(i);
             total++;
-            m.deleteFace(fvec[i].sentinel());
         }
     }
     return total;
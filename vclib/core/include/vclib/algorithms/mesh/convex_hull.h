@@ -23,357 +23,526 @@
 #ifndef VCL_ALGORITHMS_MESH_CONVEX_HULL_H
 #define VCL_ALGORITHMS_MESH_CONVEX_HULL_H
 
-#include <vclib/algorithms/core/bounding_box.h>
-#include <vclib/algorithms/core/box/box3.h>
-#include <vclib/algorithms/core/visibility.h>
-#include <vclib/algorithms/mesh/create/tetrahedron.h>
-#include <vclib/algorithms/mesh/update/topology.h>
 #include <vclib/concepts/mesh.h>
 #include <vclib/mesh/requirements.h>
 #include <vclib/misc/logger.h>
 #include <vclib/misc/parallel.h>
-#include <vclib/misc/shuffle.h>
-#include <vclib/space/complex/graph/bipartite_graph.h>
-#include <vclib/space/complex/mesh_pos.h>
+#include <vclib/space/core/point.h>
 
-namespace vcl {
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
-namespace detail {
+namespace vcl {
 
 /**
- * @brief The first points are not actually random, but are the points that are
- * closest to the box sides. This optimization makes the first tetrahedron
- * bigger, and thus the convex hull computation faster at the beginning.
+ * @brief Number of points processed by each parallel task of the convex hull
+ * computation.
  *
- * @tparam R
- * @param points
+ * The split in chunks does not depend on the number of threads, therefore the
+ * output of the convexHull function does not depend on it.
  */
-template<Range R>
-void firstTetOptimization(R&& points)
-{
-    using PointType = std::ranges::range_value_t<R>;
-    using Iterator  = std::ranges::iterator_t<R>;
+inline constexpr uint CONVEX_HULL_POINTS_PER_CHUNK = 4096;
 
-    Box<PointType> box = boundingBox(points);
+namespace detail {
 
-    std::array<std::pair<double, Iterator>, 6> distances;
+/*
+ * Calls f(begin, end) for each chunk of CONVEX_HULL_POINTS_PER_CHUNK elements
+ * in [0, n). The chunks are processed in parallel, unless there is only one.
+ */
+template<typename F>
+void forEachConvexHullChunk(uint n, F&& f)
+{
+    const uint nChunks =
+        (n + CONVEX_HULL_POINTS_PER_CHUNK - 1) / CONVEX_HULL_POINTS_PER_CHUNK;
 
-    // save in the array the closest point to each of the 6 sides of the box
-    for (uint i = 0; i < 6; ++i) {
-        auto        it        = std::ranges::begin(points);
-        const auto& boxCorner = i < 3 ? box.min() : box.max();
-        distances[i] =
-            std::make_pair(std::abs(boxCorner(i % 3) - (*it)(i % 3)), it);
-        for (++it; it != std::ranges::end(points); ++it) {
-            double d = std::abs(boxCorner(i % 3) - (*it)(i % 3));
-            if (d < distances[i].first) {
-                distances[i] = std::make_pair(d, it);
-            }
-        }
+    if (nChunks <= 1) {
+        f(0, n);
+        return;
     }
 
-    // sort the array by distance
-    std::sort(distances.begin(), distances.end(), [](auto& a, auto& b) {
-        return a.first < b.first;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+    parallelFor(chunks, [&](uint c) {
+        const uint begin = c * CONVEX_HULL_POINTS_PER_CHUNK;
+        f(begin, std::min(n, begin + CONVEX_HULL_POINTS_PER_CHUNK));
     });
-
-    // swap the first points with the closest points to the box corners
-    for (uint i = 0; i < 6; ++i) {
-        std::iter_swap(std::ranges::begin(points) + i, distances[i].second);
-    }
 }
 
-/**
- * @brief Shuffle the input range of points such that the first four points are
- * not coplanar.
- *
- * @tparam R
- * @param points
- * @param deterministic
+/*
+ * Given a function that returns K values for each index in [0, n), with
+ * n > 0, returns for each k the index that maximizes the k-th value (the
+ * smallest one in case of ties). The maxima of the chunks are computed in
+ * parallel.
  */
-template<Range R>
-void shufflePoints(R&& points, bool deterministic = false)
-    requires Point3Concept<std::ranges::range_value_t<R>>
+template<uint K, typename F>
+std::array<uint, K> parallelArgMax(uint n, F&& values)
 {
-    shuffle(points, deterministic);
-
-    firstTetOptimization(points);
-
-    auto itP0 = std::ranges::begin(points);
-    auto itP1 = std::next(itP0);
-    auto itP2 = std::next(itP1);
-    auto itP3 = std::next(itP2);
-    auto itP  = std::next(itP2);
-
-    auto rEnd = std::ranges::end(points);
-
-    while (itP != rEnd && arePointsCoplanar(*itP0, *itP1, *itP2, *itP)) {
-        itP = std::next(itP);
-    }
+    using Maxima = std::array<std::pair<double, uint>, K>;
+
+    const uint nChunks =
+        (n + CONVEX_HULL_POINTS_PER_CHUNK - 1) / CONVEX_HULL_POINTS_PER_CHUNK;
+
+    std::vector<Maxima> chunkMaxima(nChunks);
+    forEachConvexHullChunk(n, [&](uint begin, uint end) {
+        Maxima& max = chunkMaxima[begin / CONVEX_HULL_POINTS_PER_CHUNK];
+        max.fill({-std::numeric_limits<double>::infinity(), UINT_NULL});
+        for (uint i = begin; i < end; ++i) {
+            const std::array<double, K> v = values(i);
+            for (uint k = 0; k < K; ++k) {
+                if (v[k] > max[k].first)
+                    max[k] = {v[k], i};
+            }
+        }
+    });
 
-    if (itP == rEnd) {
-        throw std::runtime_error("All points are coplanar.");
+    std::array<uint, K> res;
+    for (uint k = 0; k < K; ++k) {
+        std::pair<double, uint> max = chunkMaxima[0][k];
+        for (uint c = 1; c < nChunks; ++c) {
+            if (chunkMaxima[c][k].first > max.first)
+                max = chunkMaxima[c][k];
+        }
+        res[k] = max.second;
     }
-
-    std::iter_swap(itP, itP3);
+    return res;
 }
 
-template<FaceMeshConcept MeshType, Point3Concept PointType>
-MeshType makeTetrahedron(
-    const PointType& p0,
-    const PointType& p1,
-    const PointType& p2,
-    const PointType& p3)
+/*
+ * Quickhull over a flat array of triangles.
+ *
+ * Each point that is still outside the hull is stored in the conflict list of
+ * exactly one face that sees it, and the point of each list that is farthest
+ * from its face is tracked while the list is filled. A face is processed
+ * inserting its farthest point: the visible faces are collected walking the
+ * adjacencies, replaced with a fan of faces that connects the horizon to the
+ * point, and their conflict points are distributed (in parallel, when they
+ * are many) among the new faces. Points that do not see any new face are
+ * inside the hull and are discarded. The insertions are sequential: each one
+ * depends on the hull left by the previous one.
+ *
+ * A point is outside of a face when it is farther than the tolerance from its
+ * plane. When a point is inserted, all the faces that lie below it are
+ * removed, also within the tolerance, so that the hull stays convex; the
+ * faces within the tolerance are kept only if their removal would leave a
+ * horizon that is not a simple cycle, or a fan of new faces that is not
+ * convex. When no choice gives a valid fan (the point is almost coplanar to
+ * some faces), the point is discarded instead of corrupting the topology of
+ * the hull.
+ *
+ * The faces are oriented counterclockwise seen from the outside, and the i-th
+ * adjacent face of a face is the one sharing its i-th edge.
+ */
+class QuickHull
 {
-    using FaceType = MeshType::FaceType;
-
-    MeshType result;
-
-    if (trianglePointVisibility(p0, p1, p2, p3)) {
-        result = createTetrahedron<MeshType>(p0, p2, p1, p3);
-    }
-    else {
-        result = createTetrahedron<MeshType>(p0, p1, p2, p3);
+public:
+    struct Face
+    {
+        std::array<uint, 3> vertices;
+        std::array<uint, 3> adjFaces;
+        Point3d             normal;
+        double              offset = 0;
+        bool                alive  = true;
+        uint                visit  = 0;
+
+        std::vector<uint> conflicts;
+        uint              farthest     = UINT_NULL;
+        double            farthestDist = 0;
+    };
+
+private:
+    const std::vector<Point3d>& mPoints;
+    double                      mEpsilon;
+
+    std::vector<Face> mFaces;
+    std::vector<uint> mFreeFaces;
+    uint              mVisit           = 0;
+    uint              mConflictsNumber = 0;
+
+    // buffers reused by each insertion
+    std::vector<uint>                    mStack;
+    std::vector<uint>                    mVisible;
+    std::vector<std::array<uint, 3>>     mHorizon;
+    std::vector<uint>                    mCycle;
+    std::vector<uint>                    mNewFaces;
+    std::vector<uint>                    mPending;
+    std::vector<std::pair<uint, double>> mAssignment;
+
+public:
+    QuickHull(const std::vector<Point3d>& points, double epsilon) :
+            mPoints(points), mEpsilon(epsilon)
+    {
     }
 
-    if constexpr (face::HasOptionalAdjacentFaces<FaceType>) {
-        result.enablePerFaceAdjacentFaces();
-    }
+    const std::vector<Face>& faces() const { return mFaces; }
 
-    updatePerFaceAdjacentFaces(result);
-
-    return result;
-}
-
-template<FaceMeshConcept MeshType, Range R>
-auto initConflictGraph(const MeshType& mesh, R&& points)
-    requires Point3Concept<std::ranges::range_value_t<R>>
-{
-    using PointType  = std::ranges::range_value_t<R>;
-    using MPointType = MeshType::VertexType::PositionType;
-    using FaceType   = MeshType::FaceType;
-    using GraphType  = BipartiteGraph<PointType, uint>;
+    uint conflictsNumber() const { return mConflictsNumber; }
 
-    // left nodes are points, right nodes are faces
-    // an arc (conflict) is added if a point is visible from a face
-    GraphType graph;
-
-    for (const auto& face : mesh.faces()) {
-        graph.addRightNode(face.index());
+    double distance(uint f, const Point3d& p) const
+    {
+        return mFaces[f].normal.dot(p) - mFaces[f].offset;
     }
 
-    for (const auto& point : points) {
-        bool added = false;
-        for (const auto& face : mesh.faces()) {
-            if (facePointVisibility(face, point)) {
-                if (!added) {
-                    graph.addLeftNode(point);
-                    added = true;
+    /*
+     * Initializes the hull with the tetrahedron (p0, p1, p2, p3), where p3
+     * lies on the negative side of the triangle (p0, p1, p2).
+     */
+    void initTetrahedron(uint p0, uint p1, uint p2, uint p3)
+    {
+        const std::array<uint, 4> f = {
+            addFace(p0, p1, p2),
+            addFace(p0, p2, p3),
+            addFace(p0, p3, p1),
+            addFace(p3, p2, p1)};
+
+        // each edge (a, b) of a face is adjacent to the face having (b, a)
+        for (uint i : f) {
+            for (uint e = 0; e < 3; ++e) {
+                const uint a = mFaces[i].vertices[e];
+                const uint b = mFaces[i].vertices[(e + 1) % 3];
+                for (uint j : f) {
+                    for (uint k = 0; k < 3; ++k) {
+                        if (mFaces[j].vertices[k] == b &&
+                            mFaces[j].vertices[(k + 1) % 3] == a)
+                            mFaces[i].adjFaces[e] = j;
+                    }
                 }
-                graph.addArc(point, face.index());
             }
         }
     }
 
-    return graph;
-}
-
-/**
- * @brief Returns the horizon, that is composed of a sequence of <face-edge>
- * pairs that looks out the boundary of the visible faces.
- *
- * The faces listed in the horizon are faces that are not visible from the
- * input set of visible faces, but are adjacent to at least one face in the
- * input set.
- *
- * @tparam FaceType
- * @param[in] visibleFaces: The set of visible faces.
- * @param[out] horizonVertices: The set of vertices that are on the horizon.
- * @return std::vector<std::pair<uint, uint>>
- */
-template<FaceConcept FaceType, VertexConcept VertexType>
-std::vector<std::pair<uint, uint>> horizonFaces(
-    const std::set<const FaceType*>& visibleFaces,
-    std::set<const VertexType*>&     horizonVertices)
-{
-    std::vector<std::pair<uint, uint>> horizon;
-
-    const FaceType* firstFace   = nullptr;
-    uint            firstEdge   = UINT_NULL;
-    const FaceType* currentFace = nullptr;
-    uint            currentEdge = UINT_NULL;
-
-    // looking for the first visible face that lies on the border
-    bool found = false;
-    for (auto it = visibleFaces.begin(); it != visibleFaces.end() && !found;
-         ++it) {
-        uint i = 0;
-        for (const FaceType* adjFace : (*it)->adjFaces()) {
-            // if the adjacent face is not visible, then it is on the border
-            if (visibleFaces.find(adjFace) == visibleFaces.end()) {
-                firstFace   = *it;
-                firstEdge   = i;
-                currentFace = firstFace;
-                currentEdge = firstEdge;
-                found       = true;
-                break;
+    /*
+     * Inserts the point in the hull, searching a face that sees it among all
+     * the faces. Used only while the hull has few faces.
+     */
+    void insertPoint(uint p)
+    {
+        for (uint f = 0; f < mFaces.size(); ++f) {
+            if (mFaces[f].alive && distance(f, mPoints[p]) > mEpsilon) {
+                addPoint(p, f);
+                return;
             }
-            i++;
         }
     }
 
-    do {
-        MeshPos<FaceType> pos(currentFace, currentEdge);
-        pos.flipVertex();
-        horizonVertices.insert(pos.vertex());
-
-        while (visibleFaces.find(pos.face()) != visibleFaces.end()) {
-            pos.nextEdgeAdjacentToV();
+    /*
+     * Stores each point in the conflict list of the first of the given faces
+     * that sees it; the points that do not see any face are discarded.
+     */
+    void assignPoints(
+        const std::vector<uint>& points,
+        const std::vector<uint>& faces)
+    {
+        mAssignment.resize(points.size());
+        forEachConvexHullChunk(points.size(), [&](uint begin, uint end) {
+            for (uint i = begin; i < end; ++i) {
+                const Point3d& p = mPoints[points[i]];
+                mAssignment[i]   = {UINT_NULL, 0};
+                for (uint f : faces) {
+                    const double d = distance(f, p);
+                    if (d > mEpsilon) {
+                        mAssignment[i] = {f, d};
+                        break;
+                    }
+                }
+            }
+        });
+
+        for (uint i = 0; i < points.size(); ++i) {
+            const auto [f, d] = mAssignment[i];
+            if (f != UINT_NULL) {
+                Face& face = mFaces[f];
+                face.conflicts.push_back(points[i]);
+                if (d > face.farthestDist) {
+                    face.farthest     = points[i];
+                    face.farthestDist = d;
+                }
+                ++mConflictsNumber;
+            }
         }
-        auto p = std::make_pair(pos.face()->index(), pos.edge());
-        horizon.push_back(p);
+    }
 
-        pos.flipFace();
-        currentFace = pos.face();
-        currentEdge = pos.edge();
-    } while (currentFace != firstFace || currentEdge != firstEdge);
+    /*
+     * Inserts the farthest point of the faces having conflicts, until no
+     * point is left outside of the hull.
+     */
+    template<LoggerConcept LogType>
+    void build(LogType& log)
+    {
+        const uint nConflicts = mConflictsNumber;
+
+        std::vector<uint> stack;
+        for (uint f = 0; f < mFaces.size(); ++f) {
+            if (mFaces[f].alive && !mFaces[f].conflicts.empty())
+                stack.push_back(f);
+        }
 
-    return horizon;
-}
+        while (!stack.empty()) {
+            const uint f = stack.back();
+            stack.pop_back();
 
-template<Point3Concept PointType, FaceMeshConcept MeshType>
-auto potentialConflictPoints(
-    const BipartiteGraph<PointType, uint>& conflictGraph,
-    const PointType&                       currentPoint,
-    const MeshType&                        convexHull,
-    const auto&                            horizon)
-{
-    using FaceType = MeshType::FaceType;
+            // the face could have been deleted, or its slot reused
+            if (!mFaces[f].alive || mFaces[f].conflicts.empty())
+                continue;
 
-    std::vector<std::set<PointType>> potentialConflictPoints(horizon.size());
+            if (!addPoint(mFaces[f].farthest, f)) {
+                if (!mFaces[f].conflicts.empty())
+                    stack.push_back(f);
+                continue;
+            }
 
-    uint i = 0;
-    for (const auto& [faceIndex, edgeIndex] : horizon) {
-        for (const auto& p : conflictGraph.adjacentRightNodes(faceIndex)) {
-            potentialConflictPoints[i].insert(p);
+            for (uint nf : mNewFaces) {
+                if (!mFaces[nf].conflicts.empty())
+                    stack.push_back(nf);
+            }
+            log.progress(nConflicts - mConflictsNumber);
         }
+    }
 
-        const FaceType& face = convexHull.face(faceIndex);
-
-        uint adjFaceIndex = face.adjFace(edgeIndex)->index();
-
-        for (const auto& p : conflictGraph.adjacentRightNodes(adjFaceIndex)) {
-            potentialConflictPoints[i].insert(p);
+private:
+    uint addFace(uint a, uint b, uint c)
+    {
+        uint f = mFaces.size();
+        if (mFreeFaces.empty()) {
+            mFaces.emplace_back();
+        }
+        else {
+            f = mFreeFaces.back();
+            mFreeFaces.pop_back();
         }
 
-        potentialConflictPoints[i].erase(currentPoint);
-
-        i++;
+        Face& face        = mFaces[f];
+        face.vertices     = {a, b, c};
+        face.alive        = true;
+        face.farthest     = UINT_NULL;
+        face.farthestDist = 0;
+
+        const Point3d& pa = mPoints[a];
+        face.normal = (mPoints[b] - pa).cross(mPoints[c] - pa);
+        if (face.normal.norm() > 0)
+            face.normal.normalize();
+        face.offset = face.normal.dot(pa);
+        return f;
     }
 
-    return potentialConflictPoints;
-}
+    /*
+     * Inserts the point eye, that is seen by the face start, in the hull.
+     * Returns false if the point could not be inserted without breaking the
+     * topology or the convexity of the hull: in this case, the point is
+     * removed from the conflicts of the face start, and the hull is not
+     * modified.
+     */
+    bool addPoint(uint eye, uint start)
+    {
+        const Point3d& p = mPoints[eye];
+
+        // the faces that lie below the point are removed; if the point is
+        // above some of them only because of rounding errors, their removal
+        // could leave a region that is not a disk, or a fan of new faces that
+        // is not convex: in this case, the faces within the tolerance are
+        // kept. If neither works, the point is almost coplanar to some faces
+        // and it is discarded instead of corrupting the topology of the hull
+        mNewFaces.clear();
+        if (!(findHorizon(start, p, 0) && isFanConvex(p)) &&
+            !(findHorizon(start, p, mEpsilon) && isFanConvex(p))) {
+            removeConflict(start, eye);
+            return false;
+        }
 
-template<
-    FaceMeshConcept MeshType,
-    FaceConcept     FaceType,
-    VertexConcept   VertexType>
-void deleteVisibleFaces(
-    MeshType&                          convexHull,
-    const std::set<const FaceType*>&   visibleFaces,
-    const std::set<const VertexType*>& horizonVertices)
-{
-    std::set<const VertexType*> verticesToDelete;
+        // collect the conflicts of the visible faces, and delete them
+        mPending.clear();
+        for (uint f : mVisible) {
+            Face& face = mFaces[f];
+            for (uint c : face.conflicts) {
+                if (c != eye)
+                    mPending.push_back(c);
+            }
+            mConflictsNumber -= face.conflicts.size();
+            std::vector<uint>().swap(face.conflicts);
+            face.alive = false;
+            mFreeFaces.push_back(f);
+        }
 
-    for (const FaceType* face : visibleFaces) {
-        for (const VertexType* vertex : face->vertices()) {
-            if (horizonVertices.find(vertex) == horizonVertices.end()) {
-                verticesToDelete.insert(vertex);
+        // fan of faces (a, b, eye) for each edge (a, b) of the horizon
+        for (uint e : mCycle) {
+            const auto& [a, b, adj] = mHorizon[e];
+            const uint f          = addFace(a, b, eye);
+            mFaces[f].adjFaces[0] = adj;
+            for (uint i = 0; i < 3; ++i) {
+                if (mFaces[adj].vertices[i] == b)
+                    mFaces[adj].adjFaces[i] = f;
             }
+            mNewFaces.push_back(f);
+        }
+        const uint n = mNewFaces.size();
+        for (uint i = 0; i < n; ++i) {
+            mFaces[mNewFaces[i]].adjFaces[1] = mNewFaces[(i + 1) % n];
+            mFaces[mNewFaces[i]].adjFaces[2] = mNewFaces[(i + n - 1) % n];
         }
-        convexHull.deleteFace(face->index());
-    }
 
-    for (const VertexType* vertex : verticesToDelete) {
-        convexHull.deleteVertex(vertex->index());
+        assignPoints(mPending, mNewFaces);
+        return true;
     }
-}
-
-template<Point3Concept PointType, FaceMeshConcept MeshType>
-std::vector<uint> addNewFaces(
-    MeshType&                                 convexHull,
-    const PointType&                          currentPoint,
-    const std::vector<std::pair<uint, uint>>& horizon)
-{
-    using VertexType = MeshType::VertexType;
-    using FaceType   = MeshType::FaceType;
-
-    std::vector<uint> newFaces;
-
-    newFaces.reserve(horizon.size());
-
-    uint v = convexHull.addVertex(currentPoint);
-
-    uint firstFace = UINT_NULL;
-    uint lastFace  = UINT_NULL;
 
-    for (const auto& [faceIndex, edgeIndex] : horizon) {
-        uint v1 = convexHull.face(faceIndex).vertexIndexMod(edgeIndex + 1);
-        uint v2 = convexHull.face(faceIndex).vertexIndex(edgeIndex);
-
-        uint f = convexHull.addFace(v, v1, v2);
-        newFaces.push_back(f);
-
-        if (firstFace == UINT_NULL) {
-            firstFace = f;
+    /*
+     * Collects the faces visible from the point p, that are the faces
+     * connected to the face start whose distance from p is greater than the
+     * threshold, and the horizon as the edges (a, b) of the visible faces
+     * whose adjacent face is not visible. Returns false if the horizon is not
+     * a single simple cycle.
+     */
+    bool findHorizon(uint start, const Point3d& p, double threshold)
+    {
+        ++mVisit;
+        mVisible.clear();
+        mHorizon.clear();
+        mStack.assign(1, start);
+        mFaces[start].visit = mVisit;
+        while (!mStack.empty()) {
+            const uint f = mStack.back();
+            mStack.pop_back();
+            mVisible.push_back(f);
+            for (uint i = 0; i < 3; ++i) {
+                const uint adj = mFaces[f].adjFaces[i];
+                if (mFaces[adj].visit == mVisit)
+                    continue;
+                if (distance(adj, p) > threshold) {
+                    mFaces[adj].visit = mVisit;
+                    mStack.push_back(adj);
+                }
+                else {
+                    mHorizon.push_back(
+                        {mFaces[f].vertices[i],
+                         mFaces[f].vertices[(i + 1) % 3],
+                         adj});
+                }
+            }
         }
-
-        convexHull.face(f).setAdjFace(0, lastFace);
-        if (lastFace != UINT_NULL)
-            convexHull.face(lastFace).setAdjFace(2, f);
-
-        convexHull.face(f).setAdjFace(1, faceIndex);
-        convexHull.face(faceIndex).setAdjFace(edgeIndex, f);
-
-        lastFace = f;
+        return computeHorizonCycle();
     }
 
-    convexHull.face(firstFace).setAdjFace(0, lastFace);
-    convexHull.face(lastFace).setAdjFace(2, firstFace);
-
-    return newFaces;
-}
-
-template<Point3Concept PointType, FaceMeshConcept MeshType>
-void updateNewConflicts(
-    BipartiteGraph<PointType, uint>&        conflictGraph,
-    const MeshType&                         convexHull,
-    const std::vector<uint>&                newFaces,
-    const std::vector<std::set<PointType>>& potentialConflictPoints)
-{
-    using FaceType = MeshType::FaceType;
+    /*
+     * Sorts the edges of the horizon in the order of the cycle that they
+     * form, storing it in mCycle. Returns false if the horizon is not a
+     * single simple cycle: a vertex is the first vertex of more edges, or the
+     * edges form more cycles.
+     */
+    bool computeHorizonCycle()
+    {
+        const uint n = mHorizon.size();
+
+        // sort the edges by first vertex, and follow them from the first one
+        std::sort(mHorizon.begin(), mHorizon.end());
+        for (uint i = 1; i < n; ++i) {
+            if (mHorizon[i][0] == mHorizon[i - 1][0])
+                return false;
+        }
 
-    for (uint i = 0; i < newFaces.size(); ++i) {
-        conflictGraph.addRightNode(newFaces[i]);
+        mCycle.resize(n);
+        uint e = 0;
+        for (uint i = 0; i < n; ++i) {
+            mCycle[i] = e;
+            auto it   = std::lower_bound(
+                mHorizon.begin(),
+                mHorizon.end(),
+                std::array<uint, 3> {mHorizon[e][1], 0, 0});
+            if (it == mHorizon.end() || (*it)[0] != mHorizon[e][1])
+                return false;
+            e = it - mHorizon.begin();
+            // the cycle must be closed only after visiting all the edges
+            if (e == 0 && i + 1 < n)
+                return false;
+        }
+        return e == 0;
+    }
 
-        const FaceType& face = convexHull.face(newFaces[i]);
+    /*
+     * Returns true if the fan of faces (a, b, p) built on the horizon cycle
+     * would be convex within the tolerance: for each face of the fan, the
+     * vertex opposite to (a, b) of the face adjacent to the horizon, and the
+     * last vertex of the next face of the fan, must not lie above its plane.
+     */
+    bool isFanConvex(const Point3d& p) const
+    {
+        const uint n = mCycle.size();
+        for (uint i = 0; i < n; ++i) {
+            const auto& [a, b, adj] = mHorizon[mCycle[i]];
+            const uint c            = mHorizon[mCycle[(i + 1) % n]][1];
+
+            const Point3d& pa     = mPoints[a];
+            Point3d        normal = (mPoints[b] - pa).cross(p - pa);
+            if (normal.norm() == 0)
+                return false;
+            normal.normalize();
+
+            uint opp = 0;
+            while (mFaces[adj].vertices[opp] == a ||
+                   mFaces[adj].vertices[opp] == b)
+                ++opp;
+            opp = mFaces[adj].vertices[opp];
+
+            if (normal.dot(mPoints[opp] - pa) > mEpsilon ||
+                normal.dot(mPoints[c] - pa) > mEpsilon)
+                return false;
+        }
+        return true;
+    }
 
-        for (const auto& p : potentialConflictPoints[i]) {
-            if (facePointVisibility(face, p)) {
-                conflictGraph.addArc(p, newFaces[i]);
+    /*
+     * Removes the point p from the conflict list of the face f, updating the
+     * farthest point of the face.
+     */
+    void removeConflict(uint f, uint p)
+    {
+        Face& face = mFaces[f];
+        std::erase(face.conflicts, p);
+        --mConflictsNumber;
+
+        face.farthest     = UINT_NULL;
+        face.farthestDist = 0;
+        for (uint c : face.conflicts) {
+            const double d = distance(f, mPoints[c]);
+            if (d > face.farthestDist) {
+                face.farthest     = c;
+                face.farthestDist = d;
             }
         }
     }
-}
+};
 
 } // namespace detail
 
 /**
  * @brief Compute the convex hull of a set of points.
  *
- * @tparam PointType: The type of the points.
+ * The hull is computed with a quickhull that runs on flat arrays of faces and
+ * conflicts. Before starting, the points that are extreme along 14 directions
+ * (the axes and the diagonals of the cube) are inserted in the hull, and all
+ * the points that lie inside the resulting polyhedron are discarded in
+ * parallel (Akl-Toussaint heuristic): for large point clouds, only a small
+ * fraction of the points needs to be processed. The conflict points of the
+ * faces that are removed at each step are redistributed in parallel among the
+ * new faces.
+ *
+ * Only the pre-filter and the assignment of the points to the faces run in
+ * parallel: the expansion of the hull, that inserts one point at a time, is
+ * serial.
+ *
+ * Points that lie on the hull within a tolerance proportional to the
+ * magnitude of the coordinates are not considered as hull vertices. If the
+ * mesh has per-face adjacent faces, they are computed (and enabled, if
+ * optional).
+ *
+ * @throws std::runtime_error if the points are less than four, or if they
+ * are coplanar.
+ *
+ * @tparam MeshType: The type of the output mesh.
  * @param[in] points: The set of points.
- * @param[in] deterministic: If true, the shuffle will be deterministic.
+ * @param[in] deterministic: Unused: the result is always deterministic, and
+ * it does not depend on the number of threads.
  * @param[in] log: The logger.
  * @return The convex hull of the points.
  *
@@ -381,87 +550,164 @@ void updateNewConflicts(
  */
 template<FaceMeshConcept MeshType, Range R, LoggerConcept LogType = NullLogger>
 MeshType convexHull(
-    const R& points,
-    bool     deterministic = false,
-    LogType& log           = nullLogger)
+    const R&                  points,
+    [[maybe_unused]] bool     deterministic = false,
+    LogType&                  log           = nullLogger)
     requires Point3Concept<std::ranges::range_value_t<R>>
 {
-    using PointType  = std::ranges::range_value_t<R>;
-    using VertexType = MeshType::VertexType;
-    using FaceType   = MeshType::FaceType;
+    using PositionType = MeshType::VertexType::PositionType;
+    using ScalarType   = PositionType::ScalarType;
+    using FaceType     = MeshType::FaceType;
 
-    static_assert(
-        face::HasAdjacentFaces<FaceType>,
-        "MeshType must have per-face adjacent faces.");
+    std::vector<Point3d> pts;
+    for (const auto& p : points)
+        pts.push_back(p.template cast<double>());
 
-    log.log(0, "Shuffling points...");
+    const uint n = pts.size();
+    if (n < 4)
+        throw std::runtime_error("At least four points are required.");
 
-    std::vector<PointType> pointsCopy(
-        std::ranges::begin(points), std::ranges::end(points));
+    log.log(0, "Computing extreme points...");
 
-    detail::shufflePoints(pointsCopy, deterministic);
+    // extreme points along the axes (+x, -x, +y, -y, +z, -z) and the
+    // diagonals of the cube
+    std::array<Point3d, 14> dirs;
+    for (uint i = 0; i < 6; ++i) {
+        dirs[i]        = Point3d(0, 0, 0);
+        dirs[i][i / 2] = i % 2 == 0 ? 1 : -1;
+    }
+    for (uint i = 0; i < 8; ++i) {
+        dirs[6 + i] = Point3d(
+            i & 1 ? -1 : 1, i & 2 ? -1 : 1, i & 4 ? -1 : 1);
+    }
+    const std::array<uint, 14> extremes =
+        detail::parallelArgMax<14>(n, [&](uint i) {
+            std::array<double, 14> v;
+            for (uint d = 0; d < 14; ++d)
+                v[d] = dirs[d].dot(pts[i]);
+            return v;
+        });
+
+    // tolerance on the distances from the planes of the faces: it is larger
+    // than the rounding error of a single distance, since the normals of thin
+    // faces amplify it
+    double maxCoord = 0;
+    for (uint i = 0; i < 3; ++i) {
+        maxCoord += std::max(
+            std::abs(pts[extremes[2 * i]][i]),
+            std::abs(pts[extremes[2 * i + 1]][i]));
+    }
+    const double eps = 32 * std::numeric_limits<double>::epsilon() * maxCoord;
 
-    log.log(0, "Making first tetrahedron...");
+    // first tetrahedron: the farthest pair of extreme points along the axes,
+    // the point farthest from their line, and the point farthest from the
+    // plane of the three points
+    uint p0 = extremes[0], p1 = extremes[1];
+    for (uint i = 0; i < 6; ++i) {
+        for (uint j = i + 1; j < 6; ++j) {
+            if (pts[extremes[i]].squaredDist(pts[extremes[j]]) >
+                pts[p0].squaredDist(pts[p1])) {
+                p0 = extremes[i];
+                p1 = extremes[j];
+            }
+        }
+    }
+    if (pts[p0].dist(pts[p1]) <= eps)
+        throw std::runtime_error("All points are coincident.");
 
-    auto result = detail::makeTetrahedron<MeshType>(
-        pointsCopy[0], pointsCopy[1], pointsCopy[2], pointsCopy[3]);
+    const Point3d dir = (pts[p1] - pts[p0]).normalized();
 
-    auto remainingPoints = pointsCopy | std::views::drop(4);
+    const uint p2 = detail::parallelArgMax<1>(n, [&](uint i) {
+        return std::array<double, 1> {(pts[i] - pts[p0]).cross(dir).norm()};
+    })[0];
+    if ((pts[p2] - pts[p0]).cross(dir).norm() <= eps)
+        throw std::runtime_error("All points are collinear.");
 
-    auto conflictGraph = detail::initConflictGraph(result, remainingPoints);
+    const Point3d normal =
+        (pts[p1] - pts[p0]).cross(pts[p2] - pts[p0]).normalized();
 
-    log.log(0, "Computing convex hull...");
+    const std::array<uint, 2> p3s = detail::parallelArgMax<2>(n, [&](uint i) {
+        const double d = normal.dot(pts[i] - pts[p0]);
+        return std::array<double, 2> {d, -d};
+    });
+    const double d0 = normal.dot(pts[p3s[0]] - pts[p0]);
+    const double d1 = normal.dot(pts[p3s[1]] - pts[p0]);
+    if (std::max(d0, -d1) <= eps)
+        throw std::runtime_error("All points are coplanar.");
 
-    log.startProgress("Processing Points...", pointsCopy.size() - 4);
-    uint iteration = 0;
-    // for each point in the conflict graph (still not in the convex hull)
-    for (const auto& point : conflictGraph.leftNodes()) {
-        // if the point is visible from a face in the convex hull
-        if (conflictGraph.adjacentLeftNodeNumber(point) != 0) {
-            // store the faces that are visible from (conflict with) the point
-            // these faces will be deleted from the convex hull
-            std::set<const FaceType*> visibleFaces;
-            for (const auto& faceIndex :
-                 conflictGraph.adjacentLeftNodes(point)) {
-                visibleFaces.insert(&result.face(faceIndex));
-            }
+    detail::QuickHull hull(pts, eps);
+    if (d0 > -d1)
+        hull.initTetrahedron(p0, p2, p1, p3s[0]);
+    else
+        hull.initTetrahedron(p0, p1, p2, p3s[1]);
 
-            // compute the horizon of the visible faces
-            std::set<const VertexType*> horizonVertices;
-            auto horizon = detail::horizonFaces(visibleFaces, horizonVertices);
-
-            // for each edge in the horizon, compute the points that could
-            // conflict with the new face that will be added to the convex hull
-            // in that edge
-            auto potentialConflictPoints = detail::potentialConflictPoints(
-                conflictGraph, point, result, horizon);
-
-            // delete the point and faces from the conflict graph - no more
-            // conflicts
-            conflictGraph.deleteLeftNode(point);
-            for (const FaceType* face : visibleFaces) {
-                conflictGraph.deleteRightNode(face->index());
-            }
+    log.log(10, "Filtering points...");
+
+    for (uint e : extremes)
+        hull.insertPoint(e);
+
+    std::vector<uint> hullFaces;
+    for (uint f = 0; f < hull.faces().size(); ++f) {
+        if (hull.faces()[f].alive)
+            hullFaces.push_back(f);
+    }
 
-            // delete the visible faces from the convex hull, and the vertices
-            // that are not on the horizon
-            detail::deleteVisibleFaces(result, visibleFaces, horizonVertices);
+    std::vector<uint> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    hull.assignPoints(indices, hullFaces);
+    indices = std::vector<uint>();
 
-            // add the new faces to the convex hull
-            auto newFaces = detail::addNewFaces(result, point, horizon);
+    log.log(20, "Computing convex hull...");
 
-            // update the conflict graph with the new faces
-            detail::updateNewConflicts(
-                conflictGraph, result, newFaces, potentialConflictPoints);
+    log.startProgress("Processing Points...", hull.conflictsNumber());
+    hull.build(log);
+    log.endProgress();
+
+    // output mesh: only the vertices referenced by the faces of the hull
+    MeshType result;
+
+    if constexpr (face::HasOptionalAdjacentFaces<FaceType>) {
+        result.enablePerFaceAdjacentFaces();
+    }
+
+    const auto&       faces = hull.faces();
+    std::vector<uint> faceMap(faces.size(), UINT_NULL);
+    uint              nFaces = 0;
+    for (uint f = 0; f < faces.size(); ++f) {
+        if (faces[f].alive)
+            faceMap[f] = nFaces++;
+    }
+
+    result.reserveVertices(nFaces / 2 + 2);
+    result.reserveFaces(nFaces);
+
+    std::vector<uint> vertexMap(n, UINT_NULL);
+    for (const auto& face : faces) {
+        if (!face.alive)
+            continue;
+        std::array<uint, 3> v;
+        for (uint i = 0; i < 3; ++i) {
+            uint& vi = vertexMap[face.vertices[i]];
+            if (vi == UINT_NULL) {
+                vi = result.addVertex(PositionType(
+                    pts[face.vertices[i]].template cast<ScalarType>()));
+            }
+            v[i] = vi;
         }
-        else {
-            conflictGraph.deleteLeftNode(point);
+        result.addFace(v[0], v[1], v[2]);
+    }
+
+    if constexpr (face::HasAdjacentFaces<FaceType>) {
+        for (uint f = 0; f < faces.size(); ++f) {
+            if (faces[f].alive) {
+                for (uint i = 0; i < 3; ++i) {
+                    result.face(faceMap[f])
+                        .setAdjFace(i, faceMap[faces[f].adjFaces[i]]);
+                }
+            }
         }
-        iteration++;
-        log.progress(iteration);
     }
 
-    log.endProgress();
     log.log(100, "Convex hull computed.");
 
     return result;
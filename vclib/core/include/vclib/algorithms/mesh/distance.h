@@ -28,9 +28,13 @@
 #include <vclib/mesh/requirements.h>
 #include <vclib/misc/logger.h>
 #include <vclib/misc/parallel.h>
+#include <vclib/space/complex/bvh.h>
 #include <vclib/space/complex/grid.h>
 #include <vclib/views/pointers.h>
 
+#include <atomic>
+#include <numeric>
+
 namespace vcl {
 
 struct HausdorffDistResult
@@ -48,63 +52,116 @@ enum HausdorffSamplingMethod {
     HAUSDORFF_MONTECARLO
 };
 
+/**
+ * @brief The spatial data structure used to compute the distances between the
+ * samples and the faces of a mesh.
+ *
+ * The BVH does not degrade on meshes having very non-uniform face density, on
+ * which the uniform grid may become very slow.
+ */
+enum HausdorffSpatialIndex { HAUSDORFF_STATIC_GRID = 0, HAUSDORFF_BVH };
+
 namespace detail {
 
+// number of samples processed by each task of the parallel distance
+// computation: the partition does not depend on the number of threads, so the
+// reduction of the partial results is deterministic
+inline constexpr uint HAUSDORFF_SAMPLES_PER_CHUNK = 4096;
+
+// the optional distFunction is the bounded distance function passed to the
+// closestValue member function of the spatial data structure g
 template<
     MeshConcept    MeshType,
     SamplerConcept SamplerType,
     typename GridType,
-    LoggerConcept LogType>
+    LoggerConcept LogType,
+    typename... DistFunction>
 HausdorffDistResult hausdorffDist(
     const MeshType&    m,
     const SamplerType& s,
     const GridType&    g,
-    LogType&           log)
+    LogType&           log,
+    DistFunction&&... distFunction)
 {
     using PointSampleType = SamplerType::PointType;
     using ScalarType      = PointSampleType::ScalarType;
 
+    // partial result computed on a chunk of samples
+    struct PartialResult
+    {
+        HausdorffDistResult res;
+        uint                ns = 0;
+    };
+
+    const uint nSamples = s.size();
+    const uint nChunks  = (nSamples + HAUSDORFF_SAMPLES_PER_CHUNK - 1) /
+                         HAUSDORFF_SAMPLES_PER_CHUNK;
+
     HausdorffDistResult res;
     res.histogram = Histogramd(0, m.boundingBox().diagonal() / 100, 100);
 
     log.log(
         5,
-        "Computing distances for " + std::to_string(s.size()) + " samples...");
-
-    log.startProgress("", s.size());
-
-    std::mutex mutex;
-
-    uint ns = 0;
-    uint i  = 0;
-    parallelFor(s, [&](const PointSampleType& sample) {
-        //    for (const PointSampleType& sample : s) {
-        ScalarType dist = std::numeric_limits<ScalarType>::max();
-        const auto iter = g.closestValue(sample, dist);
-
-        if (iter != g.end()) {
-            mutex.lock();
-            ns++;
-            if (dist > res.maxDist)
-                res.maxDist = dist;
-            if (dist < res.minDist)
-                res.minDist = dist;
-            res.meanDist += dist;
-            res.RMSDist += dist * dist;
-            res.histogram.addValue(dist);
-            mutex.unlock();
+        "Computing distances for " + std::to_string(nSamples) + " samples...");
+
+    log.startProgress("", nSamples);
+
+    std::vector<PartialResult> partials(nChunks);
+    std::vector<uint>          chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    std::atomic<uint> processed = 0;
+
+    parallelFor(chunks, [&](uint c) {
+        PartialResult& p = partials[c];
+        p.res.histogram  = Histogramd(
+            res.histogram.minRangeValue(),
+            res.histogram.maxRangeValue(),
+            res.histogram.binsNumber());
+
+        const uint begin = c * HAUSDORFF_SAMPLES_PER_CHUNK;
+        const uint end =
+            std::min(begin + HAUSDORFF_SAMPLES_PER_CHUNK, nSamples);
+
+        for (uint i = begin; i < end; ++i) {
+            ScalarType dist = std::numeric_limits<ScalarType>::max();
+            const auto iter =
+                g.closestValue(s.sample(i), distFunction..., dist);
+
+            if (iter != g.end()) {
+                p.ns++;
+                if (dist > p.res.maxDist)
+                    p.res.maxDist = dist;
+                if (dist < p.res.minDist)
+                    p.res.minDist = dist;
+                p.res.meanDist += dist;
+                p.res.RMSDist += dist * dist;
+                p.res.histogram.addValue(dist);
+            }
         }
 
-        log.progress(++i);
-        //    }
+        // progress is reported once per chunk
+        log.progress(processed += end - begin);
     });
 
+    // merge the partial results in chunk order, to get the same result
+    // regardless of the number of threads
+    uint ns = 0;
+    for (const PartialResult& p : partials) {
+        ns += p.ns;
+        res.maxDist = std::max(res.maxDist, p.res.maxDist);
+        res.minDist = std::min(res.minDist, p.res.minDist);
+        res.meanDist += p.res.meanDist;
+        res.RMSDist += p.res.RMSDist;
+        res.histogram.merge(p.res.histogram);
+    }
+
     log.endProgress();
     log.log(100, "Computed " + std::to_string(ns) + " distances.");
-    if (ns != s.size()) {
+    if (ns != nSamples) {
         log.log(
             100,
-            std::to_string(s.size() - ns) +
+            std::to_string(nSamples - ns) +
                 " samples were not counted because no closest vertex/face "
                 "was found.",
             LogType::WARNING_LOG);
@@ -123,7 +180,9 @@ template<
 HausdorffDistResult samplerMeshHausdorff(
     const MeshType&    m,
     const SamplerType& s,
-    LogType&           log) requires (!HasFaces<MeshType>)
+    LogType&           log,
+    HausdorffSpatialIndex = HAUSDORFF_STATIC_GRID)
+    requires (!HasFaces<MeshType>)
 {
     using VertexType = MeshType::VertexType;
 
@@ -135,7 +194,6 @@ HausdorffDistResult samplerMeshHausdorff(
     log.log(0, "Building Grid on " + meshName + " vertices...");
 
     StaticGrid3<const VertexType*> grid(m.vertices() | views::addrOf);
-    grid.build();
 
     log.log(5, "Grid built.");
 
@@ -147,9 +205,10 @@ template<
     SamplerConcept  SamplerType,
     LoggerConcept   LogType>
 HausdorffDistResult samplerMeshHausdorff(
-    const MeshType&    m,
-    const SamplerType& s,
-    LogType&           log)
+    const MeshType&       m,
+    const SamplerType&    s,
+    LogType&              log,
+    HausdorffSpatialIndex spatialIndex = HAUSDORFF_STATIC_GRID)
 {
     using VertexType = MeshType::VertexType;
     using FaceType   = MeshType::FaceType;
@@ -164,22 +223,44 @@ HausdorffDistResult samplerMeshHausdorff(
 
         StaticGrid3<const VertexType*, ScalarType> grid(
             m.vertices() | views::addrOf);
-        grid.build();
 
         log.log(5, "Grid built.");
 
         return hausdorffDist(m, s, grid, log);
     }
+
+    // polygonal faces are triangulated once, instead of at each distance
+    // computation between a sample and a face
+    FaceTriangulation triangulation;
+    if constexpr (!TriangleFaceConcept<FaceType>) {
+        log.log(0, "Triangulating " + meshName + " faces...");
+        triangulation = FaceTriangulation(m);
+    }
+
+    auto distFun = [&](const auto& p, const auto& f, ScalarType maxDist) {
+        return boundedDistance(p, dereferencePtr(f), triangulation, maxDist);
+    };
+
+    if (spatialIndex == HAUSDORFF_BVH) {
+        log.log(0, "Building BVH on " + meshName + " faces...");
+
+        // the BVH reuses the triangulation of the polygonal faces
+        BVH<const FaceType*, ScalarType> bvh(
+            m.faces() | views::addrOf, triangulation);
+
+        log.log(5, "BVH built.");
+
+        return hausdorffDist(m, s, bvh, log, distFun);
+    }
     else {
         log.log(0, "Building Grid on " + meshName + " faces...");
 
         StaticGrid3<const FaceType*, ScalarType> grid(
             m.faces() | views::addrOf);
-        grid.build();
 
         log.log(5, "Grid built.");
 
-        return hausdorffDist(m, s, grid, log);
+        return hausdorffDist(m, s, grid, log, distFun);
     }
 }
 
@@ -190,13 +271,14 @@ template<
     SamplerConcept SamplerType,
     LoggerConcept  LogType>
 HausdorffDistResult hausdorffDistance(
-    const MeshType1&   m1,
-    const MeshType2&   m2,
-    uint               nSamples,
-    bool               deterministic,
-    SamplerType&       sampler,
-    std::vector<uint>& birth,
-    LogType&           log)
+    const MeshType1&      m1,
+    const MeshType2&      m2,
+    uint                  nSamples,
+    bool                  deterministic,
+    SamplerType&          sampler,
+    std::vector<uint>&    birth,
+    LogType&              log,
+    HausdorffSpatialIndex spatialIndex)
 {
     std::string meshName1 = "first mesh";
     std::string meshName2 = "second mesh";
@@ -228,7 +310,7 @@ HausdorffDistResult hausdorffDistance(
     log.startNewTask(
         5, 100, "Computing distance between samples and " + meshName1 + "...");
 
-    auto res = samplerMeshHausdorff(m1, sampler, log);
+    auto res = samplerMeshHausdorff(m1, sampler, log, spatialIndex);
 
     log.endTask("Distance between samples and " + meshName1 + " computed.");
 
@@ -247,7 +329,8 @@ HausdorffDistResult hausdorffDistance(
     LogType&                log           = nullLogger,
     HausdorffSamplingMethod sampMethod    = HAUSDORFF_VERTEX_UNIFORM,
     uint                    nSamples      = 0,
-    bool                    deterministic = false)
+    bool                    deterministic = false,
+    HausdorffSpatialIndex   spatialIndex  = HAUSDORFF_STATIC_GRID)
 {
     if (nSamples == 0)
         nSamples = m2.vertexNumber();
@@ -259,7 +342,14 @@ HausdorffDistResult hausdorffDistance(
         ConstVertexSampler<typename MeshType2::VertexType> sampler;
 
         return detail::hausdorffDistance<HAUSDORFF_VERTEX_UNIFORM>(
-            m1, m2, nSamples, deterministic, sampler, birth, log);
+            m1,
+            m2,
+            nSamples,
+            deterministic,
+            sampler,
+            birth,
+            log,
+            spatialIndex);
     }
 
     case HAUSDORFF_EDGE_UNIFORM: {
@@ -270,7 +360,14 @@ HausdorffDistResult hausdorffDistance(
         PointSampler<typename MeshType2::VertexType::PositionType> sampler;
 
         return detail::hausdorffDistance<HAUSDORFF_MONTECARLO>(
-            m1, m2, nSamples, deterministic, sampler, birth, log);
+            m1,
+            m2,
+            nSamples,
+            deterministic,
+            sampler,
+            birth,
+            log,
+            spatialIndex);
     }
     default: assert(0); return HausdorffDistResult();
     }
@@ -25,6 +25,7 @@
 
 #include <vclib/algorithms/core/intersection/element.h>
 #include <vclib/mesh/requirements.h>
+#include <vclib/space/complex/bvh.h>
 
 /**
  * @defgroup intersection_mesh Mesh Intersection Algorithms
@@ -168,27 +169,16 @@ EdgeMesh intersection(const MeshType& m, const PlaneType& pl)
     return em;
 }
 
-/**
- * @brief Compute the intersection between a mesh and a ball.
- *
- * Given a mesh and a sphere, returns a new mesh made by a copy of all the faces
- * entirely included in the sphere, plus new faces created by refining the ones
- * intersected by the sphere border. It works by recursively splitting the
- * triangles that cross the border, as long as their area is greater than a
- * given value tol.
- *
- * @note The returned mesh is a triangle soup
- *
- * @param m
- * @param sphere
- * @param tol
- * @return
- *
- * @ingroup intersection_mesh
+namespace detail {
+
+/*
+ * Refines the faces of res (that contains the faces of a mesh that intersect
+ * the sphere) that cross the border of the sphere, and removes the faces that
+ * lie outside the sphere.
  */
 template<FaceMeshConcept MeshType, typename SScalar>
-MeshType intersection(
-    const MeshType&        m,
+void refineSphereIntersection(
+    MeshType&              res,
     const Sphere<SScalar>& sphere,
     double                 tol)
 {
@@ -197,12 +187,6 @@ MeshType intersection(
     using ScalarType   = PositionType::ScalarType;
     using FaceType     = MeshType::FaceType;
 
-    auto faceSphereIntersectionFilter = [&sphere](const FaceType& f) -> bool {
-        return intersect(f, sphere);
-    };
-
-    MeshType res = perFaceMeshFilter(m, faceSphereIntersectionFilter);
-
     uint i = 0;
     while (i < res.faceContainerSize()) {
         FaceType& f = res.face(i);
@@ -261,6 +245,92 @@ MeshType intersection(
 
         ++i;
     }
+}
+
+} // namespace detail
+
+/**
+ * @brief Compute the intersection between a mesh and a ball.
+ *
+ * Given a mesh and a sphere, returns a new mesh made by a copy of all the faces
+ * entirely included in the sphere, plus new faces created by refining the ones
+ * intersected by the sphere border. It works by recursively splitting the
+ * triangles that cross the border, as long as their area is greater than a
+ * given value tol.
+ *
+ * @note The returned mesh is a triangle soup
+ *
+ * @param m
+ * @param sphere
+ * @param tol
+ * @return
+ *
+ * @ingroup intersection_mesh
+ */
+template<FaceMeshConcept MeshType, typename SScalar>
+MeshType intersection(
+    const MeshType&        m,
+    const Sphere<SScalar>& sphere,
+    double                 tol)
+{
+    using FaceType = MeshType::FaceType;
+
+    auto faceSphereIntersectionFilter = [&sphere](const FaceType& f) -> bool {
+        return intersect(f, sphere);
+    };
+
+    MeshType res = perFaceMeshFilter(m, faceSphereIntersectionFilter);
+
+    detail::refineSphereIntersection(res, sphere, tol);
+
+    return res;
+}
+
+/**
+ * @brief Compute the intersection between a mesh and a ball, using a BVH
+ * built on the faces of the mesh to find the faces intersected by the sphere.
+ *
+ * The result is the same of intersection(const MeshType&, const
+ * Sphere<SScalar>&, double), but only the faces whose bounding box intersects
+ * the sphere are tested, instead of all the faces of the mesh. It is
+ * convenient when several intersections are computed on the same mesh.
+ *
+ * @param m
+ * @param sphere
+ * @param bvh: a BVH built on the pointers to the faces of m.
+ * @param tol
+ * @return
+ *
+ * @ingroup intersection_mesh
+ */
+template<
+    FaceMeshConcept MeshType,
+    typename SScalar,
+    typename FacePointer,
+    typename BVHScalar>
+MeshType intersection(
+    const MeshType&                    m,
+    const Sphere<SScalar>&             sphere,
+    const BVH<FacePointer, BVHScalar>& bvh,
+    double                             tol)
+{
+    using FaceType = MeshType::FaceType;
+
+    const Sphere<BVHScalar> s(
+        sphere.center().template cast<BVHScalar>(), sphere.radius());
+
+    std::vector<bool> selected(m.faceContainerSize(), false);
+    for (const auto& it : bvh.valuesInSphere(s)) {
+        const FaceType* f = *it;
+        if (intersect(*f, sphere))
+            selected[m.index(f)] = true;
+    }
+
+    MeshType res = perFaceMeshFilter(m, [&](const FaceType& f) -> bool {
+        return selected[m.index(f)];
+    });
+
+    detail::refineSphereIntersection(res, sphere, tol);
 
     return res;
 }
@@ -28,8 +28,17 @@
 #include <vclib/math/random.h>
 #include <vclib/mesh/requirements.h>
 #include <vclib/misc/comparators.h>
+#include <vclib/misc/logger.h>
+#include <vclib/misc/parallel.h>
+#include <vclib/space/complex/grid/point_hash_grid.h>
 #include <vclib/space/complex/sampler.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <ranges>
+
 /**
  * @defgroup point_sampling Point Sampling Algorithms
  *
@@ -49,6 +58,276 @@
 
 namespace vcl {
 
+/**
+ * @brief Number of elements (faces or samples) processed by each parallel
+ * task of the montecarlo sampling functions.
+ *
+ * The split in chunks does not depend on the number of threads, therefore the
+ * output of the sampling functions does not depend on it.
+ */
+inline constexpr uint POINT_SAMPLING_ELEMENTS_PER_CHUNK = 4096;
+
+/**
+ * @brief Ratio between the number of montecarlo samples generated as
+ * candidates by the poisson disk sampling functions and the expected number
+ * of poisson disk samples.
+ */
+inline constexpr uint POISSON_DISK_POOL_FACTOR = 10;
+
+namespace detail {
+
+/*
+ * Calls f(begin, end) for each chunk of POINT_SAMPLING_ELEMENTS_PER_CHUNK
+ * elements in [0, n). The first chunk is processed before the others, that
+ * are processed in parallel: when the chunks are over samples, this allows
+ * the first set of a sampler to initialize the sampler (e.g. the custom
+ * components of a MeshSampler) without races. When the chunks are over faces,
+ * see firstSampledFace.
+ */
+template<typename F>
+void forEachSamplingChunk(uint n, F&& f)
+{
+    const uint nChunks = (n + POINT_SAMPLING_ELEMENTS_PER_CHUNK - 1) /
+                         POINT_SAMPLING_ELEMENTS_PER_CHUNK;
+
+    auto chunkFun = [&](uint c) {
+        const uint begin = c * POINT_SAMPLING_ELEMENTS_PER_CHUNK;
+        f(begin, std::min(n, begin + POINT_SAMPLING_ELEMENTS_PER_CHUNK));
+    };
+
+    if (nChunks > 0)
+        chunkFun(0);
+
+    std::vector<uint> chunks(nChunks > 0 ? nChunks - 1 : 0);
+    std::iota(chunks.begin(), chunks.end(), 1);
+    parallelFor(chunks, chunkFun);
+}
+
+/*
+ * Returns the index of the first face that has samples, given the function
+ * endSample(i) that returns the (non decreasing) index of the sample that
+ * follows the samples of the i-th face, or n if no face has samples.
+ *
+ * When the parallel chunks are over faces, the first sample does not
+ * necessarily belong to the first chunk: the face returned by this function
+ * must be sampled before the parallel phase, so that the first set of the
+ * sampler (that may initialize it) does not race with the others.
+ */
+template<typename F>
+uint firstSampledFace(uint n, F&& endSample)
+{
+    auto faces = std::views::iota(0u, n);
+    return *std::ranges::partition_point(faces, [&](uint i) {
+        return endSample(i) == 0;
+    });
+}
+
+/*
+ * Computes in place the inclusive prefix sum of the given vector: each chunk
+ * is summed in parallel, and then the offsets of the chunks are added.
+ */
+template<typename T>
+void parallelPrefixSum(std::vector<T>& v)
+{
+    const uint nChunks = (v.size() + POINT_SAMPLING_ELEMENTS_PER_CHUNK - 1) /
+                         POINT_SAMPLING_ELEMENTS_PER_CHUNK;
+
+    std::vector<T> chunkSums(nChunks);
+    forEachSamplingChunk(v.size(), [&](uint begin, uint end) {
+        std::partial_sum(v.begin() + begin, v.begin() + end, v.begin() + begin);
+        chunkSums[begin / POINT_SAMPLING_ELEMENTS_PER_CHUNK] = v[end - 1];
+    });
+
+    std::exclusive_scan(
+        chunkSums.begin(), chunkSums.end(), chunkSums.begin(), T(0));
+
+    forEachSamplingChunk(v.size(), [&](uint begin, uint end) {
+        const T offset = chunkSums[begin / POINT_SAMPLING_ELEMENTS_PER_CHUNK];
+        if (offset != T(0)) {
+            for (uint i = begin; i < end; ++i)
+                v[i] += offset;
+        }
+    });
+}
+
+/*
+ * Returns the cumulative areas of the faces of the mesh, indexed by face
+ * container index (deleted faces have zero area): the last element is the
+ * area of the mesh.
+ */
+template<typename ScalarType, FaceMeshConcept MeshType>
+std::vector<ScalarType> cumulativeFaceAreas(const MeshType& m)
+{
+    std::vector<ScalarType> areas(m.faceContainerSize());
+    forEachSamplingChunk(areas.size(), [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i) {
+            const auto& f = m.face(i);
+            areas[i]      = f.deleted() ? 0 : faceArea(f);
+        }
+    });
+    parallelPrefixSum(areas);
+    return areas;
+}
+
+/*
+ * Guide table of the cumulative areas: the i-th element is the index of the
+ * first face whose cumulative area is greater than i * area / n, where n is
+ * the number of elements of the table (equal to the number of faces). It
+ * allows to find the face of a sampled value in constant expected time.
+ */
+template<typename ScalarType>
+std::vector<uint> cumulativeAreasGuide(const std::vector<ScalarType>& cdf)
+{
+    std::vector<uint> guide(cdf.size());
+    forEachSamplingChunk(guide.size(), [&](uint begin, uint end) {
+        auto it = cdf.begin();
+        for (uint i = begin; i < end; ++i) {
+            const ScalarType v = cdf.back() * i / guide.size();
+            it                 = std::upper_bound(it, cdf.end(), v);
+            guide[i]           = it - cdf.begin();
+        }
+    });
+    return guide;
+}
+
+/*
+ * Returns the index of the face whose interval in the cumulative areas
+ * contains the given value (faces having zero area are never returned),
+ * starting the search from the guide table.
+ */
+template<typename ScalarType>
+uint sampledFaceIndex(
+    const std::vector<ScalarType>& cdf,
+    const std::vector<uint>&       guide,
+    ScalarType                     val)
+{
+    const uint n = cdf.size();
+
+    uint i = std::min<uint>(n - 1, val / cdf.back() * n);
+    i      = std::min(guide[i], n - 1);
+    // the guide of the bucket may be not exact due to rounding
+    while (i > 0 && cdf[i - 1] > val)
+        --i;
+    while (i < n && cdf[i] <= val)
+        ++i;
+
+    // val may be equal to the area of the mesh due to rounding
+    if (i == n)
+        i = std::lower_bound(cdf.begin(), cdf.end(), cdf.back()) - cdf.begin();
+    return i;
+}
+
+inline uint64_t samplingSeed(bool deterministic)
+{
+    if (deterministic)
+        return 0;
+    std::random_device rd;
+    return (uint64_t(rd()) << 32) | rd();
+}
+
+/*
+ * Number of poisson disk samples per unit of area, for a unit radius: the
+ * value has been measured pruning pools of POISSON_DISK_POOL_FACTOR
+ * montecarlo samples for each poisson disk sample.
+ */
+inline constexpr double POISSON_DISK_DENSITY = 0.53;
+
+/*
+ * Radius of the disks that cover approximately the given area with the given
+ * number of poisson disk samples.
+ */
+inline double poissonDiskRadius(double area, uint nSamples)
+{
+    return std::sqrt(POISSON_DISK_DENSITY * area / nSamples);
+}
+
+/*
+ * Dart throwing over a pool of candidate points: a candidate is accepted if
+ * there are no accepted points at distance less than radius. Returns the
+ * indices of the accepted points.
+ *
+ * Candidates are bucketed in a PointHashGrid having cells of edge 2 * radius
+ * (larger cells require less hash lookups), so the points that conflict with
+ * a candidate lie in the 27 cells around its cell. Cells are split in 27
+ * phase groups by their position modulo 3: cells of the same group are not
+ * adjacent, and they are processed in parallel. The candidates of each cell
+ * are processed in the order of the pool, and the accepted ones are
+ * compacted at the beginning of the cell range of a copy of the points
+ * sorted by cell, so that the distance tests access contiguous memory.
+ */
+template<typename ScalarType>
+std::vector<uint> poissonDiskPrune(
+    const std::vector<Point3<ScalarType>>& pool,
+    ScalarType                             radius)
+{
+    using CellPos = PointHashGrid<ScalarType>::CellPos;
+
+    const PointHashGrid<ScalarType> grid(pool, 2 * radius);
+
+    std::array<std::vector<uint>, 27> phases;
+    for (uint c = 0; c < grid.cellNumber(); ++c) {
+        const CellPos p = grid.cellPosition(c);
+        phases[(p.x() % 3) * 9 + (p.y() % 3) * 3 + p.z() % 3].push_back(c);
+    }
+
+    // copy of the points and of their indices sorted by cell: the accepted
+    // points of each cell are compacted at the beginning of its range
+    std::vector<Point3<ScalarType>> points(grid.pointNumber());
+    std::vector<uint>               indices = grid.indices();
+    std::vector<uint>               acceptedNumber(grid.cellNumber(), 0);
+
+    parallelFor(points, [&](Point3<ScalarType>& p) {
+        p = pool[indices[&p - points.data()]];
+    });
+
+    const ScalarType sqRadius = radius * radius;
+
+    for (const std::vector<uint>& phase : phases) {
+        parallelFor(phase, [&](uint c) {
+            const CellPos cp = grid.cellPosition(c);
+
+            std::array<uint, 27> near;
+            uint                 nNear = 0;
+            for (int x = -1; x <= 1; ++x) {
+                for (int y = -1; y <= 1; ++y) {
+                    for (int z = -1; z <= 1; ++z) {
+                        uint nc = grid.cellIndex(cp + CellPos(x, y, z));
+                        if (nc != UINT_NULL)
+                            near[nNear++] = nc;
+                    }
+                }
+            }
+
+            const uint first = grid.cellBegin(c);
+            for (uint i = first; i < grid.cellEnd(c); ++i) {
+                bool free = true;
+                for (uint k = 0; k < nNear && free; ++k) {
+                    const Point3<ScalarType>* acc =
+                        points.data() + grid.cellBegin(near[k]);
+                    for (uint j = 0; j < acceptedNumber[near[k]] && free; ++j)
+                        free = acc[j].squaredDist(points[i]) >= sqRadius;
+                }
+                if (free) {
+                    const uint j = first + acceptedNumber[c]++;
+                    points[j]    = points[i];
+                    indices[j]   = indices[i];
+                }
+            }
+        });
+    }
+
+    std::vector<uint> res;
+    for (uint c = 0; c < grid.cellNumber(); ++c) {
+        res.insert(
+            res.end(),
+            indices.begin() + grid.cellBegin(c),
+            indices.begin() + grid.cellBegin(c) + acceptedNumber[c]);
+    }
+    return res;
+}
+
+} // namespace detail
+
 /**
  * @brief Returns a Sampler object that contains all the vertices contained in
  * the given mesh.
@@ -788,51 +1067,47 @@ SamplerType montecarloPointSampling(
     using VertexType = MeshType::VertexType;
     using ScalarType = VertexType::PositionType::ScalarType;
     using FaceType   = MeshType::FaceType;
-    using Interval   = std::pair<ScalarType, const FaceType*>;
 
-    FirstElementPairComparator<Interval> comparator;
-    SamplerType                          sampler;
+    SamplerType sampler;
 
-    // Reserve space in the sampler and birthFaces vectors
-    sampler.reserve(nSamples);
-    birthFaces.reserve(nSamples);
-    birthFaces.clear();
+    // cumulative areas of the faces: sampling a value in [0, area) and
+    // searching it in the cdf selects a face with probability proportional to
+    // its area
+    const std::vector<ScalarType> cdf =
+        detail::cumulativeFaceAreas<ScalarType>(m);
+
+    if (cdf.empty() || cdf.back() <= 0) {
+        birthFaces.clear();
+        return sampler;
+    }
+
+    sampler.resize(nSamples);
+    birthFaces.resize(nSamples);
+
+    const std::vector<uint> guide = detail::cumulativeAreasGuide(cdf);
+
+    const ScalarType meshArea = cdf.back();
+    const uint64_t   seed     = detail::samplingSeed(deterministic);
 
     std::uniform_real_distribution<ScalarType> dist(0, 1);
 
-    std::random_device rd;
-    std::mt19937       gen(rd());
-    if (deterministic)
-        gen = std::mt19937(0);
+    // each sample uses its own generator, keyed by its index
+    detail::forEachSamplingChunk(nSamples, [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i) {
+            Philox4x32 gen(seed, i);
 
-    std::vector<Interval> intervals(m.faceNumber());
-    uint                  i    = 0;
-    ScalarType            area = 0;
-    for (const FaceType& f : m.faces()) {
-        area += faceArea(f);
-        intervals[i] = std::make_pair(area, &f);
-        i++;
-    }
+            const uint fi =
+                detail::sampledFaceIndex(cdf, guide, meshArea * dist(gen));
+            const FaceType& f = m.face(fi);
 
-    ScalarType meshArea = intervals.back().first;
-    for (uint i = 0; i < nSamples; i++) {
-        ScalarType val = meshArea * dist(gen);
-        // lower_bound returns the furthermost iterator i in [first, last) such
-        // that, for every iterator j in [first, i), *j < value. E.g. An
-        // iterator pointing to the first element "not less than" val, or end()
-        // if every element is less than val.
-        typename std::vector<Interval>::iterator it = std::lower_bound(
-            intervals.begin(),
-            intervals.end(),
-            std::make_pair(val, nullptr),
-            comparator);
-
-        sampler.add(
-            *it->second,
-            randomPolygonBarycentricCoordinate<ScalarType>(
-                it->second->vertexNumber(), gen));
-        birthFaces.push_back(it->second->index());
-    }
+            sampler.set(
+                i,
+                f,
+                randomPolygonBarycentricCoordinate<ScalarType>(
+                    f.vertexNumber(), gen));
+            birthFaces[i] = fi;
+        }
+    });
 
     return sampler;
 }
@@ -864,40 +1139,76 @@ SamplerType montecarloPointSampling(
         m, nSamples, birthFaces, deterministic);
 }
 
+/**
+ * @brief Computes a montecarlo distribution in which the number of samples of
+ * each face is proportional to its area, and the remainders of the faces are
+ * carried over the following faces, so that the total number of samples is
+ * nSamples (up to rounding).
+ *
+ * @tparam SamplerType: A type that satisfies the SamplerConcept
+ * @tparam MeshType: A type that satisfies the FaceMeshConcept
+ *
+ * @param[in] m: The mesh to sample from.
+ * @param[in] nSamples: The number of samples to take.
+ * @param[in] deterministic: Whether to use a deterministic random generator.
+ *
+ * @return A SamplerType object that contains the sampled points on the faces.
+ *
+ * @ingroup point_sampling
+ */
 template<SamplerConcept SamplerType, FaceMeshConcept MeshType>
 SamplerType stratifiedMontecarloPointSampling(
     const MeshType& m,
     uint            nSamples,
     bool            deterministic = false)
 {
-    using FaceType   = MeshType::FaceType;
     using ScalarType = SamplerType::ScalarType;
 
     SamplerType ps;
 
-    std::random_device rd;
-    std::mt19937       gen(rd());
-    if (deterministic)
-        gen = std::mt19937(0);
+    const std::vector<double> cdf = detail::cumulativeFaceAreas<double>(m);
 
-    double area              = surfaceArea(m);
-    double samplePerAreaUnit = nSamples / area;
-    // Montecarlo sampling.
-    double floatSampleNum = 0.0;
+    if (cdf.empty() || cdf.back() <= 0)
+        return ps;
 
-    for (const FaceType& f : m.faces()) {
-        // compute # samples in the current face (taking into account of the
-        // remainders)
-        floatSampleNum += faceArea(f) * samplePerAreaUnit;
-        int faceSampleNum = (int) floatSampleNum;
-        // for every sample p_i in T...
-        for (int i = 0; i < faceSampleNum; i++)
-            ps.add(
+    const double samplePerAreaUnit = nSamples / cdf.back();
+
+    // carrying the remainders, the samples of the i-th face are the ones
+    // between floor(cdf[i - 1] * samplePerAreaUnit) (included) and
+    // floor(cdf[i] * samplePerAreaUnit) (excluded)
+    auto firstSample = [&](uint i) {
+        return i == 0 ? 0u : uint(cdf[i - 1] * samplePerAreaUnit);
+    };
+
+    ps.resize(firstSample(cdf.size()));
+
+    const uint64_t seed = detail::samplingSeed(deterministic);
+
+    auto sampleFace = [&](uint i) {
+        const auto& f = m.face(i);
+        for (uint j = firstSample(i); j < firstSample(i + 1); ++j) {
+            Philox4x32 gen(seed, j);
+            ps.set(
+                j,
                 f,
                 randomPolygonBarycentricCoordinate<ScalarType>(
                     f.vertexNumber(), gen));
-        floatSampleNum -= (double) faceSampleNum;
-    }
+        }
+    };
+
+    // the face of the first sample is sampled before the parallel phase
+    const uint first = detail::firstSampledFace(cdf.size(), [&](uint i) {
+        return firstSample(i + 1);
+    });
+    if (first < cdf.size())
+        sampleFace(first);
+
+    detail::forEachSamplingChunk(cdf.size(), [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i) {
+            if (i != first)
+                sampleFace(i);
+        }
+    });
 
     return ps;
 }
@@ -930,30 +1241,58 @@ SamplerType montecarloPoissonPointSampling(
     uint            nSamples,
     bool            deterministic = false)
 {
-    using FaceType   = MeshType::FaceType;
     using ScalarType = SamplerType::ScalarType;
 
     SamplerType ps;
 
-    std::random_device rd;
-    std::mt19937       gen(rd());
-    if (deterministic)
-        gen = std::mt19937(0);
-
     ScalarType area              = surfaceArea(m);
     ScalarType samplePerAreaUnit = nSamples / area;
 
-    for (const FaceType& f : m.faces()) {
-        ScalarType areaT  = faceArea(f);
-        int faceSampleNum = poissonRandomNumber(areaT * samplePerAreaUnit, gen);
+    const uint64_t seed = detail::samplingSeed(deterministic);
+
+    // number of samples of each face, drawn with a generator keyed by the
+    // face index, in a key space that differs from the one of the samples
+    std::vector<uint> offsets(m.faceContainerSize() + 1, 0);
+    detail::forEachSamplingChunk(m.faceContainerSize(), [&](uint b, uint e) {
+        for (uint i = b; i < e; ++i) {
+            const auto& f = m.face(i);
+            if (!f.deleted()) {
+                Philox4x32 gen(~seed, i);
+                offsets[i + 1] =
+                    poissonRandomNumber(faceArea(f) * samplePerAreaUnit, gen);
+            }
+        }
+    });
+    detail::parallelPrefixSum(offsets);
 
-        // for every sample p_i in T...
-        for (int i = 0; i < faceSampleNum; i++)
-            ps.add(
+    ps.resize(offsets.back());
+
+    auto sampleFace = [&](uint i) {
+        const auto& f = m.face(i);
+        for (uint j = offsets[i]; j < offsets[i + 1]; ++j) {
+            Philox4x32 gen(seed, j);
+            ps.set(
+                j,
                 f,
                 randomPolygonBarycentricCoordinate<ScalarType>(
                     f.vertexNumber(), gen));
-    }
+        }
+    };
+
+    // the face of the first sample is sampled before the parallel phase
+    const uint first =
+        detail::firstSampledFace(m.faceContainerSize(), [&](uint i) {
+            return offsets[i + 1];
+        });
+    if (first < m.faceContainerSize())
+        sampleFace(first);
+
+    detail::forEachSamplingChunk(m.faceContainerSize(), [&](uint b, uint e) {
+        for (uint i = b; i < e; ++i) {
+            if (i != first)
+                sampleFace(i);
+        }
+    });
 
     return ps;
 }
@@ -1041,6 +1380,255 @@ SamplerType vertexQualityWeightedMontecarloPointSampling(
         m, weights, nSamples, variance, deterministic);
 }
 
+namespace detail {
+
+/*
+ * Poisson disk sampling of the mesh: if radius is zero, it is computed (and
+ * iteratively refined) in order to get approximately nSamples samples;
+ * otherwise, nSamples is the expected number of samples for the given radius,
+ * and it is used only to size the pool of candidates.
+ */
+template<
+    SamplerConcept  SamplerType,
+    FaceMeshConcept MeshType,
+    LoggerConcept   LogType>
+SamplerType poissonDiskPointSampling(
+    const MeshType&    m,
+    uint               nSamples,
+    double             radius,
+    std::vector<uint>& birthFaces,
+    bool               deterministic,
+    LogType&           log)
+{
+    using PositionType = MeshType::VertexType::PositionType;
+    using ScalarType   = PositionType::ScalarType;
+
+    // maximum number of refinements of the radius, and tolerance on the
+    // number of samples, when the number of samples is given
+    constexpr uint   MAX_REFINEMENTS = 8;
+    constexpr double TOLERANCE       = 0.01;
+
+    SamplerType ps;
+
+    const double area = surfaceArea(m);
+    if (area <= 0 || nSamples == 0) {
+        birthFaces.clear();
+        return ps;
+    }
+
+    const bool fixedRadius = radius > 0;
+    if (!fixedRadius)
+        radius = poissonDiskRadius(area, nSamples);
+
+    // the size of the pool is computed in 64 bits and clamped to the maximum
+    // number of samples
+    const uint poolSize = uint(std::min<uint64_t>(
+        uint64_t(nSamples) * POISSON_DISK_POOL_FACTOR,
+        std::numeric_limits<uint>::max()));
+
+    std::vector<uint> poolFaces;
+
+    const auto pool = montecarloPointSampling<PointSampler<PositionType>>(
+        m, poolSize, poolFaces, deterministic);
+
+    // the grid has cells of edge 2 * radius, and it can store up to 2^21
+    // cells for each axis
+    Box3<ScalarType> bb;
+    for (const auto& p : pool)
+        bb.add(p);
+    const double minRadius = bb.size().maxCoeff() / ((1 << 21) - 1);
+    if (radius < minRadius) {
+        log.log(
+            "The radius is too small for the extent of the mesh: it has been "
+            "set to " +
+                std::to_string(minRadius) + ".",
+            LogType::WARNING_LOG);
+        radius = minRadius;
+    }
+
+    std::vector<uint> res =
+        poissonDiskPrune(pool.samples(), ScalarType(radius));
+
+    if (!fixedRadius) {
+        // the number of samples is inversely proportional to the square of
+        // the radius
+        for (uint i = 0; i < MAX_REFINEMENTS &&
+                         std::abs(double(res.size()) - nSamples) >
+                             TOLERANCE * nSamples;
+             ++i) {
+            const double r = radius * std::sqrt(double(res.size()) / nSamples);
+            if (r < minRadius) {
+                log.log(
+                    "The radius cannot be refined below " +
+                        std::to_string(minRadius) + ": got " +
+                        std::to_string(res.size()) + " samples.",
+                    LogType::WARNING_LOG);
+                break;
+            }
+            radius = r;
+            res    = poissonDiskPrune(pool.samples(), ScalarType(radius));
+        }
+    }
+
+    ps.resize(res.size());
+    birthFaces.resize(res.size());
+    forEachSamplingChunk(res.size(), [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i) {
+            ps.set(
+                i,
+                pool.sample(res[i])
+                    .template cast<typename SamplerType::ScalarType>());
+            birthFaces[i] = poolFaces[res[i]];
+        }
+    });
+
+    return ps;
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes a poisson disk sampling of the surface of the mesh having
+ * approximately nSamples samples: samples are evenly spaced, and the
+ * distance between any two samples is greater than a radius that is
+ * computed from the area of the mesh and nSamples.
+ *
+ * A pool of montecarlo samples (POISSON_DISK_POOL_FACTOR times the number of
+ * requested samples) is pruned with a parallel dart throwing over a flat
+ * hash grid (see PointHashGrid). The radius is then refined, and the pool
+ * pruned again, until the number of samples is within 1% of nSamples (or
+ * after a maximum number of refinements, or when the hash grid would have
+ * more than 2^21 cells along an axis).
+ *
+ * The indices of the faces on which the samples lie are stored in the
+ * birthFaces vector.
+ *
+ * @tparam SamplerType: A type that satisfies the SamplerConcept
+ * @tparam MeshType: A type that satisfies the FaceMeshConcept
+ *
+ * @param[in] m: The mesh to sample from.
+ * @param[in] nSamples: The number of samples to take.
+ * @param[out] birthFaces: A vector to store the indices of the faces that were
+ * sampled.
+ * @param[in] deterministic: Whether to use a deterministic random generator.
+ * @param[in] log: The logger used to warn when the radius cannot be refined,
+ * because the hash grid would have too many cells.
+ *
+ * @return A SamplerType object that contains the sampled points on the faces.
+ *
+ * @ingroup point_sampling
+ */
+template<
+    SamplerConcept  SamplerType,
+    FaceMeshConcept MeshType,
+    LoggerConcept   LogType = NullLogger>
+SamplerType poissonDiskPointSampling(
+    const MeshType&    m,
+    uint               nSamples,
+    std::vector<uint>& birthFaces,
+    bool               deterministic = false,
+    LogType&           log           = nullLogger)
+{
+    return detail::poissonDiskPointSampling<SamplerType>(
+        m, nSamples, 0, birthFaces, deterministic, log);
+}
+
+/**
+ * @brief Computes a poisson disk sampling of the surface of the mesh having
+ * approximately nSamples samples.
+ *
+ * @copydetails vcl::poissonDiskPointSampling(const MeshType&, uint,
+ * std::vector<uint>&, bool, LogType&)
+ *
+ * @ingroup point_sampling
+ */
+template<
+    SamplerConcept  SamplerType,
+    FaceMeshConcept MeshType,
+    LoggerConcept   LogType = NullLogger>
+SamplerType poissonDiskPointSampling(
+    const MeshType& m,
+    uint            nSamples,
+    bool            deterministic = false,
+    LogType&        log           = nullLogger)
+{
+    std::vector<uint> birthFaces;
+    return poissonDiskPointSampling<SamplerType>(
+        m, nSamples, birthFaces, deterministic, log);
+}
+
+/**
+ * @brief Computes a poisson disk sampling of the surface of the mesh in which
+ * the distance between any two samples is greater than the given radius.
+ *
+ * The samples are computed pruning a pool of montecarlo samples with a
+ * parallel dart throwing over a flat hash grid (see PointHashGrid). The
+ * indices of the faces on which the samples lie are stored in the birthFaces
+ * vector.
+ *
+ * @tparam SamplerType: A type that satisfies the SamplerConcept
+ * @tparam MeshType: A type that satisfies the FaceMeshConcept
+ *
+ * @param[in] m: The mesh to sample from.
+ * @param[in] radius: The minimum distance between two samples.
+ * @param[out] birthFaces: A vector to store the indices of the faces that were
+ * sampled.
+ * @param[in] deterministic: Whether to use a deterministic random generator.
+ * @param[in] log: The logger used to warn when the radius is too small for
+ * the hash grid, and it is enlarged.
+ *
+ * @return A SamplerType object that contains the sampled points on the faces.
+ *
+ * @ingroup point_sampling
+ */
+template<
+    SamplerConcept  SamplerType,
+    FaceMeshConcept MeshType,
+    LoggerConcept   LogType = NullLogger>
+SamplerType poissonDiskRadiusPointSampling(
+    const MeshType&    m,
+    double             radius,
+    std::vector<uint>& birthFaces,
+    bool               deterministic = false,
+    LogType&           log           = nullLogger)
+{
+    assert(radius > 0);
+
+    // expected number of samples, used to size the pool of candidates: it is
+    // clamped before the conversion, since it overflows for small radii
+    const double n = std::clamp(
+        detail::POISSON_DISK_DENSITY * surfaceArea(m) / (radius * radius),
+        1.0,
+        double(std::numeric_limits<uint>::max() / POISSON_DISK_POOL_FACTOR));
+
+    return detail::poissonDiskPointSampling<SamplerType>(
+        m, uint(n), radius, birthFaces, deterministic, log);
+}
+
+/**
+ * @brief Computes a poisson disk sampling of the surface of the mesh in which
+ * the distance between any two samples is greater than the given radius.
+ *
+ * @copydetails vcl::poissonDiskRadiusPointSampling(const MeshType&, double,
+ * std::vector<uint>&, bool, LogType&)
+ *
+ * @ingroup point_sampling
+ */
+template<
+    SamplerConcept  SamplerType,
+    FaceMeshConcept MeshType,
+    LoggerConcept   LogType = NullLogger>
+SamplerType poissonDiskRadiusPointSampling(
+    const MeshType& m,
+    double          radius,
+    bool            deterministic = false,
+    LogType&        log           = nullLogger)
+{
+    std::vector<uint> birthFaces;
+    return poissonDiskRadiusPointSampling<SamplerType>(
+        m, radius, birthFaces, deterministic, log);
+}
+
 } // namespace vcl
 
 #endif // VCL_ALGORITHMS_MESH_POINT_SAMPLING_H
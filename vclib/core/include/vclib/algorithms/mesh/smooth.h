@@ -23,89 +23,243 @@
 #ifndef VCL_ALGORITHMS_MESH_SMOOTH_H
 #define VCL_ALGORITHMS_MESH_SMOOTH_H
 
+#include <vclib/algorithms/mesh/sort.h>
 #include <vclib/mesh/requirements.h>
 #include <vclib/space/complex/kd_tree.h>
 
+#include <array>
 #include <cmath>
+#include <numeric>
 #include <vector>
 
 namespace vcl {
 
+/**
+ * @brief Number of vertices processed by each parallel task of the smoothing
+ * functions.
+ */
+inline constexpr uint SMOOTHING_VERTICES_PER_CHUNK = 4096;
+
 namespace detail {
 
-template<typename PositionType>
-struct LaplacianInfo
+/*
+ * CSR structure that stores, for each vertex, the neighbors used by the
+ * Laplacian smoothing.
+ *
+ * Each face edge incident to a vertex gives an entry, storing the other vertex
+ * of the edge and the index of the face edge. Vertices that lie on a border
+ * edge are averaged only with themselves and with their neighbors on the
+ * border, therefore only the entries of their border edges are stored. The
+ * entries of each vertex are ordered by face index.
+ *
+ * When cotangent weights are required, the [v0, v1, opposite vertex] indices
+ * of each face edge are stored as well, so that the weights can be computed
+ * once per edge at each step.
+ *
+ * The structure depends only on the topology of the mesh, and it is computed
+ * once for all the smoothing steps.
+ */
+struct LaplacianNeighbors
 {
-    using ScalarType = PositionType::ScalarType;
-    PositionType sum;
-    ScalarType   cnt;
+    std::vector<uint>                offsets; // vertexContainerSize() + 1
+    std::vector<uint>                neighbors;
+    std::vector<uint>                edgeIds;
+    std::vector<std::array<uint, 3>> edges;
+    std::vector<char>                onBorder;
 };
 
-template<typename MeshType, typename PositionType>
-void accumulateLaplacianInfo(
-    const MeshType&                           m,
-    std::vector<LaplacianInfo<PositionType>>& data,
-    bool                                      cotangentFlag = false)
+template<FaceMeshConcept MeshType>
+LaplacianNeighbors laplacianNeighbors(
+    const MeshType& m,
+    bool            storeEdges = false)
 {
-    using ScalarType = PositionType::ScalarType;
-    using VertexType = MeshType::VertexType;
-    using FaceType   = MeshType::FaceType;
-
-    ScalarType weight = 1.0f;
-
-    for (const FaceType& f : m.faces()) {
-        for (uint j = 0; j < f.vertexNumber(); ++j) {
-            if (!f.edgeOnBorder(j)) {
-                const VertexType&   v0 = *f.vertex(j);
-                const VertexType&   v1 = *f.vertexMod(j + 1);
-                const VertexType&   v2 = *f.vertexMod(j + 2);
-                const PositionType& p0 = v0.position();
-                const PositionType& p1 = v1.position();
-                const PositionType& p2 = v2.position();
-                if (cotangentFlag) {
-                    ScalarType angle = PositionType(p1 - p2).angle(p0 - p2);
-                    weight           = std::tan((M_PI * 0.5) - angle);
+    using FaceType = MeshType::FaceType;
+    using Entry    = std::pair<uint64_t, std::pair<uint, uint>>;
+
+    // entries are keyed by [vertex index, border flag]: for each vertex, the
+    // entries of border edges follow the ones of the internal edges.
+    // each face edge gives two consecutive entries, one for each vertex
+    std::vector<Entry> vec =
+        fillPerFaceKeyVector<MeshType, std::pair<uint, uint>>(
+            m,
+            [](const FaceType& f) {
+                return 2 * f.vertexNumber();
+            },
+            [](const FaceType& f, Entry* out) {
+                for (uint j = 0; j < f.vertexNumber(); ++j) {
+                    uint64_t b  = f.edgeOnBorder(j);
+                    uint64_t v0 = f.vertexIndex(j);
+                    uint64_t v1 = f.vertexIndexMod(j + 1);
+                    uint     v2 = f.vertexIndexMod(j + 2);
+                    *out++      = {(v0 << 1) | b, {uint(v1), v2}};
+                    *out++      = {(v1 << 1) | b, {uint(v0), v2}};
                 }
+            });
+
+    LaplacianNeighbors ln;
+
+    const uint nEdges  = vec.size() / 2;
+    const uint nChunks =
+        (nEdges + SMOOTHING_VERTICES_PER_CHUNK - 1) /
+        SMOOTHING_VERTICES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
 
-                data[m.index(v0)].sum +=
-                    f.vertexMod(j + 1)->position() * weight;
-                data[m.index(v1)].sum += f.vertex(j)->position() * weight;
-                data[m.index(v0)].cnt += weight;
-                data[m.index(v1)].cnt += weight;
+    // the opposite vertex is replaced by the index of the face edge
+    if (storeEdges)
+        ln.edges.resize(nEdges);
+    parallelFor(chunks, [&](uint c) {
+        uint end = std::min(nEdges, (c + 1) * SMOOTHING_VERTICES_PER_CHUNK);
+        for (uint e = c * SMOOTHING_VERTICES_PER_CHUNK; e < end; ++e) {
+            if (storeEdges) {
+                ln.edges[e] = {
+                    uint(vec[2 * e].first >> 1),
+                    vec[2 * e].second.first,
+                    vec[2 * e].second.second};
             }
+            vec[2 * e].second.second     = e;
+            vec[2 * e + 1].second.second = e;
         }
-    }
-    // si azzaera i dati per i vertici di bordo
-    for (const FaceType& f : m.faces()) {
-        for (uint j = 0; j < f.vertexNumber(); ++j) {
-            if (f.edgeOnBorder(j)) {
-                const VertexType&   v0 = *f.vertex(j);
-                const VertexType&   v1 = *f.vertexMod(j + 1);
-                const PositionType& p0 = v0.position();
-                const PositionType& p1 = v1.position();
-                data[m.index(v0)].sum  = p0;
-                data[m.index(v1)].sum  = p1;
-                data[m.index(v0)].cnt  = 1;
-                data[m.index(v1)].cnt  = 1;
-            }
+    });
+
+    radixSortByKey(vec, indexBitWidth(m.vertexContainerSize()) + 1);
+
+    auto vertexKey = [](uint64_t k) {
+        return k >> 1;
+    };
+
+    // first entry used by the vertex of the cluster [b, e)
+    auto firstUsed = [&](std::size_t b, std::size_t e) {
+        if (vec[e - 1].first & 1) {
+            while (!(vec[b].first & 1))
+                ++b;
         }
-    }
+        return b;
+    };
+
+    ln.offsets.assign(m.vertexContainerSize() + 1, 0);
+    ln.onBorder.assign(m.vertexContainerSize(), false);
+
+    parallelForEachCluster(vec, vertexKey, [&](std::size_t b, std::size_t e) {
+        uint vi            = vec[b].first >> 1;
+        ln.offsets[vi + 1] = e - firstUsed(b, e);
+        ln.onBorder[vi]    = vec[e - 1].first & 1;
+    });
+    std::partial_sum(ln.offsets.begin(), ln.offsets.end(), ln.offsets.begin());
 
-    // se l'edge j e' di bordo si deve mediare solo con gli adiacenti
-    for (const FaceType& f : m.faces()) {
-        for (uint j = 0; j < f.vertexNumber(); ++j) {
-            if (f.edgeOnBorder(j)) {
-                const VertexType&   v0 = *f.vertex(j);
-                const VertexType&   v1 = *f.vertexMod(j + 1);
-                const PositionType& p0 = v0.position();
-                const PositionType& p1 = v1.position();
-                data[m.index(v0)].sum += p1;
-                data[m.index(v1)].sum += p0;
-                ++data[m.index(v0)].cnt;
-                ++data[m.index(v1)].cnt;
+    ln.neighbors.resize(ln.offsets.back());
+    ln.edgeIds.resize(ln.offsets.back());
+    parallelForEachCluster(vec, vertexKey, [&](std::size_t b, std::size_t e) {
+        uint k = ln.offsets[vec[b].first >> 1];
+        for (std::size_t i = firstUsed(b, e); i < e; ++i, ++k) {
+            ln.neighbors[k] = vec[i].second.first;
+            ln.edgeIds[k]   = vec[i].second.second;
+        }
+    });
+
+    return ln;
+}
+
+/*
+ * Computes in parallel the cotangent weight of each face edge stored in the
+ * LaplacianNeighbors structure, that is the cotangent of the angle opposite to
+ * the edge in its face.
+ */
+template<typename PositionType>
+void cotangentWeights(
+    const LaplacianNeighbors&                       ln,
+    const std::vector<PositionType>&                pos,
+    std::vector<typename PositionType::ScalarType>& weights)
+{
+    using ScalarType = PositionType::ScalarType;
+
+    const uint nEdges  = ln.edges.size();
+    const uint nChunks =
+        (nEdges + SMOOTHING_VERTICES_PER_CHUNK - 1) /
+        SMOOTHING_VERTICES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    weights.resize(nEdges);
+    parallelFor(chunks, [&](uint c) {
+        uint end = std::min(nEdges, (c + 1) * SMOOTHING_VERTICES_PER_CHUNK);
+        for (uint e = c * SMOOTHING_VERTICES_PER_CHUNK; e < end; ++e) {
+            const PositionType& p0 = pos[ln.edges[e][0]];
+            const PositionType& p1 = pos[ln.edges[e][1]];
+            const PositionType& p2 = pos[ln.edges[e][2]];
+
+            ScalarType angle = PositionType(p1 - p2).angle(p0 - p2);
+            weights[e]       = std::tan((M_PI * 0.5) - angle);
+        }
+    });
+}
+
+/*
+ * Computes in parallel, for each vertex i having at least a neighbor, the
+ * (weighted) sum of the positions of its neighbors and the sum of the weights,
+ * and stores in newPos[i] the position returned by f(i, sum, cnt). Positions
+ * are read only from the pos vector, therefore each vertex is computed
+ * independently. Vertices without neighbors keep their position.
+ *
+ * If the weights vector is empty, all the neighbors have weight 1; otherwise
+ * it must contain the cotangent weights of the face edges, that are used for
+ * the vertices that are not on the border.
+ */
+template<typename PositionType, typename F>
+void laplacianGather(
+    const LaplacianNeighbors&                             ln,
+    const std::vector<PositionType>&                      pos,
+    const std::vector<typename PositionType::ScalarType>& weights,
+    std::vector<PositionType>&                            newPos,
+    F&&                                                   f)
+{
+    using ScalarType = PositionType::ScalarType;
+
+    const uint nVertices = pos.size();
+    const uint nChunks   =
+        (nVertices + SMOOTHING_VERTICES_PER_CHUNK - 1) /
+        SMOOTHING_VERTICES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    parallelFor(chunks, [&](uint c) {
+        uint end =
+            std::min(nVertices, (c + 1) * SMOOTHING_VERTICES_PER_CHUNK);
+        for (uint i = c * SMOOTHING_VERTICES_PER_CHUNK; i < end; ++i) {
+            const bool weighted = !weights.empty() && !ln.onBorder[i];
+
+            PositionType sum(0, 0, 0);
+            ScalarType   cnt = 0;
+            if (ln.onBorder[i]) {
+                sum = pos[i];
+                cnt = 1;
             }
+            for (uint k = ln.offsets[i]; k < ln.offsets[i + 1]; ++k) {
+                const PositionType& p = pos[ln.neighbors[k]];
+                if (weighted) {
+                    const ScalarType w = weights[ln.edgeIds[k]];
+                    sum += p * w;
+                    cnt += w;
+                }
+                else {
+                    sum += p;
+                    cnt += 1;
+                }
+            }
+            newPos[i] = cnt > 0 ? f(i, sum, cnt) : pos[i];
         }
-    }
+    });
+}
+
+template<MeshConcept MeshType>
+auto vertexPositions(const MeshType& m)
+{
+    using PositionType = MeshType::VertexType::PositionType;
+
+    std::vector<PositionType> pos(m.vertexContainerSize());
+    for (const auto& v : m.vertices())
+        pos[m.index(v)] = v.position();
+    return pos;
 }
 
 } // namespace detail
@@ -114,6 +268,9 @@ void accumulateLaplacianInfo(
  * @brief Performs the classical Laplacian smoothing. Each
  * vertex is moved onto the average of the adjacent vertices.
  *
+ * The neighbors of the vertices are computed once, and each step computes the
+ * new positions of all the vertices in parallel.
+ *
  * Requirements:
  * - Mesh:
  *   - Vertices
@@ -134,23 +291,50 @@ void laplacianSmoothing(
     using VertexType   = MeshType::VertexType;
     using PositionType = VertexType::PositionType;
 
-    const detail::LaplacianInfo<PositionType> lpz = {PositionType(0, 0, 0), 0};
+    using ScalarType   = PositionType::ScalarType;
+
+    const detail::LaplacianNeighbors ln =
+        detail::laplacianNeighbors(m, cotangentWeight);
+
+    std::vector<PositionType> pos = detail::vertexPositions(m);
+    std::vector<PositionType> newPos(pos.size());
+    std::vector<ScalarType>   weights;
 
     for (uint i = 0; i < step; ++i) {
-        std::vector<detail::LaplacianInfo<PositionType>> laplData(
-            m.vertexContainerSize(), lpz);
-        detail::accumulateLaplacianInfo(m, laplData, cotangentWeight);
-        for (VertexType& v : m.vertices()) {
-            if (laplData[m.index(v)].cnt > 0) {
-                if (!smoothSelected || v.selected()) {
-                    v.position() = (v.position() + laplData[m.index(v)].sum) /
-                                   (laplData[m.index(v)].cnt + 1);
-                }
-            }
-        }
+        if (cotangentWeight)
+            detail::cotangentWeights(ln, pos, weights);
+        detail::laplacianGather(
+            ln, pos, weights, newPos, [&](uint vi, auto sum, auto cnt) {
+                if (!smoothSelected || m.vertex(vi).selected())
+                    return PositionType((pos[vi] + sum) / (cnt + 1));
+                return pos[vi];
+            });
+        pos.swap(newPos);
     }
+
+    for (VertexType& v : m.vertices())
+        v.position() = pos[m.index(v)];
 }
 
+/**
+ * @brief Performs the Taubin smoothing, alternating for each step a
+ * shrinking Laplacian step (with factor `lambda`) and an inflating one (with
+ * factor `mu`).
+ *
+ * The neighbors of the vertices are computed once, and each step computes the
+ * new positions of all the vertices in parallel.
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices
+ *   - Faces
+ *
+ * @param m: the mesh that will be smoothed
+ * @param step
+ * @param lambda
+ * @param mu
+ * @param smoothSelected
+ */
 template<FaceMeshConcept MeshType>
 void taubinSmoothing(
     MeshType& m,
@@ -162,35 +346,33 @@ void taubinSmoothing(
     using VertexType   = MeshType::VertexType;
     using PositionType = VertexType::PositionType;
 
-    const detail::LaplacianInfo<PositionType> lpz = {PositionType(0, 0, 0), 0};
+    using ScalarType   = PositionType::ScalarType;
 
-    for (uint i = 0; i < step; ++i) {
-        std::vector<detail::LaplacianInfo<PositionType>> laplData(
-            m.vertexContainerSize(), lpz);
-        detail::accumulateLaplacianInfo(m, laplData);
-        for (VertexType& v : m.vertices()) {
-            if (laplData[m.index(v)].cnt > 0) {
-                if (!smoothSelected || v.selected()) {
-                    PositionType delta =
-                        laplData[m.index(v)].sum / laplData[m.index(v)].cnt -
-                        v.position();
-                    v.position() = v.position() + delta * lambda;
-                }
-            }
-        }
-        std::fill(laplData.begin(), laplData.end(), lpz);
-        detail::accumulateLaplacianInfo(m, laplData);
-        for (VertexType& v : m.vertices()) {
-            if (laplData[m.index(v)].cnt > 0) {
-                if (!smoothSelected || v.selected()) {
-                    PositionType delta =
-                        laplData[m.index(v)].sum / laplData[m.index(v)].cnt -
-                        v.position();
-                    v.position() = v.position() + delta * mu;
+    const detail::LaplacianNeighbors ln = detail::laplacianNeighbors(m);
+
+    std::vector<PositionType>     pos = detail::vertexPositions(m);
+    std::vector<PositionType>     newPos(pos.size());
+    const std::vector<ScalarType> noWeights;
+
+    auto taubinStep = [&](float factor) {
+        detail::laplacianGather(
+            ln, pos, noWeights, newPos, [&](uint vi, auto sum, auto cnt) {
+                if (!smoothSelected || m.vertex(vi).selected()) {
+                    PositionType delta = sum / cnt - pos[vi];
+                    return PositionType(pos[vi] + delta * factor);
                 }
-            }
-        }
+                return pos[vi];
+            });
+        pos.swap(newPos);
+    };
+
+    for (uint i = 0; i < step; ++i) {
+        taubinStep(lambda);
+        taubinStep(mu);
     }
+
+    for (VertexType& v : m.vertices())
+        v.position() = pos[m.index(v)];
 }
 
 /**
@@ -221,14 +403,29 @@ void smoothPerVertexNormalsPointCloud(
 
     std::vector<NormalType> TD(m.vertexContainerSize(), NormalType(0, 0, 0));
 
-    for (uint ii = 0; ii < iterNum; ++ii) {
-        for (const VertexType& v : m.vertices()) {
-            std::vector<Scalar> distances;
+    // vertex positions do not change: the neighbors of all the vertices are
+    // computed once, with a single bulk query
+    std::vector<PointType> points;
+    std::vector<uint>      vertIds;
+    points.reserve(m.vertexNumber());
+    vertIds.reserve(m.vertexNumber());
+    for (const VertexType& v : m.vertices()) {
+        points.push_back(v.position().template cast<Scalar>());
+        vertIds.push_back(m.index(v));
+    }
 
-            std::vector<uint> neighbors = tree.kNearestNeighborsIndices(
-                v.position(), neighborNum, distances);
+    std::vector<uint>   offsets;
+    std::vector<uint>   neighbors;
+    std::vector<Scalar> distances;
+    tree.kNearestNeighborsIndices(
+        points, neighborNum, offsets, neighbors, distances);
+
+    for (uint ii = 0; ii < iterNum; ++ii) {
+        for (uint i = 0; i < vertIds.size(); ++i) {
+            const VertexType& v = m.vertex(vertIds[i]);
 
-            for (uint nid : neighbors) {
+            for (uint j = offsets[i]; j < offsets[i + 1]; ++j) {
+                uint nid = neighbors[j];
                 if (m.vertex(nid).normal() * v.normal() > 0) {
                     TD[m.index(v)] += m.vertex(nid).normal();
                 }
@@ -24,12 +24,166 @@
 #define VCL_ALGORITHMS_MESH_SORT_H
 
 #include <vclib/misc/parallel.h>
+#include <vclib/misc/radix_sort.h>
 #include <vclib/space/complex/mesh_edge_util.h>
 
 #include <algorithm>
+#include <numeric>
 
 namespace vcl {
 
+namespace detail {
+
+/**
+ * @brief Fills in parallel a vector of [key, value] pairs computed from the
+ * faces of the mesh.
+ *
+ * For each (non-deleted) face f, `countFun(f)` must return the number of
+ * pairs generated by the face, and `fillFun(f, out)` must write exactly that
+ * number of pairs starting from the `out` pointer. Pairs are stored following
+ * the order of the faces in the container.
+ */
+template<FaceMeshConcept MeshType, typename T, typename CountF, typename FillF>
+std::vector<std::pair<uint64_t, T>> fillPerFaceKeyVector(
+    const MeshType& m,
+    CountF&&        countFun,
+    FillF&&         fillFun)
+{
+    const uint nFaces  = m.faceContainerSize();
+    const uint nChunks =
+        (nFaces + SORT_VALUES_PER_CHUNK - 1) / SORT_VALUES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    // number of pairs generated by each chunk of faces
+    std::vector<std::size_t> offsets(nChunks + 1, 0);
+    parallelFor(chunks, [&](uint c) {
+        uint end = std::min(nFaces, (c + 1) * SORT_VALUES_PER_CHUNK);
+        for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+            if (!m.face(i).deleted())
+                offsets[c + 1] += countFun(m.face(i));
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::pair<uint64_t, T>> vec(offsets[nChunks]);
+    parallelFor(chunks, [&](uint c) {
+        std::pair<uint64_t, T>* out = vec.data() + offsets[c];
+
+        uint end = std::min(nFaces, (c + 1) * SORT_VALUES_PER_CHUNK);
+        for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+            if (!m.face(i).deleted()) {
+                fillFun(m.face(i), out);
+                out += countFun(m.face(i));
+            }
+        }
+    });
+
+    return vec;
+}
+
+/**
+ * @brief Calls, in parallel, the function f(begin, end) on each cluster
+ * [begin, end) of consecutive entries of the sorted vector having the same
+ * clusterKey(entry.first).
+ *
+ * The vector is split in chunks, and each cluster is processed by the task of
+ * the chunk in which the cluster begins: clusters can therefore be modified
+ * concurrently without synchronization.
+ */
+template<typename T, typename KeyF, typename F>
+void parallelForEachCluster(
+    const std::vector<std::pair<uint64_t, T>>& vec,
+    KeyF&&                                     clusterKey,
+    F&&                                        f)
+{
+    const std::size_t n       = vec.size();
+    const uint        nChunks =
+        (n + SORT_VALUES_PER_CHUNK - 1) / SORT_VALUES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    parallelFor(chunks, [&](uint c) {
+        std::size_t b   = std::size_t(c) * SORT_VALUES_PER_CHUNK;
+        std::size_t end = std::min(n, b + SORT_VALUES_PER_CHUNK);
+
+        // skip the tail of the cluster begun in the previous chunk
+        while (b < end && b > 0 &&
+               clusterKey(vec[b].first) == clusterKey(vec[b - 1].first))
+            ++b;
+
+        while (b < end) {
+            std::size_t e = b + 1;
+            while (e < n &&
+                   clusterKey(vec[e].first) == clusterKey(vec[b].first))
+                ++e;
+            f(b, e);
+            b = e;
+        }
+    });
+}
+
+} // namespace detail
+
+/**
+ * @brief Fills and sorts in parallel a vector containing an entry for each
+ * edge of each face of the mesh.
+ *
+ * Each entry is a pair, where the first element is the key of the edge,
+ * obtained by packing in a 64 bit integer the indices of its two vertices
+ * (the smaller index in the higher bits), and the second element is a pair
+ * containing the index of the face and the index of the edge in the face.
+ *
+ * The vector is sorted by key using a parallel radix sort: entries of the
+ * same edge are contiguous, and ordered by face index. In case of non-manifold
+ * edges, clusters of entries having the same key may have size > 2.
+ *
+ * @param[in] m: the input mesh.
+ * @param[in] includeFauxEdges: if false, faux edges are not inserted in the
+ * vector.
+ * @return the sorted vector of [edge key, [face index, edge index]] entries.
+ */
+template<FaceMeshConcept MeshType>
+std::vector<std::pair<uint64_t, std::pair<uint, uint>>>
+fillAndSortEdgeKeyVector(const MeshType& m, bool includeFauxEdges = true)
+{
+    using FaceType = MeshType::FaceType;
+    using Entry    = std::pair<uint64_t, std::pair<uint, uint>>;
+
+    const uint bits = indexBitWidth(m.vertexContainerSize());
+
+    auto count = [&](const FaceType& f) {
+        if (includeFauxEdges)
+            return f.vertexNumber();
+        uint n = 0;
+        for (uint j = 0; j < f.vertexNumber(); ++j)
+            n += !f.edgeFaux(j);
+        return n;
+    };
+
+    auto fill = [&](const FaceType& f, Entry* out) {
+        const uint fi = m.index(f);
+        for (uint j = 0; j < f.vertexNumber(); ++j) {
+            if (includeFauxEdges || !f.edgeFaux(j)) {
+                uint64_t v0 = f.vertexIndex(j);
+                uint64_t v1 = f.vertexIndexMod(j + 1);
+                assert(v0 != v1);
+                if (v0 > v1)
+                    std::swap(v0, v1);
+                *out++ = Entry((v0 << bits) | v1, {fi, j});
+            }
+        }
+    };
+
+    std::vector<Entry> vec =
+        detail::fillPerFaceKeyVector<MeshType, std::pair<uint, uint>>(
+            m, count, fill);
+
+    radixSortByKey(vec, 2 * bits);
+
+    return vec;
+}
+
 template<FaceMeshConcept MeshType>
 std::vector<MeshEdgeUtil<MeshType>> fillAndSortMeshEdgeUtilVector(
     MeshType& m,
@@ -47,6 +47,21 @@ auto boundingBox(const MeshType& m)
     using VertexType = MeshType::VertexType;
     Box<typename VertexType::PositionType> b;
 
+    // if the positions are stored vertically and there are no deleted
+    // vertices, scan the contiguous array of the positions
+    if constexpr (comp::HasVerticalComponentOfType<
+                      VertexType,
+                      CompId::POSITION>) {
+        if (m.deletedVertexNumber() == 0) {
+            for (const auto& p : m.template verticalComponentData<
+                                     ElemId::VERTEX,
+                                     CompId::POSITION>()) {
+                b.add(p);
+            }
+            return b;
+        }
+    }
+
     for (const VertexType& v : m.vertices()) {
         b.add(v.position());
     }
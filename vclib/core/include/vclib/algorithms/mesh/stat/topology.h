@@ -25,12 +25,14 @@
 
 #include <vclib/concepts/mesh.h>
 #include <vclib/mesh/requirements.h>
+#include <vclib/misc/parallel.h>
+#include <vclib/space/complex/connected_components.h>
 #include <vclib/space/complex/mesh_edge_util.h>
 #include <vclib/space/complex/mesh_pos.h>
+#include <vclib/space/complex/union_find.h>
 
 #include <map>
 #include <set>
-#include <stack>
 
 namespace vcl {
 
@@ -161,6 +163,29 @@ uint numberEdges(
     return numEdges;
 }
 
+/*
+ * Given the representative of the component of each face (UINT_NULL for
+ * deleted faces), that is an index in [0, nRepresentatives), returns the
+ * ConnectedComponents numbered in the order of the first face of each
+ * component.
+ */
+inline ConnectedComponents numberedConnectedComponents(
+    std::vector<uint>& representatives,
+    uint               nRepresentatives)
+{
+    std::vector<uint> compOfRep(nRepresentatives, UINT_NULL);
+
+    uint nComps = 0;
+    for (uint& r : representatives) {
+        if (r != UINT_NULL) {
+            if (compOfRep[r] == UINT_NULL)
+                compOfRep[r] = nComps++;
+            r = compOfRep[r];
+        }
+    }
+    return ConnectedComponents(std::move(representatives));
+}
+
 inline std::list<uint>                             dummyUintList;
 inline std::list<std::list<std::pair<uint, uint>>> dummyListOfLists;
 inline std::vector<std::pair<uint, uint>>          dummyVectorOfPairs;
@@ -572,6 +597,98 @@ uint numberHoles(const MeshType& m) requires HasPerFaceAdjacentFaces<MeshType>
     return loopNum;
 }
 
+/**
+ * @brief Computes the connected components of the faces of the input mesh,
+ * where two faces are connected if they are adjacent (i.e. they share an
+ * edge).
+ *
+ * The components are computed with a lock-free concurrent union-find over the
+ * face-face adjacency relation, in parallel over the faces of the mesh. The
+ * result stores, for each face (indexed by its index in the face container),
+ * the label of its component, and the list of faces of each component;
+ * deleted faces do not belong to any component. Components are numbered in
+ * the order of their first face.
+ *
+ * @tparam MeshType: The type of the input Mesh. It must satisfy the
+ * FaceMeshConcept and have per-face adjacent faces.
+ *
+ * @param[in] m: The input mesh for which to compute the connected components.
+ * @return The connected components of the faces of the input mesh.
+ *
+ * @ingroup mesh_stat
+ * @ingroup clean
+ */
+template<FaceMeshConcept MeshType>
+ConnectedComponents faceConnectedComponents(const MeshType& m)
+    requires HasPerFaceAdjacentFaces<MeshType>
+{
+    requirePerFaceAdjacentFaces(m);
+
+    using FaceType = MeshType::FaceType;
+
+    ConcurrentUnionFind uf(m.faceContainerSize());
+
+    parallelFor(m.faces(), [&](const FaceType& f) {
+        for (uint fi : f.adjFaceIndices()) {
+            if (fi != UINT_NULL)
+                uf.unite(m.index(f), fi);
+        }
+    });
+
+    // the root of each set is its first face
+    std::vector<uint> reps(m.faceContainerSize(), UINT_NULL);
+    parallelFor(m.faces(), [&](const FaceType& f) {
+        reps[m.index(f)] = uf.find(m.index(f));
+    });
+
+    return detail::numberedConnectedComponents(reps, reps.size());
+}
+
+/**
+ * @brief Computes the connected components of the faces of the input mesh,
+ * where two faces are connected if they share a vertex.
+ *
+ * Unlike vcl::faceConnectedComponents, this function does not require the
+ * per-face adjacent faces: the components are computed with a lock-free
+ * concurrent union-find over the vertices of the mesh, merging the vertices
+ * of each face in parallel over the faces. Note that faces that touch only
+ * at a vertex belong to the same component.
+ *
+ * The result stores, for each face (indexed by its index in the face
+ * container), the label of its component, and the list of faces of each
+ * component; deleted faces do not belong to any component. Components are
+ * numbered in the order of their first face.
+ *
+ * @tparam MeshType: The type of the input Mesh. It must satisfy the
+ * FaceMeshConcept.
+ *
+ * @param[in] m: The input mesh for which to compute the connected components.
+ * @return The connected components of the faces of the input mesh.
+ *
+ * @ingroup mesh_stat
+ * @ingroup clean
+ */
+template<FaceMeshConcept MeshType>
+ConnectedComponents faceConnectedComponentsByVertices(const MeshType& m)
+{
+    using FaceType = MeshType::FaceType;
+
+    ConcurrentUnionFind uf(m.vertexContainerSize());
+
+    parallelFor(m.faces(), [&](const FaceType& f) {
+        for (uint i = 1; i < f.vertexNumber(); ++i)
+            uf.unite(f.vertexIndex(0), f.vertexIndex(i));
+    });
+
+    // the representative of each face is the root of its vertices
+    std::vector<uint> reps(m.faceContainerSize(), UINT_NULL);
+    parallelFor(m.faces(), [&](const FaceType& f) {
+        reps[m.index(f)] = uf.find(f.vertexIndex(0));
+    });
+
+    return detail::numberedConnectedComponents(reps, uf.size());
+}
+
 /**
  * @brief Computes the connected components of the input mesh based on its
  * topology.
@@ -579,8 +696,9 @@ uint numberHoles(const MeshType& m) requires HasPerFaceAdjacentFaces<MeshType>
  * This function computes the connected components of the input mesh based on
  * its topology, and returns a vector of sets, where each set represents a
  * connected component and contains the face indices of the mesh that compose
- * it. The function uses a depth-first search algorithm to traverse the mesh and
- * find the connected components. The function requires the input MeshType to
+ * it. The components are computed by vcl::faceConnectedComponents, that
+ * should be preferred when the sets are not needed, since it returns the
+ * components in a flat layout. The function requires the input MeshType to
  * have per-face adjacent faces, and uses the `vcl::requirePerFaceAdjacentFaces`
  * function to enforce this requirement.
  *
@@ -599,50 +717,13 @@ template<FaceMeshConcept MeshType>
 std::vector<std::set<uint>> connectedComponents(const MeshType& m)
     requires HasPerFaceAdjacentFaces<MeshType>
 {
-    requirePerFaceAdjacentFaces(m);
-
-    using FaceType = MeshType::FaceType;
-
-    std::vector<std::set<uint>> cc;
-
-           // create a vector of bools to keep track of visited faces.
-    std::vector<bool> visitedFaces(m.faceContainerSize(), false);
+    ConnectedComponents comps = faceConnectedComponents(m);
 
-           // create a stack to hold the faces that need to be visited during the
-           // depth-first search.
-    std::stack<const FaceType*> sf;
-
-           // traverse the mesh using a depth-first search algorithm to find the
-           // connected components.
-    for (const FaceType& f : m.faces()) {
-        if (!visitedFaces[m.index(f)]) { // first time I see this face
-            visitedFaces[m.index(f)] = true;
-
-                   // new connected component
-            cc.emplace_back();
-            std::set<uint>& ccf = cc[cc.size() - 1];
-            ccf.insert(m.index(f));
-
-                   // while the stack is empty, visit the adjacent faces of the top
-                   // face of the stack
-            sf.push(&f);
-            while (!sf.empty()) {
-                const FaceType* fpt = sf.top();
-                // remove the top face and add it to the connected component
-                sf.pop();
-                ccf.insert(m.index(fpt));
-
-                       // add the adjacent faces of the current visited in the stack
-                for (uint j = 0; j < fpt->vertexNumber(); ++j) {
-                    const FaceType* adjf = fpt->adjFace(j);
-                    // if there is an adj face and it has not been visited
-                    if (adjf != nullptr && !visitedFaces[m.index(adjf)]) {
-                        sf.push(adjf);
-                        visitedFaces[m.index(adjf)] = true;
-                    }
-                }
-            }
-        }
+    std::vector<std::set<uint>> cc(comps.componentNumber());
+    for (uint i = 0; i < cc.size(); ++i) {
+        // the faces of each component are sorted
+        for (uint fi : comps.elements(i))
+            cc[i].insert(cc[i].end(), fi);
     }
     return cc;
 }
@@ -653,8 +734,8 @@ std::vector<std::set<uint>> connectedComponents(const MeshType& m)
  *
  * This function computes the number of connected components of the input mesh
  * based on its topology, and returns the result as an unsigned integer. The
- * function simply calls the `connectedComponents` function to compute the
- * connected components and then returns the size of the resulting vector.
+ * function simply calls the `faceConnectedComponents` function to compute the
+ * connected components and then returns their number.
  *
  * @tparam MeshType The type of the input Mesh. It must satisfy the
  * FaceMeshConcept and have per-face adjacent faces.
@@ -669,7 +750,7 @@ std::vector<std::set<uint>> connectedComponents(const MeshType& m)
 template<FaceMeshConcept MeshType>
 uint numberConnectedComponents(const MeshType& m)
 {
-    return connectedComponents(m).size();
+    return faceConnectedComponents(m).componentNumber();
 }
 
 } // namespace vcl
@@ -433,9 +433,9 @@ void setPerVertexColorFromFaceBorderFlag(
 
 /**
  * @brief Given an already computed vector of sets of connected components (see
- * vcl::connectedComponents(m) in `vclib/algorithms/clean.h`), sets face colors
- * according from connected components of the mesh. Each connected component
- * will have a different per face color.
+ * vcl::connectedComponents(m) in `vclib/algorithms/mesh/stat.h`), sets face
+ * colors according from connected components of the mesh. Each connected
+ * component will have a different per face color.
  *
  * Requirements:
  * - Mesh:
@@ -465,6 +465,43 @@ void setPerFaceColorFromConnectedComponents(
     }
 }
 
+/**
+ * @brief Given already computed connected components of the faces of the mesh
+ * (see vcl::faceConnectedComponents(m) in `vclib/algorithms/mesh/stat.h`),
+ * sets face colors according from them. Each connected component will have a
+ * different per face color.
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Faces:
+ *     - Color
+ *
+ * @param[in,out] m: the mesh on which set the face colors according to its
+ * connected components.
+ * @param[in] connectedComponents: the connected components of the faces of the
+ * mesh, labeled by face index.
+ *
+ * @ingroup update
+ */
+template<FaceMeshConcept MeshType>
+void setPerFaceColorFromConnectedComponents(
+    MeshType&                  m,
+    const ConnectedComponents& connectedComponents)
+{
+    using FaceType = MeshType::FaceType;
+
+    assert(connectedComponents.elementNumber() == m.faceContainerSize());
+
+    std::vector<Color> vc =
+        colorScattering(connectedComponents.componentNumber());
+
+    parallelFor(m.faces(), [&](FaceType& f) {
+        uint cid = connectedComponents.component(m.index(f));
+        if (cid != UINT_NULL)
+            f.color() = vc[cid];
+    });
+}
+
 /**
  * @brief Sets face colors according from connected components of the mesh. Each
  * connected component will have a different per face color. Since this function
@@ -487,9 +524,7 @@ void setPerFaceColorFromConnectedComponents(MeshType& m)
 {
     requirePerFaceColor(m);
 
-    std::vector<std::set<uint>> connComps = connectedComponents(m);
-
-    setPerFaceColorFromConnectedComponents(m, connComps);
+    setPerFaceColorFromConnectedComponents(m, faceConnectedComponents(m));
 }
 
 /**
@@ -25,7 +25,6 @@
 
 #include <vclib/algorithms/core/polygon.h>
 #include <vclib/algorithms/core/stat.h>
-#include <vclib/algorithms/mesh/intersection.h>
 #include <vclib/algorithms/mesh/point_sampling.h>
 #include <vclib/algorithms/mesh/stat.h>
 #include <vclib/algorithms/mesh/update/normal.h>
@@ -33,12 +32,17 @@
 #include <vclib/mesh/requirements.h>
 #include <vclib/misc/logger.h>
 #include <vclib/misc/parallel.h>
+#include <vclib/space/complex/bvh.h>
+#include <vclib/space/complex/face_triangulation.h>
 #include <vclib/space/complex/grid.h>
 #include <vclib/space/complex/mesh_pos.h>
 #include <vclib/space/core/principal_curvature.h>
 #include <vclib/views/pointers.h>
 
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <span>
 
 namespace vcl {
 
@@ -47,202 +51,612 @@ typedef enum {
     VCL_PRINCIPAL_CURVATURE_PCA
 } VCLibPrincipalCurvatureAlgorithm;
 
-template<FaceMeshConcept MeshType, LoggerConcept LogType = NullLogger>
-void updatePrincipalCurvatureTaubin95(MeshType& m, LogType& log = nullLogger)
+namespace detail {
+
+// number of elements (vertices or faces) processed by each task of the
+// parallel curvature computations
+inline constexpr uint CURVATURE_ELEMENTS_PER_CHUNK = 1024;
+
+/*
+ * Calls f(begin, end) in parallel for each chunk of
+ * CURVATURE_ELEMENTS_PER_CHUNK indices in [0, n). Scratch buffers declared
+ * in f are shared by all the elements of a chunk.
+ */
+template<typename F>
+void forEachCurvatureChunk(uint n, F&& f)
 {
-    requirePerVertexPrincipalCurvature(m);
-    requirePerVertexAdjacentFaces(m);
-    requirePerFaceAdjacentFaces(m);
+    std::vector<uint> chunks(
+        (n + CURVATURE_ELEMENTS_PER_CHUNK - 1) / CURVATURE_ELEMENTS_PER_CHUNK);
+    std::iota(chunks.begin(), chunks.end(), 0);
 
-    using VertexType   = MeshType::VertexType;
-    using PositionType = VertexType::PositionType;
-    using NormalType   = VertexType::NormalType;
-    using ScalarType   = PositionType::ScalarType;
-    using FaceType     = MeshType::FaceType;
+    parallelFor(chunks, [&](uint c) {
+        const uint begin = c * CURVATURE_ELEMENTS_PER_CHUNK;
+        f(begin, std::min(n, begin + CURVATURE_ELEMENTS_PER_CHUNK));
+    });
+}
 
-    // Auxiliary data structure
-    struct AdjVertex
+/*
+ * Area, first moment int{x} and second moment int{x x^T} of a surface,
+ * accumulated triangle by triangle. Points should be expressed relative to an
+ * origin close to the surface, to limit the cancellation in covariance().
+ */
+struct SurfaceMoments
+{
+    double           area = 0;
+    Point3d          first;
+    Matrix33d second = Matrix33d::Zero();
+
+    // the covariance matrix int{(x-b)(x-b)^T}, where b is the barycenter
+    Matrix33d covariance() const
     {
-        const VertexType* vert;
-        double            doubleArea;
-        bool              isBorder;
-    };
+        if (area <= 0)
+            return Matrix33d::Zero();
+        return second - first.outerProduct(first) / area;
+    }
 
-    log.log(0, "Updating per vertex normals...");
+    void addTriangle(const Point3d& p0, const Point3d& p1, const Point3d& p2)
+    {
+        const double  a = (p1 - p0).cross(p2 - p0).norm() / 2;
+        const Point3d s = p0 + p1 + p2;
+
+        area += a;
+        first += s * (a / 3);
+        second += (p0.outerProduct(p0) + p1.outerProduct(p1) +
+                   p2.outerProduct(p2) + s.outerProduct(s)) *
+                  (a / 12);
+    }
 
-    updatePerVertexNormalsAngleWeighted(m);
-    normalizePerVertexNormals(m);
+    /*
+     * Adds the part of the triangle p0 p1 p2 that lies inside the sphere
+     * having the given radius and centered in the origin.
+     *
+     * The plane of the triangle cuts the sphere in a disk: the moments of the
+     * intersection between the triangle and the disk are computed exactly in
+     * the plane, as the signed sum over the edges (a, b) of the moments of
+     * the triangle (c, a, b) clipped by the disk (c is the center of the
+     * disk), that is made of triangles and circular sectors.
+     */
+    void addTriangleInSphere(
+        const Point3d& p0,
+        const Point3d& p1,
+        const Point3d& p2,
+        double         radius)
+    {
+        const double sqRadius = radius * radius;
+        if (p0.squaredNorm() <= sqRadius && p1.squaredNorm() <= sqRadius &&
+            p2.squaredNorm() <= sqRadius) {
+            addTriangle(p0, p1, p2);
+            return;
+        }
 
-    log.log(5, "Computing per vertex curvature...");
-    // log every 5%, starting from 5% to 100%
-    log.startProgress("", m.vertexNumber(), 5, 5, 100);
-
-    for (VertexType& v : m.vertices()) {
-        std::vector<ScalarType> weights;
-        std::vector<AdjVertex>  vertices;
-
-        MeshPos<FaceType> pos(v.adjFace(0), &v);
-        const VertexType* firstVertex = pos.adjVertex();
-        const VertexType* tmpVertex;
-        float             totalDoubleAreaSize = 0;
-
-        // compute the area of each triangle around the central vertex as well
-        // as their total area
-        do {
-            pos.nextEdgeAdjacentToV();
-            tmpVertex = pos.adjVertex();
-            AdjVertex adjV;
-            adjV.isBorder   = pos.isEdgeOnBorder();
-            adjV.vert       = tmpVertex;
-            adjV.doubleArea = faceArea(*pos.face()) * 2;
-            totalDoubleAreaSize += adjV.doubleArea;
-            vertices.push_back(adjV);
-        } while (tmpVertex != firstVertex);
-
-        weights.reserve(vertices.size());
-
-        for (int i = 0; i < vertices.size(); ++i) {
-            if (vertices[i].isBorder) {
-                weights.push_back(vertices[i].doubleArea / totalDoubleAreaSize);
+        Point3d      n       = (p1 - p0).cross(p2 - p0);
+        const double dblArea = n.norm();
+        if (dblArea <= 0)
+            return;
+        n /= dblArea;
+
+        const double d      = n.dot(p0);
+        const double sqDisk = sqRadius - d * d;
+        if (sqDisk <= 0)
+            return;
+
+        // frame of the plane in which the triangle is counterclockwise
+        const Point3d c = n * d;
+        const Point3d u = (p1 - p0).normalized();
+        const Point3d w = n.cross(u);
+
+        auto planar = [&](const Point3d& p) {
+            return Point2d((p - c).dot(u), (p - c).dot(w));
+        };
+        const std::array<Point2d, 3> q = {planar(p0), planar(p1), planar(p2)};
+
+        // moments in the plane, relative to c
+        double           a2 = 0;
+        Point2d          f2;
+        Matrix<double, 2, 2> s2 = Matrix<double, 2, 2>::Zero();
+
+        auto cross = [](const Point2d& a, const Point2d& b) {
+            return a.x() * b.y() - a.y() * b.x();
+        };
+        auto addTriangle2 = [&](const Point2d& a, const Point2d& b) {
+            const double  at = cross(a, b) / 2;
+            const Point2d sm = a + b;
+            a2 += at;
+            f2 += sm * (at / 3);
+            s2 += (a.outerProduct(a) + b.outerProduct(b) + sm.outerProduct(sm)) *
+                  (at / 12);
+        };
+        auto addSector = [&](const Point2d& a, const Point2d& b) {
+            const double t  = std::atan2(cross(a, b), a.dot(b));
+            const double t0 = std::atan2(a.y(), a.x());
+            const double t1 = t0 + t;
+            const double r3 = sqDisk * std::sqrt(sqDisk) / 3;
+            const double r4 = sqDisk * sqDisk / 4;
+            const double dSin2 = (std::sin(2 * t1) - std::sin(2 * t0)) / 4;
+            const double xy =
+                (std::pow(std::sin(t1), 2) - std::pow(std::sin(t0), 2)) / 2;
+
+            a2 += sqDisk * t / 2;
+            f2 += Point2d(
+                r3 * (std::sin(t1) - std::sin(t0)),
+                r3 * (std::cos(t0) - std::cos(t1)));
+            s2(0, 0) += r4 * (t / 2 + dSin2);
+            s2(1, 1) += r4 * (t / 2 - dSin2);
+            s2(0, 1) += r4 * xy;
+            s2(1, 0) += r4 * xy;
+        };
+
+        for (uint i = 0; i < 3; ++i) {
+            const Point2d& a  = q[i];
+            const Point2d& b  = q[(i + 1) % 3];
+            const Point2d  ab = b - a;
+
+            // intersections a + t * ab of the edge with the circle
+            const double aa   = ab.squaredNorm();
+            const double bb   = a.dot(ab);
+            const double disc = bb * bb - aa * (a.squaredNorm() - sqDisk);
+            if (aa <= 0)
+                continue;
+            if (disc <= 0) {
+                addSector(a, b);
+                continue;
             }
-            else {
-                weights.push_back(
-                    0.5f *
-                    (vertices[i].doubleArea +
-                     vertices[(i - 1) % vertices.size()].doubleArea) /
-                    totalDoubleAreaSize);
+            const double t0 = std::max(0.0, (-bb - std::sqrt(disc)) / aa);
+            const double t1 = std::min(1.0, (-bb + std::sqrt(disc)) / aa);
+            if (t0 >= t1) {
+                addSector(a, b);
+                continue;
             }
-            assert(weights.back() < 1.0f);
+            const Point2d i0 = a + ab * t0;
+            const Point2d i1 = a + ab * t1;
+            if (t0 > 0)
+                addSector(a, i0);
+            addTriangle2(i0, i1);
+            if (t1 < 1)
+                addSector(i1, b);
         }
 
-        // compute I-NN^t to be used for computing the T_i's
-        Matrix33<ScalarType> Tp;
-
-        NormalType n = v.normal();
-        for (int i = 0; i < 3; ++i)
-            Tp(i, i) = 1.0f - std::pow(n[i], 2);
-        Tp(0, 1) = Tp(1, 0) = -1.0f * (n[0] * n[1]);
-        Tp(1, 2) = Tp(2, 1) = -1.0f * (n[1] * n[2]);
-        Tp(0, 2) = Tp(2, 0) = -1.0f * (n[0] * n[2]);
-
-        // for all neighbors vi compute the directional curvatures k_i and the
-        // T_i compute M by summing all w_i k_i T_i T_i^t
-        Matrix33<ScalarType> tempMatrix;
-        Matrix33<ScalarType> M = Matrix33<ScalarType>::Zero();
-        for (size_t i = 0; i < vertices.size(); ++i) {
-            PositionType edge = (v.position() - vertices[i].vert->position());
-            float        curvature =
-                (2.0f * (v.normal().dot(edge))) / edge.squaredNorm();
-            PositionType t = Tp * edge;
-            t.normalize();
-            tempMatrix = t.outerProduct(t);
-            M += tempMatrix * weights[i] * curvature;
+        // back to 3D: x = c + u * y(0) + w * y(1)
+        const Point3d  g  = u * f2.x() + w * f2.y();
+        const Matrix33d uw = u.outerProduct(w);
+
+        area += a2;
+        first += c * a2 + g;
+        second += c.outerProduct(c) * a2 + c.outerProduct(g) +
+                  g.outerProduct(c) + u.outerProduct(u) * s2(0, 0) +
+                  (uw + uw.transpose()) * s2(0, 1) +
+                  w.outerProduct(w) * s2(1, 1);
+    }
+};
+
+/*
+ * Sets the principal curvature of the vertex v from the covariance matrix A of
+ * its neighborhood of the given radius, as described in: Robust principal
+ * curvatures on Multiple Scales, Yang et al.
+ */
+template<typename VertexType, typename ScalarType>
+void setPrincipalCurvatureFromCovariance(
+    VertexType&                 v,
+    const Matrix33<ScalarType>& A,
+    ScalarType                  radius)
+{
+    using PositionType = VertexType::PositionType;
+
+    Matrix33<ScalarType> eigenvectors;
+    PositionType         eigenvalues;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<ScalarType, 3, 3>> eig(A);
+    eigenvalues  = PositionType(eig.eigenvalues());
+    eigenvectors = eig.eigenvectors(); // eigenvector are stored as columns.
+    // get the estimate of curvatures from eigenvalues and eigenvectors
+    // find the 2 most tangent eigenvectors (by finding the one closest to
+    // the normal)
+    uint       best  = 0;
+    ScalarType bestv = std::abs(
+        v.normal().dot(PositionType(eigenvectors.col(0).normalized())));
+    for (uint i = 1; i < 3; ++i) {
+        ScalarType prod = std::abs(
+            v.normal().dot(PositionType(eigenvectors.col(i).normalized())));
+        if (prod > bestv) {
+            bestv = prod;
+            best  = i;
         }
+    }
+    v.principalCurvature().maxDir() =
+        (eigenvectors.col((best + 1) % 3).normalized());
+    v.principalCurvature().minDir() =
+        (eigenvectors.col((best + 2) % 3).normalized());
+
+    Matrix33<ScalarType> rot;
+    ScalarType           angle;
+    angle = acos(v.principalCurvature().maxDir().dot(v.normal()));
+
+    rot = rotationMatrix<Matrix33<ScalarType>>(
+        PositionType(v.principalCurvature().maxDir().cross(v.normal())),
+        -(M_PI * 0.5 - angle));
+
+    v.principalCurvature().maxDir() = rot * v.principalCurvature().maxDir();
+
+    angle = acos(v.principalCurvature().minDir().dot(v.normal()));
+
+    rot = rotationMatrix<Matrix33<ScalarType>>(
+        PositionType(v.principalCurvature().minDir().cross(v.normal())),
+        -(M_PI * 0.5 - angle));
+
+    v.principalCurvature().minDir() = rot * v.principalCurvature().minDir();
+
+    // computes the curvature values
+    const ScalarType r5 = std::pow(radius, 5);
+    const ScalarType r6 = r5 * radius;
+    v.principalCurvature().maxValue() =
+        (2.0 / 5.0) *
+        (4.0 * M_PI * r5 + 15 * eigenvalues[(best + 2) % 3] -
+         45.0 * eigenvalues[(best + 1) % 3]) /
+        (M_PI * r6);
+    v.principalCurvature().minValue() =
+        (2.0 / 5.0) *
+        (4.0 * M_PI * r5 + 15 * eigenvalues[(best + 1) % 3] -
+         45.0 * eigenvalues[(best + 2) % 3]) /
+        (M_PI * r6);
+    if (v.principalCurvature().maxValue() <
+        v.principalCurvature().minValue()) {
+        std::swap(
+            v.principalCurvature().minValue(),
+            v.principalCurvature().maxValue());
+        std::swap(
+            v.principalCurvature().minDir(), v.principalCurvature().maxDir());
+    }
+}
 
-        // compute vector W for the Householder matrix
-        PositionType w;
-        PositionType e1(1.0f, 0.0f, 0.0f);
-        if ((e1 - v.normal()).squaredNorm() > (e1 + v.normal()).squaredNorm())
-            w = e1 - v.normal();
-        else
-            w = e1 + v.normal();
-        w.normalize();
-
-        // compute the Householder matrix I - 2WW^t
-        Matrix33<ScalarType> Q = Matrix33<ScalarType>::Identity();
-        tempMatrix             = w.outerProduct(w);
-        Q -= tempMatrix * 2.0f;
-
-        // compute matrix Q^t M Q
-        Matrix33<ScalarType> QtMQ = (Q.transpose() * M * Q);
-
-        Eigen::Matrix<ScalarType, 1, 3> T1 = Q.col(1);
-        Eigen::Matrix<ScalarType, 1, 3> T2 = Q.col(2);
-
-        // find sin and cos for the Givens rotation
-        ScalarType s, c;
-        // Gabriel Taubin hint and Valentino Fiorin impementation
-        ScalarType alpha = QtMQ(1, 1) - QtMQ(2, 2);
-        ScalarType beta  = QtMQ(2, 1);
-
-        ScalarType h[2];
-        ScalarType delta =
-            std::sqrt(4.0f * std::pow(alpha, 2) + 16.0f * std::pow(beta, 2));
-        h[0] = (2.0f * alpha + delta) / (2.0f * beta);
-        h[1] = (2.0f * alpha - delta) / (2.0f * beta);
-
-        ScalarType t[2];
-        ScalarType bestC, bestS;
-        ScalarType minError = std::numeric_limits<ScalarType>::infinity();
-        for (uint i = 0; i < 2; i++) {
-            delta = std::sqrt(std::pow(h[i], 2) + 4.0f);
-            t[0]  = (h[i] + delta) / 2.0f;
-            t[1]  = (h[i] - delta) / 2.0f;
-
-            for (uint j = 0; j < 2; j++) {
-                ScalarType squaredT    = std::pow(t[j], 2);
-                ScalarType denominator = 1.0f + squaredT;
-
-                s = (2.0f * t[j]) / denominator;
-                c = (1 - squaredT) / denominator;
-
-                ScalarType approximation =
-                    c * s * alpha + (std::pow(c, 2) - std::pow(s, 2)) * beta;
-                ScalarType angleSimilarity =
-                    std::abs(std::acos(c) / std::asin(s));
-                ScalarType error =
-                    std::abs(1.0f - angleSimilarity) + std::abs(approximation);
-                if (error < minError) {
-                    minError = error;
-                    bestC    = c;
-                    bestS    = s;
-                }
+template<typename VertexType>
+struct Taubin95AdjVertex
+{
+    const VertexType* vert;
+    double            doubleArea;
+    bool              isBorder;
+};
+
+/*
+ * Computes the principal curvature of the vertex v with the Taubin95
+ * algorithm, given the function that returns the double area of a face. The
+ * ring vector is a scratch buffer that is cleared and filled with the
+ * adjacent vertices of v: reusing it for several vertices avoids allocations.
+ */
+template<typename FaceType, typename VertexType, typename DoubleAreaF>
+void taubin95Curvature(
+    VertexType&                                 v,
+    DoubleAreaF&&                               doubleArea,
+    std::vector<Taubin95AdjVertex<VertexType>>& ring)
+{
+    using PositionType = VertexType::PositionType;
+    using NormalType   = VertexType::NormalType;
+    using ScalarType   = PositionType::ScalarType;
+
+    ring.clear();
+
+    MeshPos<FaceType> pos(v.adjFace(0), &v);
+    const VertexType* firstVertex = pos.adjVertex();
+    const VertexType* tmpVertex;
+    ScalarType        totalDoubleAreaSize = 0;
+
+    // compute the area of each triangle around the central vertex as well
+    // as their total area
+    do {
+        pos.nextEdgeAdjacentToV();
+        tmpVertex = pos.adjVertex();
+        Taubin95AdjVertex<VertexType> adjV;
+        adjV.isBorder   = pos.isEdgeOnBorder();
+        adjV.vert       = tmpVertex;
+        adjV.doubleArea = doubleArea(*pos.face());
+        totalDoubleAreaSize += adjV.doubleArea;
+        ring.push_back(adjV);
+    } while (tmpVertex != firstVertex);
+
+    // compute I-NN^t to be used for computing the T_i's
+    Matrix33<ScalarType> Tp;
+
+    NormalType n = v.normal();
+    for (int i = 0; i < 3; ++i)
+        Tp(i, i) = 1.0f - std::pow(n[i], 2);
+    Tp(0, 1) = Tp(1, 0) = -1.0f * (n[0] * n[1]);
+    Tp(1, 2) = Tp(2, 1) = -1.0f * (n[1] * n[2]);
+    Tp(0, 2) = Tp(2, 0) = -1.0f * (n[0] * n[2]);
+
+    // for all neighbors vi compute the directional curvatures k_i and the
+    // T_i compute M by summing all w_i k_i T_i T_i^t
+    Matrix33<ScalarType> tempMatrix;
+    Matrix33<ScalarType> M = Matrix33<ScalarType>::Zero();
+    for (uint i = 0; i < ring.size(); ++i) {
+        ScalarType weight;
+        if (ring[i].isBorder) {
+            weight = ring[i].doubleArea / totalDoubleAreaSize;
+        }
+        else {
+            const uint prev = (i + ring.size() - 1) % ring.size();
+            weight = 0.5f * (ring[i].doubleArea + ring[prev].doubleArea) /
+                     totalDoubleAreaSize;
+        }
+        assert(weight < 1.0f);
+
+        PositionType edge = (v.position() - ring[i].vert->position());
+        ScalarType   curvature =
+            (2.0f * (v.normal().dot(edge))) / edge.squaredNorm();
+        PositionType t = Tp * edge;
+        t.normalize();
+        tempMatrix = t.outerProduct(t);
+        M += tempMatrix * weight * curvature;
+    }
+
+    // compute vector W for the Householder matrix
+    PositionType w;
+    PositionType e1(1.0f, 0.0f, 0.0f);
+    if ((e1 - v.normal()).squaredNorm() > (e1 + v.normal()).squaredNorm())
+        w = e1 - v.normal();
+    else
+        w = e1 + v.normal();
+    w.normalize();
+
+    // compute the Householder matrix I - 2WW^t
+    Matrix33<ScalarType> Q = Matrix33<ScalarType>::Identity();
+    tempMatrix             = w.outerProduct(w);
+    Q -= tempMatrix * 2.0f;
+
+    // compute matrix Q^t M Q
+    Matrix33<ScalarType> QtMQ = (Q.transpose() * M * Q);
+
+    Eigen::Matrix<ScalarType, 1, 3> T1 = Q.col(1);
+    Eigen::Matrix<ScalarType, 1, 3> T2 = Q.col(2);
+
+    // find sin and cos for the Givens rotation
+    ScalarType s, c;
+    // Gabriel Taubin hint and Valentino Fiorin impementation
+    ScalarType alpha = QtMQ(1, 1) - QtMQ(2, 2);
+    ScalarType beta  = QtMQ(2, 1);
+
+    ScalarType h[2];
+    ScalarType delta =
+        std::sqrt(4.0f * std::pow(alpha, 2) + 16.0f * std::pow(beta, 2));
+    h[0] = (2.0f * alpha + delta) / (2.0f * beta);
+    h[1] = (2.0f * alpha - delta) / (2.0f * beta);
+
+    ScalarType t[2];
+    ScalarType bestC = 1, bestS = 0;
+    ScalarType minError = std::numeric_limits<ScalarType>::infinity();
+    for (uint i = 0; i < 2; i++) {
+        delta = std::sqrt(std::pow(h[i], 2) + 4.0f);
+        t[0]  = (h[i] + delta) / 2.0f;
+        t[1]  = (h[i] - delta) / 2.0f;
+
+        for (uint j = 0; j < 2; j++) {
+            ScalarType squaredT    = std::pow(t[j], 2);
+            ScalarType denominator = 1.0f + squaredT;
+
+            s = (2.0f * t[j]) / denominator;
+            c = (1 - squaredT) / denominator;
+
+            ScalarType approximation =
+                c * s * alpha + (std::pow(c, 2) - std::pow(s, 2)) * beta;
+            ScalarType angleSimilarity = std::abs(std::acos(c) / std::asin(s));
+            ScalarType error =
+                std::abs(1.0f - angleSimilarity) + std::abs(approximation);
+            if (error < minError) {
+                minError = error;
+                bestC    = c;
+                bestS    = s;
             }
         }
-        c = bestC;
-        s = bestS;
+    }
+    c = bestC;
+    s = bestS;
+
+    Eigen::Matrix2f minor2x2;
+    Eigen::Matrix2f S;
+
+    // diagonalize M
+    minor2x2(0, 0) = QtMQ(1, 1);
+    minor2x2(0, 1) = QtMQ(1, 2);
+    minor2x2(1, 0) = QtMQ(2, 1);
+    minor2x2(1, 1) = QtMQ(2, 2);
+
+    S(0, 0) = S(1, 1) = c;
+    S(0, 1)           = s;
+    S(1, 0)           = -1.0f * s;
+
+    Eigen::Matrix2f StMS = S.transpose() * minor2x2 * S;
+
+    // compute curvatures and curvature directions
+    ScalarType principalCurv1 = (3.0f * StMS(0, 0)) - StMS(1, 1);
+    ScalarType principalCurv2 = (3.0f * StMS(1, 1)) - StMS(0, 0);
+
+    Eigen::Matrix<ScalarType, 1, 3> principalDir1 = T1 * c - T2 * s;
+    Eigen::Matrix<ScalarType, 1, 3> principalDir2 = T1 * s + T2 * c;
+
+    v.principalCurvature().maxDir()   = principalDir1;
+    v.principalCurvature().minDir()   = principalDir2;
+    v.principalCurvature().maxValue() = principalCurv1;
+    v.principalCurvature().minValue() = principalCurv2;
+    if (v.principalCurvature().maxValue() <
+        v.principalCurvature().minValue()) {
+        std::swap(
+            v.principalCurvature().minValue(),
+            v.principalCurvature().maxValue());
+        std::swap(
+            v.principalCurvature().minDir(), v.principalCurvature().maxDir());
+    }
+}
 
-        Eigen::Matrix2f minor2x2;
-        Eigen::Matrix2f S;
+} // namespace detail
 
-        // diagonalize M
-        minor2x2(0, 0) = QtMQ(1, 1);
-        minor2x2(0, 1) = QtMQ(1, 2);
-        minor2x2(1, 0) = QtMQ(2, 1);
-        minor2x2(1, 1) = QtMQ(2, 2);
+/**
+ * @brief Computes the principal curvature of the vertices of the mesh with the
+ * algorithm described in: Estimating the Tensor of Curvature of a Surface
+ * from a Polyhedral Approximation, Gabriel Taubin, ICCV 1995.
+ *
+ * Vertices are processed in parallel. The double areas of the faces are
+ * computed once and shared by all the vertices, and the adjacent vertices of
+ * each vertex are collected in a scratch buffer that is reused by all the
+ * vertices of a parallel task, so no allocation is done for each vertex.
+ * Vertices that are not referenced by any face are left unchanged.
+ *
+ * The per-vertex and per-face adjacent faces must be up to date.
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices:
+ *     - Normal
+ *     - PrincipalCurvature
+ *     - AdjacentFaces
+ *   - Faces:
+ *     - AdjacentFaces
+ *
+ * @param[in,out] m: the mesh on which compute the principal curvature.
+ * @param[in,out] log: The logger used to log the performed operations.
+ */
+template<FaceMeshConcept MeshType, LoggerConcept LogType = NullLogger>
+void updatePrincipalCurvatureTaubin95(MeshType& m, LogType& log = nullLogger)
+{
+    requirePerVertexPrincipalCurvature(m);
+    requirePerVertexAdjacentFaces(m);
+    requirePerFaceAdjacentFaces(m);
 
-        S(0, 0) = S(1, 1) = c;
-        S(0, 1)           = s;
-        S(1, 0)           = -1.0f * s;
+    using VertexType = MeshType::VertexType;
+    using ScalarType = VertexType::PositionType::ScalarType;
+    using FaceType   = MeshType::FaceType;
 
-        Eigen::Matrix2f StMS = S.transpose() * minor2x2 * S;
+    log.log(0, "Updating per vertex normals...");
 
-        // compute curvatures and curvature directions
-        ScalarType principalCurv1 = (3.0f * StMS(0, 0)) - StMS(1, 1);
-        ScalarType principalCurv2 = (3.0f * StMS(1, 1)) - StMS(0, 0);
+    // the adjacent faces are required and up to date: the normals are gathered
+    // as in the incremental update
+    updatePerVertexNormalsAngleWeighted(m, true, nullLogger, true);
+
+    std::vector<ScalarType> doubleAreas(m.faceContainerSize());
+    detail::forEachCurvatureChunk(
+        m.faceContainerSize(), [&](uint begin, uint end) {
+            for (uint i = begin; i < end; ++i) {
+                const FaceType& f = m.face(i);
+                if (!f.deleted())
+                    doubleAreas[i] = faceArea(f) * 2;
+            }
+        });
 
-        Eigen::Matrix<ScalarType, 1, 3> principalDir1 = T1 * c - T2 * s;
-        Eigen::Matrix<ScalarType, 1, 3> principalDir2 = T1 * s + T2 * c;
+    auto doubleArea = [&](const FaceType& f) {
+        return doubleAreas[m.index(f)];
+    };
 
-        v.principalCurvature().maxDir()   = principalDir1;
-        v.principalCurvature().minDir()   = principalDir2;
-        v.principalCurvature().maxValue() = principalCurv1;
-        v.principalCurvature().minValue() = principalCurv2;
+    log.log(5, "Computing per vertex curvature...");
+    // log every 5%, starting from 5% to 100%
+    log.startProgress("", m.vertexContainerSize(), 5, 5, 100);
 
-        log.progress(m.index(v));
-    }
+    std::atomic<uint> processed = 0;
+
+    detail::forEachCurvatureChunk(
+        m.vertexContainerSize(), [&](uint begin, uint end) {
+            std::vector<detail::Taubin95AdjVertex<VertexType>> ring;
+            for (uint i = begin; i < end; ++i) {
+                VertexType& v = m.vertex(i);
+                if (!v.deleted() && v.adjFacesNumber() > 0)
+                    detail::taubin95Curvature<FaceType>(v, doubleArea, ring);
+            }
+            log.progress(processed += end - begin);
+        });
 
     log.endProgress();
     log.log(100, "Per vertex curvature computed.");
 }
 
+/**
+ * @brief Recomputes the Taubin95 principal curvature (and the normal) only
+ * for the vertices that share a face with at least one of the given moved
+ * vertices.
+ *
+ * This is meant for meshes that are locally deformed without changing their
+ * topology: if only the given vertices moved since the last update of the
+ * curvature, the result is the same that would be obtained calling
+ * updatePrincipalCurvatureTaubin95(m, log), up to rounding.
+ *
+ * The per-vertex and per-face adjacent faces must be up to date.
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices:
+ *     - Normal
+ *     - PrincipalCurvature
+ *     - AdjacentFaces
+ *   - Faces:
+ *     - AdjacentFaces
+ *
+ * @param[in,out] m: the mesh on which compute the principal curvature.
+ * @param[in] movedVertices: a range of indices of the moved vertices.
+ * @param[in,out] log: The logger used to log the performed operations.
+ */
+template<FaceMeshConcept MeshType, LoggerConcept LogType = NullLogger>
+void updatePrincipalCurvatureTaubin95(
+    MeshType&    m,
+    Range auto&& movedVertices,
+    LogType&     log = nullLogger)
+{
+    requirePerVertexPrincipalCurvature(m);
+    requirePerVertexAdjacentFaces(m);
+    requirePerFaceAdjacentFaces(m);
+
+    using VertexType = MeshType::VertexType;
+    using FaceType   = MeshType::FaceType;
+
+    log.log(0, "Updating per vertex normals...");
+
+    updatePerVertexNormalsAngleWeighted(m, movedVertices);
+
+    // the vertices whose normal or one-ring changed
+    std::vector<bool> touched(m.vertexContainerSize(), false);
+    std::vector<uint> vertices;
+    for (uint vi : movedVertices) {
+        for (const FaceType* f : m.vertex(vi).adjFaces()) {
+            for (uint vj : f->vertexIndices()) {
+                if (!touched[vj]) {
+                    touched[vj] = true;
+                    vertices.push_back(vj);
+                }
+            }
+        }
+    }
+
+    auto doubleArea = [](const FaceType& f) {
+        return faceArea(f) * 2;
+    };
+
+    log.log(5, "Computing per vertex curvature...");
+
+    detail::forEachCurvatureChunk(vertices.size(), [&](uint begin, uint end) {
+        std::vector<detail::Taubin95AdjVertex<VertexType>> ring;
+        for (uint i = begin; i < end; ++i) {
+            detail::taubin95Curvature<FaceType>(
+                m.vertex(vertices[i]), doubleArea, ring);
+        }
+    });
+
+    log.log(100, "Per vertex curvature computed.");
+}
+
 /**
  * @brief Computes the Principal Curvature meseaure as described in the paper:
  * Robust principal curvatures on Multiple Scales, Yong-Liang Yang, Yu-Kun Lai,
- * Shi-Min Hu Helmut Pottmann SGP 2004. If montecarloSampling==true the
- * covariance is computed by montecarlo sampling on the mesh (faster); If
- * montecarloSampling==false the covariance is computed by (analytic)integration
- * over the surface (slower).
+ * Shi-Min Hu Helmut Pottmann SGP 2004.
+ *
+ * The curvature of each vertex is computed from the covariance matrix of the
+ * part of the mesh that lies in the sphere of the given radius centered in the
+ * vertex:
+ * - if montecarloSampling==true, the covariance is computed on the vertices
+ *   of the mesh in the sphere, found using a StaticGrid (faster);
+ * - if montecarloSampling==false, the covariance is integrated over the
+ *   surface of the faces in the sphere, found using a BVH of the faces. Faces
+ *   are clipped exactly by the sphere (polygons are split in the triangles of
+ *   their ear-cut triangulation, computed once for all the vertices).
+ *
+ * In both cases the spatial data structure is built once and shared by all
+ * the vertices, that are processed in parallel: the covariance is accumulated
+ * in place, and the scratch buffers of the queries are reused by the vertices
+ * of each parallel task.
+ *
  * @param m
  * @param radius
  * @param montecarloSampling
@@ -255,120 +669,123 @@ void updatePrincipalCurvaturePCA(
     bool     montecarloSampling = true,
     LogType& log                = nullLogger)
 {
+    requirePerVertexPrincipalCurvature(m);
+
     using VertexType   = MeshType::VertexType;
     using PositionType = VertexType::PositionType;
     using ScalarType   = PositionType::ScalarType;
-    using NormalType   = VertexType::NormalType;
     using FaceType     = MeshType::FaceType;
 
     using VGrid         = StaticGrid3<VertexType*, ScalarType>;
     using VGridIterator = VGrid::ConstIterator;
 
-    VGrid      pGrid;
-    ScalarType area;
-
     log.log(0, "Updating per vertex normals...");
 
     updatePerVertexNormalsAngleWeighted(m);
     normalizePerVertexNormals(m);
 
     log.log(0, "Computing per vertex curvature...");
-    log.startProgress("", m.vertexNumber());
+    log.startProgress("", m.vertexContainerSize());
+
+    std::atomic<uint> processed = 0;
 
     if (montecarloSampling) {
-        area  = surfaceArea(m);
-        pGrid = VGrid(m.vertices() | views::addrOf);
-        pGrid.build();
+        const ScalarType area = surfaceArea(m);
+
+        VGrid pGrid = VGrid(m.vertices() | views::addrOf);
+
+        detail::forEachCurvatureChunk(
+            m.vertexContainerSize(), [&](uint begin, uint end) {
+                std::vector<VGridIterator> near;
+                for (uint i = begin; i < end; ++i) {
+                    VertexType& v = m.vertex(i);
+                    if (v.deleted())
+                        continue;
+
+                    pGrid.valuesInSphere(Sphere(v.position(), radius), near);
+
+                    // covariance of the points, relative to the vertex
+                    Point3d          sum;
+                    Matrix33d sq = Matrix33d::Zero();
+                    for (const auto& it : near) {
+                        const Point3d e =
+                            (it->second->position() - v.position())
+                                .template cast<double>();
+                        sum += e;
+                        sq += e.outerProduct(e);
+                    }
+                    Matrix33d A = sq - sum.outerProduct(sum) /
+                                                  std::max<uint>(near.size(), 1);
+                    A *= area * area / 1000;
+
+                    detail::setPrincipalCurvatureFromCovariance(
+                        v, Matrix33<ScalarType>(A.cast<ScalarType>()), radius);
+                }
+                log.progress(processed += end - begin);
+            });
     }
-
-    parallelFor(m.vertices(), [&](VertexType& v) {
-        // for (VertexType& v : m.vertices()) {
-        Matrix33<ScalarType> A, eigenvectors;
-        PositionType         bp, eigenvalues;
-        if (montecarloSampling) {
-            Sphere                     s(v.position(), radius);
-            std::vector<VGridIterator> vec = pGrid.valuesInSphere(s);
-            std::vector<PositionType>  points;
-            points.reserve(vec.size());
-            for (const auto& it : vec) {
-                points.push_back(it->second->position());
-            }
-            A = covarianceMatrixOfPointCloud(points);
-            A *= area * area / 1000;
-        }
-        else {
-            Sphere<ScalarType> sph(v.position(), radius);
-            MeshType           tmpMesh = intersection(m, sph);
-
-            A = covarianceMatrixOfMesh(tmpMesh);
+    else {
+        // polygonal faces are triangulated once, and the triangulation is
+        // shared with the BVH
+        FaceTriangulation triangulation;
+        if constexpr (!TriangleFaceConcept<FaceType>) {
+            log.log(0, "Triangulating faces...");
+            triangulation = FaceTriangulation(m);
         }
 
-        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<ScalarType, 3, 3>> eig(A);
-        eigenvalues  = PositionType(eig.eigenvalues());
-        eigenvectors = eig.eigenvectors(); // eigenvector are stored as columns.
-        // get the estimate of curvatures from eigenvalues and eigenvectors
-        // find the 2 most tangent eigenvectors (by finding the one closest to
-        // the normal)
-        uint       best  = 0;
-        ScalarType bestv = std::abs(
-            v.normal().dot(PositionType(eigenvectors.col(0).normalized())));
-        for (uint i = 1; i < 3; ++i) {
-            ScalarType prod = std::abs(
-                v.normal().dot(PositionType(eigenvectors.col(i).normalized())));
-            if (prod > bestv) {
-                bestv = prod;
-                best  = i;
-            }
-        }
-        v.principalCurvature().maxDir() =
-            (eigenvectors.col((best + 1) % 3).normalized());
-        v.principalCurvature().minDir() =
-            (eigenvectors.col((best + 2) % 3).normalized());
-
-        Matrix33<ScalarType> rot;
-        ScalarType           angle;
-        angle = acos(v.principalCurvature().maxDir().dot(v.normal()));
-
-        rot = rotationMatrix<Matrix33<ScalarType>>(
-            PositionType(v.principalCurvature().maxDir().cross(v.normal())),
-            -(M_PI * 0.5 - angle));
-
-        v.principalCurvature().maxDir() = rot * v.principalCurvature().maxDir();
-
-        angle = acos(v.principalCurvature().minDir().dot(v.normal()));
-
-        rot = rotationMatrix<Matrix33<ScalarType>>(
-            PositionType(v.principalCurvature().minDir().cross(v.normal())),
-            -(M_PI * 0.5 - angle));
-
-        v.principalCurvature().minDir() = rot * v.principalCurvature().minDir();
-
-        // computes the curvature values
-        const ScalarType r5 = std::pow(radius, 5);
-        const ScalarType r6 = r5 * radius;
-        v.principalCurvature().maxValue() =
-            (2.0 / 5.0) *
-            (4.0 * M_PI * r5 + 15 * eigenvalues[(best + 2) % 3] -
-             45.0 * eigenvalues[(best + 1) % 3]) /
-            (M_PI * r6);
-        v.principalCurvature().minValue() =
-            (2.0 / 5.0) *
-            (4.0 * M_PI * r5 + 15 * eigenvalues[(best + 1) % 3] -
-             45.0 * eigenvalues[(best + 2) % 3]) /
-            (M_PI * r6);
-        if (v.principalCurvature().maxValue() <
-            v.principalCurvature().minValue()) {
-            std::swap(
-                v.principalCurvature().minValue(),
-                v.principalCurvature().maxValue());
-            std::swap(
-                v.principalCurvature().minDir(),
-                v.principalCurvature().maxDir());
-        }
-
-        log.progress(m.index(v));
-        //}
-    });
+        const BVH bvh(std::as_const(m).faces() | views::addrOf, triangulation);
+
+        using BVHIterator = decltype(bvh)::ConstIterator;
+
+        detail::forEachCurvatureChunk(
+            m.vertexContainerSize(), [&](uint begin, uint end) {
+                std::vector<BVHIterator> near;
+                for (uint i = begin; i < end; ++i) {
+                    VertexType& v = m.vertex(i);
+                    if (v.deleted())
+                        continue;
+
+                    bvh.valuesInSphere(Sphere(v.position(), radius), near);
+
+                    // moments of the faces clipped by the sphere, relative to
+                    // the vertex
+                    auto local = [&](const auto* v1) {
+                        return (v1->position() - v.position())
+                            .template cast<double>();
+                    };
+
+                    detail::SurfaceMoments mom;
+                    for (const auto& it : near) {
+                        const FaceType& f = **it;
+                        if constexpr (TriangleFaceConcept<FaceType>) {
+                            mom.addTriangleInSphere(
+                                local(f.vertex(0)),
+                                local(f.vertex(1)),
+                                local(f.vertex(2)),
+                                radius);
+                        }
+                        else {
+                            std::span<const uint> t =
+                                triangulation.triangles(m.index(f));
+                            for (uint j = 0; j < t.size(); j += 3) {
+                                mom.addTriangleInSphere(
+                                    local(f.vertex(t[j])),
+                                    local(f.vertex(t[j + 1])),
+                                    local(f.vertex(t[j + 2])),
+                                    radius);
+                            }
+                        }
+                    }
+
+                    detail::setPrincipalCurvatureFromCovariance(
+                        v,
+                        Matrix33<ScalarType>(
+                            mom.covariance().cast<ScalarType>()),
+                        radius);
+                }
+                log.progress(processed += end - begin);
+            });
+    }
 
     log.endProgress();
     log.log(100, "Per vertex curvature computed.");
@@ -25,6 +25,7 @@
 
 #include <vclib/algorithms/core/polygon.h>
 #include <vclib/algorithms/core/transform.h>
+#include <vclib/algorithms/mesh/sort.h>
 #include <vclib/mesh/requirements.h>
 #include <vclib/misc/logger.h>
 #include <vclib/misc/parallel.h>
@@ -397,12 +398,265 @@ void updatePerFaceNormals(
     log.log(100, "Per-Face normals updated.");
 }
 
+namespace detail {
+
+/*
+ * Contributions of the faces to the normals of their vertices, computed from
+ * the normal n of the face, used by the update functions of the vertex
+ * normals.
+ */
+
+// normal of the face
+struct FaceCornerNormal
+{
+    auto operator()(const auto&, uint, const auto& n) const { return n; }
+};
+
+// normal weighted by the angle of the wedge of the face in the vertex
+template<typename NormalType>
+auto angleWeightedCornerNormal()
+{
+    using ScalarType = NormalType::ScalarType;
+
+    return [](const auto& f, uint i, const NormalType& n) -> NormalType {
+        NormalType vec1 =
+            (f.vertexMod(i - 1)->position() - f.vertexMod(i)->position())
+                .normalized()
+                .template cast<ScalarType>();
+        NormalType vec2 =
+            (f.vertexMod(i + 1)->position() - f.vertexMod(i)->position())
+                .normalized()
+                .template cast<ScalarType>();
+
+        return n * vec1.angle(vec2);
+    };
+}
+
+// normal divided by the product of the squared lengths of the wedge edges
+template<typename NormalType>
+auto nelsonMaxWeightedCornerNormal()
+{
+    using ScalarType = NormalType::ScalarType;
+
+    return [](const auto& f, uint i, const NormalType& n) -> NormalType {
+        ScalarType e1 =
+            (f.vertexMod(i - 1)->position() - f.vertexMod(i)->position())
+                .squaredNorm();
+        ScalarType e2 =
+            (f.vertexMod(i + 1)->position() - f.vertexMod(i)->position())
+                .squaredNorm();
+
+        return n / (e1 * e2);
+    };
+}
+
+/*
+ * Sets the normal of the vertex as the sum of the contributions of its
+ * adjacent faces, where the contribution of a face f to its i-th vertex is
+ * contributionFun(f, i).
+ *
+ * The contributions are summed following the order of the adjacent faces: if
+ * they are ordered by face index (as done by updatePerVertexAdjacentFaces),
+ * the result is the same of the serial loop over the faces of the mesh.
+ */
+template<typename VertexType, typename ContributionF, LoggerConcept LogType>
+void gatherVertexNormal(
+    VertexType&     v,
+    ContributionF&& contributionFun,
+    bool            normalize,
+    LogType&        log)
+{
+    v.normal().setZero();
+    for (const auto* f : v.adjFaces())
+        v.normal() += contributionFun(*f, f->indexOfVertex(&v));
+    if (normalize)
+        normalizeNoThrow<ElemId::VERTEX>(v, log);
+}
+
+/*
+ * Computes the normal of each vertex referenced by a face as the sum of the
+ * contributions of its incident faces, where the contribution of a face f to
+ * its i-th vertex is cornerNormalFun(f, i, faceNormalFun(f)).
+ *
+ * If useAdjacentFaces is true, the per-vertex adjacent faces (that are
+ * required, and must be up to date) are used as a precomputed vertex-face
+ * incidence: the contributions are computed once, in parallel over the faces,
+ * and then each vertex gathers in parallel the contributions of its adjacent
+ * faces, without concurrent writes. Otherwise, the contributions are
+ * accumulated by a serial loop over the faces. In both cases, the
+ * contributions of each vertex are summed following the order of the faces,
+ * therefore the result does not depend on the number of threads.
+ */
+template<
+    FaceMeshConcept MeshType,
+    typename FaceNormalF,
+    typename CornerNormalF,
+    LoggerConcept LogType>
+void updatePerVertexNormals(
+    MeshType&       mesh,
+    FaceNormalF&&   faceNormalFun,
+    CornerNormalF&& cornerNormalFun,
+    bool            normalize,
+    LogType&        log,
+    bool            useAdjacentFaces)
+{
+    using VertexType = MeshType::VertexType;
+    using FaceType   = MeshType::FaceType;
+    using NormalType = VertexType::NormalType;
+
+    // if the contribution is the normal of the face, it is stored once for
+    // each face instead of once for each corner
+    constexpr bool PER_FACE =
+        std::same_as<std::remove_cvref_t<CornerNormalF>, FaceCornerNormal>;
+    constexpr int N_CORNERS = PER_FACE ? 1 : FaceType::VERTEX_NUMBER;
+
+    requirePerVertexNormal(mesh);
+
+    if (useAdjacentFaces) {
+        requirePerVertexAdjacentFaces(mesh);
+
+        const uint nFaces = mesh.faceContainerSize();
+        const uint nVerts = mesh.vertexContainerSize();
+
+        std::vector<uint> chunks(
+            (std::max(nFaces, nVerts) + SORT_VALUES_PER_CHUNK - 1) /
+            SORT_VALUES_PER_CHUNK);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        // index of the first contribution of each face
+        std::vector<uint> offsets;
+        if constexpr (N_CORNERS < 0) {
+            offsets.resize(nFaces + 1, 0);
+            for (uint i = 0; i < nFaces; ++i) {
+                const FaceType& f = mesh.face(i);
+                offsets[i + 1]    = offsets[i];
+                if (!f.deleted())
+                    offsets[i + 1] += f.vertexNumber();
+            }
+        }
+        auto firstContribution = [&](uint fi) {
+            if constexpr (N_CORNERS < 0)
+                return offsets[fi];
+            else
+                return fi * N_CORNERS;
+        };
+
+        std::vector<NormalType> contributions(firstContribution(nFaces));
+        parallelFor(chunks, [&](uint c) {
+            uint end = std::min(nFaces, (c + 1) * SORT_VALUES_PER_CHUNK);
+            for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+                const FaceType& f = mesh.face(i);
+                if (f.deleted())
+                    continue;
+
+                NormalType* out = &contributions[firstContribution(i)];
+                if constexpr (PER_FACE) {
+                    *out = faceNormalFun(f);
+                }
+                else {
+                    const NormalType n = faceNormalFun(f);
+                    for (uint j = 0; j < f.vertexNumber(); ++j)
+                        out[j] = cornerNormalFun(f, j, n);
+                }
+            }
+        });
+
+        auto storedContribution = [&](const FaceType& f, uint i) {
+            if constexpr (PER_FACE)
+                return contributions[mesh.index(f)];
+            else
+                return contributions[firstContribution(mesh.index(f)) + i];
+        };
+
+        parallelFor(chunks, [&](uint c) {
+            uint end = std::min(nVerts, (c + 1) * SORT_VALUES_PER_CHUNK);
+            for (uint i = c * SORT_VALUES_PER_CHUNK; i < end; ++i) {
+                VertexType& v = mesh.vertex(i);
+                // unreferenced vertex normals are left unchanged
+                if (!v.deleted() && v.adjFacesNumber() > 0) {
+                    gatherVertexNormal(v, storedContribution, normalize, log);
+                }
+            }
+        });
+    }
+    else {
+        log.startNewTask(0, 20, "Clearing per-Vertex normals...");
+        clearPerReferencedVertexNormals(mesh, log);
+        log.endTask("Clearing per-Vertex normals...");
+
+        log.log(20, "Updating per-Vertex normals...");
+
+        for (auto& f : mesh.faces()) {
+            const NormalType n = faceNormalFun(f);
+            for (uint i = 0; i < f.vertexNumber(); ++i)
+                f.vertex(i)->normal() += cornerNormalFun(f, i, n);
+        }
+
+        if (normalize) {
+            log.startNewTask(80, 100, "Normalizing per-Vertex normals...");
+            normalizePerReferencedVertexNormals(mesh, log);
+            log.endTask("Normalizing per-Vertex normals...");
+        }
+    }
+}
+
+/*
+ * Same as updatePerVertexNormals, but the normals are recomputed only for the
+ * vertices that share a face with at least one of the moved vertices, looking
+ * at the per-vertex adjacent faces (that are required).
+ */
+template<
+    FaceMeshConcept MeshType,
+    typename FaceNormalF,
+    typename CornerNormalF,
+    LoggerConcept LogType>
+void updatePerVertexNormals(
+    MeshType&       mesh,
+    Range auto&&    movedVertices,
+    FaceNormalF&&   faceNormalFun,
+    CornerNormalF&& cornerNormalFun,
+    bool            normalize,
+    LogType&        log)
+{
+    requirePerVertexNormal(mesh);
+    requirePerVertexAdjacentFaces(mesh);
+
+    std::vector<bool> touched(mesh.vertexContainerSize(), false);
+    std::vector<uint> vertices;
+    for (uint vi : movedVertices) {
+        for (const auto* f : mesh.vertex(vi).adjFaces()) {
+            for (uint vj : f->vertexIndices()) {
+                if (!touched[vj]) {
+                    touched[vj] = true;
+                    vertices.push_back(vj);
+                }
+            }
+        }
+    }
+
+    auto contribution = [&](const auto& f, uint i) {
+        return cornerNormalFun(f, i, faceNormalFun(f));
+    };
+
+    parallelFor(vertices, [&](uint vi) {
+        gatherVertexNormal(mesh.vertex(vi), contribution, normalize, log);
+    });
+}
+
+} // namespace detail
+
 /**
  * @brief Computes the vertex normal as the classic area weighted average.
  *
  * This function does not need or exploit current face normals. Unreferenced
  * vertex normals are left unchanged.
  *
+ * If useAdjacentFaces is true, the normals are computed in parallel, gathering
+ * for each vertex the contributions of its adjacent faces: the per-vertex
+ * adjacent faces are required and must be up to date (see
+ * updatePerVertexAdjacentFaces), otherwise the computed normals are wrong. The
+ * result does not depend on the number of threads.
+ *
  * Requirements:
  * - Mesh:
  *   - Vertices:
@@ -413,35 +667,82 @@ void updatePerFaceNormals(
  * @param[in] normalize: if true (default), normals are normalized after
  * computation.
  * @param[in,out] log: The logger used to log the performed operations.
+ * @param[in] useAdjacentFaces: if true, the normals are computed in parallel
+ * using the per-vertex adjacent faces (default: false).
  */
 template<LoggerConcept LogType = NullLogger>
 void updatePerVertexNormals(
     FaceMeshConcept auto& mesh,
-    bool                  normalize = true,
-    LogType&              log       = nullLogger)
+    bool                  normalize        = true,
+    LogType&              log              = nullLogger,
+    bool                  useAdjacentFaces = false)
 {
     using VertexType = RemoveRef<decltype(mesh)>::VertexType;
-    using NScalar    = VertexType::NormalType::ScalarType;
+    using NormalType = VertexType::NormalType;
+    using NScalar    = NormalType::ScalarType;
 
     log.log(0, "Updating per-Vertex normals...");
 
-    log.startNewTask(0, 20, "Clearing per-Vertex normals...");
-    clearPerReferencedVertexNormals(mesh, log);
-    log.endTask("Clearing per-Vertex normals...");
+    detail::updatePerVertexNormals(
+        mesh,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalar>();
+        },
+        detail::FaceCornerNormal(),
+        normalize,
+        log,
+        useAdjacentFaces);
 
-    log.log(20, "Updating per-Vertex normals...");
+    log.log(100, "Per-Vertex normals updated.");
+}
 
-    for (auto& f : mesh.faces()) {
-        for (auto* v : f.vertices()) {
-            v->normal() += faceNormal(f).template cast<NScalar>();
-        }
-    }
+/**
+ * @brief Recomputes the area weighted vertex normals only for the vertices
+ * that share a face with at least one of the given moved vertices.
+ *
+ * This is meant for meshes that are deformed without changing their
+ * topology: if only the given vertices moved since the last update of the
+ * normals, the result is the same that would be obtained calling
+ * updatePerVertexNormals(mesh, normalize, log, true).
+ *
+ * The per-vertex adjacent faces must be up to date (see
+ * updatePerVertexAdjacentFaces).
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices:
+ *     - Normal
+ *     - AdjacentFaces
+ *   - Faces
+ *
+ * @param[in,out] mesh: the mesh on which compute the vertex normals.
+ * @param[in] movedVertices: a range of indices of the moved vertices.
+ * @param[in] normalize: if true (default), normals are normalized after
+ * computation.
+ * @param[in,out] log: The logger used to log the performed operations.
+ */
+template<LoggerConcept LogType = NullLogger>
+void updatePerVertexNormals(
+    FaceMeshConcept auto& mesh,
+    Range auto&&          movedVertices,
+    bool                  normalize = true,
+    LogType&              log       = nullLogger)
+{
+    using VertexType = RemoveRef<decltype(mesh)>::VertexType;
+    using NormalType = VertexType::NormalType;
+    using NScalar    = NormalType::ScalarType;
 
-    if (normalize) {
-        log.startNewTask(80, 100, "Normalizing per-Vertex normals...");
-        normalizePerReferencedVertexNormals(mesh, log);
-        log.endTask("Normalizing per-Vertex normals...");
-    }
+    log.log(0, "Updating per-Vertex normals...");
+
+    detail::updatePerVertexNormals(
+        mesh,
+        movedVertices,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalar>();
+        },
+        detail::FaceCornerNormal(),
+        normalize,
+        log);
 
     log.log(100, "Per-Vertex normals updated.");
 }
@@ -451,6 +752,12 @@ void updatePerVertexNormals(
  *
  * Unreferenced vertex normals are left unchanged.
  *
+ * If useAdjacentFaces is true, the normals are computed in parallel, gathering
+ * for each vertex the contributions of its adjacent faces: the per-vertex
+ * adjacent faces are required and must be up to date (see
+ * updatePerVertexAdjacentFaces), otherwise the computed normals are wrong. The
+ * result does not depend on the number of threads.
+ *
  * Requirements:
  * - Mesh:
  *   - Vertices:
@@ -462,37 +769,33 @@ void updatePerVertexNormals(
  * @param[in] normalize: if true (default), normals are normalized after
  * computation.
  * @param[in,out] log: The logger used to log the performed operations.
+ * @param[in] useAdjacentFaces: if true, the normals are computed in parallel
+ * using the per-vertex adjacent faces (default: false).
  */
 template<LoggerConcept LogType = NullLogger>
 void updatePerVertexNormalsFromFaceNormals(
     FaceMeshConcept auto& mesh,
-    bool                  normalize = true,
-    LogType&              log       = nullLogger)
+    bool                  normalize        = true,
+    LogType&              log              = nullLogger,
+    bool                  useAdjacentFaces = false)
 {
     requirePerFaceNormal(mesh);
 
     using VertexType = RemoveRef<decltype(mesh)>::VertexType;
-    using ScalarType = VertexType::NormalType::ScalarType;
+    using NormalType = VertexType::NormalType;
+    using ScalarType = NormalType::ScalarType;
 
     log.log(0, "Updating per-Vertex normals...");
 
-    log.startNewTask(0, 20, "Clearing per-Vertex normals...");
-    clearPerReferencedVertexNormals(mesh, log);
-    log.endTask("Clearing per-Vertex normals...");
-
-    log.log(20, "Updating per-Vertex normals...");
-
-    for (auto& f : mesh.faces()) {
-        for (auto* v : f.vertices()) {
-            v->normal() += f.normal().template cast<ScalarType>();
-        }
-    }
-
-    if (normalize) {
-        log.startNewTask(80, 100, "Normalizing per-Vertex normals...");
-        normalizePerReferencedVertexNormals(mesh, log);
-        log.endTask("Normalizing per-Vertex normals...");
-    }
+    detail::updatePerVertexNormals(
+        mesh,
+        [](const auto& f) -> NormalType {
+            return f.normal().template cast<ScalarType>();
+        },
+        detail::FaceCornerNormal(),
+        normalize,
+        log,
+        useAdjacentFaces);
 
     log.log(100, "Per-Vertex normals updated.");
 }
@@ -557,6 +860,12 @@ void updatePerVertexAndFaceNormals(
  * This function does not need or exploit current face normals. Unreferenced
  * vertex normals are left unchanged.
  *
+ * If useAdjacentFaces is true, the normals are computed in parallel, gathering
+ * for each vertex the contributions of its adjacent faces: the per-vertex
+ * adjacent faces are required and must be up to date (see
+ * updatePerVertexAdjacentFaces), otherwise the computed normals are wrong. The
+ * result does not depend on the number of threads.
+ *
  * Requirements:
  * - Mesh:
  *   - Vertices:
@@ -568,12 +877,15 @@ void updatePerVertexAndFaceNormals(
  * @param[in] normalize: if true (default), normals are normalized after
  * computation.
  * @param[in,out] log: The logger used to log the performed operations.
+ * @param[in] useAdjacentFaces: if true, the normals are computed in parallel
+ * using the per-vertex adjacent faces (default: false).
  */
 template<LoggerConcept LogType = NullLogger>
 void updatePerVertexNormalsAngleWeighted(
     FaceMeshConcept auto& mesh,
-    bool                  normalize = true,
-    LogType&              log       = nullLogger)
+    bool                  normalize        = true,
+    LogType&              log              = nullLogger,
+    bool                  useAdjacentFaces = false)
 {
     using VertexType  = RemoveRef<decltype(mesh)>::VertexType;
     using NormalType  = VertexType::NormalType;
@@ -581,34 +893,63 @@ void updatePerVertexNormalsAngleWeighted(
 
     log.log(0, "Updating per-Vertex normals...");
 
-    log.startNewTask(0, 5, "Clearing per-Vertex normals...");
-    clearPerReferencedVertexNormals(mesh, log);
-    log.endTask("Clearing per-Vertex normals...");
-
-    log.log(5, "Updating per-Vertex normals...");
+    detail::updatePerVertexNormals(
+        mesh,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalarType>();
+        },
+        detail::angleWeightedCornerNormal<NormalType>(),
+        normalize,
+        log,
+        useAdjacentFaces);
 
-    for (auto& f : mesh.faces()) {
-        auto n = faceNormal(f).template cast<NScalarType>();
+    log.log(100, "Per-Vertex normals updated.");
+}
 
-        for (uint i = 0; i < f.vertexNumber(); ++i) {
-            NormalType vec1 =
-                (f.vertexMod(i - 1)->position() - f.vertexMod(i)->position())
-                    .normalized()
-                    .template cast<NScalarType>();
-            NormalType vec2 =
-                (f.vertexMod(i + 1)->position() - f.vertexMod(i)->position())
-                    .normalized()
-                    .template cast<NScalarType>();
+/**
+ * @brief Recomputes the angle weighted vertex normals only for the vertices
+ * that share a face with at least one of the given moved vertices.
+ *
+ * The per-vertex adjacent faces must be up to date (see
+ * updatePerVertexAdjacentFaces).
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices:
+ *     - Normal
+ *     - AdjacentFaces
+ *   - Faces
+ *
+ * @param[in,out] mesh: the mesh on which compute the vertex normals.
+ * @param[in] movedVertices: a range of indices of the moved vertices.
+ * @param[in] normalize: if true (default), normals are normalized after
+ * computation.
+ * @param[in,out] log: The logger used to log the performed operations.
+ *
+ * @see updatePerVertexNormals(mesh, movedVertices, normalize, log)
+ */
+template<LoggerConcept LogType = NullLogger>
+void updatePerVertexNormalsAngleWeighted(
+    FaceMeshConcept auto& mesh,
+    Range auto&&          movedVertices,
+    bool                  normalize = true,
+    LogType&              log       = nullLogger)
+{
+    using VertexType  = RemoveRef<decltype(mesh)>::VertexType;
+    using NormalType  = VertexType::NormalType;
+    using NScalarType = NormalType::ScalarType;
 
-            f.vertex(i)->normal() += n * vec1.angle(vec2);
-        }
-    }
+    log.log(0, "Updating per-Vertex normals...");
 
-    if (normalize) {
-        log.startNewTask(95, 100, "Normalizing per-Vertex normals...");
-        normalizePerReferencedVertexNormals(mesh, log);
-        log.endTask("Normalizing per-Vertex normals...");
-    }
+    detail::updatePerVertexNormals(
+        mesh,
+        movedVertices,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalarType>();
+        },
+        detail::angleWeightedCornerNormal<NormalType>(),
+        normalize,
+        log);
 
     log.log(100, "Per-Vertex normals updated.");
 }
@@ -631,6 +972,12 @@ void updatePerVertexNormalsAngleWeighted(
  * This function does not need or exploit current face normals. Unreferenced
  * vertex normals are left unchanged.
  *
+ * If useAdjacentFaces is true, the normals are computed in parallel, gathering
+ * for each vertex the contributions of its adjacent faces: the per-vertex
+ * adjacent faces are required and must be up to date (see
+ * updatePerVertexAdjacentFaces), otherwise the computed normals are wrong. The
+ * result does not depend on the number of threads.
+ *
  * Requirements:
  * - Mesh:
  *   - Vertices:
@@ -642,44 +989,79 @@ void updatePerVertexNormalsAngleWeighted(
  * @param[in] normalize: if true (default), normals are normalized after
  * computation.
  * @param[in,out] log: The logger used to log the performed operations.
+ * @param[in] useAdjacentFaces: if true, the normals are computed in parallel
+ * using the per-vertex adjacent faces (default: false).
  */
 template<LoggerConcept LogType = NullLogger>
 void updatePerVertexNormalsNelsonMaxWeighted(
     FaceMeshConcept auto& mesh,
-    bool                  normalize = true,
-    LogType&              log       = nullLogger)
+    bool                  normalize        = true,
+    LogType&              log              = nullLogger,
+    bool                  useAdjacentFaces = false)
 {
     using VertexType  = RemoveRef<decltype(mesh)>::VertexType;
-    using NScalarType = VertexType::NormalType::ScalarType;
+    using NormalType  = VertexType::NormalType;
+    using NScalarType = NormalType::ScalarType;
 
     log.log(0, "Updating per-Vertex normals...");
 
-    log.startNewTask(0, 5, "Clearing per-Vertex normals...");
-    clearPerReferencedVertexNormals(mesh, log);
-    log.endTask("Clearing per-Vertex normals...");
-
-    log.log(5, "Updating per-Vertex normals...");
+    detail::updatePerVertexNormals(
+        mesh,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalarType>();
+        },
+        detail::nelsonMaxWeightedCornerNormal<NormalType>(),
+        normalize,
+        log,
+        useAdjacentFaces);
 
-    for (auto& f : mesh.faces()) {
-        auto n = faceNormal(f).template cast<NScalarType>();
+    log.log(100, "Per-Vertex normals updated.");
+}
 
-        for (uint i = 0; i < f.vertexNumber(); ++i) {
-            NScalarType e1 =
-                (f.vertexMod(i - 1)->position() - f.vertexMod(i)->position())
-                    .squaredNorm();
-            NScalarType e2 =
-                (f.vertexMod(i + 1)->position() - f.vertexMod(i)->position())
-                    .squaredNorm();
+/**
+ * @brief Recomputes the Max et al. weighted vertex normals only for the
+ * vertices that share a face with at least one of the given moved vertices.
+ *
+ * The per-vertex adjacent faces must be up to date (see
+ * updatePerVertexAdjacentFaces).
+ *
+ * Requirements:
+ * - Mesh:
+ *   - Vertices:
+ *     - Normal
+ *     - AdjacentFaces
+ *   - Faces
+ *
+ * @param[in,out] mesh: the mesh on which compute the vertex normals.
+ * @param[in] movedVertices: a range of indices of the moved vertices.
+ * @param[in] normalize: if true (default), normals are normalized after
+ * computation.
+ * @param[in,out] log: The logger used to log the performed operations.
+ *
+ * @see updatePerVertexNormals(mesh, movedVertices, normalize, log)
+ */
+template<LoggerConcept LogType = NullLogger>
+void updatePerVertexNormalsNelsonMaxWeighted(
+    FaceMeshConcept auto& mesh,
+    Range auto&&          movedVertices,
+    bool                  normalize = true,
+    LogType&              log       = nullLogger)
+{
+    using VertexType  = RemoveRef<decltype(mesh)>::VertexType;
+    using NormalType  = VertexType::NormalType;
+    using NScalarType = NormalType::ScalarType;
 
-            f.vertex(i)->normal() += n / (e1 * e2);
-        }
-    }
+    log.log(0, "Updating per-Vertex normals...");
 
-    if (normalize) {
-        log.startNewTask(95, 100, "Normalizing per-Vertex normals...");
-        normalizePerReferencedVertexNormals(mesh, log);
-        log.endTask("Normalizing per-Vertex normals...");
-    }
+    detail::updatePerVertexNormals(
+        mesh,
+        movedVertices,
+        [](const auto& f) -> NormalType {
+            return faceNormal(f).template cast<NScalarType>();
+        },
+        detail::nelsonMaxWeightedCornerNormal<NormalType>(),
+        normalize,
+        log);
 
     log.log(100, "Per-Vertex normals updated.");
 }
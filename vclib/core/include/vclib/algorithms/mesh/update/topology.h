@@ -72,15 +72,34 @@ void updatePerVertexAdjacentFaces(MeshType& m)
     using VertexType = MeshType::VertexType;
     using FaceType   = MeshType::FaceType;
 
-    for (VertexType& v : m.vertices()) {
-        v.clearAdjFaces();
-    }
+    // vector of [vertex index, face index] pairs, one for each corner of each
+    // face, sorted by vertex index: each vertex has a cluster containing its
+    // adjacent faces, ordered by face index
+    std::vector<std::pair<uint64_t, uint>> vec =
+        detail::fillPerFaceKeyVector<MeshType, uint>(
+            m,
+            [](const FaceType& f) {
+                return f.vertexNumber();
+            },
+            [&](const FaceType& f, std::pair<uint64_t, uint>* out) {
+                const uint fi = m.index(f);
+                for (uint j = 0; j < f.vertexNumber(); ++j)
+                    *out++ = {f.vertexIndex(j), fi};
+            });
 
-    for (FaceType& f : m.faces()) {
-        for (VertexType* v : f.vertices()) {
-            v->pushAdjFace(&f);
-        }
-    }
+    radixSortByKey(vec, indexBitWidth(m.vertexContainerSize()));
+
+    detail::parallelForEachCluster(
+        vec,
+        [](uint64_t k) {
+            return k;
+        },
+        [&](std::size_t b, std::size_t e) {
+            VertexType& v = m.vertex(vec[b].first);
+            v.resizeAdjFaces(e - b);
+            for (std::size_t i = b; i < e; ++i)
+                v.setAdjFace(i - b, &m.face(vec[i].second));
+        });
 }
 
 /**
@@ -125,26 +144,50 @@ void updatePerVertexAdjacentVertices(MeshType& m)
     clearPerVertexAdjacentVertices(m);
 
     using VertexType = MeshType::VertexType;
+    using FaceType   = MeshType::FaceType;
 
-    // vector that contains edges sorted trough unordered vertex pointers
-    // it contains clusters of "same" edges, but each one of them has its face
-    // pointer note that in case on non-manifold mesh, clusters may be of size
-    // >= 2
-    std::vector<MeshEdgeUtil<MeshType>> vec = fillAndSortMeshEdgeUtilVector(m);
+    const uint bits = indexBitWidth(m.vertexContainerSize());
 
-    // store the last pair of vertices
-    VertexType* v1 = nullptr;
-    VertexType* v2 = nullptr;
-    for (uint i = 0; i < vec.size(); ++i) {
-        // if this pair is different from the last pair
-        if (vec[i].v[0] != v1 || vec[i].v[1] != v2) {
-            // update last pair
-            v1 = vec[i].v[0];
-            v2 = vec[i].v[1];
-            v1->pushAdjVertex(v2); // set the pair as adjacent
-            v2->pushAdjVertex(v1);
-        }
-    }
+    // vector that contains both the directed half-edges of each edge of each
+    // face, keyed by the packed [origin index, destination index] pair: after
+    // sorting, each vertex has a cluster containing its adjacent vertices,
+    // ordered by index, in which an adjacent vertex may appear more than once
+    std::vector<std::pair<uint64_t, uint>> vec =
+        detail::fillPerFaceKeyVector<MeshType, uint>(
+            m,
+            [](const FaceType& f) {
+                return 2 * f.vertexNumber();
+            },
+            [&](const FaceType& f, std::pair<uint64_t, uint>* out) {
+                for (uint j = 0; j < f.vertexNumber(); ++j) {
+                    uint64_t v0 = f.vertexIndex(j);
+                    uint64_t v1 = f.vertexIndexMod(j + 1);
+                    *out++      = {(v0 << bits) | v1, v1};
+                    *out++      = {(v1 << bits) | v0, v0};
+                }
+            });
+
+    radixSortByKey(vec, 2 * bits);
+
+    detail::parallelForEachCluster(
+        vec,
+        [bits](uint64_t k) {
+            return k >> bits;
+        },
+        [&](std::size_t b, std::size_t e) {
+            VertexType& v = m.vertex(vec[b].first >> bits);
+
+            uint n = 1;
+            for (std::size_t i = b + 1; i < e; ++i)
+                n += vec[i].first != vec[i - 1].first;
+
+            v.resizeAdjVertices(n);
+            uint k = 0;
+            for (std::size_t i = b; i < e; ++i) {
+                if (i == b || vec[i].first != vec[i - 1].first)
+                    v.setAdjVertex(k++, &m.vertex(vec[i].second));
+            }
+        });
 }
 
 /**
@@ -224,44 +267,36 @@ void updatePerFaceAdjacentFaces(MeshType& m)
 {
     requirePerFaceAdjacentFaces(m);
 
-    // vector that contains edges sorted trough unordered vertex pointers
+    // vector that contains edges sorted trough packed vertex indices
     // it contains clusters of "same" edges, but each one of them has its face
-    // pointer note that in case on non-manifold mesh, clusters may be of size
-    // >= 2
-    std::vector<MeshEdgeUtil<MeshType>> vec = fillAndSortMeshEdgeUtilVector(m);
-
-    if (vec.size() > 0) {
-        // in this loop, base will point to the first element of a cluster of
-        // edges
-        // increment of clusters into loop
-        for (auto base = vec.begin(); base != vec.end();) {
-            auto first = base; // remember the first to set adj to the last
+    // and edge indices. Note that in case on non-manifold mesh, clusters may
+    // be of size >= 2
+    std::vector<std::pair<uint64_t, std::pair<uint, uint>>> vec =
+        fillAndSortEdgeKeyVector(m);
 
-            // i and j will increment together, and if i == j, i will be adj to
-            // j, but j will not be adj to i (to manage non manifold edges and
-            // make cyclic adj on the same edge)
-            auto i = base;
-            auto j = i + 1;
-            if (j != vec.end()) {
-                // case of cluster composed of one element. adj of i is nullptr
-                if (*i != *j) {
-                    i->f->setAdjFace(i->e, nullptr);
-                }
-                else { // at least two edges in the cluster
-                    while (j != vec.end() && *i == *j) {
-                        i->f->setAdjFace(i->e, j->f);
-                        ++i;
-                        ++j;
-                    }
-                    // i now is the last element that was equal to first
-                    i->f->setAdjFace(i->e, first->f);
-                }
+    // clusters are linked in parallel: each cluster touches only the
+    // adjacencies of its own edges
+    detail::parallelForEachCluster(
+        vec,
+        [](uint64_t k) {
+            return k;
+        },
+        [&](std::size_t b, std::size_t e) {
+            // case of cluster composed of one element: adj is nullptr
+            if (e - b == 1) {
+                const auto& [fi, ei] = vec[b].second;
+                m.face(fi).setAdjFace(ei, nullptr);
+                return;
             }
-
-            // j is the first different edge from first (or it is vec.end()!)
-            base = j;
-        }
-    }
+            // each edge is adj to the next one, and the last is adj to the
+            // first (to manage non manifold edges and make cyclic adj on the
+            // same edge)
+            for (std::size_t i = b; i < e; ++i) {
+                const auto& [fi, ei] = vec[i].second;
+                std::size_t next     = i + 1 < e ? i + 1 : b;
+                m.face(fi).setAdjFace(ei, &m.face(vec[next].second.first));
+            }
+        });
 }
 
 } // namespace vcl
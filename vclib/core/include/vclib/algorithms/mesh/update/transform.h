@@ -29,15 +29,59 @@
 
 namespace vcl {
 
+namespace detail {
+
+/*
+ * Returns a range over the positions of the vertices of the mesh. If the
+ * positions are stored vertically, the range is the contiguous array of the
+ * positions (that contains also the positions of the deleted vertices).
+ */
+template<MeshConcept MeshType>
+auto transformedPositions(MeshType& mesh)
+{
+    using VertexType = MeshType::VertexType;
+
+    if constexpr (comp::HasVerticalComponentOfType<
+                      VertexType,
+                      CompId::POSITION>) {
+        return mesh
+            .template verticalComponentData<ElemId::VERTEX, CompId::POSITION>();
+    }
+    else {
+        return mesh.vertices() | views::positions;
+    }
+}
+
+/*
+ * Returns a range over the normals of the elements having ID ELEM_ID of the
+ * mesh. If the normals are stored vertically, the range is the contiguous
+ * array of the normals (that contains also the normals of the deleted
+ * elements).
+ */
+template<uint ELEM_ID, MeshConcept MeshType>
+auto transformedNormals(MeshType& mesh)
+{
+    using ElementType = MeshType::template ElementType<ELEM_ID>;
+
+    if constexpr (comp::HasVerticalComponentOfType<
+                      ElementType,
+                      CompId::NORMAL>) {
+        return mesh.template verticalComponentData<ELEM_ID, CompId::NORMAL>();
+    }
+    else {
+        return mesh.template elements<ELEM_ID>() | views::normals;
+    }
+}
+
+} // namespace detail
+
 template<MeshConcept MeshType, typename ScalarM>
 void applyTransformMatrix(
     MeshType&                mesh,
     const Matrix44<ScalarM>& matrix,
     bool                     updateNormals = true)
 {
-    using VertexType = MeshType::VertexType;
-
-    multiplyPointsByMatrix(mesh.vertices() | vcl::views::positions, matrix);
+    multiplyPointsByMatrix(detail::transformedPositions(mesh), matrix);
 
     // TODO: automatize: for each element, check if it has normal and apply
     // the matrix to it
@@ -45,13 +89,13 @@ void applyTransformMatrix(
         if constexpr (HasPerVertexNormal<MeshType>) {
             if (isPerVertexNormalAvailable(mesh)) {
                 multiplyNormalsByMatrix(
-                    mesh.vertices() | vcl::views::normals, matrix);
+                    detail::transformedNormals<ElemId::VERTEX>(mesh), matrix);
             }
         }
         if constexpr (HasPerFaceNormal<MeshType>) {
             if (isPerFaceNormalAvailable(mesh)) {
                 multiplyNormalsByMatrix(
-                    mesh.faces() | vcl::views::normals, matrix);
+                    detail::transformedNormals<ElemId::FACE>(mesh), matrix);
             }
         }
     }
@@ -60,29 +104,26 @@ void applyTransformMatrix(
 template<MeshConcept MeshType, PointConcept PointType>
 void translate(MeshType& mesh, const PointType& t)
 {
-    using VertexType = MeshType::VertexType;
-    for (VertexType& v : mesh.vertices()) {
-        v.position() += t;
+    for (auto& p : detail::transformedPositions(mesh)) {
+        p += t;
     }
 }
 
 template<MeshConcept MeshType, PointConcept PointType>
 void scale(MeshType& mesh, const PointType& s)
 {
-    using VertexType = MeshType::VertexType;
-    for (VertexType& v : mesh.vertices()) {
-        v.position()(0) *= s(0);
-        v.position()(1) *= s(1);
-        v.position()(2) *= s(2);
+    for (auto& p : detail::transformedPositions(mesh)) {
+        p(0) *= s(0);
+        p(1) *= s(1);
+        p(2) *= s(2);
     }
 }
 
 template<MeshConcept MeshType, typename Scalar = double>
 void scale(MeshType& mesh, const Scalar& s)
 {
-    using VertexType = MeshType::VertexType;
-    for (VertexType& v : mesh.vertices()) {
-        v.position() *= s;
+    for (auto& p : detail::transformedPositions(mesh)) {
+        p *= s;
     }
 }
 
@@ -92,23 +133,25 @@ void rotate(
     const Matrix33<Scalar>& m,
     bool                    updateNormals = true)
 {
-    for (auto& v : mesh.vertices()) {
-        v.position() = m * v.position();
+    for (auto& p : detail::transformedPositions(mesh)) {
+        p = m * p;
     }
 
     if (updateNormals) {
         if constexpr (HasPerVertexNormal<MeshType>) {
             if (isPerVertexNormalAvailable(mesh)) {
-                for (auto& v : mesh.vertices()) {
-                    v.normal() = m * v.normal();
+                auto normals = detail::transformedNormals<ElemId::VERTEX>(mesh);
+                for (auto& n : normals) {
+                    n = m * n;
                 }
             }
         }
 
         if constexpr (HasPerFaceNormal<MeshType>) {
             if (isPerFaceNormalAvailable(mesh)) {
-                for (auto& f : mesh.faces()) {
-                    f.normal() = m * f.normal();
+                auto normals = detail::transformedNormals<ElemId::FACE>(mesh);
+                for (auto& n : normals) {
+                    n = m * n;
                 }
             }
         }
@@ -30,22 +30,116 @@
 #include <vclib/io/image/load.h>
 #include <vclib/io/mesh/settings.h>
 #include <vclib/io/read.h>
+#include <vclib/io/text_chunks.h>
 #include <vclib/misc/logger.h>
 #include <vclib/space/complex/mesh_info.h>
 #include <vclib/space/core/texture.h>
 
 #include <algorithm>
 #include <map>
+#include <string_view>
+#include <vector>
 
 namespace vcl {
 
 namespace detail {
 
-template<MeshConcept MeshType>
-using ObjNormalsMap = std::conditional_t<
-    HasPerVertexNormal<MeshType>,
-    std::map<uint, typename MeshType::VertexType::NormalType>,
-    std::map<uint, Point3d>>;
+/*
+ * A mtllib or usemtl line of an obj file, together with the number of elements
+ * of each type read in its chunk before it.
+ */
+struct ObjChunkEvent
+{
+    bool        isMtlLib = false; // otherwise, it is an usemtl line
+    std::string name;
+
+    uint nVertices  = 0;
+    uint nTexCoords = 0;
+    uint nFaces     = 0;
+    uint nEdges     = 0;
+
+    // index of the material in use after the line, set when stitching chunks
+    uint material = 0;
+};
+
+/*
+ * The content of a chunk of lines of an obj file, parsed independently from
+ * the other chunks.
+ *
+ * The vertex and texcoord indices are stored 0-based, and they are validated
+ * when the chunks are stitched.
+ */
+struct ObjChunk
+{
+    std::vector<double> positions; // 3 per vertex
+    std::vector<float>  colors;    // 3 per vertex, valid if vertexHasColor
+    std::vector<bool>   vertexHasColor;
+    std::vector<double> normals;   // 3 per normal
+    std::vector<double> texCoords; // 2 per texcoord
+
+    // the corners of the i-th face are in [faceOffsets[i], faceOffsets[i+1])
+    std::vector<uint> faceOffsets = {0};
+    std::vector<uint> cornerVertices;
+    std::vector<uint> cornerTexCoords;  // valid if faceHasTexCoords
+    std::vector<bool> faceHasTexCoords; // true if all the corners have one
+    // number of vertices and texcoords read in the chunk before each face: the
+    // indices of a face are valid only if lower than the number of elements
+    // read before it, that is known only when the chunks are stitched
+    std::vector<uint> faceReadVertices;
+    std::vector<uint> faceReadTexCoords;
+    std::vector<uint> edges; // 2 per edge
+
+    std::vector<ObjChunkEvent> events;
+
+    // number of lines of each type, also when they are not stored
+    uint nNormalLines = 0;
+    uint nFaceLines   = 0;
+    uint nEdgeLines   = 0;
+
+    // size of the first face, and first size different from it
+    uint firstFaceSize = UINT_NULL;
+    uint otherFaceSize = UINT_NULL;
+
+    uint vertexNumber() const { return positions.size() / 3; }
+
+    uint normalNumber() const { return normals.size() / 3; }
+
+    uint texCoordNumber() const { return texCoords.size() / 2; }
+
+    uint faceNumber() const { return faceOffsets.size() - 1; }
+
+    uint edgeNumber() const { return edges.size() / 2; }
+};
+
+/*
+ * Iterates over the materials of the elements of a chunk of a given type, in
+ * order of index: the material of an element is the one set by the last event
+ * read before it in the chunk, or the one in use at the start of the chunk.
+ */
+class ObjMaterialCursor
+{
+    const std::vector<ObjChunkEvent>& mEvents;
+    uint ObjChunkEvent::*             mCount;
+    uint                              mNext = 0;
+    uint                              mMaterial;
+
+public:
+    ObjMaterialCursor(
+        const ObjChunk&       chunk,
+        uint ObjChunkEvent::* count,
+        uint                  startMaterial) :
+            mEvents(chunk.events), mCount(count), mMaterial(startMaterial)
+    {
+    }
+
+    // material of the k-th element; k must not decrease between the calls
+    uint operator()(uint k)
+    {
+        while (mNext < mEvents.size() && mEvents[mNext].*mCount <= k)
+            mMaterial = mEvents[mNext++].material;
+        return mMaterial;
+    }
+};
 
 template<MeshConcept MeshType>
 void loadObjMaterials(
@@ -170,305 +264,232 @@ void loadObjMaterials(
     loadObjMaterials(materialMap, mesh, file, loadedInfo, settings);
 }
 
+/*
+ * Parses the lines of a chunk of an obj file. Only the data that can be stored
+ * in a mesh of type MeshType are parsed; for the other lines, only their number
+ * is counted.
+ */
 template<MeshConcept MeshType>
-void readObjVertex(
-    MeshType&            m,
-    Tokenizer::iterator& token,
-    MeshInfo&            loadedInfo,
-    const Tokenizer&     tokens,
-    const ObjMaterial&   currentMaterial,
-    const LoadSettings&  settings)
+void parseObjChunk(std::string_view text, ObjChunk& c)
 {
-    uint vid = m.addVertex();
-    for (uint i = 0; i < 3; ++i) {
-        m.vertex(vid).position()[i] = io::readDouble<double>(token);
-    }
-    if constexpr (HasPerVertexColor<MeshType>) {
-        if (vid == 0) {
-            // if the current material has a valid color, or the file stores the
-            // vertex color in the non-standard way (color values after the
-            // positions)
-            if (currentMaterial.hasColor || tokens.size() > 6) {
-                if (settings.enableOptionalComponents) {
-                    enableIfPerVertexColorOptional(m);
-                    loadedInfo.setPerVertexColor();
-                }
-                else {
-                    if (isPerVertexColorAvailable(m))
-                        loadedInfo.setPerVertexColor();
+    constexpr bool READ_TEXCOORDS =
+        HasPerVertexTexCoord<MeshType> || HasPerFaceWedgeTexCoords<MeshType>;
+
+    TextLineTokens   tokens;
+    std::string_view line;
+
+    while (nextTextLine(text, line)) {
+        tokens.split(line);
+        if (tokens.empty())
+            continue;
+        const std::string_view header = tokens.nextToken();
+        if (header == "mtllib" || header == "usemtl") {
+            ObjChunkEvent e;
+            e.isMtlLib = header == "mtllib";
+            if (tokens.remaining() > 0)
+                e.name = tokens.nextToken();
+            e.nVertices  = c.vertexNumber();
+            e.nTexCoords = c.texCoordNumber();
+            e.nFaces     = c.nFaceLines;
+            e.nEdges     = c.nEdgeLines;
+            c.events.push_back(std::move(e));
+        }
+        // read vertex (and for some non-standard obj files, also vertex color)
+        else if (header == "v") {
+            for (uint i = 0; i < 3; ++i)
+                c.positions.push_back(tokens.next<double>());
+            // the file stores the vertex color in the non-standard way (color
+            // values after the positions)
+            const bool hasColor = tokens.size() > 6;
+            c.vertexHasColor.push_back(hasColor);
+            for (uint i = 0; i < 3; ++i) {
+                float col = 0;
+                if constexpr (HasPerVertexColor<MeshType>) {
+                    if (hasColor)
+                        col = tokens.next<float>();
                 }
+                c.colors.push_back(col);
             }
         }
-        if (loadedInfo.hasPerVertexColor()) {
-            // the file has the nonstandard way to store vertex colors, after
-            // the positions...
-            if (tokens.size() > 6) {
-                m.vertex(vid).color().setRedF(io::readFloat<float>(token));
-                m.vertex(vid).color().setGreenF(io::readFloat<float>(token));
-                m.vertex(vid).color().setBlueF(io::readFloat<float>(token));
+        else if (header == "vn") {
+            if constexpr (HasPerVertexNormal<MeshType>) {
+                for (uint i = 0; i < 3; ++i)
+                    c.normals.push_back(tokens.next<double>());
             }
-            else if (currentMaterial.hasColor) {
-                m.vertex(vid).color() = currentMaterial.color();
+            c.nNormalLines++;
+        }
+        else if (header == "vt") {
+            if constexpr (READ_TEXCOORDS) {
+                for (uint i = 0; i < 2; ++i)
+                    c.texCoords.push_back(tokens.next<double>());
             }
         }
-    }
-}
+        else if (header == "f") {
+            if constexpr (HasFaces<MeshType>) {
+                const uint size = tokens.remaining();
+                if (c.nFaceLines == 0)
+                    c.firstFaceSize = size;
+                else if (size != c.firstFaceSize)
+                    c.otherFaceSize = size;
 
-template<MeshConcept MeshType>
-void readObjVertexNormal(
-    MeshType&                        m,
-    detail::ObjNormalsMap<MeshType>& mapNormalsCache,
-    uint                             vn,
-    Tokenizer::iterator&             token,
-    MeshInfo&                        loadedInfo,
-    const LoadSettings&              settings)
-{
-    using NormalType = MeshType::VertexType::NormalType;
+                // corners are in the form v, v/vt, v//vn or v/vt/vn
+                bool hasTexCoords = true;
+                while (tokens.remaining() > 0) {
+                    std::string_view corner = tokens.nextToken();
+                    std::size_t      slash  = corner.find('/');
+                    uint vid = tokenToNumber<uint>(corner.substr(0, slash)) - 1;
+                    c.cornerVertices.push_back(vid);
 
-    // first, need to check if I can store normals in the mesh
-    if (vn == 0) {
-        if (settings.enableOptionalComponents) {
-            enableIfPerVertexNormalOptional(m);
-            loadedInfo.setPerVertexNormal();
-        }
-        else {
-            if (isPerVertexNormalAvailable(m))
-                loadedInfo.setPerVertexNormal();
-        }
-    }
-    if (loadedInfo.hasPerVertexNormal()) {
-        // read the normal
-        NormalType n;
-        for (uint i = 0; i < 3; ++i) {
-            n[i] = io::readDouble<typename NormalType::ScalarType>(token);
-        }
-        // I can store the normal in its vertex
-        if (m.vertexNumber() > vn) {
-            m.vertex(vn).normal() = n;
+                    uint wid = UINT_NULL;
+                    if (slash != std::string_view::npos) {
+                        std::string_view t = corner.substr(slash + 1);
+                        t                  = t.substr(0, t.find('/'));
+                        if (!t.empty())
+                            wid = tokenToNumber<uint>(t) - 1;
+                        else
+                            hasTexCoords = false;
+                    }
+                    else {
+                        hasTexCoords = false;
+                    }
+                    c.cornerTexCoords.push_back(wid);
+                }
+                c.faceHasTexCoords.push_back(hasTexCoords);
+                c.faceReadVertices.push_back(c.vertexNumber());
+                c.faceReadTexCoords.push_back(c.texCoordNumber());
+                c.faceOffsets.push_back(c.cornerVertices.size());
+            }
+            c.nFaceLines++;
         }
-        // read the normal and save it in the cache map, because we still don't
-        // have read the vertex corresponding to the current normal
-        else {
-            mapNormalsCache[vn] = n;
+        else if (header == "l") {
+            if constexpr (HasEdges<MeshType>) {
+                for (uint i = 0; i < 2; ++i)
+                    c.edges.push_back(tokens.next<uint>() - 1);
+            }
+            c.nEdgeLines++;
         }
     }
 }
 
+/*
+ * Sets the k-th face of the chunk c in the face fid of the mesh, that must have
+ * been already added. If the face must be split into triangles, the triangles
+ * after the first one are appended to the mesh: in this case, the function
+ * cannot be called concurrently.
+ *
+ * vOffset and tOffset are the number of vertices and texcoords read in the
+ * file before the chunk, used to validate the indices of the face.
+ */
 template<FaceMeshConcept MeshType>
-void readObjFace(
+void setObjFace(
     MeshType&                            m,
-    MeshInfo&                            loadedInfo,
-    const Tokenizer&                     tokens,
-    const std::vector<TexCoordIndexedd>& wedgeTexCoords,
-    const ObjMaterial&                   currentMaterial,
-    const LoadSettings&                  settings)
+    uint                                 fid,
+    const ObjChunk&                      c,
+    uint                                 k,
+    uint                                 vOffset,
+    uint                                 tOffset,
+    const ObjMaterial&                   material,
+    const std::vector<TexCoordIndexedd>& texCoords,
+    const MeshInfo&                      loadedInfo)
 {
     using FaceType = MeshType::FaceType;
 
-    std::vector<uint> vids;
-    std::vector<uint> wids;
-
-    loadedInfo.updateMeshType(tokens.size() - 1);
-
-    // actual read - load vertex indices and texcoords indices, if present
-    Tokenizer::iterator token = tokens.begin();
-    ++token;
-    vids.resize(tokens.size() - 1);
-    wids.reserve(tokens.size() - 1);
-    for (uint i = 0; i < tokens.size() - 1; ++i) {
-        Tokenizer subt(*token, '/', false);
-        auto      t = subt.begin();
-        vids[i]     = io::readUInt<uint>(t) - 1;
-        if (subt.size() > 1) {
-            if (!t->empty()) {
-                wids.push_back(io::readUInt<uint>(t) - 1);
-            }
+    const uint  begin = c.faceOffsets[k];
+    const uint  size  = c.faceOffsets[k + 1] - begin;
+    const uint* vids  = c.cornerVertices.data() + begin;
+    const uint* wids  = c.cornerTexCoords.data() + begin;
+
+    // a face can reference only the vertices (texcoords) read before it
+    for (uint i = 0; i < size; ++i) {
+        if (vids[i] >= vOffset + c.faceReadVertices[k]) {
+            throw MalformedFileException(
+                "Bad vertex index for face " + std::to_string(fid));
+        }
+    }
+    const bool wedges = HasPerFaceWedgeTexCoords<MeshType> &&
+                        loadedInfo.hasPerFaceWedgeTexCoords() &&
+                        c.faceHasTexCoords[k];
+    for (uint i = 0; wedges && i < size; ++i) {
+        if (wids[i] >= tOffset + c.faceReadTexCoords[k]) {
+            throw MalformedFileException(
+                "Bad texcoord index for face " + std::to_string(fid));
         }
-        ++token;
     }
 
-    // add the face
-    uint      fid = m.addFace();
-    FaceType& f   = m.face(fid);
+    FaceType& f = m.face(fid);
 
     // check if we need to split the face we read into triangles
     bool splitFace = false;
     // we have a polygonal mesh, no need to split
     if constexpr (FaceType::VERTEX_NUMBER < 0) {
         // need to resize to the right number of verts
-        f.resizeVertices(tokens.size() - 1);
+        f.resizeVertices(size);
     }
-    else if (FaceType::VERTEX_NUMBER != tokens.size() - 1) {
+    else if (FaceType::VERTEX_NUMBER != size) {
         // we have faces with static sizes (triangles), but we are loading faces
         // with number of verts > 3. Need to split the face we are loading in n
         // faces!
         splitFace = true;
     }
 
-    // create the face in the mesh, for now we manage only vertex indices
+    uint lastFace = fid + 1;
     if (!splitFace) { // no need to split face case
-        for (uint i = 0; i < vids.size(); ++i) {
-            if (vids[i] >= m.vertexNumber()) {
-                throw MalformedFileException(
-                    "Bad vertex index for face " + std::to_string(fid));
-            }
+        for (uint i = 0; i < size; ++i)
             f.setVertex(i, vids[i]);
-        }
     }
     else { // split needed
-        addTriangleFacesFromPolygon(m, f, vids);
+        addTriangleFacesFromPolygon(
+            m, f, std::vector<uint>(vids, vids + size));
+        lastFace = m.faceNumber();
     }
 
     // color
-    if (HasPerFaceColor<MeshType>) {
-        // if the first face, we need to check if I can store colors
-        if (fid == 0) {
-            // if the current material has no color, we assume that the file has
-            // no face color
-            if (currentMaterial.hasColor) {
-                if (settings.enableOptionalComponents) {
-                    enableIfPerFaceColorOptional(m);
-                    loadedInfo.setPerFaceColor();
-                }
-                else {
-                    if (isPerFaceColorAvailable(m))
-                        loadedInfo.setPerFaceColor();
-                }
-            }
-        }
-        if (loadedInfo.hasPerFaceColor()) {
-            if (currentMaterial.hasColor) {
-                // in case the loaded polygon has been triangulated in the last
-                // n triangles of mesh
-                for (uint ff = fid; ff < m.faceNumber(); ++ff) {
-                    m.face(ff).color() = currentMaterial.color();
-                }
-            }
+    if constexpr (HasPerFaceColor<MeshType>) {
+        if (loadedInfo.hasPerFaceColor() && material.hasColor) {
+            // in case the loaded polygon has been triangulated in the last n
+            // triangles of mesh
+            for (uint ff = fid; ff < lastFace; ++ff)
+                m.face(ff).color() = material.color();
         }
     }
 
     // wedge texcoords
     if constexpr (HasPerFaceWedgeTexCoords<MeshType>) {
-        // first, need to check if I can store wedge texcoords in the mesh
-        if (fid == 0) {
-            // if the current face has the right number of wedge texcoords, we
-            // assume that we can load wedge texcoords
-            if (wids.size() == vids.size()) {
-                if (settings.enableOptionalComponents) {
-                    enableIfPerFaceWedgeTexCoordsOptional(m);
-                    loadedInfo.setPerFaceWedgeTexCoords();
-                }
-                else {
-                    if (isPerFaceWedgeTexCoordsAvailable(m))
-                        loadedInfo.setPerFaceWedgeTexCoords();
-                }
-            }
-        }
-        if (loadedInfo.hasPerFaceWedgeTexCoords()) {
-            if (wids.size() == vids.size()) {
-                if (!splitFace) { // there wasn't a triangulation of the face
-                    // it is safe to assign each wedge texcoord to its position
-                    // in the face
-                    for (uint i = 0; i < wids.size(); ++i) {
-                        if (wids[i] >= wedgeTexCoords.size()) {
-                            throw MalformedFileException(
-                                "Bad texcoord index for face " +
-                                std::to_string(fid));
-                        }
-                        f.wedgeTexCoord(i) =
-                            ((vcl::TexCoordd) wedgeTexCoords[wids[i]])
-                                .cast<typename FaceType::WedgeTexCoordType::
-                                          ScalarType>();
-                        if (currentMaterial.hasTexture) {
-                            f.textureIndex() = currentMaterial.mapId;
-                        }
-                    }
-                }
-                else {
-                    // take read texcoords and map them in the triangulated
-                    // faces for each face of the triangulation of the polygon
-                    for (uint ff = fid; ff < m.faceNumber(); ++ff) {
-                        FaceType& f = m.face(ff);
-                        // for each vertex of the face
-                        for (uint i = 0; i < f.vertexNumber(); ++i) {
-                            uint vid = m.index(f.vertex(i));
-                            // find the position of the vertex in the vids array
-                            auto it = std::find(vids.begin(), vids.end(), vid);
-                            assert(it != vids.end());
-                            uint pos = it - vids.begin();
-                            // check that the texcoord id is valid
-                            if (wids[pos] >= wedgeTexCoords.size()) {
-                                throw MalformedFileException(
-                                    "Bad texcoord index for face " +
-                                    std::to_string(fid));
-                            }
-                            // set the wedge texcoord in the same position of
-                            // the vertex
-                            f.wedgeTexCoord(i) =
-                                ((vcl::TexCoordd) wedgeTexCoords[wids[pos]])
-                                    .cast<typename FaceType::WedgeTexCoordType::
-                                              ScalarType>();
-                            if (currentMaterial.hasTexture) {
-                                f.textureIndex() = currentMaterial.mapId;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-template<EdgeMeshConcept MeshType>
-void readObjEdge(
-    MeshType&           m,
-    MeshInfo&           loadedInfo,
-    const Tokenizer&    tokens,
-    const ObjMaterial&  currentMaterial,
-    const LoadSettings& settings)
-{
-    using EdgeType = MeshType::EdgeType;
-
-    // add the edge
-    uint      eid = m.addEdge();
-    EdgeType& e   = m.edge(eid);
-
-    // actual read - load vertex indices
-    Tokenizer::iterator token = tokens.begin();
-    ++token;
-    uint vid1 = io::readUInt<uint>(token) - 1;
-    uint vid2 = io::readUInt<uint>(token) - 1;
-    e.setVertices(vid1, vid2);
+        using WedgeScalar = FaceType::WedgeTexCoordType::ScalarType;
 
-    // color
-    if (HasPerEdgeColor<MeshType>) {
-        // if the first edge, we need to check if I can store colors
-        if (eid == 0) {
-            // if the current material has no color, we assume that the file has
-            // no edge color
-            if (currentMaterial.hasColor) {
-                if (settings.enableOptionalComponents) {
-                    enableIfPerEdgeColorOptional(m);
-                    loadedInfo.setPerEdgeColor();
+        if (wedges) {
+            // take read texcoords and map them in the faces (more than one if
+            // the polygon has been triangulated): each wedge texcoord is set in
+            // the same position of its vertex
+            for (uint ff = fid; ff < lastFace; ++ff) {
+                FaceType& f = m.face(ff);
+                for (uint i = 0; i < f.vertexNumber(); ++i) {
+                    uint pos = i;
+                    if (splitFace) {
+                        uint vid = m.index(f.vertex(i));
+                        pos      = std::find(vids, vids + size, vid) - vids;
+                        assert(pos < size);
+                    }
+                    f.wedgeTexCoord(i) =
+                        ((TexCoordd) texCoords[wids[pos]]).cast<WedgeScalar>();
                 }
-                else {
-                    if (isPerEdgeColorAvailable(m))
-                        loadedInfo.setPerEdgeColor();
+                if (material.hasTexture) {
+                    f.textureIndex() = material.mapId;
                 }
             }
         }
-        if (loadedInfo.hasPerEdgeColor()) {
-            if (currentMaterial.hasColor) {
-                // set the current color to the edge
-                m.edge(eid).color() = currentMaterial.color();
-            }
-        }
     }
 }
 
 /**
  * @brief Actual implementation of loading an obj from a stream or a file.
  *
+ * The content of the stream is read in a single buffer and split into chunks
+ * of lines, that are parsed in parallel. The chunks are then stitched in order:
+ * materials, the optional components to enable and the validity of the indices
+ * are resolved sequentially, and the elements of each chunk are then stored in
+ * the mesh in parallel (except for polygons that must be triangulated).
+ *
  * @param[in] m: The mesh to fill with the data read from the file.
  * @param[in] inputObjStream: The stream from which to read the obj file.
  * @param[in] inputMtlStreams: A vector of streams from which to read the mtl
@@ -498,13 +519,6 @@ void loadObj(
 {
     loadedInfo.clear();
 
-    // save normals if they can't be stored directly into vertices
-    detail::ObjNormalsMap<MeshType> mapNormalsCache;
-    uint                            vn = 0; // number of vertex normals read
-    // save array of texcoords, that are stored later (into wedges when loading
-    // faces or into vertices as a fallback)
-    std::vector<TexCoordIndexedd> texCoords;
-
     // map of materials loaded
     std::map<std::string, detail::ObjMaterial> materialMap;
 
@@ -513,9 +527,6 @@ void loadObj(
         detail::loadObjMaterials(materialMap, m, *stream, loadedInfo, settings);
     }
 
-    // the current material, set by 'usemtl'
-    detail::ObjMaterial currentMaterial;
-
     if constexpr (HasTexturePaths<MeshType>) {
         m.meshBasePath() = FileInfo::pathWithoutFileName(filename);
     }
@@ -524,117 +535,346 @@ void loadObj(
         m.name() = FileInfo::fileNameWithoutExtension(filename);
     }
 
-    inputObjStream.seekg(0, inputObjStream.end);
-    std::size_t fsize = inputObjStream.tellg();
+    // progress: parsing of the chunks, then storing of the elements in the mesh
+    log.startProgress("Loading OBJ file", 2);
+
     inputObjStream.seekg(0, inputObjStream.beg);
-    log.startProgress("Loading OBJ file", fsize);
+    const std::string text = readRemainingStream(inputObjStream);
+    const std::vector<std::string_view> texts   = splitInLineChunks(text);
+    const uint                          nChunks = texts.size();
 
-    // cycle that reads line by line
-    do {
-        Tokenizer tokens =
-            readAndTokenizeNextNonEmptyLineNoThrow(inputObjStream);
-        if (inputObjStream) {
-            Tokenizer::iterator token  = tokens.begin();
-            std::string         header = *token++;
-            if (header == "mtllib" && !ignoreMtlLib) { // material file
+    std::vector<ObjChunk> chunks(nChunks);
+    parallelForTextChunks(nChunks, [&](uint i) {
+        parseObjChunk<MeshType>(texts[i], chunks[i]);
+    });
+
+    log.progress(1);
+
+    // global index of the first element of each chunk
+    auto offsets = [&](auto number) {
+        std::vector<uint> off(nChunks + 1, 0);
+        for (uint i = 0; i < nChunks; ++i)
+            off[i + 1] = off[i] + number(chunks[i]);
+        return off;
+    };
+    const std::vector<uint> vOffsets =
+        offsets([](const ObjChunk& c) { return c.vertexNumber(); });
+    const std::vector<uint> nOffsets =
+        offsets([](const ObjChunk& c) { return c.normalNumber(); });
+    const std::vector<uint> tOffsets =
+        offsets([](const ObjChunk& c) { return c.texCoordNumber(); });
+    const std::vector<uint> fOffsets =
+        offsets([](const ObjChunk& c) { return c.faceNumber(); });
+    const std::vector<uint> eOffsets =
+        offsets([](const ObjChunk& c) { return c.edgeNumber(); });
+
+    // first chunk containing elements of a type, UINT_NULL if there is none
+    auto firstChunk = [&](const std::vector<uint>& off) {
+        for (uint i = 0; i < nChunks; ++i) {
+            if (off[i + 1] > off[i])
+                return i;
+        }
+        return UINT_NULL;
+    };
+
+    // replay the mtllib and usemtl lines in order: the materials set by usemtl
+    // are stored in a vector, and the first one is the default material
+    std::vector<ObjMaterial> materials(1);
+    std::vector<uint>        chunkMaterials(nChunks);
+    uint                     currentMaterial = 0;
+    for (uint i = 0; i < nChunks; ++i) {
+        chunkMaterials[i] = currentMaterial;
+        for (ObjChunkEvent& e : chunks[i].events) {
+            if (e.isMtlLib) {
                 // we load the material file if they are not ignored
-                std::string mtlfile =
-                    FileInfo::pathWithoutFileName(filename) + *token;
-                try {
-                    detail::loadObjMaterials(
-                        materialMap, m, mtlfile, loadedInfo, settings);
-                }
-                catch (CannotOpenFileException) {
-                    log.log(
-                        "Cannot open material file " + mtlfile,
-                        LogType::WARNING_LOG);
+                if (!ignoreMtlLib) {
+                    std::string mtlfile =
+                        FileInfo::pathWithoutFileName(filename) + e.name;
+                    try {
+                        detail::loadObjMaterials(
+                            materialMap, m, mtlfile, loadedInfo, settings);
+                    }
+                    catch (CannotOpenFileException) {
+                        log.log(
+                            "Cannot open material file " + mtlfile,
+                            LogType::WARNING_LOG);
+                    }
                 }
             }
-            // use a new material - change currentMaterial
-            if (header == "usemtl") {
-                std::string matname = *token;
-                auto        it      = materialMap.find(matname);
+            else {
+                auto it = materialMap.find(e.name);
                 if (it != materialMap.end()) {
-                    currentMaterial = it->second;
+                    materials.push_back(it->second);
+                    currentMaterial = materials.size() - 1;
                 }
                 else { // material not found - warning
                     log.log(
-                        "Material " + matname + " not found.",
+                        "Material " + e.name + " not found.",
                         LogType::WARNING_LOG);
                 }
             }
-            // read vertex (and for some non-standard obj files, also vertex
-            // color)
-            if (header == "v") {
-                loadedInfo.setVertices();
-                loadedInfo.setPerVertexPosition();
-                detail::readObjVertex(
-                    m, token, loadedInfo, tokens, currentMaterial, settings);
+            e.material = currentMaterial;
+        }
+    }
+
+    // material of the first element of a type, given the first chunk that
+    // contains an element of that type
+    auto firstMaterial = [&](uint chunk, uint ObjChunkEvent::* count) {
+        return materials[ObjMaterialCursor(
+            chunks[chunk], count, chunkMaterials[chunk])(0)];
+    };
+
+    // vertices
+    const uint nv = vOffsets.back();
+    if (nv > 0) {
+        loadedInfo.setVertices();
+        loadedInfo.setPerVertexPosition();
+    }
+    if constexpr (HasPerVertexColor<MeshType>) {
+        if (nv > 0) {
+            const uint c = firstChunk(vOffsets);
+            // if the material of the first vertex has a valid color, or the
+            // file stores the vertex color in the non-standard way
+            if (firstMaterial(c, &ObjChunkEvent::nVertices).hasColor ||
+                chunks[c].vertexHasColor[0]) {
+                if (settings.enableOptionalComponents) {
+                    enableIfPerVertexColorOptional(m);
+                    loadedInfo.setPerVertexColor();
+                }
+                else {
+                    if (isPerVertexColorAvailable(m))
+                        loadedInfo.setPerVertexColor();
+                }
             }
-            // read vertex normal (and save in vn how many normals we read)
-            if (header == "vn") {
-                loadedInfo.setPerVertexNormal();
-                if constexpr (HasPerVertexNormal<MeshType>) {
-                    detail::readObjVertexNormal(
-                        m, mapNormalsCache, vn, token, loadedInfo, settings);
-                    vn++;
+        }
+    }
+    if (std::ranges::any_of(chunks, [](const ObjChunk& c) {
+            return c.nNormalLines > 0;
+        })) {
+        loadedInfo.setPerVertexNormal();
+        if constexpr (HasPerVertexNormal<MeshType>) {
+            if (settings.enableOptionalComponents)
+                enableIfPerVertexNormalOptional(m);
+        }
+    }
+
+    m.addVertices(nv);
+    parallelForTextChunks(nChunks, [&](uint i) {
+        const ObjChunk&   c = chunks[i];
+        ObjMaterialCursor material(
+            c, &ObjChunkEvent::nVertices, chunkMaterials[i]);
+        for (uint k = 0; k < c.vertexNumber(); ++k) {
+            auto& v = m.vertex(vOffsets[i] + k);
+            for (uint j = 0; j < 3; ++j)
+                v.position()[j] = c.positions[k * 3 + j];
+            if constexpr (HasPerVertexColor<MeshType>) {
+                if (loadedInfo.hasPerVertexColor()) {
+                    const ObjMaterial& mat = materials[material(k)];
+                    if (c.vertexHasColor[k]) {
+                        v.color().setRedF(c.colors[k * 3]);
+                        v.color().setGreenF(c.colors[k * 3 + 1]);
+                        v.color().setBlueF(c.colors[k * 3 + 2]);
+                    }
+                    else if (mat.hasColor) {
+                        v.color() = mat.color();
+                    }
                 }
             }
-            // read texcoords and save them in the vector of texcoords, we will
-            // store them in the mesh later
-            if constexpr (
-                HasPerVertexTexCoord<MeshType> ||
-                HasPerFaceWedgeTexCoords<MeshType>) {
-                if (header == "vt") {
-                    // save the texcoord for later
-                    TexCoordIndexedd tf;
-                    for (uint i = 0; i < 2; ++i) {
-                        tf[i] = io::readDouble<double>(token);
+        }
+    });
+
+    // normals: the i-th normal is set to the i-th vertex
+    if constexpr (HasPerVertexNormal<MeshType>) {
+        using NormalType = MeshType::VertexType::NormalType;
+        using NScalar    = NormalType::ScalarType;
+
+        if (isPerVertexNormalAvailable(m)) {
+            parallelForTextChunks(nChunks, [&](uint i) {
+                const ObjChunk& c = chunks[i];
+                for (uint k = 0; k < c.normalNumber(); ++k) {
+                    const uint vi = nOffsets[i] + k;
+                    if (vi < nv) {
+                        m.vertex(vi).normal() = NormalType(
+                            NScalar(c.normals[k * 3]),
+                            NScalar(c.normals[k * 3 + 1]),
+                            NScalar(c.normals[k * 3 + 2]));
+                    }
+                }
+            });
+        }
+    }
+
+    // save array of texcoords, that are stored later (into wedges when loading
+    // faces or into vertices as a fallback)
+    std::vector<TexCoordIndexedd> texCoords(tOffsets.back());
+    parallelForTextChunks(nChunks, [&](uint i) {
+        const ObjChunk&   c = chunks[i];
+        ObjMaterialCursor material(
+            c, &ObjChunkEvent::nTexCoords, chunkMaterials[i]);
+        for (uint k = 0; k < c.texCoordNumber(); ++k) {
+            TexCoordIndexedd& tf = texCoords[tOffsets[i] + k];
+            tf[0]                = c.texCoords[k * 2];
+            tf[1]                = c.texCoords[k * 2 + 1];
+            const ObjMaterial& mat = materials[material(k)];
+            if (mat.hasTexture) {
+                tf.index() = mat.mapId;
+            }
+        }
+    });
+
+    // faces, and the eventual split of polygonal faces into triangles
+    if (std::ranges::any_of(chunks, [](const ObjChunk& c) {
+            return c.nFaceLines > 0;
+        })) {
+        loadedInfo.setFaces();
+        loadedInfo.setPerFaceVertexReferences();
+    }
+    if constexpr (HasFaces<MeshType>) {
+        using FaceType = MeshType::FaceType;
+
+        bool splitFaces = false;
+        for (uint i = 0; i < nChunks; ++i) {
+            const ObjChunk& c = chunks[i];
+            if (c.faceNumber() == 0)
+                continue;
+            loadedInfo.updateMeshType(c.firstFaceSize);
+            if (c.otherFaceSize != UINT_NULL)
+                loadedInfo.updateMeshType(c.otherFaceSize);
+            if constexpr (FaceType::VERTEX_NUMBER > 0) {
+                splitFaces |=
+                    c.firstFaceSize != FaceType::VERTEX_NUMBER ||
+                    c.otherFaceSize != UINT_NULL;
+            }
+        }
+
+        const uint nf = fOffsets.back();
+        if (nf > 0) {
+            const uint      fc = firstChunk(fOffsets);
+            const ObjChunk& c  = chunks[fc];
+
+            // if the material of the first face has no color, we assume that
+            // the file has no face color
+            if constexpr (HasPerFaceColor<MeshType>) {
+                if (firstMaterial(fc, &ObjChunkEvent::nFaces).hasColor) {
+                    if (settings.enableOptionalComponents) {
+                        enableIfPerFaceColorOptional(m);
+                        loadedInfo.setPerFaceColor();
+                    }
+                    else {
+                        if (isPerFaceColorAvailable(m))
+                            loadedInfo.setPerFaceColor();
+                    }
+                }
+            }
+            // if the first face has a texcoord for each corner, we assume that
+            // we can load wedge texcoords
+            if constexpr (HasPerFaceWedgeTexCoords<MeshType>) {
+                if (c.faceHasTexCoords[0]) {
+                    if (settings.enableOptionalComponents) {
+                        enableIfPerFaceWedgeTexCoordsOptional(m);
+                        loadedInfo.setPerFaceWedgeTexCoords();
                     }
-                    if (currentMaterial.hasTexture) {
-                        tf.index() = currentMaterial.mapId;
+                    else {
+                        if (isPerFaceWedgeTexCoordsAvailable(m))
+                            loadedInfo.setPerFaceWedgeTexCoords();
                     }
-                    texCoords.push_back(tf);
                 }
             }
-            // read faces and manage:
-            // - color
-            // - eventual texcoords
-            // - possibility to split polygonal face into several triangles
-            if (header == "f") {
-                loadedInfo.setFaces();
-                loadedInfo.setPerFaceVertexReferences();
-                if constexpr (HasFaces<MeshType>) {
-                    detail::readObjFace(
+        }
+
+        if (!splitFaces) {
+            // each face of the file is a face of the mesh
+            m.addFaces(nf);
+            parallelForTextChunks(nChunks, [&](uint i) {
+                const ObjChunk&   c = chunks[i];
+                ObjMaterialCursor material(
+                    c, &ObjChunkEvent::nFaces, chunkMaterials[i]);
+                for (uint k = 0; k < c.faceNumber(); ++k) {
+                    setObjFace(
                         m,
-                        loadedInfo,
-                        tokens,
+                        fOffsets[i] + k,
+                        c,
+                        k,
+                        vOffsets[i],
+                        tOffsets[i],
+                        materials[material(k)],
                         texCoords,
-                        currentMaterial,
-                        settings);
+                        loadedInfo);
                 }
-            }
-            // read edges and manage their color
-            if (header == "l") {
-                loadedInfo.setEdges();
-                loadedInfo.setPerEdgeVertexReferences();
-                if constexpr (HasEdges<MeshType>) {
-                    detail::readObjEdge(
-                        m, loadedInfo, tokens, currentMaterial, settings);
+            });
+        }
+        else {
+            m.reserveFaces(nf);
+            for (uint i = 0; i < nChunks; ++i) {
+                const ObjChunk&   c = chunks[i];
+                ObjMaterialCursor material(
+                    c, &ObjChunkEvent::nFaces, chunkMaterials[i]);
+                for (uint k = 0; k < c.faceNumber(); ++k) {
+                    setObjFace(
+                        m,
+                        m.addFace(),
+                        c,
+                        k,
+                        vOffsets[i],
+                        tOffsets[i],
+                        materials[material(k)],
+                        texCoords,
+                        loadedInfo);
                 }
             }
-            log.progress(inputObjStream.tellg());
         }
-    } while (inputObjStream);
+    }
 
-    if constexpr (HasPerVertexNormal<MeshType>) {
-        // set all vertex normals that have not been stored in vertices
-        for (const auto& p : mapNormalsCache) {
-            if (p.first < m.vertexNumber()) {
-                m.vertex(p.first).normal() = p.second;
+    // edges and their color
+    if (std::ranges::any_of(chunks, [](const ObjChunk& c) {
+            return c.nEdgeLines > 0;
+        })) {
+        loadedInfo.setEdges();
+        loadedInfo.setPerEdgeVertexReferences();
+    }
+    if constexpr (HasEdges<MeshType>) {
+        const uint ne = eOffsets.back();
+        if constexpr (HasPerEdgeColor<MeshType>) {
+            // if the material of the first edge has no color, we assume that
+            // the file has no edge color
+            if (ne > 0 &&
+                firstMaterial(firstChunk(eOffsets), &ObjChunkEvent::nEdges)
+                    .hasColor) {
+                if (settings.enableOptionalComponents) {
+                    enableIfPerEdgeColorOptional(m);
+                    loadedInfo.setPerEdgeColor();
+                }
+                else {
+                    if (isPerEdgeColorAvailable(m))
+                        loadedInfo.setPerEdgeColor();
+                }
             }
         }
+
+        m.addEdges(ne);
+        parallelForTextChunks(nChunks, [&](uint i) {
+            const ObjChunk&   c = chunks[i];
+            ObjMaterialCursor material(
+                c, &ObjChunkEvent::nEdges, chunkMaterials[i]);
+            for (uint k = 0; k < c.edgeNumber(); ++k) {
+                const uint eid = eOffsets[i] + k;
+                if (c.edges[k * 2] >= nv || c.edges[k * 2 + 1] >= nv) {
+                    throw MalformedFileException(
+                        "Bad vertex index for edge " + std::to_string(eid));
+                }
+                auto& e = m.edge(eid);
+                e.setVertices(c.edges[k * 2], c.edges[k * 2 + 1]);
+                if constexpr (HasPerEdgeColor<MeshType>) {
+                    const ObjMaterial& mat = materials[material(k)];
+                    if (loadedInfo.hasPerEdgeColor() && mat.hasColor) {
+                        // set the current color to the edge
+                        e.color() = mat.color();
+                    }
+                }
+            }
+        });
     }
+
     if constexpr (HasPerVertexTexCoord<MeshType>) {
         using VertexType = MeshType::VertexType;
         if (!loadedInfo.hasPerFaceWedgeTexCoords()) {
@@ -28,10 +28,16 @@
 #include <vclib/io/file_info.h>
 #include <vclib/io/mesh/settings.h>
 #include <vclib/io/read.h>
+#include <vclib/io/text_chunks.h>
 #include <vclib/misc/logger.h>
 #include <vclib/misc/tokenizer.h>
 #include <vclib/space/complex/mesh_info.h>
 
+#include <iterator>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
 namespace vcl {
 
 namespace detail {
@@ -274,12 +280,14 @@ inline void readOffHeader(
     //    loadedInfo.setEdges();
 }
 
-inline Color readOffColor(Tokenizer::iterator& token, int nColorComponents)
+inline Color readOffColor(TextLineTokens& tokens, int nColorComponents)
 {
     uint red, green, blue, alpha = 255;
 
     if (nColorComponents == 1) {
-        uint k = io::readUInt<uint>(token);
+        uint k = tokens.next<uint>();
+        if (k >= std::size(OFF_GEOMVIEW_COLOR_MAP))
+            throw MalformedFileException("Bad color map index in line.");
 
         red   = OFF_GEOMVIEW_COLOR_MAP[k][0] * 255;
         green = OFF_GEOMVIEW_COLOR_MAP[k][1] * 255;
@@ -287,12 +295,12 @@ inline Color readOffColor(Tokenizer::iterator& token, int nColorComponents)
         alpha = OFF_GEOMVIEW_COLOR_MAP[k][3] * 255;
     }
     else {
-        double r = io::readDouble<double>(token);
-        double g = io::readDouble<double>(token);
-        double b = io::readDouble<double>(token);
+        double r = tokens.next<double>();
+        double g = tokens.next<double>();
+        double b = tokens.next<double>();
         double a = -1;
         if (nColorComponents == 4) {
-            a = io::readDouble<double>(token);
+            a = tokens.next<double>();
         }
         if (r > 1 || g > 1 || b > 1) {
             red   = r;
@@ -310,175 +318,161 @@ inline Color readOffColor(Tokenizer::iterator& token, int nColorComponents)
     return Color(red, green, blue, alpha);
 }
 
-template<MeshConcept MeshType, LoggerConcept LogType>
-void readOffVertices(
-    MeshType&       mesh,
-    std::istream&   file,
-    const MeshInfo& fileInfo,
-    uint            nv,
-    LogType&        log)
+/*
+ * The faces read from a chunk of lines of an off file: they are stored in the
+ * mesh only after all the chunks have been read, since a polygon may need to
+ * be split into a number of triangles.
+ */
+struct OffFaceChunk
 {
-    using VertexType = MeshType::VertexType;
+    // the vertices of the i-th face are in [offsets[i], offsets[i+1])
+    std::vector<uint>  offsets = {0};
+    std::vector<uint>  vertices;
+    std::vector<Color> colors; // valid if hasColor
+    std::vector<bool>  hasColor;
 
-    const uint nTexCoords = fileInfo.hasPerVertexTexCoord() ? 2 : 0;
+    // size of the first face, and first size different from it
+    uint firstSize = UINT_NULL;
+    uint otherSize = UINT_NULL;
 
-    log.startProgress("Reading vertices", nv);
-    mesh.addVertices(nv);
-    for (uint i = 0; i < nv; i++) {
-        VertexType& v = mesh.vertex(i);
+    uint faceNumber() const { return offsets.size() - 1; }
+};
 
-        Tokenizer           tokens = readAndTokenizeNextNonEmptyLine(file);
-        Tokenizer::iterator token  = tokens.begin();
+template<MeshConcept MeshType>
+void readOffVertex(
+    MeshType&                     mesh,
+    typename MeshType::VertexType& v,
+    TextLineTokens&               tokens,
+    const MeshInfo&               fileInfo)
+{
+    const uint nTexCoords = fileInfo.hasPerVertexTexCoord() ? 2 : 0;
 
-        // Read 3 vertex coordinates
-        for (unsigned int j = 0; j < 3; j++) {
-            // Read vertex coordinate
-            v.position()[j] = io::readDouble<double>(token);
-        }
+    // Read 3 vertex coordinates
+    for (uint j = 0; j < 3; j++) {
+        v.position()[j] = tokens.next<double>();
+    }
 
-        if constexpr (HasPerVertexNormal<MeshType>) {
-            if (isPerVertexNormalAvailable(mesh) &&
-                fileInfo.hasPerVertexNormal()) {
-                // Read 3 normal coordinates
-                for (unsigned int j = 0; j < 3; j++) {
-                    v.normal()[j] = io::readDouble<double>(token);
-                }
+    // the data that cannot be stored in the mesh is read and thrown away
+    if (fileInfo.hasPerVertexNormal()) {
+        for (uint j = 0; j < 3; j++) {
+            double n = tokens.next<double>();
+            if constexpr (HasPerVertexNormal<MeshType>) {
+                if (isPerVertexNormalAvailable(mesh))
+                    v.normal()[j] = n;
             }
         }
-        // need to read and throw away data
-        else if (fileInfo.hasPerVertexNormal()) {
-            for (unsigned int j = 0; j < 3; j++) {
-                io::readDouble<double>(token);
-            }
-        }
-
-        const uint nReadComponents = token - tokens.begin();
-        const int  nColorComponents =
-            (int) tokens.size() - nReadComponents - nTexCoords;
+    }
 
+    if (fileInfo.hasPerVertexColor()) {
+        const int nColorComponents = (int) tokens.remaining() - nTexCoords;
+        if (nColorComponents != 1 && nColorComponents != 3 &&
+            nColorComponents != 4)
+            throw MalformedFileException(
+                "Wrong number of components in line.");
+        Color c = readOffColor(tokens, nColorComponents);
         if constexpr (HasPerVertexColor<MeshType>) {
-            if (isPerVertexColorAvailable(mesh) &&
-                fileInfo.hasPerVertexColor()) {
-                if (nColorComponents != 1 && nColorComponents != 3 &&
-                    nColorComponents != 4)
-                    throw MalformedFileException(
-                        "Wrong number of components in line.");
-                v.color() = readOffColor(token, nColorComponents);
-            }
-        }
-        // need to read and throw away data
-        else if (fileInfo.hasPerVertexColor()) {
-            if (nColorComponents != 1 && nColorComponents != 3 &&
-                nColorComponents != 4)
-                throw MalformedFileException(
-                    "Wrong number of components in line.");
-            readOffColor(token, nColorComponents);
+            if (isPerVertexColorAvailable(mesh))
+                v.color() = c;
         }
+    }
 
-        if constexpr (HasPerVertexTexCoord<MeshType>) {
-            if (isPerVertexTexCoordAvailable(mesh) &&
-                fileInfo.hasPerVertexTexCoord()) {
-                // Read 2 tex coordinates
-                for (unsigned int j = 0; j < 2; j++) {
-                    v.texCoord()[j] = io::readDouble<double>(token);
-                }
-            }
-        }
-        // need to read and throw away data
-        else if (fileInfo.hasPerVertexTexCoord()) {
-            for (unsigned int j = 0; j < 2; j++) {
-                io::readDouble<double>(token);
+    if (fileInfo.hasPerVertexTexCoord()) {
+        for (uint j = 0; j < 2; j++) {
+            double t = tokens.next<double>();
+            if constexpr (HasPerVertexTexCoord<MeshType>) {
+                if (isPerVertexTexCoordAvailable(mesh))
+                    v.texCoord()[j] = t;
             }
         }
+    }
+}
 
-        log.progress(i);
+template<FaceMeshConcept MeshType>
+void readOffFace(TextLineTokens& tokens, OffFaceChunk& c, uint nv, uint fid)
+{
+    // read vertex indices
+    uint fSize = tokens.next<uint>();
+    if (c.faceNumber() == 0)
+        c.firstSize = fSize;
+    else if (fSize != c.firstSize)
+        c.otherSize = fSize;
+    for (uint i = 0; i < fSize; ++i) {
+        uint vid = tokens.next<uint>();
+        if (vid >= nv) {
+            throw MalformedFileException(
+                "Bad vertex index for face " + std::to_string(fid));
+        }
+        c.vertices.push_back(vid);
     }
-    log.endProgress();
+    c.offsets.push_back(c.vertices.size());
+
+    // read face color, if there are colors to read
+    bool  hasColor = false;
+    Color color;
+    if constexpr (HasPerFaceColor<MeshType>) {
+        if (tokens.remaining() > 0) {
+            hasColor = true;
+            color    = readOffColor(tokens, tokens.remaining());
+        }
+    }
+    c.hasColor.push_back(hasColor);
+    c.colors.push_back(color);
 }
 
-template<FaceMeshConcept MeshType, LoggerConcept LogType>
-void readOffFaces(
+/*
+ * Sets the k-th face of the chunk c in the face fid of the mesh, that must have
+ * been already added. If the face must be split into triangles, the triangles
+ * after the first one are appended to the mesh: in this case, the function
+ * cannot be called concurrently.
+ */
+template<FaceMeshConcept MeshType>
+void setOffFace(
     MeshType&           mesh,
-    std::istream&       file,
-    MeshInfo&           loadedInfo,
-    uint                nf,
-    const LoadSettings& settings,
-    LogType&            log)
+    uint                fid,
+    const OffFaceChunk& c,
+    uint                k,
+    const MeshInfo&     loadedInfo)
 {
-    if constexpr (HasFaces<MeshType>) {
-        using FaceType = MeshType::FaceType;
+    using FaceType = MeshType::FaceType;
 
-        mesh.reserveFaces(nf);
-        log.startProgress("Reading faces", nf);
-
-        for (uint fid = 0; fid < nf; ++fid) {
-            Tokenizer           tokens = readAndTokenizeNextNonEmptyLine(file);
-            Tokenizer::iterator token  = tokens.begin();
-            mesh.addFace();
-            FaceType& f = mesh.face(mesh.faceNumber() - 1);
-
-            // read vertex indices
-            uint fSize = io::readUInt<uint>(token);
-            loadedInfo.updateMeshType(fSize);
-            // contains the vertex ids of the actual face
-            std::vector<uint> vids;
-            vids.resize(fSize);
-            // read vertex indices
-            for (uint i = 0; i < fSize; ++i) {
-                vids[i] = io::readUInt<uint>(token);
-            }
+    const uint  begin = c.offsets[k];
+    const uint  size  = c.offsets[k + 1] - begin;
+    const uint* vids  = c.vertices.data() + begin;
 
-            // load vertex indices into face
-            bool splitFace = false;
-            // we have a polygonal mesh
-            if constexpr (FaceType::VERTEX_NUMBER < 0) {
-                // need to resize to the right number of verts
-                f.resizeVertices(vids.size());
-            }
-            else if (FaceType::VERTEX_NUMBER != vids.size()) {
-                // we have faces with static sizes (triangles), but we are
-                // loading faces with number of verts > 3. Need to split the
-                // face we are loading in n faces!
-                splitFace = true;
-            }
-            if (!splitFace) { // classic load, no split needed
-                for (uint i = 0; i < vids.size(); ++i) {
-                    if (vids[i] >= mesh.vertexNumber()) {
-                        throw MalformedFileException(
-                            "Bad vertex index for face " + std::to_string(i));
-                    }
-                    f.setVertex(i, vids[i]);
-                }
-            }
-            else { // split needed
-                addTriangleFacesFromPolygon(mesh, f, vids);
-            }
+    FaceType& f = mesh.face(fid);
 
-            // read face color
-            if (token != tokens.end()) { // there are colors to read
-                if constexpr (HasPerFaceColor<MeshType>) {
-                    if (isPerFaceColorAvailable(mesh) ||
-                        (settings.enableOptionalComponents &&
-                         enableIfPerFaceColorOptional(mesh))) {
-                        loadedInfo.setPerFaceColor();
-                        f.color() = readOffColor(
-                            token, tokens.size() - (token - tokens.begin()));
-                        // in case the loaded polygon has been triangulated in
-                        // the last n triangles
-                        for (uint ff = mesh.index(f); ff < mesh.faceNumber();
-                             ++ff) {
-                            mesh.face(ff).color() = f.color();
-                        }
-                    }
-                }
-            }
-            log.progress(fid);
-        }
-        log.endProgress();
+    // load vertex indices into face
+    bool splitFace = false;
+    // we have a polygonal mesh
+    if constexpr (FaceType::VERTEX_NUMBER < 0) {
+        // need to resize to the right number of verts
+        f.resizeVertices(size);
+    }
+    else if (FaceType::VERTEX_NUMBER != size) {
+        // we have faces with static sizes (triangles), but we are loading faces
+        // with number of verts > 3. Need to split the face we are loading in n
+        // faces!
+        splitFace = true;
+    }
+
+    uint lastFace = fid + 1;
+    if (!splitFace) { // classic load, no split needed
+        for (uint i = 0; i < size; ++i)
+            f.setVertex(i, vids[i]);
     }
-    else { // mesh does not have face, read nf lines and throw them away
-        for (uint i = 0; i < nf; ++i)
-            readAndTokenizeNextNonEmptyLine(file);
+    else { // split needed
+        addTriangleFacesFromPolygon(
+            mesh, f, std::vector<uint>(vids, vids + size));
+        lastFace = mesh.faceNumber();
+    }
+
+    if constexpr (HasPerFaceColor<MeshType>) {
+        if (loadedInfo.hasPerFaceColor() && c.hasColor[k]) {
+            // in case the loaded polygon has been triangulated in the last n
+            // triangles
+            for (uint ff = fid; ff < lastFace; ++ff)
+                mesh.face(ff).color() = c.colors[k];
+        }
     }
 }
 
@@ -533,13 +527,104 @@ void loadOff(
     int percVertices = nVertices / (nVertices + nFaces) * 100;
     int percFaces    = 100 - percVertices;
 
+    // the rest of the file is read in a buffer, split into chunks of lines
+    // parsed in parallel: the global index of each line (and therefore if it is
+    // a vertex or a face) is given by the number of non-empty lines of the
+    // previous chunks
+    const std::string text = detail::readRemainingStream(inputOffStream);
+    const std::vector<std::string_view> texts =
+        detail::splitInLineChunks(text);
+    const uint nChunks = texts.size();
+    const uint nLines  = nVertices + (HasFaces<MeshType> ? nFaces : 0);
+
+    auto isEmptyLine = [](std::string_view line) {
+        return line.find_first_not_of(" \t") == std::string_view::npos;
+    };
+
+    std::vector<uint> lineOffsets(nChunks + 1, 0);
+    detail::parallelForTextChunks(nChunks, [&](uint i) {
+        std::string_view t = texts[i], line;
+        while (detail::nextTextLine(t, line)) {
+            if (!isEmptyLine(line))
+                lineOffsets[i + 1]++;
+        }
+    });
+    std::partial_sum(
+        lineOffsets.begin(), lineOffsets.end(), lineOffsets.begin());
+    if (lineOffsets.back() < nLines)
+        throw MalformedFileException("Unexpected end of file.");
+
     log.startNewTask(0, percVertices, "Reading vertices");
-    detail::readOffVertices(m, inputOffStream, fileInfo, nVertices, log);
+    m.addVertices(nVertices);
+    std::vector<detail::OffFaceChunk> faceChunks(nChunks);
+    detail::parallelForTextChunks(nChunks, [&](uint i) {
+        detail::TextLineTokens tokens;
+        std::string_view       t = texts[i], line;
+        uint                   l = lineOffsets[i];
+        while (l < nLines && detail::nextTextLine(t, line)) {
+            if (isEmptyLine(line))
+                continue;
+            tokens.split(line);
+            if (l < nVertices) {
+                detail::readOffVertex(m, m.vertex(l), tokens, fileInfo);
+            }
+            else if constexpr (HasFaces<MeshType>) {
+                detail::readOffFace<MeshType>(
+                    tokens, faceChunks[i], nVertices, l - nVertices);
+            }
+            ++l;
+        }
+    });
     log.endTask("Reading vertices");
+
     if constexpr (HasFaces<MeshType>) {
+        using FaceType = MeshType::FaceType;
+
         log.startNewTask(percVertices, 100, "Reading faces");
-        detail::readOffFaces(
-            m, inputOffStream, fileInfo, nFaces, settings, log);
+
+        bool splitFaces = false;
+        bool hasColors  = false;
+        for (const detail::OffFaceChunk& c : faceChunks) {
+            if (c.faceNumber() == 0)
+                continue;
+            fileInfo.updateMeshType(c.firstSize);
+            if (c.otherSize != UINT_NULL)
+                fileInfo.updateMeshType(c.otherSize);
+            if constexpr (FaceType::VERTEX_NUMBER > 0) {
+                splitFaces |= c.firstSize != FaceType::VERTEX_NUMBER ||
+                              c.otherSize != UINT_NULL;
+            }
+            hasColors |=
+                std::ranges::find(c.hasColor, true) != c.hasColor.end();
+        }
+        if constexpr (HasPerFaceColor<MeshType>) {
+            if (hasColors && (isPerFaceColorAvailable(m) ||
+                              (settings.enableOptionalComponents &&
+                               enableIfPerFaceColorOptional(m)))) {
+                fileInfo.setPerFaceColor();
+            }
+        }
+
+        if (!splitFaces) {
+            std::vector<uint> faceOffsets(nChunks + 1, 0);
+            for (uint i = 0; i < nChunks; ++i)
+                faceOffsets[i + 1] =
+                    faceOffsets[i] + faceChunks[i].faceNumber();
+
+            m.addFaces(nFaces);
+            detail::parallelForTextChunks(nChunks, [&](uint i) {
+                const detail::OffFaceChunk& c = faceChunks[i];
+                for (uint k = 0; k < c.faceNumber(); ++k)
+                    detail::setOffFace(m, faceOffsets[i] + k, c, k, fileInfo);
+            });
+        }
+        else {
+            m.reserveFaces(nFaces);
+            for (const detail::OffFaceChunk& c : faceChunks) {
+                for (uint k = 0; k < c.faceNumber(); ++k)
+                    detail::setOffFace(m, m.addFace(), c, k, fileInfo);
+            }
+        }
         log.endTask("Reading faces");
     }
     else {
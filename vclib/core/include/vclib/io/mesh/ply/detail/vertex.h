@@ -30,7 +30,12 @@
 #include <vclib/io/read.h>
 #include <vclib/io/write.h>
 #include <vclib/mesh/requirements.h>
+#include <vclib/misc/parallel.h>
 #include <vclib/misc/tokenizer.h>
+#include <vclib/serialization/endian.h>
+
+#include <cstring>
+#include <numeric>
 
 namespace vcl::detail {
 
@@ -230,6 +235,353 @@ void writePlyVertices(
     }
 }
 
+// number of vertices read from the stream with a single read call when the
+// binary block decoder is used
+inline constexpr uint PLY_VERTEX_BLOCK_SIZE = 1 << 16;
+
+// number of vertices decoded by each parallel task inside a block
+inline constexpr uint PLY_VERTEX_SUB_BLOCK_SIZE = 4096;
+
+/**
+ * @brief Decodes a column of n binary values of type `In`, starting at `data`
+ * and separated by `stride` bytes, and passes each value (converted to T)
+ * along with its index to the `set` function.
+ *
+ * The loop does not contain any branch on the type of the property, and the
+ * swap of the endianness (if needed) is applied to the whole column.
+ */
+template<typename T, typename In, typename SetFunction>
+void decodePlyBinaryColumn(
+    const char*   data,
+    uint          n,
+    uint          stride,
+    bool          swap,
+    SetFunction&& set)
+{
+    for (uint i = 0; i < n; ++i) {
+        In v;
+        std::memcpy(&v, data + std::size_t(i) * stride, sizeof(In));
+        if (swap)
+            v = swapEndian(v);
+        set(i, static_cast<T>(v));
+    }
+}
+
+template<typename T, typename SetFunction>
+void decodePlyBinaryColumn(
+    const char*   data,
+    uint          n,
+    uint          stride,
+    PrimitiveType type,
+    std::endian   end,
+    SetFunction&& set)
+{
+    const bool swap = end != std::endian::native;
+    switch (type) {
+    case PrimitiveType::CHAR:
+        decodePlyBinaryColumn<T, char>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::UCHAR:
+        decodePlyBinaryColumn<T, unsigned char>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::SHORT:
+        decodePlyBinaryColumn<T, int16_t>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::USHORT:
+        decodePlyBinaryColumn<T, uint16_t>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::INT:
+        decodePlyBinaryColumn<T, int32_t>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::UINT:
+        decodePlyBinaryColumn<T, uint32_t>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::FLOAT:
+        decodePlyBinaryColumn<T, float>(data, n, stride, swap, set);
+        break;
+    case PrimitiveType::DOUBLE:
+        decodePlyBinaryColumn<T, double>(data, n, stride, swap, set);
+        break;
+    default: assert(0);
+    }
+}
+
+// types of the per vertex custom components that can be read from a ply file
+using PlyCustomComponentTypes = TypeWrapper<
+    char,
+    unsigned char,
+    short,
+    unsigned short,
+    int,
+    uint,
+    float,
+    double>;
+
+template<MeshConcept MeshType, typename... T>
+bool isPlyCustomComponentReadable(
+    const MeshType&    mesh,
+    const std::string& name,
+    TypeWrapper<T...>)
+{
+    return (mesh.template isPerVertexCustomComponentOfType<T>(name) || ...);
+}
+
+/**
+ * @brief Decodes a column of n binary values directly into the contiguous
+ * values of the per vertex custom component having the given name, if the
+ * custom component is of type T. Returns true if the column has been decoded.
+ */
+template<typename T, MeshConcept MeshType>
+bool decodePlyCustomComponentColumn(
+    const char*        data,
+    uint               n,
+    uint               stride,
+    uint               first,
+    MeshType&          mesh,
+    const PlyProperty& p,
+    std::endian        end)
+{
+    if (!mesh.template isPerVertexCustomComponentOfType<T>(
+            p.unknownPropertyName))
+        return false;
+
+    T* values = mesh.template perVertexCustomComponentVectorHandle<T>(
+                        p.unknownPropertyName)
+                    .data() +
+                first;
+    decodePlyBinaryColumn<T>(data, n, stride, p.type, end, [&](uint i, T v) {
+        values[i] = v;
+    });
+    return true;
+}
+
+template<MeshConcept MeshType, typename... T>
+void decodePlyCustomComponentColumn(
+    const char*        data,
+    uint               n,
+    uint               stride,
+    uint               first,
+    MeshType&          mesh,
+    const PlyProperty& p,
+    std::endian        end,
+    TypeWrapper<T...>)
+{
+    (decodePlyCustomComponentColumn<T>(
+         data, n, stride, first, mesh, p, end) ||
+     ...);
+}
+
+/**
+ * @brief Returns true if the binary vertices described by the header can be
+ * read by the block decoder, i.e. if all the vertex properties have a fixed
+ * size and the ones that must be stored in a custom component have a
+ * primitive type. In this case, `stride` is set to the size in bytes of a
+ * vertex in the file.
+ */
+template<MeshConcept MeshType>
+bool isPlyVertexBlockReadable(
+    const PlyHeader& header,
+    const MeshType&  mesh,
+    uint&            stride)
+{
+    if (header.format() == ply::ASCII)
+        return false;
+
+    stride = 0;
+    for (const PlyProperty& p : header.vertexProperties()) {
+        if (p.list || sizeOf(p.type) == 0)
+            return false;
+        if (p.name == ply::unknown) {
+            if constexpr (HasPerVertexCustomComponents<MeshType>) {
+                if (mesh.hasPerVertexCustomComponent(
+                        p.unknownPropertyName) &&
+                    !isPlyCustomComponentReadable(
+                        mesh,
+                        p.unknownPropertyName,
+                        PlyCustomComponentTypes()))
+                    return false;
+            }
+        }
+        stride += sizeOf(p.type);
+    }
+    return stride > 0;
+}
+
+/**
+ * @brief Decodes the properties of n vertices stored in the binary buffer
+ * `data`, with the given stride, into the vertices of the mesh starting from
+ * the vertex having index `first`.
+ *
+ * The properties are decoded column by column: the layout of the vertex (the
+ * offset of each property) is computed once from the header, and each column
+ * is decoded with a tight loop without per-value branches. Custom components
+ * are decoded directly into their contiguous storage.
+ */
+template<MeshConcept MeshType>
+void decodePlyVertexBlock(
+    const char*                   data,
+    uint                          n,
+    uint                          stride,
+    uint                          first,
+    MeshType&                     mesh,
+    const std::list<PlyProperty>& vertexProperties,
+    std::endian                   end)
+{
+    using VertexType = MeshType::VertexType;
+
+    uint offset = 0;
+    for (const PlyProperty& p : vertexProperties) {
+        const char* col = data + offset;
+        offset += sizeOf(p.type);
+
+        if (p.name >= ply::x && p.name <= ply::z) {
+            using Scalar = VertexType::PositionType::ScalarType;
+            const int a  = p.name - ply::x;
+            decodePlyBinaryColumn<Scalar>(
+                col, n, stride, p.type, end, [&](uint i, Scalar v) {
+                    mesh.vertex(first + i).position()[a] = v;
+                });
+        }
+        if (p.name >= ply::nx && p.name <= ply::nz) {
+            if constexpr (HasPerVertexNormal<MeshType>) {
+                if (isPerVertexNormalAvailable(mesh)) {
+                    using Scalar = VertexType::NormalType::ScalarType;
+                    const int a  = p.name - ply::nx;
+                    decodePlyBinaryColumn<Scalar>(
+                        col, n, stride, p.type, end, [&](uint i, Scalar v) {
+                            mesh.vertex(first + i).normal()[a] = v;
+                        });
+                }
+            }
+        }
+        if (p.name >= ply::red && p.name <= ply::alpha) {
+            if constexpr (HasPerVertexColor<MeshType>) {
+                if (isPerVertexColorAvailable(mesh)) {
+                    const int a = p.name - ply::red;
+                    decodePlyBinaryColumn<unsigned char>(
+                        col,
+                        n,
+                        stride,
+                        p.type,
+                        end,
+                        [&](uint i, unsigned char v) {
+                            mesh.vertex(first + i).color()[a] = v;
+                        });
+                }
+            }
+        }
+        if (p.name == ply::quality) {
+            if constexpr (HasPerVertexQuality<MeshType>) {
+                using QualityType = VertexType::QualityType;
+                if (isPerVertexQualityAvailable(mesh)) {
+                    decodePlyBinaryColumn<QualityType>(
+                        col,
+                        n,
+                        stride,
+                        p.type,
+                        end,
+                        [&](uint i, QualityType v) {
+                            mesh.vertex(first + i).quality() = v;
+                        });
+                }
+            }
+        }
+        if (p.name >= ply::texture_u && p.name <= ply::texture_v) {
+            if constexpr (HasPerVertexTexCoord<MeshType>) {
+                using Scalar = VertexType::TexCoordType::ScalarType;
+                if (isPerVertexTexCoordAvailable(mesh)) {
+                    const int a = p.name - ply::texture_u;
+                    decodePlyBinaryColumn<Scalar>(
+                        col, n, stride, p.type, end, [&](uint i, Scalar v) {
+                            mesh.vertex(first + i).texCoord()[a] = v;
+                        });
+                }
+            }
+        }
+        if (p.name == ply::texnumber) {
+            if constexpr (HasPerVertexTexCoord<MeshType>) {
+                if (isPerVertexTexCoordAvailable(mesh)) {
+                    decodePlyBinaryColumn<ushort>(
+                        col, n, stride, p.type, end, [&](uint i, ushort v) {
+                            mesh.vertex(first + i).texCoord().index() = v;
+                        });
+                }
+            }
+        }
+        if (p.name == ply::unknown) {
+            if constexpr (HasPerVertexCustomComponents<MeshType>) {
+                if (mesh.hasPerVertexCustomComponent(p.unknownPropertyName)) {
+                    decodePlyCustomComponentColumn(
+                        col,
+                        n,
+                        stride,
+                        first,
+                        mesh,
+                        p,
+                        end,
+                        PlyCustomComponentTypes());
+                }
+            }
+        }
+        // all the other properties are skipped
+    }
+}
+
+/**
+ * @brief Reads the binary vertices of the ply file in blocks: each block is
+ * read from the stream with a single read call, and then it is decoded in
+ * parallel.
+ */
+template<MeshConcept MeshType, LoggerConcept LogType>
+void readPlyVerticesBinBlocks(
+    std::istream&    file,
+    const PlyHeader& header,
+    MeshType&        m,
+    uint             stride,
+    LogType&         log)
+{
+    const uint        nv  = header.numberVertices();
+    const std::endian end = header.format() == ply::BINARY_BIG_ENDIAN ?
+                                std::endian::big :
+                                std::endian::little;
+
+    std::vector<char> buffer(
+        std::size_t(std::min(nv, PLY_VERTEX_BLOCK_SIZE)) * stride);
+    std::vector<uint> subBlocks(
+        (PLY_VERTEX_BLOCK_SIZE + PLY_VERTEX_SUB_BLOCK_SIZE - 1) /
+        PLY_VERTEX_SUB_BLOCK_SIZE);
+    std::iota(subBlocks.begin(), subBlocks.end(), 0);
+
+    for (uint first = 0; first < nv; first += PLY_VERTEX_BLOCK_SIZE) {
+        const uint n = std::min(PLY_VERTEX_BLOCK_SIZE, nv - first);
+
+        file.read(buffer.data(), std::streamsize(n) * stride);
+        if (file.gcount() != std::streamsize(n) * stride) {
+            throw MalformedFileException("Unexpected end of file.");
+        }
+
+        const uint nSub =
+            (n + PLY_VERTEX_SUB_BLOCK_SIZE - 1) / PLY_VERTEX_SUB_BLOCK_SIZE;
+
+        parallelFor(
+            subBlocks.begin(), subBlocks.begin() + nSub, [&](uint sb) {
+                const uint sFirst = sb * PLY_VERTEX_SUB_BLOCK_SIZE;
+                const uint sn =
+                    std::min(PLY_VERTEX_SUB_BLOCK_SIZE, n - sFirst);
+                decodePlyVertexBlock(
+                    buffer.data() + std::size_t(sFirst) * stride,
+                    sn,
+                    stride,
+                    first + sFirst,
+                    m,
+                    header.vertexProperties(),
+                    end);
+            });
+
+        log.progress(first + n);
+    }
+}
+
 template<MeshConcept MeshType, LoggerConcept LogType>
 void readPlyVertices(
     std::istream&    file,
@@ -241,19 +593,26 @@ void readPlyVertices(
 
     log.startProgress("Reading vertices", header.numberVertices());
 
-    for (uint vid = 0; vid < header.numberVertices(); ++vid) {
-        auto& v = m.vertex(vid);
-        if (header.format() == ply::ASCII) {
-            detail::readPlyVertexTxt(file, v, m, header.vertexProperties());
-        }
-        else {
-            std::endian end = header.format() == ply::BINARY_BIG_ENDIAN ?
-                                  std::endian::big :
-                                  std::endian::little;
-            detail::readPlyVertexBin(
-                file, v, m, header.vertexProperties(), end);
+    uint stride = 0;
+    if (isPlyVertexBlockReadable(header, m, stride)) {
+        readPlyVerticesBinBlocks(file, header, m, stride, log);
+    }
+    else {
+        for (uint vid = 0; vid < header.numberVertices(); ++vid) {
+            auto& v = m.vertex(vid);
+            if (header.format() == ply::ASCII) {
+                detail::readPlyVertexTxt(
+                    file, v, m, header.vertexProperties());
+            }
+            else {
+                std::endian end = header.format() == ply::BINARY_BIG_ENDIAN ?
+                                      std::endian::big :
+                                      std::endian::little;
+                detail::readPlyVertexBin(
+                    file, v, m, header.vertexProperties(), end);
+            }
+            log.progress(vid);
         }
-        log.progress(vid);
     }
     log.endProgress();
 }
@@ -30,6 +30,10 @@
 #include <vclib/misc/tokenizer.h>
 #include <vclib/serialization.h>
 
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+
 namespace vcl {
 
 namespace detail {
@@ -48,9 +52,8 @@ namespace detail {
  * @return the next non-empty line read from the stream.
  */
 template<bool THROW = true>
-inline std::string readNextNonEmptyLine(std::istream& file)
+inline void readNextNonEmptyLine(std::istream& file, std::string& line)
 {
-    std::string line;
     do {
         std::getline(file, line);
         if constexpr (THROW) {
@@ -62,9 +65,62 @@ inline std::string readNextNonEmptyLine(std::istream& file)
             removeCarriageReturn(line);
         }
     } while (file && line.size() == 0);
+}
+
+template<bool THROW = true>
+inline std::string readNextNonEmptyLine(std::istream& file)
+{
+    std::string line;
+    readNextNonEmptyLine<THROW>(file, line);
     return line;
 }
 
+/**
+ * @brief Converts the given token to a number of type T.
+ *
+ * Integral types are parsed as int (to preserve the behaviour of negative
+ * values), floating point types as double. The conversion does not depend on
+ * the current locale and, where std::from_chars supports floating point types,
+ * does not allocate memory.
+ *
+ * @throws MalformedFileException if the token is not entirely a number.
+ */
+template<typename T>
+T tokenToNumber(std::string_view token)
+{
+    const char* first = token.data();
+    const char* last  = token.data() + token.size();
+    if (first != last && *first == '+')
+        ++first;
+
+    if constexpr (std::is_integral_v<T>) {
+        int  v   = 0;
+        auto res = std::from_chars(first, last, v);
+        if (res.ec != std::errc() || res.ptr != last)
+            throw MalformedFileException(
+                "Cannot read integer: " + std::string(token));
+        return static_cast<T>(v);
+    }
+    else {
+        double v = 0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::from_chars(first, last, v);
+        if (res.ec != std::errc() || res.ptr != last)
+            throw MalformedFileException(
+                "Cannot read number: " + std::string(token));
+#else
+        // strtod needs a null terminated string
+        const std::string str(first, last);
+        char*             end = nullptr;
+        v = std::strtod(str.c_str(), &end);
+        if (end == str.c_str() || *end != '\0')
+            throw MalformedFileException(
+                "Cannot read number: " + std::string(token));
+#endif
+        return static_cast<T>(v);
+    }
+}
+
 } // namespace detail
 
 /**
@@ -123,6 +179,54 @@ inline std::string readNextNonEmptyLineNoThrow(std::istream& file)
     return detail::readNextNonEmptyLine<false>(file);
 }
 
+/**
+ * @brief Reads the next non-empty line from a txt stream and tokenizes it with
+ * the given tokenizer.
+ *
+ * The memory of the line and of the tokenizer is reused, therefore this
+ * function should be preferred when reading a stream line by line.
+ *
+ * @throws MalformedFileException if the stream ends before a non-empty line is
+ * found.
+ *
+ * @param[in] file: the stream to read from.
+ * @param[out] line: the string where the line is read.
+ * @param[out] tokenizer: the tokenizer used to split the line.
+ */
+inline void readAndTokenizeNextNonEmptyLine(
+    std::istream& file,
+    std::string&  line,
+    Tokenizer&    tokenizer)
+{
+    do {
+        detail::readNextNonEmptyLine(file, line);
+        tokenizer.tokenize(line);
+    } while (tokenizer.begin() == tokenizer.end());
+}
+
+/**
+ * @brief Reads the next non-empty line from a txt stream and tokenizes it with
+ * the given tokenizer.
+ *
+ * The memory of the line and of the tokenizer is reused, therefore this
+ * function should be preferred when reading a stream line by line. If the
+ * stream ends before a non-empty line is found, the tokenizer is empty.
+ *
+ * @param[in] file: the stream to read from.
+ * @param[out] line: the string where the line is read.
+ * @param[out] tokenizer: the tokenizer used to split the line.
+ */
+inline void readAndTokenizeNextNonEmptyLineNoThrow(
+    std::istream& file,
+    std::string&  line,
+    Tokenizer&    tokenizer)
+{
+    do {
+        detail::readNextNonEmptyLine<false>(file, line);
+        tokenizer.tokenize(line);
+    } while (file && tokenizer.begin() == tokenizer.end());
+}
+
 /**
  * @brief Reads and returns the next non-empty line from a txt stream, tokenized
  * with the given separator.
@@ -140,12 +244,9 @@ inline Tokenizer readAndTokenizeNextNonEmptyLine(
     std::vector<char> separators = {' ', '\t'})
 {
     std::string line;
-    Tokenizer   tokenizer;
+    Tokenizer   tokenizer(separators);
 
-    do {
-        line      = readNextNonEmptyLine(file);
-        tokenizer = Tokenizer(line, separators);
-    } while (tokenizer.begin() == tokenizer.end());
+    readAndTokenizeNextNonEmptyLine(file, line, tokenizer);
 
     return tokenizer;
 }
@@ -165,12 +266,9 @@ inline Tokenizer readAndTokenizeNextNonEmptyLineNoThrow(
     std::vector<char> separators = {' ', '\t'})
 {
     std::string line;
-    Tokenizer   tokenizer;
+    Tokenizer   tokenizer(separators);
 
-    do {
-        line      = readNextNonEmptyLineNoThrow(file);
-        tokenizer = Tokenizer(line, separators);
-    } while (file && tokenizer.begin() == tokenizer.end());
+    readAndTokenizeNextNonEmptyLineNoThrow(file, line, tokenizer);
 
     return tokenizer;
 }
@@ -431,37 +529,37 @@ void readCustomComponent(
 template<typename T>
 T readChar(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
 T readUChar(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
 T readShort(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
 T readUShort(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
 T readInt(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
 T readUInt(Tokenizer::iterator& token, std::endian = std::endian::native)
 {
-    return std::stoi(*token++);
+    return detail::tokenToNumber<T>(*token++);
 }
 
 template<typename T>
@@ -471,10 +569,10 @@ T readFloat(
     bool isColor = false)
 {
     if (isColor && std::is_integral<T>::value) {
-        return std::stod(*token++) * 255;
+        return detail::tokenToNumber<double>(*token++) * 255;
     }
     else {
-        return std::stod(*token++);
+        return detail::tokenToNumber<double>(*token++);
     }
 }
 
@@ -485,10 +583,10 @@ T readDouble(
     bool isColor = false)
 {
     if (isColor && std::is_integral<T>::value) {
-        return std::stod(*token++) * 255;
+        return detail::tokenToNumber<double>(*token++) * 255;
     }
     else {
-        return std::stod(*token++);
+        return detail::tokenToNumber<double>(*token++);
     }
 }
 
@@ -506,14 +604,14 @@ T readPrimitiveType(
     case PrimitiveType::SHORT:
     case PrimitiveType::USHORT:
     case PrimitiveType::INT:
-    case PrimitiveType::UINT: p = std::stoi(*token++); break;
+    case PrimitiveType::UINT: p = detail::tokenToNumber<int>(*token++); break;
     case PrimitiveType::FLOAT:
     case PrimitiveType::DOUBLE:
         if (isColor) {
-            p = std::stod(*token++) * 255;
+            p = detail::tokenToNumber<double>(*token++) * 255;
         }
         else {
-            p = std::stod(*token++);
+            p = detail::tokenToNumber<double>(*token++);
         }
         break;
     default: assert(0); p = 0;
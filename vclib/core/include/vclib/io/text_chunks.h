@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_IO_TEXT_CHUNKS_H
+#define VCL_IO_TEXT_CHUNKS_H
+
+#include "read.h"
+
+#include <vclib/misc/parallel.h>
+
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vcl::detail {
+
+// size in bytes of the chunks in which a text file is split to be parsed in
+// parallel; the actual chunks are extended up to the end of their last line
+inline constexpr std::size_t TEXT_CHUNK_BYTES = 1 << 20;
+
+/**
+ * @brief Reads all the content of the stream that follows its current position
+ * in a single buffer.
+ *
+ * Seekable streams are read with a single read call; the others are consumed
+ * character by character.
+ *
+ * @param[in] stream: the stream to read from.
+ * @return the remaining content of the stream.
+ */
+inline std::string readRemainingStream(std::istream& stream)
+{
+    std::string buffer;
+
+    const std::streampos begin = stream.tellg();
+    if (begin != std::streampos(-1)) {
+        stream.seekg(0, std::ios::end);
+        const std::streampos end = stream.tellg();
+        stream.seekg(begin);
+        if (end != std::streampos(-1) && end >= begin) {
+            buffer.resize(end - begin);
+            stream.read(buffer.data(), buffer.size());
+            buffer.resize(stream.gcount());
+            return buffer;
+        }
+    }
+    stream.clear();
+    buffer.assign(std::istreambuf_iterator<char>(stream), {});
+    return buffer;
+}
+
+/**
+ * @brief Splits the given text in chunks of about chunkBytes bytes, each one
+ * ending at the end of a line (or of the text).
+ *
+ * @param[in] text: the text to split.
+ * @param[in] chunkBytes: the minimum size of each chunk, except the last one.
+ * @return the chunks, which cover the whole text in order.
+ */
+inline std::vector<std::string_view> splitInLineChunks(
+    std::string_view text,
+    std::size_t      chunkBytes = TEXT_CHUNK_BYTES)
+{
+    std::vector<std::string_view> chunks;
+
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = begin + chunkBytes;
+        if (end >= text.size()) {
+            end = text.size();
+        }
+        else {
+            end = text.find('\n', end - 1);
+            end = end == std::string_view::npos ? text.size() : end + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+/**
+ * @brief Extracts the next line from the text, without its end of line
+ * characters, and removes it from the text.
+ *
+ * @param[in/out] text: the text from which the line is extracted.
+ * @param[out] line: the extracted line.
+ * @return false if the text was empty and no line has been extracted.
+ */
+inline bool nextTextLine(std::string_view& text, std::string_view& line)
+{
+    if (text.empty())
+        return false;
+
+    std::size_t end = text.find('\n');
+    if (end == std::string_view::npos) {
+        line = text;
+        text = std::string_view();
+    }
+    else {
+        line = text.substr(0, end);
+        text.remove_prefix(end + 1);
+    }
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return true;
+}
+
+/**
+ * @brief The tokens of a line of a text file, separated by spaces and tabs.
+ *
+ * The tokens are views into the line, and their storage is reused when a new
+ * line is split. The numbers are read sequentially with the next() member
+ * function, which throws a MalformedFileException when the line has no more
+ * tokens or when the token is not a number.
+ */
+class TextLineTokens
+{
+    std::vector<std::string_view> mTokens;
+    uint                          mNext = 0;
+
+public:
+    void split(std::string_view line)
+    {
+        mTokens.clear();
+        mNext = 0;
+
+        std::size_t i = 0;
+        while (i < line.size()) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t'))
+                ++i;
+            std::size_t begin = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t')
+                ++i;
+            if (i > begin)
+                mTokens.push_back(line.substr(begin, i - begin));
+        }
+    }
+
+    uint size() const { return mTokens.size(); }
+
+    bool empty() const { return mTokens.empty(); }
+
+    std::string_view operator[](uint i) const { return mTokens[i]; }
+
+    // number of tokens not yet read by next() and nextToken()
+    uint remaining() const { return mTokens.size() - mNext; }
+
+    std::string_view nextToken()
+    {
+        if (mNext == mTokens.size())
+            throw MalformedFileException("Unexpected end of line.");
+        return mTokens[mNext++];
+    }
+
+    template<typename T>
+    T next()
+    {
+        return tokenToNumber<T>(nextToken());
+    }
+};
+
+/**
+ * @brief Calls f(i) in parallel for each i in [0, n).
+ *
+ * An exception thrown by f cannot leave the worker thread that executes it:
+ * the exceptions are captured, and the one thrown by the lowest i is rethrown
+ * after all the calls have completed. This way, the error reported for a
+ * malformed file is the first one in the file, and it does not depend on the
+ * scheduling.
+ *
+ * @param[in] n: the number of calls.
+ * @param[in] f: the function to call, taking the index of the call.
+ */
+template<typename F>
+void parallelForTextChunks(uint n, F&& f)
+{
+    std::vector<uint> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::vector<std::exception_ptr> errors(n);
+
+    parallelFor(ids, [&](uint i) {
+        try {
+            f(i);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for (const std::exception_ptr& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+} // namespace vcl::detail
+
+#endif // VCL_IO_TEXT_CHUNKS_H
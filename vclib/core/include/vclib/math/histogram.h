@@ -137,6 +137,32 @@ public:
         mRMS += (value * value) * increment;
     }
 
+    /**
+     * @brief Merges the values collected by another histogram into this
+     * histogram.
+     *
+     * The two histograms must have been initialized with the same bins (same
+     * range, number of bins and gamma). This allows to collect values in
+     * several partial histograms (e.g. one for each thread or chunk of data)
+     * and to combine them at the end of the computation.
+     *
+     * @param[in] other: the histogram to merge into this histogram.
+     */
+    void merge(const Histogram& other)
+    {
+        assert(mHist.size() == other.mHist.size());
+        assert(mRanges == other.mRanges);
+        for (uint i = 0; i < mHist.size(); ++i)
+            mHist[i] += other.mHist[i];
+        if (other.mMin < mMin)
+            mMin = other.mMin;
+        if (other.mMax > mMax)
+            mMax = other.mMax;
+        mCnt += other.mCnt;
+        mSum += other.mSum;
+        mRMS += other.mRMS;
+    }
+
     /**
      * @brief Minimum value of the range where the histogram is defined.
      * @return
@@ -27,10 +27,119 @@
 
 #include <vclib/concepts/space/point.h>
 
+#include <array>
+#include <cstdint>
 #include <random>
 
 namespace vcl {
 
+/**
+ * @brief The Philox4x32 class is a counter-based random number generator,
+ * that implements the Philox-4x32-10 generator described in:
+ *
+ * J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw
+ * "Parallel random numbers: as easy as 1, 2, 3".
+ * Proceedings of the International Conference for High Performance Computing,
+ * Networking, Storage and Analysis, 2011.
+ *
+ * Each generator is identified by a seed and by a stream number: the values
+ * generated are a pure function of these two numbers and of the number of
+ * values already drawn. Generators with different streams are independent
+ * and cheap to construct, therefore a generator can be created for each
+ * element that is processed in parallel (e.g. using the index of the element
+ * as stream), and the output does not depend on the order in which the
+ * elements are processed or on the number of threads.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements, and can be
+ * used with the distributions of the standard library.
+ *
+ * @ingroup math
+ */
+class Philox4x32
+{
+    static constexpr uint32_t M0 = 0xD2511F53;
+    static constexpr uint32_t M1 = 0xCD9E8D57;
+    static constexpr uint32_t W0 = 0x9E3779B9;
+    static constexpr uint32_t W1 = 0xBB67AE85;
+
+    static constexpr uint ROUNDS = 10;
+
+    std::array<uint32_t, 4> mCounter = {0, 0, 0, 0};
+    std::array<uint32_t, 2> mKey     = {0, 0};
+    std::array<uint32_t, 4> mBlock   = {0, 0, 0, 0};
+
+    // position of the next value to return in mBlock
+    uint mNext = 4;
+
+public:
+    using result_type = uint32_t;
+
+    /**
+     * @brief Creates a generator with the given seed and stream number.
+     *
+     * @param[in] seed: the seed (key) of the generator.
+     * @param[in] stream: the stream number.
+     */
+    explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) :
+            mKey {uint32_t(seed), uint32_t(seed >> 32)}
+    {
+        mCounter[2] = uint32_t(stream);
+        mCounter[3] = uint32_t(stream >> 32);
+    }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Returns the next random value of the stream.
+     */
+    result_type operator()()
+    {
+        if (mNext == 4) {
+            mBlock = generateBlock();
+            mNext  = 0;
+            // the first 64 bits of the counter count the generated blocks
+            if (++mCounter[0] == 0)
+                ++mCounter[1];
+        }
+        return mBlock[mNext++];
+    }
+
+    /**
+     * @brief Advances the stream by n values.
+     */
+    void discard(unsigned long long n)
+    {
+        for (; n > 0; --n)
+            (*this)();
+    }
+
+private:
+    std::array<uint32_t, 4> generateBlock() const
+    {
+        std::array<uint32_t, 4> c = mCounter;
+        std::array<uint32_t, 2> k = mKey;
+        for (uint r = 0; r < ROUNDS; ++r) {
+            const uint64_t p0 = uint64_t(M0) * c[0];
+            const uint64_t p1 = uint64_t(M1) * c[2];
+
+            c = {
+                uint32_t(p1 >> 32) ^ c[1] ^ k[0],
+                uint32_t(p1),
+                uint32_t(p0 >> 32) ^ c[3] ^ k[1],
+                uint32_t(p0)};
+
+            k[0] += W0;
+            k[1] += W1;
+        }
+        return c;
+    }
+};
+
 /**
  * @brief This subfunction generates a integer with the poisson distribution
  * using the ratio-of-uniforms rejection method (PRUAt). This approach is STABLE
@@ -54,7 +163,8 @@ namespace vcl {
  *
  * @ingroup math
  */
-inline int poissonRatioOfUniformsInteger(double L, std::mt19937& gen)
+template<typename Generator>
+int poissonRatioOfUniformsInteger(double L, Generator& gen)
 {
     // constants
     const double SHAT1 = 2.943035529371538573;  // 8/e
@@ -115,7 +225,8 @@ inline int poissonRatioOfUniformsInteger(double L)
  *
  * @ingroup math
  */
-inline int poissonRandomNumber(double lambda, std::mt19937& gen)
+template<typename Generator>
+int poissonRandomNumber(double lambda, Generator& gen)
 {
     if (lambda > 50)
         return poissonRatioOfUniformsInteger(lambda, gen);
@@ -150,8 +261,8 @@ inline int poissonRandomNumber(double lambda)
  *
  * @ingroup math
  */
-template<Point3Concept PointType>
-PointType randomTriangleBarycentricCoordinate(std::mt19937& gen)
+template<Point3Concept PointType, typename Generator>
+PointType randomTriangleBarycentricCoordinate(Generator& gen)
 {
     using ScalarType = PointType::ScalarType;
 
@@ -177,10 +288,10 @@ PointType randomTriangleBarycentricCoordinate()
     return randomTriangleBarycentricCoordinate<PointType>(gen);
 }
 
-template<typename ScalarType>
+template<typename ScalarType, typename Generator>
 std::vector<ScalarType> randomPolygonBarycentricCoordinate(
-    uint          polySize,
-    std::mt19937& gen)
+    uint       polySize,
+    Generator& gen)
 {
     std::vector<ScalarType> barCoord(polySize);
     ScalarType              sum = 0;
@@ -27,6 +27,7 @@
 
 #include <vclib/mesh/iterators/components/index_from_pointer_iterator.h>
 #include <vclib/misc/iterators/const_pointer_iterator.h>
+#include <vclib/space/core/vector/chunked_vector.h>
 
 namespace vcl::comp {
 
@@ -155,21 +156,36 @@ protected:
      * pointers to the new ones, we need to know how many elements were in the
      * container BEFORE the append operation, and this becomes the offset to
      * be applied to the pointers of the newly appended elements.
+     *
+     * If the Elements are stored in a container having stable addresses (see
+     * ChunkedVector), the old index of each Element is computed from its
+     * address, and the oldBase is not used.
      */
     void updateReferences(const Elem* oldBase, std::size_t offset = 0)
     {
-        const Elem* newBase = baseOfElemContainer();
-
         auto& baseContainer = Base::container();
 
-        for (uint j = 0; j < baseContainer.size();
-             ++j) { // for each pointer in this container
-            if (baseContainer.at(j) != nullptr) {
-                size_t diff =
-                    baseContainer.at(j) - oldBase; // offset w.r.t. the old base
+        if constexpr (hasStableElementAddresses()) {
+            for (uint j = 0; j < baseContainer.size(); ++j) {
+                if (baseContainer.at(j) != nullptr) {
+                    std::size_t i = ChunkedVector<Elem>::index(
+                        baseContainer.at(j));
+                    baseContainer.at(j) = elementOfParentMesh(i + offset);
+                }
+            }
+        }
+        else {
+            const Elem* newBase = baseOfElemContainer();
+
+            for (uint j = 0; j < baseContainer.size();
+                 ++j) { // for each pointer in this container
+                if (baseContainer.at(j) != nullptr) {
+                    // offset w.r.t. the old base
+                    size_t diff = baseContainer.at(j) - oldBase;
 
-                // update the pointer using newBase
-                baseContainer.at(j) = (Elem*) newBase + diff + offset;
+                    // update the pointer using newBase
+                    baseContainer.at(j) = (Elem*) newBase + diff + offset;
+                }
             }
         }
     }
@@ -188,30 +204,59 @@ protected:
      */
     void updateReferences(const std::vector<uint>& newIndices)
     {
-        const Elem* base = baseOfElemContainer();
-
         auto& baseContainer = Base::container();
 
-        for (uint j = 0; j < baseContainer.size(); ++j) {
-            if (baseContainer.at(j) != nullptr) {
-                size_t diff = baseContainer.at(j) - base;
-                if (newIndices[diff] == UINT_NULL) { // element has been removed
-                    baseContainer.at(j) = nullptr;
+        if constexpr (hasStableElementAddresses()) {
+            for (uint j = 0; j < baseContainer.size(); ++j) {
+                if (baseContainer.at(j) != nullptr) {
+                    uint ni = newIndices[ChunkedVector<Elem>::index(
+                        baseContainer.at(j))];
+                    baseContainer.at(j) =
+                        ni == UINT_NULL ? nullptr : elementOfParentMesh(ni);
                 }
-                else { // the new pointer will be base + newIndices[diff]
-                    baseContainer.at(j) = (Elem*) base + newIndices[diff];
+            }
+        }
+        else {
+            const Elem* base = baseOfElemContainer();
+
+            for (uint j = 0; j < baseContainer.size(); ++j) {
+                if (baseContainer.at(j) != nullptr) {
+                    size_t diff = baseContainer.at(j) - base;
+                    // element has been removed
+                    if (newIndices[diff] == UINT_NULL) {
+                        baseContainer.at(j) = nullptr;
+                    }
+                    else { // the new pointer will be base + newIndices[diff]
+                        baseContainer.at(j) = (Elem*) base + newIndices[diff];
+                    }
                 }
             }
         }
     }
 
 private:
+    // true if the Elements are stored in a container having stable addresses:
+    // in this case, they are not contiguous and there is no base pointer
+    static constexpr bool hasStableElementAddresses()
+    {
+        using MeshType  = Elem::ParentMeshType;
+        using Container = MeshType::template ContainerType<Elem::ELEMENT_ID>;
+        return Container::STABLE_ADDRESSES;
+    }
+
     const Elem* baseOfElemContainer() const
     {
         return &(Base::parentElement()
                      ->parentMesh()
                      ->template element<Elem::ELEMENT_ID>(0));
     }
+
+    Elem* elementOfParentMesh(std::size_t i)
+    {
+        return &(Base::parentElement()
+                     ->parentMesh()
+                     ->template element<Elem::ELEMENT_ID>(i));
+    }
 };
 
 /// @endcond
@@ -77,6 +77,11 @@ class BitFlags :
             !std::is_same_v<ParentElemType, void>,
             OPT>
 {
+    // the flags of components having different parent element types (e.g.
+    // horizontal and vertical) are accessed when importing
+    template<typename, bool>
+    friend class BitFlags;
+
     using Base = Component<
         BitFlags<ParentElemType, OPT>,
         CompId::BIT_FLAGS,
@@ -150,17 +150,15 @@ public:
     const CompType& get(const std::string& compName, const ElementType* elem)
         const
     {
-        return std::any_cast<const CompType&>(
-            ccVec(elem).template componentVector<CompType>(
-                compName)[thisId(elem)]);
+        return ccVec(elem).template componentData<CompType>(
+            compName)[thisId(elem)];
     }
 
     template<typename CompType>
     CompType& get(const std::string& compName, ElementType* elem)
     {
-        return std::any_cast<CompType&>(
-            ccVec(elem).template componentVector<CompType>(
-                compName)[thisId(elem)]);
+        return ccVec(elem).template componentData<CompType>(
+            compName)[thisId(elem)];
     }
 
 private:
@@ -107,6 +107,11 @@ class PolygonBitFlags :
             OPT,
             true>
 {
+    // the flags of components having different parent element types (e.g.
+    // horizontal and vertical) are accessed when importing
+    template<int, typename, bool>
+    friend class PolygonBitFlags;
+
     using FT = char; // FlagsType, the integral type used for the flags
 
     using Base = ContainerComponent<
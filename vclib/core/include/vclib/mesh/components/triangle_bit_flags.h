@@ -87,6 +87,11 @@ class TriangleBitFlags :
             !std::is_same_v<ParentElemType, void>,
             OPT>
 {
+    // the flags of components having different parent element types (e.g.
+    // horizontal and vertical) are accessed when importing
+    template<typename, bool>
+    friend class TriangleBitFlags;
+
     using Base = Component<
         TriangleBitFlags<ParentElemType, OPT>,
         CompId::BIT_FLAGS,
@@ -0,0 +1,296 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_MESH_CONTAINERS_CUSTOM_COMPONENT_COLUMN_H
+#define VCL_MESH_CONTAINERS_CUSTOM_COMPONENT_COLUMN_H
+
+#include <vclib/misc/compactness.h>
+#include <vclib/serialization.h>
+#include <vclib/types.h>
+
+#include <cassert>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vcl::mesh {
+
+/**
+ * @brief The CustomComponentColumn class stores the values of a custom
+ * component for all the elements of a container, in a single contiguous buffer
+ * of the actual type of the custom component.
+ *
+ * The type of the values is chosen at construction and then erased: the
+ * operations that do not need to know it (copy, resize, compaction...) are
+ * dispatched through a table of functions that is instantiated once for each
+ * type. The values can be accessed through the data() member function, and
+ * serialized through the serialize() and deserialize() member functions, that
+ * require the actual type of the values.
+ *
+ * @note bool values are stored in a buffer of bytes, and not in a
+ * std::vector<bool>, that does not store its values contiguously.
+ */
+class CustomComponentColumn
+{
+    // wrapper that avoids the std::vector<bool> specialization; since it is
+    // standard-layout, a pointer to it can be used as a pointer to its value
+    struct BoolValue
+    {
+        bool value = false;
+    };
+
+    static_assert(sizeof(BoolValue) == sizeof(bool));
+
+    template<typename T>
+    using ValueType =
+        std::conditional_t<std::is_same_v<T, bool>, BoolValue, T>;
+
+    template<typename T>
+    using Vector = std::vector<ValueType<T>>;
+
+    template<typename T>
+    static Vector<T>& vec(void* v)
+    {
+        return *static_cast<Vector<T>*>(v);
+    }
+
+    template<typename T>
+    static const Vector<T>& vec(const void* v)
+    {
+        return *static_cast<const Vector<T>*>(v);
+    }
+
+    struct VTable
+    {
+        const std::type_info* type;
+
+        void* (*clone)(const void* v);
+        void (*destroy)(void* v);
+        std::size_t (*size)(const void* v);
+        void (*resize)(void* v, std::size_t n);
+        void (*reserve)(void* v, std::size_t n);
+        void (*compact)(void* v, const std::vector<uint>& newIndices);
+        void (*copyValue)(void* v, std::size_t i, const void* o, std::size_t j);
+    };
+
+    template<typename T>
+    static constexpr VTable VTABLE = {
+        &typeid(T),
+        [](const void* v) -> void* {
+            return new Vector<T>(vec<T>(v));
+        },
+        [](void* v) {
+            delete &vec<T>(v);
+        },
+        [](const void* v) {
+            return vec<T>(v).size();
+        },
+        [](void* v, std::size_t n) {
+            vec<T>(v).resize(n);
+        },
+        [](void* v, std::size_t n) {
+            vec<T>(v).reserve(n);
+        },
+        [](void* v, const std::vector<uint>& newIndices) {
+            compactVector(vec<T>(v), newIndices);
+        },
+        [](void* v, std::size_t i, const void* o, std::size_t j) {
+            vec<T>(v)[i] = vec<T>(o)[j];
+        },
+    };
+
+    const VTable* mVTable = nullptr;
+    void*         mVec    = nullptr; // a Vector<T>, where T is the actual type
+
+public:
+    /**
+     * @brief Creates an empty column without type, that can only be assigned.
+     */
+    CustomComponentColumn() = default;
+
+    /**
+     * @brief Creates a column of values of type T, having the given size.
+     * The values are value-initialized.
+     *
+     * @tparam T: the type of the values of the column.
+     * @param[in] size: the number of values of the column.
+     */
+    template<typename T>
+    CustomComponentColumn(TypeWrapper<T>, std::size_t size = 0) :
+            mVTable(&VTABLE<T>), mVec(new Vector<T>(size))
+    {
+    }
+
+    CustomComponentColumn(const CustomComponentColumn& oth) :
+            mVTable(oth.mVTable),
+            mVec(oth.mVec ? oth.mVTable->clone(oth.mVec) : nullptr)
+    {
+    }
+
+    CustomComponentColumn(CustomComponentColumn&& oth) noexcept { swap(oth); }
+
+    ~CustomComponentColumn()
+    {
+        if (mVec)
+            mVTable->destroy(mVec);
+    }
+
+    CustomComponentColumn& operator=(CustomComponentColumn oth) noexcept
+    {
+        swap(oth);
+        return *this;
+    }
+
+    /**
+     * @brief Returns the type of the values of the column.
+     */
+    std::type_index type() const
+    {
+        assert(mVTable);
+        return *mVTable->type;
+    }
+
+    template<typename T>
+    bool isOfType() const
+    {
+        return mVTable && *mVTable->type == typeid(T);
+    }
+
+    std::size_t size() const { return mVec ? mVTable->size(mVec) : 0; }
+
+    void resize(std::size_t n) { mVTable->resize(mVec, n); }
+
+    void reserve(std::size_t n) { mVTable->reserve(mVec, n); }
+
+    /**
+     * @brief Compacts the column according to the given new indices (see
+     * compactVector).
+     */
+    void compact(const std::vector<uint>& newIndices)
+    {
+        mVTable->compact(mVec, newIndices);
+    }
+
+    /**
+     * @brief Copies the j-th value of the other column, that must have the
+     * same type of this column, into the i-th value of this column.
+     */
+    void copyValue(
+        std::size_t                  i,
+        const CustomComponentColumn& other,
+        std::size_t                  j)
+    {
+        assert(type() == other.type());
+        mVTable->copyValue(mVec, i, other.mVec, j);
+    }
+
+    /**
+     * @brief Returns a pointer to the contiguous values of the column, that
+     * must have type T.
+     *
+     * @note For bool columns, the returned pointer points to an array of
+     * one-byte BoolValue wrappers, each one holding a single bool: it can be
+     * indexed as a bool array since the wrapper has the same size of a bool.
+     */
+    template<typename T>
+    T* data()
+    {
+        assert(isOfType<T>());
+        if constexpr (std::is_same_v<T, bool>)
+            return reinterpret_cast<T*>(vec<T>(mVec).data());
+        else
+            return vec<T>(mVec).data();
+    }
+
+    template<typename T>
+    const T* data() const
+    {
+        assert(isOfType<T>());
+        if constexpr (std::is_same_v<T, bool>)
+            return reinterpret_cast<const T*>(vec<T>(mVec).data());
+        else
+            return vec<T>(mVec).data();
+    }
+
+    /**
+     * @brief Serializes the values of the column, that must have type T: the
+     * size of the column is followed by the values. Arithmetic values are
+     * written with a single write of the whole column, when possible.
+     *
+     * The function is not part of the type-erased operations of the column,
+     * since it requires T to be serializable: it is instantiated only when a
+     * column of type T is actually serialized.
+     */
+    template<typename T>
+    void serialize(std::ostream& os) const
+    {
+        assert(isOfType<T>());
+        if constexpr (std::is_same_v<T, bool>) {
+            vcl::serialize(os, vec<T>(mVec).size());
+            for (const BoolValue& b : vec<T>(mVec))
+                vcl::serialize(os, b.value);
+        }
+        else {
+            vcl::serialize(os, vec<T>(mVec));
+        }
+    }
+
+    /**
+     * @brief Deserializes the values of the column, that must have been
+     * created with the type T of the serialized values.
+     */
+    template<typename T>
+    void deserialize(std::istream& is)
+    {
+        assert(isOfType<T>());
+        if constexpr (std::is_same_v<T, bool>) {
+            std::size_t size;
+            vcl::deserialize(is, size);
+            vec<T>(mVec).resize(size);
+            for (BoolValue& b : vec<T>(mVec))
+                vcl::deserialize(is, b.value);
+        }
+        else {
+            vcl::deserialize(is, vec<T>(mVec));
+        }
+    }
+
+    void swap(CustomComponentColumn& oth) noexcept
+    {
+        using std::swap;
+        swap(mVTable, oth.mVTable);
+        swap(mVec, oth.mVec);
+    }
+
+    friend void swap(
+        CustomComponentColumn& a,
+        CustomComponentColumn& b) noexcept
+    {
+        a.swap(b);
+    }
+};
+
+} // namespace vcl::mesh
+
+#endif // VCL_MESH_CONTAINERS_CUSTOM_COMPONENT_COLUMN_H
@@ -25,9 +25,6 @@
 
 #include <vclib/types.h>
 
-#include <any>
-#include <vector>
-
 namespace vcl {
 
 /**
@@ -35,11 +32,12 @@ namespace vcl {
  *
  * The class allows to access a custom component stored in a Contaner of
  * Elements without having to use the Container itself and avoiding copies, and
- * it can be used as a normal std::vector. The class stores references to the
- * custom components, therefore it allows to modify them.
+ * it can be used as a normal std::vector. The class stores a pointer to the
+ * contiguous values of the custom component, therefore it allows to modify
+ * them.
  *
- * It is meant to be created by a Container, that constructs it from the vector
- * of custom components and then returns it to the user.
+ * It is meant to be created by a Container, that constructs it from the data
+ * of the custom component and then returns it to the user.
  *
  * @note A CustomComponentVectorHandle object is meant to be used to access the
  * custom components. It does not make sense to modify the size of the container
@@ -48,89 +46,55 @@ namespace vcl {
  *
  * @note If the Element Container is modified after the creation of a
  * CustomComponentVectorHandle, the CustomComponentVectorHandle is not updated
- * and still contains the old references to the custom components (that may be
- * invalidated).
+ * and still points to the old custom components (that may be invalidated).
  *
  * @tparam T: The type of the custom component.
  */
 template<typename T>
 class CustomComponentVectorHandle
 {
-    std::vector<std::reference_wrapper<T>> mVec;
+    T*   mData = nullptr;
+    uint mSize = 0;
 
 public:
-    class Iterator : public std::vector<std::reference_wrapper<T>>::iterator
-    {
-        using Base = std::vector<std::reference_wrapper<T>>::iterator;
-
-    public:
-        using value_type = T;
-        using reference  = value_type&;
-        using pointer    = value_type*;
-
-        using Base::Base;
-
-        Iterator(Base it) : Base(it) {}
-
-        reference operator*() const { return Base::operator*().get(); }
-
-        pointer operator->() const { return &(Base::operator*().get()); }
-    };
-
-    class ConstIterator :
-            public std::vector<std::reference_wrapper<T>>::const_iterator
-    {
-        using Base = std::vector<std::reference_wrapper<T>>::const_iterator;
-
-    public:
-        using value_type = T;
-        using reference  = const value_type&;
-        using pointer    = const value_type*;
-
-        using Base::Base;
-
-        ConstIterator(Base it) : Base(it) {}
-
-        reference operator*() const { return Base::operator*().get(); }
-
-        pointer operator->() const { return &(Base::operator*().get()); }
-    };
+    using Iterator      = T*;
+    using ConstIterator = const T*;
 
     CustomComponentVectorHandle() {}
 
-    CustomComponentVectorHandle(std::vector<std::any>& cc)
+    CustomComponentVectorHandle(T* data, uint size) : mData(data), mSize(size)
     {
-        mVec.reserve(cc.size());
-        for (uint i = 0; i < cc.size(); ++i) {
-            mVec.push_back(std::any_cast<T&>(cc[i]));
-        }
     }
 
-    T& at(uint i) { return mVec[i].get(); }
+    T& at(uint i) { return mData[i]; }
+
+    const T& at(uint i) const { return mData[i]; }
+
+    T& front() { return mData[0]; }
 
-    const T& at(uint i) const { return mVec[i].get(); }
+    const T& front() const { return mData[0]; }
 
-    T& front() { return mVec.begin()->get(); }
+    T& back() { return mData[mSize - 1]; }
 
-    const T& front() const { return mVec.begin()->get(); }
+    const T& back() const { return mData[mSize - 1]; }
 
-    T& back() { return std::prev(mVec.end())->get(); }
+    uint size() const { return mSize; }
 
-    const T& back() const { return std::prev(mVec.end())->get(); }
+    T* data() { return mData; }
 
-    uint size() const { return mVec.size(); }
+    const T* data() const { return mData; }
 
-    T& operator[](uint i) { return mVec[i].get(); }
+    T& operator[](uint i) { return mData[i]; }
 
-    const T& operator[](uint i) const { return mVec[i].get(); }
+    const T& operator[](uint i) const { return mData[i]; }
 
-    Iterator begin() { return Iterator(mVec.begin()); }
+    Iterator begin() { return mData; }
 
-    Iterator end() { return Iterator(mVec.end()); }
+    Iterator end() { return mData + mSize; }
 
-    ConstIterator begin() const { return ConstIterator(mVec.begin()); }
+    ConstIterator begin() const { return mData; }
 
-    ConstIterator end() const { return ConstIterator(mVec.end()); }
+    ConstIterator end() const { return mData + mSize; }
 };
 
 template<typename T>
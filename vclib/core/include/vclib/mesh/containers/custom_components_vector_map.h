@@ -23,12 +23,12 @@
 #ifndef VCL_MESH_CONTAINERS_CUSTOM_COMPONENTS_VECTOR_MAP_H
 #define VCL_MESH_CONTAINERS_CUSTOM_COMPONENTS_VECTOR_MAP_H
 
+#include "custom_component_column.h"
+
 #include <vclib/exceptions/mesh.h>
-#include <vclib/misc/compactness.h>
 #include <vclib/serialization.h>
 #include <vclib/types.h>
 
-#include <any>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -49,9 +49,10 @@ namespace vcl::mesh {
  * The class allows to access to the vectors of custom components trough their
  * name and type.
  *
- * For each custom component, the class stores a vector of std::any, that
- * allows to store any type of data. The actual type of the data stored in the
- * vectors is required to access to the vector data.
+ * For each custom component, the class stores a CustomComponentColumn, that
+ * is a contiguous buffer of values of the actual type of the component. The
+ * actual type of the data stored in the columns is required to access to the
+ * column data, and the access to a value is a plain array index.
  *
  * @note This class is templated over a boolean value that enables the
  * functionalities of the class. If a CustomComponentsVectorMap<false> is
@@ -71,28 +72,14 @@ template<>
 class CustomComponentsVectorMap<true>
 {
     // the actual map containing, for each name of a custom component, the
-    // vector of values (a value for each element(vertex/face...) of the mesh)
-    std::unordered_map<std::string, std::vector<std::any>> mMap;
-    // map that stores if some custom components need to be initialized.
-    // this happens when we resize the container of an element: we need to
-    // resize also the vectors of the custom components, but we cannot
-    // initialize them with the right type (because we don't know it in resize
-    // phase). The initialization will be made when the type is known (get of
-    // the custom component vector).
-    mutable std::unordered_map<std::string, bool> mNeedToInitialize;
-    // types used for each custom component
-    std::unordered_map<std::string, std::type_index> mCompType;
+    // column of values (a value for each element(vertex/face...) of the mesh)
+    std::unordered_map<std::string, CustomComponentColumn> mMap;
 
 public:
     /**
      * @brief Removes all the custom component vectors stored in the mMap.
      */
-    void clear()
-    {
-        mMap.clear();
-        mNeedToInitialize.clear();
-        mCompType.clear();
-    }
+    void clear() { mMap.clear(); }
 
     /**
      * @brief For each custom component vector, it reserves the given size.
@@ -107,20 +94,13 @@ public:
 
     /**
      * @brief For each custom component vector, it resizes the vector to the
-     * given size.
+     * given size. The new values are initialized with the empty constructor
+     * of the type of each custom component.
      * @param[in] size: the size to reserve for each custom component vector.
      */
     void resize(uint size)
     {
         for (auto& p : mMap) {
-            // At this call, we don't know statically the types of each custom
-            // component, therefore we cannot initialize them (std::any of each
-            // vector will be in an invalid state). Therefore, we mark all the
-            // resized custom components as 'needToInitialize'. Initiaization
-            // will be made just on the uninitialized values of the vectors at
-            // the first access of each custom component.
-            if (p.second.size() < size)
-                mNeedToInitialize.at(p.first) = true;
             p.second.resize(size);
         }
     }
@@ -140,7 +120,7 @@ public:
     void compact(const std::vector<uint>& newIndices)
     {
         for (auto& p : mMap) {
-            compactVector(p.second, newIndices);
+            p.second.compact(newIndices);
         }
     }
 
@@ -160,10 +140,8 @@ public:
     template<typename CompType>
     void addNewComponent(const std::string& name, uint size)
     {
-        std::vector<std::any>& v = mMap[name];
-        v.resize(size, CompType());
-        mNeedToInitialize[name] = false;
-        mCompType.emplace(name, typeid(CompType));
+        mMap.insert_or_assign(
+            name, CustomComponentColumn(TypeWrapper<CompType>(), size));
     }
 
     /**
@@ -171,12 +149,7 @@ public:
      * It does nothing if the element does not exist.
      * @param[in] name: the name of the custom component vector to delete.
      */
-    void deleteComponent(const std::string& name)
-    {
-        mMap.erase(name);
-        mNeedToInitialize.erase(name);
-        mCompType.erase(name);
-    }
+    void deleteComponent(const std::string& name) { mMap.erase(name); }
 
     /**
      * @brief Asserts that the compName component exists.
@@ -225,9 +198,7 @@ public:
     template<typename CompType>
     bool isComponentOfType(const std::string& compName) const
     {
-        std::type_index t(typeid(CompType));
-
-        return t == mCompType.at(compName);
+        return mMap.at(compName).isOfType<CompType>();
     }
 
     /**
@@ -241,7 +212,7 @@ public:
      */
     std::type_index componentType(const std::string& compName) const
     {
-        return mCompType.at(compName);
+        return mMap.at(compName).type();
     }
 
     /**
@@ -256,16 +227,28 @@ public:
     std::vector<std::string> allComponentNamesOfType() const
     {
         std::vector<std::string> names;
-        std::type_index          t(typeid(CompType));
-        for (const auto& p : mCompType) {
-            if (p.second == t)
+        for (const auto& p : mMap) {
+            if (p.second.isOfType<CompType>())
                 names.push_back(p.first);
         }
         return names;
     }
 
     /**
-     * @brief Returns a const reference of std::vector<std::any> of the custom
+     * @brief Returns the number of values stored for the custom component
+     * with the given name.
+     *
+     * @throws std::out_of_range if the compName does not exist.
+     * @param[in] compName: the name of the custom component.
+     * @return the number of values of the custom component.
+     */
+    uint componentSize(const std::string& compName) const
+    {
+        return mMap.at(compName).size();
+    }
+
+    /**
+     * @brief Returns a const pointer to the contiguous values of the custom
      * component with the given name and the given template argument CompType.
      *
      * If the CompType does not mach with the type associated with compName,
@@ -273,56 +256,33 @@ public:
      *
      * @tparam CompType: the type of the custom component to return.
      * @param[in] compName: the name of the custom component to return.
-     * @return a const reference of std::vector<std::any> of the custom
-     * component with the given name and the given template argument CompType.
+     * @return a const pointer to the values of the custom component with the
+     * given name and the given template argument CompType.
      */
     template<typename CompType>
-    const std::vector<std::any>& componentVector(
-        const std::string& compName) const
+    const CompType* componentData(const std::string& compName) const
     {
         checkComponentType<CompType>(compName);
-        std::vector<std::any>& v =
-            const_cast<std::vector<std::any>&>(mMap.at(compName));
-        // if the component needs to be initialized (e.g. we made a resize)
-        if (mNeedToInitialize.at(compName)) {
-            for (std::any& a : v) {
-                if (!a.has_value())
-                    a = CompType();
-            }
-            mNeedToInitialize.at(compName) = false;
-        }
-        return v;
+        return mMap.at(compName).data<std::remove_const_t<CompType>>();
     }
 
     /**
-     * @brief Returns a reference of std::vector<std::any> of the custom
+     * @brief Returns a pointer to the contiguous values of the custom
      * component with the given name and the given template argument CompType.
      *
      * If the CompType does not mach with the type associated with compName,
      * thows a vcl::BadCustomComponentTypeException.
      *
-     * This function will initialize all the uninitialized values of the
-     * accessed custom component.
-     *
      * @tparam CompType: the type of the custom component to return.
      * @param[in] compName: the name of the custom component to return.
-     * @return a reference of std::vector<std::any> of the custom component
-     * with the given name and the given template argument CompType.
+     * @return a pointer to the values of the custom component with the given
+     * name and the given template argument CompType.
      */
     template<typename CompType>
-    std::vector<std::any>& componentVector(const std::string& compName)
+    CompType* componentData(const std::string& compName)
     {
         checkComponentType<CompType>(compName);
-        std::vector<std::any>& v = mMap.at(compName);
-        // if the component needs to be initialized (e.g. we made a resize)
-        if (mNeedToInitialize.at(compName)) {
-            for (std::any& a : v) {
-                if (!a.has_value())
-                    a = CompType();
-            }
-            mNeedToInitialize.at(compName) = false;
-        }
-        return v;
+        return mMap.at(compName).data<std::remove_const_t<CompType>>();
     }
 
     void importSameCustomComponentFrom(
@@ -333,7 +293,8 @@ public:
     {
         if (other.componentExists(compName) && componentExists(compName)) {
             if (other.componentType(compName) == componentType(compName)) {
-                mMap.at(compName)[thisPos] = other.mMap.at(compName)[otherPos];
+                mMap.at(compName).copyValue(
+                    thisPos, other.mMap.at(compName), otherPos);
             }
         }
     }
@@ -345,10 +306,11 @@ public:
             allComponentNamesOfType<CompType>();
         vcl::serialize(os, compNames);
         for (const auto& name : compNames) {
-            bool b = mNeedToInitialize.at(name);
+            // values are always initialized: the flag is kept for
+            // compatibility with the previous format
+            bool b = false;
             vcl::serialize(os, b);
-            const std::vector<std::any>& v = componentVector<CompType>(name);
-            vcl::serialize<CompType>(os, v);
+            mMap.at(name).serialize<CompType>(os);
         }
     }
 
@@ -360,11 +322,9 @@ public:
         for (const auto& name : compNames) {
             bool b;
             vcl::deserialize(is, b);
-            std::vector<std::any> v;
-            vcl::deserialize<CompType>(is, v);
-            mMap[name]              = v;
-            mNeedToInitialize[name] = b;
-            mCompType.emplace(name, typeid(CompType));
+            CustomComponentColumn c(TypeWrapper<CompType>{});
+            c.deserialize<CompType>(is);
+            mMap.insert_or_assign(name, std::move(c));
         }
     }
 
@@ -372,12 +332,12 @@ private:
     template<typename CompType>
     void checkComponentType(const std::string& compName) const
     {
-        std::type_index t(typeid(CompType));
-        if (t != mCompType.at(compName)) {
+        const CustomComponentColumn& c = mMap.at(compName);
+        if (!c.isOfType<CompType>()) {
+            std::type_index t(typeid(CompType));
             throw BadCustomComponentTypeException(
-                "Expected type " + std::string(mCompType.at(compName).name()) +
-                " for " + compName + ", but was " + std::string(t.name()) +
-                ".");
+                "Expected type " + std::string(c.type().name()) + " for " +
+                compName + ", but was " + std::string(t.name()) + ".");
         }
     }
 };
@@ -45,17 +45,20 @@ namespace vcl::mesh {
  *
  * @tparam T: The type of the Edge elements. It must satisfy the
  * EdgeConcept.
+ * @tparam CHUNKED: If true, the Edges are stored in fixed size chunks (see
+ * ChunkedVector), and their addresses never change when new Edges are added:
+ * no pointer stored in the mesh needs to be updated when the container grows.
  *
  * @ingroup containers
  */
-template<EdgeConcept T>
-class EdgeContainer : public ElementContainer<T>
+template<EdgeConcept T, bool CHUNKED = false>
+class EdgeContainer : public ElementContainer<T, CHUNKED>
 {
-    template<EdgeConcept U>
+    template<EdgeConcept U, bool C>
     friend class EdgeContainer;
 
-    using EdgeContainerType = EdgeContainer<T>;
-    using Base              = ElementContainer<T>;
+    using EdgeContainerType = EdgeContainer<T, CHUNKED>;
+    using Base              = ElementContainer<T, CHUNKED>;
 
 public:
     using Edge              = T;
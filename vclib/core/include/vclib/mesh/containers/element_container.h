@@ -32,7 +32,9 @@
 #include <vclib/concepts/mesh/elements/element.h>
 #include <vclib/mesh/components/bases/component.h>
 #include <vclib/mesh/iterators/element_container_iterator.h>
+#include <vclib/misc/compactness.h>
 #include <vclib/serialization.h>
+#include <vclib/space/core/vector/chunked_vector.h>
 #include <vclib/types/view.h>
 
 #include <vector>
@@ -40,13 +42,19 @@
 namespace vcl::mesh {
 
 /// @cond VCLIB_HIDDEN_DOCS
-template<ElementConcept T>
+template<ElementConcept T, bool CHUNKED = false>
 class ElementContainer : public ElementContainerTriggerer
 {
-    template<ElementConcept U>
+    template<ElementConcept U, bool C>
     friend class ElementContainer;
 
-    using ElementContainerType = ElementContainer<T>;
+    using ElementContainerType = ElementContainer<T, CHUNKED>;
+
+    // the vector used to store the elements: a ChunkedVector when the
+    // container has stable element addresses
+    template<typename U>
+    using ElementVector =
+        std::conditional_t<CHUNKED, ChunkedVector<U>, std::vector<U>>;
 
     // filter components of elements, taking only vertical ones
     using vComps = FilterTypesByCondition<
@@ -72,7 +80,7 @@ protected:
      * each one of these will contain the data of the horizontal components and
      * a pointer to the parent mesh
      */
-    std::vector<T> mElemVec;
+    ElementVector<T> mElemVec;
 
     /**
      * @brief The tuple of vectors of all the vertical components of
@@ -90,6 +98,18 @@ protected:
 public:
     static const uint ELEMENT_ID = T::ELEMENT_ID;
 
+    /**
+     * @brief Tells whether the addresses of the elements of the container are
+     * stable, that is whether the elements are never moved when the container
+     * grows.
+     *
+     * When true, the elements are stored in fixed size chunks (see
+     * ChunkedVector): adding elements never invalidates the pointers to the
+     * elements, and therefore it never requires to update the pointers stored
+     * in the mesh.
+     */
+    static constexpr bool STABLE_ADDRESSES = CHUNKED;
+
     /**
      * @brief Empty constructor that creates an empty container of Elements.
      */
@@ -97,8 +117,9 @@ public:
 
 protected:
     /* Members that are directly inherited by Containers (just renaming them) */
-    using ElementIterator      = ElementContainerIterator<std::vector, T>;
-    using ConstElementIterator = ConstElementContainerIterator<std::vector, T>;
+    using ElementIterator = ElementContainerIterator<ElementVector, T>;
+    using ConstElementIterator =
+        ConstElementContainerIterator<ElementVector, T>;
 
     /**
      * @brief Returns a const reference of the element at the i-th position in
@@ -297,6 +318,10 @@ protected:
      * @brief Compacts the element container, keeping only the non-deleted
      * elements.
      *
+     * The new indices are computed, the elements are moved and the references
+     * stored in the mesh are updated in parallel. The elements are moved back
+     * into the storage of the container, that is therefore never reallocated.
+     *
      * @return a vector that tells, for each old element index, the new index of
      * the element. Will contain UINT_NULL if the element has been deleted.
      */
@@ -304,7 +329,9 @@ protected:
     {
         std::vector<uint> newIndices = elementCompactIndices();
         if (elementNumber() != elementContainerSize()) {
-            compactVector(mElemVec, newIndices);
+            // keep the storage: the references to the elements are updated
+            // w.r.t. the current base of the container
+            compactVector(mElemVec, newIndices, true);
 
             mVerticalCompVecTuple.compact(newIndices);
             if constexpr (comp::HasCustomComponents<T>)
@@ -396,18 +423,9 @@ protected:
      */
     std::vector<uint> elementCompactIndices() const
     {
-        std::vector<uint> newIndices(mElemVec.size());
-        uint              k = 0;
-        for (uint i = 0; i < mElemVec.size(); ++i) {
-            if (!mElemVec[i].deleted()) {
-                newIndices[i] = k;
-                k++;
-            }
-            else {
-                newIndices[i] = UINT_NULL;
-            }
-        }
-        return newIndices;
+        return compactIndices(mElemVec.size(), [&](uint i) {
+            return mElemVec[i].deleted();
+        });
     }
 
     /**
@@ -424,7 +442,7 @@ protected:
      * @param[in] other: the container from which the elements will be copied
      * and appended.
      */
-    void append(const ElementContainer<T>& other)
+    void append(const ElementContainer& other)
     {
         using Comps = T::Components;
 
@@ -864,20 +882,18 @@ protected:
     CustomComponentVectorHandle<K> customComponentVectorHandle(
         const std::string& name) requires comp::HasCustomComponents<T>
     {
-        std::vector<std::any>& cc =
-            mCustomCompVecMap.template componentVector<K>(name);
-        CustomComponentVectorHandle<K> v(cc);
-        return v;
+        return CustomComponentVectorHandle<K>(
+            mCustomCompVecMap.template componentData<K>(name),
+            mCustomCompVecMap.componentSize(name));
     }
 
     template<typename K>
     ConstCustomComponentVectorHandle<K> customComponentVectorHandle(
         const std::string& name) const requires comp::HasCustomComponents<T>
     {
-        const std::vector<std::any>& cc =
-            mCustomCompVecMap.template componentVector<K>(name);
-        ConstCustomComponentVectorHandle<K> v(cc);
-        return cc;
+        return ConstCustomComponentVectorHandle<K>(
+            mCustomCompVecMap.template componentData<K>(name),
+            mCustomCompVecMap.componentSize(name));
     }
 
     template<typename K>
@@ -896,9 +912,17 @@ protected:
 
     uint index(const T* e) const
     {
-        assert(
-            !mElemVec.empty() && e >= mElemVec.data() && e <= &mElemVec.back());
-        return e - mElemVec.data();
+        if constexpr (CHUNKED) {
+            uint i = ChunkedVector<T>::index(e);
+            assert(i < mElemVec.size() && &mElemVec[i] == e);
+            return i;
+        }
+        else {
+            assert(
+                !mElemVec.empty() && e >= mElemVec.data() &&
+                e <= &mElemVec.back());
+            return e - mElemVec.data();
+        }
     }
 
     void setParentMeshPointers(void* pm)
@@ -1054,15 +1078,18 @@ private:
         uint         offset                = 0)
     {
         if constexpr (comp::HasReferencesOfType<Comp, ElPtr>) {
+            // indices do not change when the referenced container is
+            // reallocated: only appended elements need to be updated
+            if constexpr (comp::HasIndicesOfType<Comp, ElPtr>) {
+                if (offset == 0)
+                    return;
+            }
+
             // lambda to avoid code duplication
             auto loop = [&]() {
-                for (uint i = firstElementToProcess; i < elementContainerSize();
-                     i++) {
-                    T& e = element(i);
-                    if (!e.deleted()) {
-                        e.Comp::updateReferences(oldBase, offset);
-                    }
-                }
+                parallelForNonDeletedElements(firstElementToProcess, [&](T& e) {
+                    e.Comp::updateReferences(oldBase, offset);
+                });
             };
 
             if constexpr (comp::HasOptionalReferencesOfType<Comp, ElPtr>) {
@@ -1080,31 +1107,54 @@ private:
     void updateReferencesOnComponent(const std::vector<uint>& newIndices)
     {
         if constexpr (comp::HasReferencesOfType<Comp, ElPtr>) {
+            auto loop = [&]() {
+                parallelForNonDeletedElements(0, [&](T& e) {
+                    e.Comp::updateReferences(newIndices);
+                });
+            };
+
             if constexpr (comp::HasOptionalReferencesOfType<Comp, ElPtr>) {
                 if (isOptionalComponentEnabled<Comp>()) {
-                    for (T& e : elements()) {
-                        e.Comp::updateReferences(newIndices);
-                    }
+                    loop();
                 }
             }
             else {
-                for (T& e : elements()) {
-                    e.Comp::updateReferences(newIndices);
-                }
+                loop();
             }
         }
     }
 
+    /*
+     * Calls f on each non-deleted element having index greater or equal than
+     * first. The elements are processed in parallel: f must modify only the
+     * element that is given as argument.
+     */
+    template<typename F>
+    void parallelForNonDeletedElements(uint first, F&& f)
+    {
+        if (first >= elementContainerSize())
+            return;
+
+        vcl::detail::parallelForCompactnessChunks(
+            elementContainerSize() - first,
+            [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = first + b; i < first + e; ++i) {
+                    if (!mElemVec[i].deleted())
+                        f(mElemVec[i]);
+                }
+            });
+    }
+
     template<typename... Comps>
     void appendVerticalComponents(
-        const ElementContainer<T>& other,
+        const ElementContainer& other,
         TypeWrapper<Comps...>)
     {
         (appendVerticalComponent<Comps>(other), ...);
     }
 
     template<typename Comp>
-    void appendVerticalComponent(const ElementContainer<T>& other)
+    void appendVerticalComponent(const ElementContainer& other)
     {
         uint on = other.elementContainerSize();
         uint n  = elementContainerSize() - on;
@@ -1121,7 +1171,7 @@ private:
         }
     }
 
-    void appendCustomComponents(const ElementContainer<T>& other)
+    void appendCustomComponents(const ElementContainer& other)
     {
         if constexpr (comp::HasCustomComponents<T>) {
             uint on = other.elementContainerSize();
@@ -46,17 +46,20 @@ namespace vcl::mesh {
  * Faces.
  *
  * @tparam T: The type of the Face elements. It must satisfy the FaceConcept.
+ * @tparam CHUNKED: If true, the Faces are stored in fixed size chunks (see
+ * ChunkedVector), and their addresses never change when new Faces are added:
+ * no pointer stored in the mesh needs to be updated when the container grows.
  *
  * @ingroup containers
  */
-template<FaceConcept T>
-class FaceContainer : public ElementContainer<T>
+template<FaceConcept T, bool CHUNKED = false>
+class FaceContainer : public ElementContainer<T, CHUNKED>
 {
-    template<FaceConcept U>
+    template<FaceConcept U, bool C>
     friend class FaceContainer;
 
-    using FaceContainerType = FaceContainer<T>;
-    using Base              = ElementContainer<T>;
+    using FaceContainerType = FaceContainer<T, CHUNKED>;
+    using Base              = ElementContainer<T, CHUNKED>;
 
 public:
     using Face              = T;
@@ -1212,10 +1215,8 @@ protected:
     void manageImportTriFromPoly(const OthMesh& m)
     {
         if constexpr (HasFaceContainer<OthMesh>) {
-            using ParentMesh  = Base::ParentMeshType;
-            using VertexType  = ParentMesh::VertexType;
-            using MVertexType = OthMesh::VertexType;
-            using MFaceType   = OthMesh::FaceType;
+            using ParentMesh = Base::ParentMeshType;
+            using MFaceType  = OthMesh::FaceType;
 
             using VertexContainer = ParentMesh::VertexContainer;
 
@@ -1238,9 +1239,6 @@ protected:
                 FaceType::VERTEX_NUMBER == 3 &&
                 (MFaceType::VERTEX_NUMBER > 3 ||
                  MFaceType::VERTEX_NUMBER < 0)) {
-                VertexType*        base   = &Base::mParentMesh->vertex(0);
-                const MVertexType* mvbase = &m.vertex(0);
-
                 for (const MFaceType& mf : m.faces()) {
                     // if the current face has the same number of vertices of
                     // this faces (3), then the vertex pointers have been
@@ -1255,7 +1253,7 @@ protected:
                         std::vector<uint> tris =
                             earCut(mf.vertices() | views::positions);
                         FaceType& f = face(m.index(mf));
-                        importTriPointersHelper(f, mf, base, mvbase, tris, 0);
+                        importTriPointersHelper(f, mf, tris, 0);
 
                         // number of other faces to add
                         uint nf  = tris.size() / 3 - 1;
@@ -1264,8 +1262,7 @@ protected:
                         uint i = 3; // index that cycles into tris
                         for (; fid < faceContainerSize(); ++fid) {
                             FaceType& f = face(fid);
-                            importTriPointersHelper(
-                                f, mf, base, mvbase, tris, i);
+                            importTriPointersHelper(f, mf, tris, i);
                             i += 3;
                         }
                     }
@@ -1297,18 +1294,17 @@ private:
         addFaceHelper(f, args...);
     }
 
-    template<typename MFaceType, typename VertexType, typename MVertexType>
+    template<typename MFaceType>
     static void importTriPointersHelper(
         FaceType&                f,
         const MFaceType&         mf,
-        VertexType*              base,
-        const MVertexType*       mvbase,
         const std::vector<uint>& tris,
         uint                     basetri)
     {
         f.importFrom(mf); // import all the components from mf
         for (uint i = basetri, j = 0; i < basetri + 3; i++, j++) {
-            f.setVertex(j, base + (mf.vertex(tris[i]) - mvbase));
+            // the vertices have the same indices in the two meshes
+            f.setVertex(j, mf.vertexIndex(tris[i]));
 
             // wedge colors
             if constexpr (
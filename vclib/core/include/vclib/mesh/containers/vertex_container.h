@@ -44,16 +44,20 @@ namespace vcl::mesh {
  * This container can be templated on a type that satisfies the VertexConcept
  * concept.
  *
+ * When CHUNKED is true, the vertices are stored in fixed size chunks (see
+ * ChunkedVector) and their addresses never change when new vertices are added:
+ * no pointer stored in the mesh needs to be updated when the container grows.
+ *
  * @ingroup containers
  */
-template<VertexConcept T>
-class VertexContainer : public ElementContainer<T>
+template<VertexConcept T, bool CHUNKED = false>
+class VertexContainer : public ElementContainer<T, CHUNKED>
 {
-    template<VertexConcept U>
+    template<VertexConcept U, bool C>
     friend class VertexContainer;
 
-    using VertexContainerType = VertexContainer<T>;
-    using Base                = ElementContainer<T>;
+    using VertexContainerType = VertexContainer<T, CHUNKED>;
+    using Base                = ElementContainer<T, CHUNKED>;
 
 public:
     using Vertex              = T;
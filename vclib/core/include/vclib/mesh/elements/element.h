@@ -40,7 +40,7 @@
 
 namespace vcl::mesh {
 
-template<ElementConcept>
+template<ElementConcept, bool>
 class ElementContainer;
 
 } // namespace vcl::mesh
@@ -55,7 +55,7 @@ namespace vcl {
 template<uint ELEM_ID, typename MeshType, typename... Comps>
 class Element : public comp::ParentMeshPointer<MeshType>, public Comps...
 {
-    template<ElementConcept>
+    template<ElementConcept, bool>
     friend class mesh::ElementContainer;
 
 public:
@@ -29,6 +29,8 @@
 #include <vclib/algorithms/core/transform.h>
 #include <vclib/concepts/mesh.h>
 
+#include <span>
+
 namespace vcl {
 
 /**
@@ -75,7 +77,7 @@ class Mesh : public Args...
     template<typename El, bool b>
     friend struct comp::detail::ComponentData;
 
-    template<ElementConcept T>
+    template<ElementConcept T, bool C>
     friend class mesh::ElementContainer;
 
     template<uint ELEM_ID, typename MeshType, typename... Comps>
@@ -724,6 +726,60 @@ public:
         return Cont::deletedElementNumber();
     }
 
+    /**
+     * @brief Returns a span over the contiguous array that stores the data of
+     * the given vertical component of the elements of the given type. The
+     * i-th value of the span is the data of the element having index i in its
+     * container (deleted elements included).
+     *
+     * This allows geometry kernels to process the data of a component (e.g.
+     * the positions of the vertices) with a cache-friendly layout, without
+     * accessing to the elements. If the component is optional and it is not
+     * enabled, the returned span is empty.
+     *
+     * The function requires that the Mesh has a Container of Elements having ID
+     * ELEM_ID, and that the elements have a vertical component having ID
+     * COMP_ID. Otherwise, a compiler error will be triggered.
+     *
+     * @tparam ELEM_ID: the ID of the element.
+     * @tparam COMP_ID: the ID of the vertical component.
+     * @return a span over the data of the component of the elements.
+     */
+    template<uint ELEM_ID, uint COMP_ID>
+    auto verticalComponentData() requires (
+        hasContainerOf<ELEM_ID>() &&
+        comp::HasVerticalComponentOfType<
+            typename ContainerOfElement<ELEM_ID>::type::ElementType,
+            COMP_ID>)
+    {
+        using Cont = ContainerOfElement<ELEM_ID>::type;
+        using Comp = comp::ComponentOfType<
+            COMP_ID,
+            typename Cont::ElementType::Components>;
+
+        return std::span(
+            Cont::mVerticalCompVecTuple.template vector<Comp>());
+    }
+
+    /**
+     * @copydoc verticalComponentData()
+     */
+    template<uint ELEM_ID, uint COMP_ID>
+    auto verticalComponentData() const requires (
+        hasContainerOf<ELEM_ID>() &&
+        comp::HasVerticalComponentOfType<
+            typename ContainerOfElement<ELEM_ID>::type::ElementType,
+            COMP_ID>)
+    {
+        using Cont = ContainerOfElement<ELEM_ID>::type;
+        using Comp = comp::ComponentOfType<
+            COMP_ID,
+            typename Cont::ElementType::Components>;
+
+        return std::span(
+            Cont::mVerticalCompVecTuple.template vector<Comp>());
+    }
+
     /**
      * @brief Adds a new element of the given type into its container, returning
      * the index of the added element in its container.
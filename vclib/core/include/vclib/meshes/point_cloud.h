@@ -28,22 +28,22 @@
 
 namespace vcl {
 
-template<typename ScalarType>
+template<typename ScalarType, bool VERTICAL = false>
 class PointCloudT;
 
 } // namespace vcl
 
 namespace vcl::pointcloud {
 
-template<typename Scalar>
+template<typename Scalar, bool VERTICAL = false>
 class Vertex;
 
 /**
  * @brief The Vertex type used by the PointCloudT class.
  *
- * @extends vert::BitFlags
- * @extends vert::Position3
- * @extends vert::Normal3
+ * @extends vert::BitFlags (or vert::VerticalBitFlags)
+ * @extends vert::Position3 (or vert::VerticalPosition3)
+ * @extends vert::Normal3 (or vert::VerticalNormal3)
  * @extends vert::OptionalColor
  * @extends vert::OptionalQuality
  * @extends vert::OptionalTexCoord
@@ -51,21 +51,32 @@ class Vertex;
  * @extends vert::CustomComponents
  *
  * @tparam Scalar: The scalar type used for the mesh.
+ * @tparam V: A boolean flag that indicates whether the bit flags, the position
+ * and the normal are stored vertically, in contiguous per-component arrays.
  *
  * @ingroup meshes
  */
-template<typename Scalar>
+template<typename Scalar, bool V>
 class Vertex :
         public vcl::Vertex<
-            PointCloudT<Scalar>,
-            vert::BitFlags,
-            vert::Position3<Scalar>,
-            vert::Normal3<Scalar>,
-            vert::OptionalColor<Vertex<Scalar>>,
-            vert::OptionalQuality<Scalar, Vertex<Scalar>>,
-            vert::OptionalTexCoord<Scalar, Vertex<Scalar>>,
-            vert::OptionalMark<Vertex<Scalar>>,
-            vert::CustomComponents<Vertex<Scalar>>>
+            PointCloudT<Scalar, V>,
+            std::conditional_t<
+                V,
+                vert::VerticalBitFlags<Vertex<Scalar, V>>,
+                vert::BitFlags>,
+            std::conditional_t<
+                V,
+                vert::VerticalPosition3<Scalar, Vertex<Scalar, V>>,
+                vert::Position3<Scalar>>,
+            std::conditional_t<
+                V,
+                vert::VerticalNormal3<Scalar, Vertex<Scalar, V>>,
+                vert::Normal3<Scalar>>,
+            vert::OptionalColor<Vertex<Scalar, V>>,
+            vert::OptionalQuality<Scalar, Vertex<Scalar, V>>,
+            vert::OptionalTexCoord<Scalar, Vertex<Scalar, V>>,
+            vert::OptionalMark<Vertex<Scalar, V>>,
+            vert::CustomComponents<Vertex<Scalar, V>>>
 {
 };
 
@@ -78,7 +89,12 @@ namespace vcl {
  *
  * It allows to store only pointcloud::Vertex elements.
  *
+ * When VERTICAL is true, the bit flags, the positions and the normals of the
+ * vertices are stored vertically, like in the TriMeshT class.
+ *
  * @tparam Scalar: The scalar type used for the mesh.
+ * @tparam VERTICAL: A boolean flag that indicates whether the non-optional
+ * components of the vertices are stored vertically.
  *
  * @extends mesh::VertexContainer
  * @extends mesh::BoundingBox3
@@ -90,10 +106,10 @@ namespace vcl {
  *
  * @ingroup meshes
  */
-template<typename Scalar>
+template<typename Scalar, bool VERTICAL>
 class PointCloudT :
         public Mesh<
-            mesh::VertexContainer<pointcloud::Vertex<Scalar>>,
+            mesh::VertexContainer<pointcloud::Vertex<Scalar, VERTICAL>>,
             mesh::BoundingBox3<Scalar>,
             mesh::Mark,
             mesh::Name,
@@ -120,6 +136,22 @@ using PointCloudf = PointCloudT<float>;
  */
 using PointCloud = PointCloudT<double>;
 
+/**
+ * @brief The PointCloudVerticalf class is a specialization of the PointCloudT
+ * class that uses `float` as scalar, and stores the components of the
+ * vertices vertically.
+ * @ingroup meshes
+ */
+using PointCloudVerticalf = PointCloudT<float, true>;
+
+/**
+ * @brief The PointCloudVertical class is a specialization of the PointCloudT
+ * class that uses `double` as scalar, and stores the components of the
+ * vertices vertically.
+ * @ingroup meshes
+ */
+using PointCloudVertical = PointCloudT<double, true>;
+
 } // namespace vcl
 
 #endif // VCL_MESHES_POINT_CLOUD_H
@@ -28,25 +28,37 @@
 
 namespace vcl {
 
-template<typename ScalarType, bool INDEXED>
+template<
+    typename ScalarType,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class PolyMeshT;
 
 } // namespace vcl
 
 namespace vcl::polymesh {
 
-template<typename Scalar, bool INDEXED>
+template<
+    typename Scalar,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class Vertex;
 
-template<typename Scalar, bool INDEXED>
+template<
+    typename Scalar,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class Face;
 
 /**
  * @brief The Vertex type used by the PolyMeshT class.
  *
- * @extends vert::BitFlags
- * @extends vert::Position3
- * @extends vert::Normal3
+ * @extends vert::BitFlags (or vert::VerticalBitFlags)
+ * @extends vert::Position3 (or vert::VerticalPosition3)
+ * @extends vert::Normal3 (or vert::VerticalNormal3)
  * @extends vert::OptionalColor
  * @extends vert::OptionalQuality
  * @extends vert::OptionalAdjacentFaces
@@ -59,33 +71,49 @@ class Face;
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam I: A boolean flag that indicates whether the mesh uses indices or
  * pointers to store vertices of faces and adjacency information.
+ * @tparam V: A boolean flag that indicates whether the bit flags, the position
+ * and the normal are stored vertically, in contiguous per-component arrays.
+ * @tparam C: A boolean flag that indicates whether the elements are stored in
+ * chunks having stable addresses.
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool I>
+template<typename Scalar, bool I, bool V, bool C>
 class Vertex :
         public vcl::Vertex<
-            PolyMeshT<Scalar, I>,
-            vert::BitFlags,
-            vert::Position3<Scalar>,
-            vert::Normal3<Scalar>,
-            vert::OptionalColor<Vertex<Scalar, I>>,
-            vert::OptionalQuality<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalAdjacentFaces<I, Face<Scalar, I>, Vertex<Scalar, I>>,
-            vert::OptionalAdjacentVertices<I, Vertex<Scalar, I>>,
-            vert::OptionalPrincipalCurvature<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalTexCoord<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalMark<Vertex<Scalar, I>>,
-            vert::CustomComponents<Vertex<Scalar, I>>>
+            PolyMeshT<Scalar, I, V, C>,
+            std::conditional_t<
+                V,
+                vert::VerticalBitFlags<Vertex<Scalar, I, V, C>>,
+                vert::BitFlags>,
+            std::conditional_t<
+                V,
+                vert::VerticalPosition3<Scalar, Vertex<Scalar, I, V, C>>,
+                vert::Position3<Scalar>>,
+            std::conditional_t<
+                V,
+                vert::VerticalNormal3<Scalar, Vertex<Scalar, I, V, C>>,
+                vert::Normal3<Scalar>>,
+            vert::OptionalColor<Vertex<Scalar, I, V, C>>,
+            vert::OptionalQuality<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalAdjacentFaces<
+                I,
+                Face<Scalar, I, V, C>,
+                Vertex<Scalar, I, V, C>>,
+            vert::OptionalAdjacentVertices<I, Vertex<Scalar, I, V, C>>,
+            vert::OptionalPrincipalCurvature<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalTexCoord<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalMark<Vertex<Scalar, I, V, C>>,
+            vert::CustomComponents<Vertex<Scalar, I, V, C>>>
 {
 };
 
 /**
  * @brief The Face type used by the PolyMeshT class.
  *
- * @extends face::PolygonBitFlags
+ * @extends face::PolygonBitFlags (or face::VerticalPolygonBitFlags)
  * @extends face::PolygonVertexRefs
- * @extends face::Normal3
+ * @extends face::Normal3 (or face::VerticalNormal3)
  * @extends face::OptionalColor
  * @extends face::OptionalQuality
  * @extends face::OptionalAdjacentPolygons
@@ -96,22 +124,35 @@ class Vertex :
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam I: A boolean flag that indicates whether the mesh uses indices or
  * pointers to store vertices of faces and adjacency information.
+ * @tparam V: A boolean flag that indicates whether the bit flags and the
+ * normal are stored vertically, in contiguous per-component arrays.
+ * @tparam C: A boolean flag that indicates whether the elements are stored in
+ * chunks having stable addresses.
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool I>
+template<typename Scalar, bool I, bool V, bool C>
 class Face :
         public vcl::Face<
-            PolyMeshT<Scalar, I>,
-            face::PolygonBitFlags, // 4b
-            face::PolygonVertexRefs<I, Vertex<Scalar, I>, Face<Scalar, I>>,
-            face::Normal3<Scalar>,
-            face::OptionalColor<Face<Scalar, I>>,
-            face::OptionalQuality<Scalar, Face<Scalar, I>>,
-            face::OptionalAdjacentPolygons<I, Face<Scalar, I>>,
-            face::OptionalPolygonWedgeTexCoords<Scalar, Face<Scalar, I>>,
-            face::OptionalMark<Face<Scalar, I>>,
-            face::CustomComponents<Face<Scalar, I>>>
+            PolyMeshT<Scalar, I, V, C>,
+            std::conditional_t<
+                V,
+                face::VerticalPolygonBitFlags<Face<Scalar, I, V, C>>,
+                face::PolygonBitFlags>, // 4b
+            face::PolygonVertexRefs<
+                I,
+                Vertex<Scalar, I, V, C>,
+                Face<Scalar, I, V, C>>,
+            std::conditional_t<
+                V,
+                face::VerticalNormal3<Scalar, Face<Scalar, I, V, C>>,
+                face::Normal3<Scalar>>,
+            face::OptionalColor<Face<Scalar, I, V, C>>,
+            face::OptionalQuality<Scalar, Face<Scalar, I, V, C>>,
+            face::OptionalAdjacentPolygons<I, Face<Scalar, I, V, C>>,
+            face::OptionalPolygonWedgeTexCoords<Scalar, Face<Scalar, I, V, C>>,
+            face::OptionalMark<Face<Scalar, I, V, C>>,
+            face::CustomComponents<Face<Scalar, I, V, C>>>
 {
 };
 
@@ -124,9 +165,20 @@ namespace vcl {
  *
  * It allows to store polymesh::Vertex and polymesh::Face elements.
  *
+ * When VERTICAL is true, the bit flags, the positions and the normals of the
+ * vertices, and the bit flags and the normals of the faces are stored
+ * vertically, like in the TriMeshT class. When CHUNKED is true, the vertices
+ * and the faces are stored in chunks having stable addresses, like in the
+ * TriMeshT class.
+ *
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam INDEXED: A boolean flag that indicates whether the mesh uses indices
  * or pointers to store references.
+ * @tparam VERTICAL: A boolean flag that indicates whether the non-optional
+ * components of the elements (except the vertex references) are stored
+ * vertically.
+ * @tparam CHUNKED: A boolean flag that indicates whether the vertices and the
+ * faces are stored in chunks having stable addresses.
  *
  * @extends mesh::VertexContainer
  * @extends mesh::FaceContainer
@@ -140,11 +192,15 @@ namespace vcl {
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool INDEXED>
+template<typename Scalar, bool INDEXED, bool VERTICAL, bool CHUNKED>
 class PolyMeshT :
         public Mesh<
-            mesh::VertexContainer<polymesh::Vertex<Scalar, INDEXED>>,
-            mesh::FaceContainer<polymesh::Face<Scalar, INDEXED>>,
+            mesh::VertexContainer<
+                polymesh::Vertex<Scalar, INDEXED, VERTICAL, CHUNKED>,
+                CHUNKED>,
+            mesh::FaceContainer<
+                polymesh::Face<Scalar, INDEXED, VERTICAL, CHUNKED>,
+                CHUNKED>,
             mesh::BoundingBox3<Scalar>,
             mesh::Color,
             mesh::Mark,
@@ -190,6 +246,42 @@ using PolyMeshIndexedf = PolyMeshT<float, true>;
  */
 using PolyMeshIndexed = PolyMeshT<double, true>;
 
+/**
+ * @brief The PolyMeshVerticalf class is a specialization of the PolyMeshT
+ * class that uses `float` as scalar, pointers to store vertices of faces and
+ * adjacency information, and stores the components of vertices and faces
+ * vertically.
+ * @ingroup meshes
+ */
+using PolyMeshVerticalf = PolyMeshT<float, false, true>;
+
+/**
+ * @brief The PolyMeshVertical class is a specialization of the PolyMeshT class
+ * that uses `double` as scalar, pointers to store vertices of faces and
+ * adjacency information, and stores the components of vertices and faces
+ * vertically.
+ * @ingroup meshes
+ */
+using PolyMeshVertical = PolyMeshT<double, false, true>;
+
+/**
+ * @brief The PolyMeshChunkedf class is a specialization of the PolyMeshT
+ * class that uses `float` as scalar, pointers to store vertices of faces and
+ * adjacency information, and stores vertices and faces in chunks having
+ * stable addresses.
+ * @ingroup meshes
+ */
+using PolyMeshChunkedf = PolyMeshT<float, false, false, true>;
+
+/**
+ * @brief The PolyMeshChunked class is a specialization of the PolyMeshT class
+ * that uses `double` as scalar, pointers to store vertices of faces and
+ * adjacency information, and stores vertices and faces in chunks having
+ * stable addresses.
+ * @ingroup meshes
+ */
+using PolyMeshChunked = PolyMeshT<double, false, false, true>;
+
 } // namespace vcl
 
 #endif // VCL_MESHES_POLY_MESH_H
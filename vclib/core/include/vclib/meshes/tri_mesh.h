@@ -28,25 +28,37 @@
 
 namespace vcl {
 
-template<typename ScalarType, bool INDEXED>
+template<
+    typename ScalarType,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class TriMeshT;
 
 } // namespace vcl
 
 namespace vcl::trimesh {
 
-template<typename Scalar, bool INDEXED>
+template<
+    typename Scalar,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class Vertex;
 
-template<typename Scalar, bool INDEXED>
+template<
+    typename Scalar,
+    bool INDEXED,
+    bool VERTICAL = false,
+    bool CHUNKED  = false>
 class Face;
 
 /**
  * @brief The Vertex type used by the TriMeshT class.
  *
- * @extends vert::BitFlags
- * @extends vert::Position3
- * @extends vert::Normal3
+ * @extends vert::BitFlags (or vert::VerticalBitFlags)
+ * @extends vert::Position3 (or vert::VerticalPosition3)
+ * @extends vert::Normal3 (or vert::VerticalNormal3)
  * @extends vert::OptionalColor
  * @extends vert::OptionalQuality
  * @extends vert::OptionalAdjacentFaces
@@ -59,33 +71,49 @@ class Face;
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam I: A boolean flag that indicates whether the mesh uses indices or
  * pointers to store vertices of faces and adjacency information.
+ * @tparam V: A boolean flag that indicates whether the bit flags, the position
+ * and the normal are stored vertically, in contiguous per-component arrays.
+ * @tparam C: A boolean flag that indicates whether the elements are stored in
+ * chunks having stable addresses.
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool I>
+template<typename Scalar, bool I, bool V, bool C>
 class Vertex :
         public vcl::Vertex<
-            TriMeshT<Scalar, I>,
-            vert::BitFlags,
-            vert::Position3<Scalar>,
-            vert::Normal3<Scalar>,
-            vert::OptionalColor<Vertex<Scalar, I>>,
-            vert::OptionalQuality<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalAdjacentFaces<I, Face<Scalar, I>, Vertex<Scalar, I>>,
-            vert::OptionalAdjacentVertices<I, Vertex<Scalar, I>>,
-            vert::OptionalPrincipalCurvature<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalTexCoord<Scalar, Vertex<Scalar, I>>,
-            vert::OptionalMark<Vertex<Scalar, I>>,
-            vert::CustomComponents<Vertex<Scalar, I>>>
+            TriMeshT<Scalar, I, V, C>,
+            std::conditional_t<
+                V,
+                vert::VerticalBitFlags<Vertex<Scalar, I, V, C>>,
+                vert::BitFlags>,
+            std::conditional_t<
+                V,
+                vert::VerticalPosition3<Scalar, Vertex<Scalar, I, V, C>>,
+                vert::Position3<Scalar>>,
+            std::conditional_t<
+                V,
+                vert::VerticalNormal3<Scalar, Vertex<Scalar, I, V, C>>,
+                vert::Normal3<Scalar>>,
+            vert::OptionalColor<Vertex<Scalar, I, V, C>>,
+            vert::OptionalQuality<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalAdjacentFaces<
+                I,
+                Face<Scalar, I, V, C>,
+                Vertex<Scalar, I, V, C>>,
+            vert::OptionalAdjacentVertices<I, Vertex<Scalar, I, V, C>>,
+            vert::OptionalPrincipalCurvature<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalTexCoord<Scalar, Vertex<Scalar, I, V, C>>,
+            vert::OptionalMark<Vertex<Scalar, I, V, C>>,
+            vert::CustomComponents<Vertex<Scalar, I, V, C>>>
 {
 };
 
 /**
  * @brief The Face type used by the TriMeshT class.
  *
- * @extends face::TriangleBitFlags
+ * @extends face::TriangleBitFlags (or face::VerticalTriangleBitFlags)
  * @extends face::TriangleVertexRefs
- * @extends face::Normal3
+ * @extends face::Normal3 (or face::VerticalNormal3)
  * @extends face::OptionalColor
  * @extends face::OptionalQuality
  * @extends face::OptionalAdjacentTriangles
@@ -96,22 +124,37 @@ class Vertex :
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam I: A boolean flag that indicates whether the mesh uses indices or
  * pointers to store vertices of faces and adjacency information.
+ * @tparam V: A boolean flag that indicates whether the bit flags and the
+ * normal are stored vertically, in contiguous per-component arrays.
+ * @tparam C: A boolean flag that indicates whether the elements are stored in
+ * chunks having stable addresses.
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool I>
+template<typename Scalar, bool I, bool V, bool C>
 class Face :
         public vcl::Face<
-            TriMeshT<Scalar, I>,
-            face::TriangleBitFlags,
-            face::TriangleVertexRefs<I, Vertex<Scalar, I>, Face<Scalar, I>>,
-            face::Normal3<Scalar>,
-            face::OptionalColor<Face<Scalar, I>>,
-            face::OptionalQuality<Scalar, Face<Scalar, I>>,
-            face::OptionalAdjacentTriangles<I, Face<Scalar, I>>,
-            face::OptionalTriangleWedgeTexCoords<Scalar, Face<Scalar, I>>,
-            face::OptionalMark<Face<Scalar, I>>,
-            face::CustomComponents<Face<Scalar, I>>>
+            TriMeshT<Scalar, I, V, C>,
+            std::conditional_t<
+                V,
+                face::VerticalTriangleBitFlags<Face<Scalar, I, V, C>>,
+                face::TriangleBitFlags>,
+            face::TriangleVertexRefs<
+                I,
+                Vertex<Scalar, I, V, C>,
+                Face<Scalar, I, V, C>>,
+            std::conditional_t<
+                V,
+                face::VerticalNormal3<Scalar, Face<Scalar, I, V, C>>,
+                face::Normal3<Scalar>>,
+            face::OptionalColor<Face<Scalar, I, V, C>>,
+            face::OptionalQuality<Scalar, Face<Scalar, I, V, C>>,
+            face::OptionalAdjacentTriangles<I, Face<Scalar, I, V, C>>,
+            face::OptionalTriangleWedgeTexCoords<
+                Scalar,
+                Face<Scalar, I, V, C>>,
+            face::OptionalMark<Face<Scalar, I, V, C>>,
+            face::CustomComponents<Face<Scalar, I, V, C>>>
 {
 };
 
@@ -124,13 +167,35 @@ namespace vcl {
  *
  * It allows to store trimesh::Vertex and trimesh::Face elements.
  *
- * The mesh is templated over the scalar type and a boolean flag that indicates
+ * The mesh is templated over the scalar type, a boolean flag that indicates
  * whether the mesh uses indices to store vertices of faces and adjacency
- * information.
+ * information, and two boolean flags that select the storage of the elements
+ * and of their components.
+ *
+ * When VERTICAL is true, the bit flags, the positions and the normals of the
+ * vertices, and the bit flags and the normals of the faces are stored
+ * vertically: each one in a contiguous array owned by its container, like the
+ * optional components. The API of the elements does not change, but the
+ * elements are smaller, and the algorithms that touch only some components
+ * (e.g. the positions) do not stream through cache the other ones. The
+ * contiguous arrays can be accessed with the Mesh::verticalComponentData
+ * member function.
+ *
+ * When CHUNKED is true, the vertices and the faces are stored in fixed size
+ * chunks (see ChunkedVector) instead of contiguous vectors: their addresses
+ * never change when new elements are added, and therefore the pointers stored
+ * in the mesh never need to be updated when the mesh grows. This makes the
+ * incremental construction of a mesh (adding one element at a time) linear,
+ * at the cost of a slightly slower access by index.
  *
  * @tparam Scalar: The scalar type used for the mesh.
  * @tparam INDEXED: A boolean flag that indicates whether the mesh uses indices
  * or pointers to store references.
+ * @tparam VERTICAL: A boolean flag that indicates whether the non-optional
+ * components of the elements (except the vertex references) are stored
+ * vertically.
+ * @tparam CHUNKED: A boolean flag that indicates whether the vertices and the
+ * faces are stored in chunks having stable addresses.
  *
  * @extends mesh::VertexContainer
  * @extends mesh::FaceContainer
@@ -144,11 +209,15 @@ namespace vcl {
  *
  * @ingroup meshes
  */
-template<typename Scalar, bool INDEXED>
+template<typename Scalar, bool INDEXED, bool VERTICAL, bool CHUNKED>
 class TriMeshT :
         public Mesh<
-            mesh::VertexContainer<trimesh::Vertex<Scalar, INDEXED>>,
-            mesh::FaceContainer<trimesh::Face<Scalar, INDEXED>>,
+            mesh::VertexContainer<
+                trimesh::Vertex<Scalar, INDEXED, VERTICAL, CHUNKED>,
+                CHUNKED>,
+            mesh::FaceContainer<
+                trimesh::Face<Scalar, INDEXED, VERTICAL, CHUNKED>,
+                CHUNKED>,
             mesh::BoundingBox3<Scalar>,
             mesh::Color,
             mesh::Mark,
@@ -192,6 +261,40 @@ using TriMeshIndexedf = TriMeshT<float, true>;
  */
 using TriMeshIndexed = TriMeshT<double, true>;
 
+/**
+ * @brief The TriMeshVerticalf class is a specialization of TriMeshT that uses
+ * `float` as scalar, pointers to store vertices of faces and adjacency
+ * information, and stores the components of vertices and faces vertically.
+ * @ingroup meshes
+ */
+using TriMeshVerticalf = TriMeshT<float, false, true>;
+
+/**
+ * @brief The TriMeshVertical class is a specialization of TriMeshT that uses
+ * `double` as scalar, pointers to store vertices of faces and adjacency
+ * information, and stores the components of vertices and faces vertically.
+ * @ingroup meshes
+ */
+using TriMeshVertical = TriMeshT<double, false, true>;
+
+/**
+ * @brief The TriMeshChunkedf class is a specialization of TriMeshT that uses
+ * `float` as scalar, pointers to store vertices of faces and adjacency
+ * information, and stores vertices and faces in chunks having stable
+ * addresses.
+ * @ingroup meshes
+ */
+using TriMeshChunkedf = TriMeshT<float, false, false, true>;
+
+/**
+ * @brief The TriMeshChunked class is a specialization of TriMeshT that uses
+ * `double` as scalar, pointers to store vertices of faces and adjacency
+ * information, and stores vertices and faces in chunks having stable
+ * addresses.
+ * @ingroup meshes
+ */
+using TriMeshChunked = TriMeshT<double, false, false, true>;
+
 } // namespace vcl
 
 #endif // VCL_MESHES_TRI_MESH_H
@@ -23,12 +23,205 @@
 #ifndef VCL_MISC_COMPACTNESS_H
 #define VCL_MISC_COMPACTNESS_H
 
+#include <vclib/misc/parallel.h>
 #include <vclib/types.h>
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace vcl {
 
+/**
+ * @brief Number of values processed by each parallel task of the functions
+ * of this file. Vectors smaller than this are compacted sequentially.
+ */
+inline constexpr uint COMPACTNESS_VALUES_PER_CHUNK = 16384;
+
+namespace detail {
+
+// the parallel algorithms need two passes over the values: on a single thread
+// the sequential in-place algorithms are faster
+inline bool compactInParallel(std::size_t n)
+{
+    return n > COMPACTNESS_VALUES_PER_CHUNK &&
+           std::thread::hardware_concurrency() > 1;
+}
+
+// calls f(begin, end) in parallel on the chunks of the range [0, n)
+template<typename F>
+void parallelForCompactnessChunks(std::size_t n, F&& f)
+{
+    const uint nChunks =
+        (n + COMPACTNESS_VALUES_PER_CHUNK - 1) / COMPACTNESS_VALUES_PER_CHUNK;
+
+    if (nChunks < 2) {
+        f(std::size_t(0), n);
+        return;
+    }
+
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    parallelFor(chunks, [&](uint c) {
+        std::size_t b = std::size_t(c) * COMPACTNESS_VALUES_PER_CHUNK;
+        f(b, std::min(n, b + COMPACTNESS_VALUES_PER_CHUNK));
+    });
+}
+
+// implementation of compactIndices: if parallel is false, the indices are
+// computed with a single sequential pass
+template<typename DeletedFunction>
+std::vector<uint> compactIndices(
+    uint              n,
+    DeletedFunction&& isDeleted,
+    bool              parallel)
+{
+    std::vector<uint> newIndices(n);
+
+    if (!parallel) {
+        uint k = 0;
+        for (uint i = 0; i < n; ++i)
+            newIndices[i] = isDeleted(i) ? UINT_NULL : k++;
+        return newIndices;
+    }
+
+    const uint nChunks =
+        (n + COMPACTNESS_VALUES_PER_CHUNK - 1) / COMPACTNESS_VALUES_PER_CHUNK;
+
+    // the first pass marks the deleted values with UINT_NULL
+    std::vector<uint> offsets(nChunks + 1, 0);
+    parallelForCompactnessChunks(n, [&](std::size_t b, std::size_t e) {
+        uint k = 0;
+        for (std::size_t i = b; i < e; ++i) {
+            bool d        = isDeleted(i);
+            newIndices[i] = d ? UINT_NULL : 0;
+            k += !d;
+        }
+        offsets[b / COMPACTNESS_VALUES_PER_CHUNK + 1] = k;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    parallelForCompactnessChunks(n, [&](std::size_t b, std::size_t e) {
+        uint k = offsets[b / COMPACTNESS_VALUES_PER_CHUNK];
+        for (std::size_t i = b; i < e; ++i) {
+            if (newIndices[i] != UINT_NULL)
+                newIndices[i] = k++;
+        }
+    });
+    return newIndices;
+}
+
+// implementation of compactVector: if parallel is false, or if the values are
+// bools (std::vector<bool> cannot be written concurrently), the vector is
+// compacted sequentially in place
+template<typename VecType>
+void compactVector(
+    VecType&                 vec,
+    const std::vector<uint>& newIndices,
+    bool                     keepStorage,
+    bool                     parallel)
+{
+    using ValueType = VecType::value_type;
+
+    assert(vec.size() == newIndices.size());
+
+    if (!parallel || std::is_same_v<ValueType, bool>) {
+        uint newSize = 0;
+        for (uint i = 0; i < newIndices.size(); ++i) {
+            if (newIndices[i] != UINT_NULL) {
+                ++newSize;
+                if (newIndices[i] != i) {
+                    // must move the element from position i to position
+                    // newIndices[i]
+                    vec[newIndices[i]] = std::move(vec[i]);
+                }
+            }
+        }
+        vec.resize(newSize);
+        return;
+    }
+
+    const uint newSize = std::ranges::count_if(newIndices, [](uint i) {
+        return i != UINT_NULL;
+    });
+
+    if (keepStorage) {
+        // uninitialized scratch buffer, indexed by the new positions: only the
+        // elements that change position are constructed in it
+        std::allocator<ValueType> alloc;
+        ValueType*                tmp = alloc.allocate(newSize);
+
+        auto moves = [&](std::size_t i) {
+            return newIndices[i] != UINT_NULL && newIndices[i] != i;
+        };
+
+        parallelForCompactnessChunks(
+            newIndices.size(), [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    if (moves(i))
+                        std::construct_at(
+                            tmp + newIndices[i], std::move(vec[i]));
+                }
+            });
+        parallelForCompactnessChunks(
+            newIndices.size(), [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    if (moves(i)) {
+                        vec[newIndices[i]] = std::move(tmp[newIndices[i]]);
+                        std::destroy_at(tmp + newIndices[i]);
+                    }
+                }
+            });
+
+        alloc.deallocate(tmp, newSize);
+        vec.resize(newSize);
+    }
+    else {
+        VecType tmp(newSize);
+        parallelForCompactnessChunks(
+            newIndices.size(), [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    if (newIndices[i] != UINT_NULL)
+                        tmp[newIndices[i]] = std::move(vec[i]);
+                }
+            });
+
+        using std::swap;
+        swap(vec, tmp);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the vector that tells, for each one of the n values of a
+ * container, its index after the compactness of the container, that is the
+ * number of non-deleted values that precede it. Deleted values get the index
+ * UINT_NULL.
+ *
+ * The indices are computed with a parallel exclusive scan: the non-deleted
+ * values are counted for each chunk, and the chunks are then filled starting
+ * from their own offset. The isDeleted function is called once per value.
+ *
+ * @param[in] n: the number of values of the container.
+ * @param[in] isDeleted: function that, given the index of a value, tells
+ * whether the value is deleted. It is called concurrently.
+ * @return the vector of the new indices, having size n.
+ */
+template<typename DeletedFunction>
+std::vector<uint> compactIndices(uint n, DeletedFunction&& isDeleted)
+{
+    return detail::compactIndices(
+        n,
+        std::forward<DeletedFunction>(isDeleted),
+        detail::compactInParallel(n));
+}
+
 /**
  * @brief It will take care of compacting the vector vec, depending on the
  * content of the vector newIndices.
@@ -45,27 +238,29 @@ namespace vcl {
  * than the new size of vec after the compactness. The new size of vec will be
  * the number of non-null elements of newIndices.
  *
- * @param vec
+ * When more than one hardware thread is available, large vectors are
+ * compacted in parallel, moving the kept elements into a fresh buffer that
+ * replaces the storage of vec. If keepStorage is true, the storage of vec is
+ * instead preserved: the elements that change position are moved into a
+ * scratch buffer and then back into their new position in vec. In this case,
+ * pointers to the old elements can still be rebased w.r.t. the storage of vec
+ * (e.g. the vector of the elements of a mesh container).
+ *
+ * @param vec: a vector-like container (e.g. std::vector or vcl::ChunkedVector)
  * @param newIndices
+ * @param keepStorage: if true, the storage of vec is not replaced.
  */
-template<typename T, typename... Args>
+template<typename VecType>
 void compactVector(
-    std::vector<T, Args...>& vec,
-    const std::vector<uint>& newIndices)
+    VecType&                 vec,
+    const std::vector<uint>& newIndices,
+    bool                     keepStorage = false)
 {
-    assert(vec.size() == newIndices.size());
-    uint newSize = 0;
-    for (uint i = 0; i < newIndices.size(); ++i) {
-        if (newIndices[i] != UINT_NULL) {
-            ++newSize;
-            if (newIndices[i] != i) {
-                // must move the element from position i to position
-                // newIndices[i]
-                vec[newIndices[i]] = std::move(vec[i]);
-            }
-        }
-    }
-    vec.resize(newSize);
+    detail::compactVector(
+        vec,
+        newIndices,
+        keepStorage,
+        detail::compactInParallel(newIndices.size()));
 }
 
 } // namespace vcl
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_MISC_RADIX_SORT_H
+#define VCL_MISC_RADIX_SORT_H
+
+#include <vclib/misc/parallel.h>
+#include <vclib/types.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief Number of elements processed by each parallel task of the sorting
+ * functions (and of the other chunked parallel loops of the library).
+ *
+ * @ingroup miscellaneous
+ */
+inline constexpr uint SORT_VALUES_PER_CHUNK = 16384;
+
+/**
+ * @brief Sorts in parallel a vector of [key, value] pairs by their 64 bit
+ * unsigned keys, using a least significant digit radix sort.
+ *
+ * Only the lowest `keyBits` bits of the keys are considered, and passes on
+ * digits that are equal for all the keys are skipped: sorting keys that pack
+ * small indices (e.g. vertex indices) requires therefore only few passes.
+ *
+ * The sort is stable: pairs having the same key keep their relative order.
+ *
+ * @param[in, out] vec: the vector of pairs to sort.
+ * @param[in] keyBits: the number of (lowest) bits of the keys to consider.
+ *
+ * @ingroup miscellaneous
+ */
+template<typename T>
+void radixSortByKey(
+    std::vector<std::pair<uint64_t, T>>& vec,
+    uint                                 keyBits = 64)
+{
+    constexpr uint DIGIT_BITS = 11;
+    constexpr uint BUCKETS    = 1 << DIGIT_BITS;
+
+    const std::size_t n = vec.size();
+    if (n < 2)
+        return;
+
+    const uint nChunks =
+        (n + SORT_VALUES_PER_CHUNK - 1) / SORT_VALUES_PER_CHUNK;
+    std::vector<uint> chunks(nChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    auto chunkEnd = [&](uint c) {
+        return std::min<std::size_t>(
+            n, std::size_t(c + 1) * SORT_VALUES_PER_CHUNK);
+    };
+
+    std::vector<std::pair<uint64_t, T>>          tmp(n);
+    std::vector<std::array<std::size_t, BUCKETS>> counts(nChunks);
+
+    for (uint shift = 0; shift < keyBits; shift += DIGIT_BITS) {
+        // histogram of the digit, for each chunk
+        parallelFor(chunks, [&](uint c) {
+            std::array<std::size_t, BUCKETS>& cnt = counts[c];
+            cnt.fill(0);
+            for (std::size_t i = std::size_t(c) * SORT_VALUES_PER_CHUNK;
+                 i < chunkEnd(c);
+                 ++i)
+                ++cnt[(vec[i].first >> shift) & (BUCKETS - 1)];
+        });
+
+        // starting position of each [bucket, chunk] pair, ordered by bucket
+        // and then by chunk to keep the sort stable
+        std::size_t sum        = 0;
+        bool        sameDigits = false;
+        for (uint b = 0; b < BUCKETS; ++b) {
+            const std::size_t bucketBegin = sum;
+            for (uint c = 0; c < nChunks; ++c) {
+                std::size_t k = counts[c][b];
+                counts[c][b]  = sum;
+                sum += k;
+            }
+            if (sum - bucketBegin == n)
+                sameDigits = true;
+        }
+        if (sameDigits)
+            continue;
+
+        parallelFor(chunks, [&](uint c) {
+            std::array<std::size_t, BUCKETS>& pos = counts[c];
+            for (std::size_t i = std::size_t(c) * SORT_VALUES_PER_CHUNK;
+                 i < chunkEnd(c);
+                 ++i) {
+                uint d        = (vec[i].first >> shift) & (BUCKETS - 1);
+                tmp[pos[d]++] = std::move(vec[i]);
+            }
+        });
+        vec.swap(tmp);
+    }
+}
+
+/**
+ * @brief Returns the number of bits required to store the index of any
+ * element of a container having the given size.
+ *
+ * @ingroup miscellaneous
+ */
+inline uint indexBitWidth(uint containerSize)
+{
+    return std::max<uint>(1, std::bit_width(containerSize));
+}
+
+} // namespace vcl
+
+#endif // VCL_MISC_RADIX_SORT_H
@@ -31,19 +31,31 @@
 namespace vcl {
 
 /**
- * @brief The Tokenizer class
+ * @brief The Tokenizer class splits a string in tokens, using a set of
+ * separator characters.
+ *
+ * A Tokenizer can be reused to split several strings with the same separators,
+ * by calling the tokenize() member function: the storage of the tokens is
+ * reused between calls, so that no allocations are made when splitting
+ * strings having tokens of similar lengths (e.g. when reading a text file
+ * line by line).
  */
 class Tokenizer
 {
     std::vector<char> mSeparators = {'\0'};
 
+    // the storage of the tokens: only the first mSize strings are valid, the
+    // other ones are kept to reuse their memory
     std::vector<std::string> mSplitted;
+    uint                     mSize = 0;
 
 public:
     using iterator = std::vector<std::string>::const_iterator;
 
     Tokenizer() = default;
 
+    Tokenizer(const std::vector<char>& separators) : mSeparators(separators) {}
+
     Tokenizer(const char* string, char separator, bool jumpEmptyTokens = true) :
             mSeparators({separator})
     {
@@ -74,11 +86,23 @@ public:
         split(string.c_str(), jumpEmptyTokens);
     }
 
+    /**
+     * @brief Splits the given string using the separators of the Tokenizer,
+     * replacing the tokens of the previously tokenized string.
+     *
+     * @param[in] string: the string to split.
+     * @param[in] jumpEmptyTokens: if true, empty tokens are not stored.
+     */
+    void tokenize(const std::string& string, bool jumpEmptyTokens = true)
+    {
+        split(string.c_str(), jumpEmptyTokens);
+    }
+
     iterator begin() const { return mSplitted.begin(); }
 
-    iterator end() const { return mSplitted.end(); }
+    iterator end() const { return mSplitted.begin() + mSize; }
 
-    unsigned long int size() const { return (unsigned long) mSplitted.size(); }
+    unsigned long int size() const { return (unsigned long) mSize; }
 
     const std::string& operator[](uint i) const { return mSplitted[i]; }
 
@@ -86,7 +110,7 @@ private:
     void split(const char* str, bool jumpEmptyTokens = true)
     {
         // https://stackoverflow.com/questions/53849/
-        mSplitted.clear();
+        mSize = 0;
         if (*str != '\0') {
             do {
                 const char* begin = str;
@@ -94,14 +118,23 @@ private:
                 while (isDiffFromAllSeparators(str) && *str)
                     str++;
                 if (begin != str)
-                    mSplitted.push_back(std::string(begin, str));
+                    pushToken(begin, str);
                 else if (!jumpEmptyTokens) {
-                    mSplitted.push_back(std::string());
+                    pushToken(begin, begin);
                 }
             } while ('\0' != *str++);
         }
     }
 
+    void pushToken(const char* begin, const char* end)
+    {
+        if (mSize < mSplitted.size())
+            mSplitted[mSize].assign(begin, end);
+        else
+            mSplitted.emplace_back(begin, end);
+        ++mSize;
+    }
+
     bool isDiffFromAllSeparators(const char* str)
     {
         bool diffFromAllSeparators = true;
@@ -62,7 +62,9 @@ void deserialize(std::istream& is, T& data, std::endian endian)
  * stream. If the endian format is different from the native one, the data is
  * swapped.
  *
- * By default, the deserialization is done in binary little endian format.
+ * By default, the deserialization is done in binary little endian format. If
+ * the endian format is the native one, the array is read with a single read
+ * call.
  *
  * @param[in] is: input stream.
  * @param[out] data: pointer to the deserialized data.
@@ -76,8 +78,13 @@ void deserializeN(
     std::size_t   size,
     std::endian   endian = std::endian::little)
 {
-    for (std::size_t i = 0; i < size; ++i) {
-        deserialize(is, data[i], endian);
+    if (endian == std::endian::native) {
+        is.read(reinterpret_cast<char*>(data), sizeof(T) * size);
+    }
+    else {
+        for (std::size_t i = 0; i < size; ++i) {
+            deserialize(is, data[i], endian);
+        }
     }
 }
 
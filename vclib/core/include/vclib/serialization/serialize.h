@@ -62,7 +62,9 @@ void serialize(std::ostream& os, const T& data, std::endian endian)
  * The endian format specifies if the data should be converted to a different
  * endianness w.r.t. the native one.
  *
- * By default, the serialization is done in binary little endian format.
+ * By default, the serialization is done in binary little endian format. If
+ * the endian format is the native one, the array is written with a single
+ * write call.
  *
  * @param[in] os: output stream.
  * @param[in] data: pointer to the data to serialize.
@@ -76,8 +78,13 @@ void serializeN(
     std::size_t   size,
     std::endian   endian = std::endian::little)
 {
-    for (std::size_t i = 0; i < size; ++i) {
-        serialize(os, data[i], endian);
+    if (endian == std::endian::native) {
+        os.write(reinterpret_cast<const char*>(data), sizeof(T) * size);
+    }
+    else {
+        for (std::size_t i = 0; i < size; ++i) {
+            serialize(os, data[i], endian);
+        }
     }
 }
 
@@ -25,7 +25,6 @@
 
 #include "deserialize.h"
 
-#include <any>
 #include <array>
 #include <string>
 #include <vector>
@@ -80,6 +79,10 @@ void deserialize(std::istream& is, std::vector<T>& v)
             e.deserialize(is);
         }
     }
+    else if constexpr (IsNotClass<T> && !std::is_same_v<T, bool>) {
+        // contiguous values: read with a single call, when possible
+        deserializeN(is, v.data(), size);
+    }
     else {
         for (T& e : v) {
             deserialize(is, e);
@@ -87,28 +90,6 @@ void deserialize(std::istream& is, std::vector<T>& v)
     }
 }
 
-template<typename T>
-void deserialize(std::istream& is, std::vector<std::any>& v)
-{
-    std::size_t size;
-    deserialize(is, size);
-    v.resize(size);
-    if constexpr (Serializable<T>) {
-        for (std::any& e : v) {
-            T obj;
-            obj.deserialize(is);
-            e = std::move(obj);
-        }
-    }
-    else {
-        for (std::any& e : v) {
-            T obj;
-            deserialize(is, obj);
-            e = std::move(obj);
-        }
-    }
-}
-
 } // namespace vcl
 
 #endif // VCL_SERIALIZATION_STL_DESERIALIZE_H
@@ -25,7 +25,6 @@
 
 #include "serialize.h"
 
-#include <any>
 #include <array>
 #include <string>
 #include <vector>
@@ -78,6 +77,10 @@ void serialize(std::ostream& os, const std::vector<T>& v)
             e.serialize(os);
         }
     }
+    else if constexpr (IsNotClass<T> && !std::is_same_v<T, bool>) {
+        // contiguous values: written with a single call, when possible
+        serializeN(os, v.data(), size);
+    }
     else {
         for (const T& e : v) {
             serialize(os, e);
@@ -85,23 +88,6 @@ void serialize(std::ostream& os, const std::vector<T>& v)
     }
 }
 
-template<typename T>
-void serialize(std::ostream& os, const std::vector<std::any>& v)
-{
-    std::size_t size = v.size();
-    serialize(os, size);
-    if constexpr (Serializable<T>) {
-        for (const std::any& e : v) {
-            std::any_cast<T>(e).serialize(os);
-        }
-    }
-    else {
-        for (const std::any& e : v) {
-            serialize(os, std::any_cast<T>(e));
-        }
-    }
-}
-
 } // namespace vcl
 
 #endif // VCL_SERIALIZATION_STL_SERIALIZE_H
@@ -23,6 +23,9 @@
 #ifndef VCL_SPACE_COMPLEX_H
 #define VCL_SPACE_COMPLEX_H
 
+#include "complex/bvh.h"
+#include "complex/connected_components.h"
+#include "complex/face_triangulation.h"
 #include "complex/graph.h"
 #include "complex/grid.h"
 #include "complex/kd_tree.h"
@@ -32,5 +35,6 @@
 #include "complex/mesh_pos.h"
 #include "complex/sampler.h"
 #include "complex/tri_poly_index_bimap.h"
+#include "complex/union_find.h"
 
 #endif // VCL_SPACE_COMPLEX_H
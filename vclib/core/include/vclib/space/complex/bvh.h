@@ -0,0 +1,972 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_COMPLEX_BVH_H
+#define VCL_SPACE_COMPLEX_BVH_H
+
+#include <vclib/algorithms/core/bounding_box.h>
+#include <vclib/algorithms/core/distance/functions.h>
+#include <vclib/algorithms/core/polygon.h>
+#include <vclib/concepts/ranges/mesh/face_range.h>
+#include <vclib/misc/parallel.h>
+#include <vclib/space/complex/face_triangulation.h>
+#include <vclib/space/core/sphere.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+namespace vcl {
+
+// maximum number of values stored in a leaf of the BVH
+inline constexpr uint BVH_MAX_LEAF_SIZE = 4;
+
+// maximum depth of the BVH: nodes at this depth become leaves regardless of
+// the number of their values. It bounds the stack used by the queries
+inline constexpr uint BVH_MAX_DEPTH = 64;
+
+// number of bins used to evaluate the Surface Area Heuristic
+inline constexpr uint BVH_SAH_BINS = 16;
+
+// nodes with less values than this are built as independent parallel tasks;
+// larger nodes are split with a parallel binning of their values
+inline constexpr uint BVH_VALUES_PER_TASK = 4096;
+
+/**
+ * @brief The BVH class is a Bounding Volume Hierarchy built on a set of
+ * spatial objects (e.g. the faces of a mesh), that allows to perform closest
+ * value, ray intersection and sphere/box overlap queries.
+ *
+ * Unlike the uniform grids (e.g. StaticGrid), the BVH adapts to the
+ * distribution of the values, and it does not degrade on meshes having very
+ * non-uniform element density.
+ *
+ * The hierarchy is built top-down using a binned Surface Area Heuristic
+ * (SAH). The top levels of the tree are split using a parallel binning of
+ * the values; the subtrees having less than BVH_VALUES_PER_TASK values are
+ * then built in parallel, and finally merged in a single vector of nodes.
+ *
+ * Nodes are stored in a flat vector, and the two children of an inner node
+ * are stored in consecutive positions. The values are stored in the order of
+ * the leaves, so each leaf refers to a contiguous range of values.
+ *
+ * The ValueType can be an object or a pointer to an object for which the
+ * vcl::boundingBox function is defined. Null pointers are not stored in the
+ * BVH.
+ *
+ * @tparam ValueType: the type of the values stored in the BVH.
+ * @tparam ScalarType: the scalar type used for the bounding boxes of the
+ * nodes.
+ *
+ * @ingroup space_complex
+ */
+template<typename ValueType, typename ScalarType = double>
+class BVH
+{
+    /* VT is ValueType without pointers or references */
+    using VT = RemoveCVRefAndPointer<ValueType>;
+
+public:
+    using PointType = Point3<ScalarType>;
+    using BBoxType  = Box3<ScalarType>;
+
+    using ConstIterator = std::vector<ValueType>::const_iterator;
+
+private:
+    struct Node
+    {
+        BBoxType bbox;
+        // inner node: index of the first child (the second child is first + 1)
+        // leaf: index of the first value of the leaf
+        uint first = 0;
+        // number of values of the leaf, 0 if the node is an inner node
+        uint count = 0;
+
+        bool isLeaf() const { return count > 0; }
+    };
+
+    // a node whose subtree must be built by a parallel task
+    struct Task
+    {
+        uint node;
+        uint begin;
+        uint end;
+        uint depth;
+    };
+
+    // bounding boxes and centroids of the values, used only during the build
+    struct BuildData
+    {
+        std::vector<BBoxType>  boxes;
+        std::vector<PointType> centroids;
+        std::vector<uint>      indices;
+    };
+
+    struct Bin
+    {
+        BBoxType bbox;
+        uint     count = 0;
+    };
+
+    // bins of a range of values, along the three axes
+    struct Bins
+    {
+        std::array<std::array<Bin, BVH_SAH_BINS>, 3> bins;
+
+        void merge(const Bins& b)
+        {
+            for (uint a = 0; a < 3; ++a) {
+                for (uint i = 0; i < BVH_SAH_BINS; ++i) {
+                    grow(bins[a][i].bbox, b.bins[a][i].bbox);
+                    bins[a][i].count += b.bins[a][i].count;
+                }
+            }
+        }
+    };
+
+    // bounding box of a range of values and of their centroids
+    struct Bounds
+    {
+        BBoxType bbox;
+        BBoxType centroids;
+
+        void merge(const Bounds& b)
+        {
+            grow(bbox, b.bbox);
+            grow(centroids, b.centroids);
+        }
+    };
+
+    using NodeStack = std::array<uint, BVH_MAX_DEPTH + 1>;
+
+    std::vector<Node> mNodes;
+
+    // values sorted by leaf
+    std::vector<ValueType> mValues;
+
+    // bounding boxes of the values, in the same order of mValues
+    std::vector<BBoxType> mBoxes;
+
+    // triangulation of the polygonal faces, in the same order of mValues
+    FaceTriangulation mTriangulation;
+
+public:
+    BVH() = default;
+
+    template<typename ObjIterator>
+    BVH(ObjIterator begin, ObjIterator end)
+    {
+        std::vector<ValueType> values;
+        for (ObjIterator it = begin; it != end; ++it) {
+            const ValueType v = *it;
+            if (addressOfObj(v))
+                values.push_back(v);
+        }
+        build(values);
+    }
+
+    template<Range Rng>
+    BVH(Rng&& r) : BVH(std::ranges::begin(r), std::ranges::end(r))
+    {
+    }
+
+    /**
+     * @brief Builds the BVH of a range of pointers to the faces of a mesh,
+     * taking the triangles of the polygonal faces from the given
+     * triangulation of the mesh instead of triangulating them again.
+     *
+     * @param[in] r: the range of face pointers.
+     * @param[in] triangulation: the triangulation of the faces of the mesh
+     * (see FaceTriangulation(const MeshType&)), indexed by face index.
+     */
+    template<Range Rng>
+    BVH(Rng&& r, const FaceTriangulation& triangulation)
+        requires (FaceConcept<VT> && std::is_pointer_v<ValueType>)
+    {
+        std::vector<ValueType> values;
+        for (const ValueType v : r) {
+            if (v)
+                values.push_back(v);
+        }
+        build(values, &triangulation);
+    }
+
+    bool empty() const { return mValues.empty(); }
+
+    uint size() const { return mValues.size(); }
+
+    uint nodeNumber() const { return mNodes.size(); }
+
+    BBoxType boundingBox() const
+    {
+        return mNodes.empty() ? BBoxType() : mNodes[0].bbox;
+    }
+
+    ConstIterator begin() const { return mValues.begin(); }
+
+    ConstIterator end() const { return mValues.end(); }
+
+    /**
+     * @brief Returns an iterator to the value closest to the query value,
+     * according to the given bounded distance function, or end() if there is
+     * no value closer than the given maximum distance.
+     *
+     * Nodes are visited starting from the closest one, and a node is skipped
+     * if the distance between its bounding box and the bounding box of the
+     * query value is greater than the distance of the closest value found so
+     * far.
+     *
+     * @param[in] qv: the query value.
+     * @param[in] distFunction: a callable that takes as input the query value,
+     * a value stored in the BVH and a maximum distance, and returns their
+     * distance (or a value greater than the maximum distance).
+     * @param[in/out] dist: on input, the maximum distance of the searched
+     * value; on output, the distance of the closest value, if found.
+     * @return the iterator to the closest value, or end().
+     */
+    template<typename QueryValueType, typename DistFunction>
+    ConstIterator closestValue(
+        const QueryValueType& qv,
+        DistFunction&&        distFunction,
+        ScalarType&           dist) const
+        requires std::invocable<
+            DistFunction&,
+            const QueryValueType&,
+            const VT&,
+            ScalarType>
+    {
+        using QVT      = RemoveCVRefAndPointer<QueryValueType>;
+        const QVT* qvv = addressOfObj(qv);
+
+        ConstIterator result = end();
+        if (!qvv || mNodes.empty())
+            return result;
+
+        const BBoxType qbb = vcl::boundingBox(*qvv).template cast<ScalarType>();
+
+        ScalarType best  = dist;
+        ScalarType best2 = sqBound(best);
+
+        NodeStack stack;
+        uint      top = 0;
+        stack[top++]  = 0;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (sqDist(node.bbox, qbb) > best2)
+                continue;
+
+            if (node.isLeaf()) {
+                for (uint i = node.first; i < node.first + node.count; ++i) {
+                    if (sqDist(mBoxes[i], qbb) > best2)
+                        continue;
+                    ScalarType d =
+                        distFunction(qv, dereferencePtr(mValues[i]), best);
+                    if (d < best) {
+                        best   = d;
+                        best2  = sqBound(best);
+                        result = begin() + i;
+                    }
+                }
+            }
+            else {
+                ScalarType dl = sqDist(mNodes[node.first].bbox, qbb);
+                ScalarType dr = sqDist(mNodes[node.first + 1].bbox, qbb);
+                // the closest child is pushed last, to be visited first
+                uint near = node.first, far = node.first + 1;
+                if (dr < dl) {
+                    std::swap(near, far);
+                    std::swap(dl, dr);
+                }
+                if (dr <= best2)
+                    stack[top++] = far;
+                if (dl <= best2)
+                    stack[top++] = near;
+            }
+        }
+
+        if (result != end())
+            dist = best;
+        return result;
+    }
+
+    template<typename QueryValueType, typename DistFunction>
+    ConstIterator closestValue(
+        const QueryValueType& qv,
+        DistFunction&&        distFunction,
+        ScalarType&           dist) const
+        requires std::invocable<DistFunction&, const QueryValueType&, const VT&>
+    {
+        auto boundDistFun =
+            [&](const QueryValueType& q, const VT& v, ScalarType) {
+                return distFunction(q, v);
+            };
+
+        dist = std::numeric_limits<ScalarType>::max();
+
+        return closestValue(qv, boundDistFun, dist);
+    }
+
+    template<typename QueryValueType>
+    ConstIterator closestValue(const QueryValueType& qv, ScalarType& dist) const
+    {
+        auto f = boundedDistFunction<QueryValueType, VT, ScalarType>();
+        return closestValue(qv, f, dist);
+    }
+
+    template<typename QueryValueType>
+    ConstIterator closestValue(const QueryValueType& qv) const
+    {
+        ScalarType maxDist = std::numeric_limits<ScalarType>::max();
+        return closestValue(qv, maxDist);
+    }
+
+    /**
+     * @brief Returns an iterator to the first value (face) intersected by the
+     * given ray, or end() if the ray does not intersect any value.
+     *
+     * The intersection point is origin + t * direction. Nodes are visited
+     * front to back, and a node is skipped if the ray enters its bounding box
+     * after the closest intersection found so far.
+     *
+     * Polygonal faces are triangulated with the earcut algorithm.
+     *
+     * @param[in] origin: the origin of the ray.
+     * @param[in] direction: the direction of the ray.
+     * @param[in/out] t: on input, the maximum value of the ray parameter; on
+     * output, the ray parameter of the intersection point, if found.
+     * @return the iterator to the first intersected value, or end().
+     */
+    ConstIterator rayIntersection(
+        const PointType& origin,
+        const PointType& direction,
+        ScalarType&      t) const requires FaceConcept<VT>
+    {
+        ConstIterator result = end();
+        if (mNodes.empty())
+            return result;
+
+        PointType invDir;
+        for (uint a = 0; a < 3; ++a)
+            invDir[a] = ScalarType(1) / direction[a];
+
+        ScalarType best = t;
+
+        NodeStack  stack;
+        uint       top = 0;
+        ScalarType tn;
+        if (rayBox(origin, invDir, mNodes[0].bbox, best, tn))
+            stack[top++] = 0;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (!rayBox(origin, invDir, node.bbox, best, tn))
+                continue;
+
+            if (node.isLeaf()) {
+                for (uint i = node.first; i < node.first + node.count; ++i) {
+                    if (!rayBox(origin, invDir, mBoxes[i], best, tn))
+                        continue;
+                    ScalarType tf;
+                    if (rayFace(origin, direction, i, best, tf)) {
+                        best   = tf;
+                        result = begin() + i;
+                    }
+                }
+            }
+            else {
+                ScalarType tl, tr;
+                bool       hl = rayBox(
+                    origin, invDir, mNodes[node.first].bbox, best, tl);
+                bool hr = rayBox(
+                    origin, invDir, mNodes[node.first + 1].bbox, best, tr);
+                // the child entered first is pushed last, to be visited first
+                uint near = node.first, far = node.first + 1;
+                if (hr && (!hl || tr < tl)) {
+                    std::swap(near, far);
+                    std::swap(hl, hr);
+                }
+                if (hr)
+                    stack[top++] = far;
+                if (hl)
+                    stack[top++] = near;
+            }
+        }
+
+        if (result != end())
+            t = best;
+        return result;
+    }
+
+    ConstIterator rayIntersection(
+        const PointType& origin,
+        const PointType& direction) const requires FaceConcept<VT>
+    {
+        ScalarType t = std::numeric_limits<ScalarType>::max();
+        return rayIntersection(origin, direction, t);
+    }
+
+    /**
+     * @brief Fills the given vector with the iterators to the values that are
+     * inside the given sphere.
+     *
+     * Points and vertices are tested against the sphere; for the other value
+     * types, the bounding box of the value is tested.
+     *
+     * The vector is cleared before being filled, but its capacity is kept:
+     * reusing the same vector for several queries avoids allocations.
+     *
+     * @param[in] s: the query sphere.
+     * @param[out] resVec: the iterators to the values inside the sphere.
+     */
+    void valuesInSphere(
+        const Sphere<ScalarType>&   s,
+        std::vector<ConstIterator>& resVec) const
+    {
+        BBoxType sbb;
+        sbb.add(s.center(), s.radius());
+
+        overlapQuery(
+            resVec,
+            [&](const BBoxType& b) {
+                return sbb.overlap(b) && s.intersects(b);
+            },
+            [&](uint i) {
+                if constexpr (PointConcept<VT> || VertexConcept<VT>) {
+                    return s.isInside(valuePosition(i));
+                }
+                else {
+                    return s.intersects(mBoxes[i]);
+                }
+            });
+    }
+
+    std::vector<ConstIterator> valuesInSphere(const Sphere<ScalarType>& s) const
+    {
+        std::vector<ConstIterator> resVec;
+        valuesInSphere(s, resVec);
+        return resVec;
+    }
+
+    /**
+     * @brief Fills the given vector with the iterators to the values that are
+     * inside the given box.
+     *
+     * Points and vertices are tested against the box; for the other value
+     * types, the bounding box of the value is tested.
+     *
+     * The vector is cleared before being filled, but its capacity is kept:
+     * reusing the same vector for several queries avoids allocations.
+     *
+     * @param[in] b: the query box.
+     * @param[out] resVec: the iterators to the values inside the box.
+     */
+    void valuesInBox(const BBoxType& b, std::vector<ConstIterator>& resVec)
+        const
+    {
+        overlapQuery(
+            resVec,
+            [&](const BBoxType& nb) {
+                return b.overlap(nb);
+            },
+            [&](uint i) {
+                if constexpr (PointConcept<VT> || VertexConcept<VT>) {
+                    return b.isInside(valuePosition(i));
+                }
+                else {
+                    return b.overlap(mBoxes[i]);
+                }
+            });
+    }
+
+    std::vector<ConstIterator> valuesInBox(const BBoxType& b) const
+    {
+        std::vector<ConstIterator> resVec;
+        valuesInBox(b, resVec);
+        return resVec;
+    }
+
+private:
+    // the triangles of the polygonal faces are copied from the triangulation,
+    // if given, otherwise they are computed
+    void build(
+        std::vector<ValueType>&  values,
+        const FaceTriangulation* triangulation = nullptr)
+    {
+        const uint n = values.size();
+        if (n == 0)
+            return;
+
+        BuildData data;
+        data.boxes.resize(n);
+        data.centroids.resize(n);
+        data.indices.resize(n);
+        std::iota(data.indices.begin(), data.indices.end(), 0);
+
+        forEachChunk(0, n, [&](uint begin, uint end) {
+            for (uint i = begin; i < end; ++i) {
+                data.boxes[i] = vcl::boundingBox(dereferencePtr(values[i]))
+                                    .template cast<ScalarType>();
+                data.centroids[i] = data.boxes[i].center();
+            }
+        });
+
+        // top levels of the tree, split with a parallel binning
+        std::vector<Task> tasks;
+        mNodes.resize(1);
+        buildNode(mNodes, 0, 0, n, 0, data, &tasks);
+
+        // subtrees, built in parallel in their own vectors of nodes
+        std::vector<std::vector<Node>> subtrees(tasks.size());
+        parallelFor(tasks, [&](const Task& t) {
+            std::vector<Node>& nodes = subtrees[&t - tasks.data()];
+            nodes.resize(1);
+            nodes.reserve(2 * (t.end - t.begin) / BVH_MAX_LEAF_SIZE + 1);
+            buildNode(nodes, 0, t.begin, t.end, t.depth, data, nullptr);
+        });
+
+        // merge: the root of each subtree replaces the node of its task, and
+        // the other nodes are appended to the nodes vector
+        std::vector<uint> bases(tasks.size() + 1, mNodes.size());
+        for (uint i = 0; i < tasks.size(); ++i)
+            bases[i + 1] = bases[i] + subtrees[i].size() - 1;
+        mNodes.resize(bases.back());
+
+        parallelFor(tasks, [&](const Task& t) {
+            const uint i = &t - tasks.data();
+
+            const std::vector<Node>& nodes = subtrees[i];
+            // local node j > 0 is stored at position bases[i] + j - 1
+            auto relocate = [&](Node nd) {
+                if (!nd.isLeaf())
+                    nd.first += bases[i] - 1;
+                return nd;
+            };
+            mNodes[t.node] = relocate(nodes[0]);
+            for (uint j = 1; j < nodes.size(); ++j)
+                mNodes[bases[i] + j - 1] = relocate(nodes[j]);
+        });
+
+        mValues.resize(n);
+        mBoxes.resize(n);
+        forEachChunk(0, n, [&](uint begin, uint end) {
+            for (uint i = begin; i < end; ++i) {
+                mValues[i] = values[data.indices[i]];
+                mBoxes[i]  = data.boxes[data.indices[i]];
+            }
+        });
+
+        if constexpr (
+            FaceConcept<VT> && !TriangleFaceConcept<VT> &&
+            std::is_pointer_v<ValueType>) {
+            if (triangulation) {
+                mTriangulation = FaceTriangulation(
+                    *triangulation,
+                    mValues | std::views::transform([](ValueType f) {
+                        return f->index();
+                    }));
+            }
+            else {
+                mTriangulation = FaceTriangulation(mValues);
+            }
+        }
+    }
+
+    /**
+     * Builds the subtree of the given node, that contains the values in the
+     * range [begin, end) of data.indices. If tasks is not nullptr, the nodes
+     * having less than BVH_VALUES_PER_TASK values are not built, but stored in
+     * the tasks vector.
+     */
+    void buildNode(
+        std::vector<Node>& nodes,
+        uint               id,
+        uint               begin,
+        uint               end,
+        uint               depth,
+        BuildData&         data,
+        std::vector<Task>* tasks) const
+    {
+        const uint count = end - begin;
+
+        if (tasks && count < BVH_VALUES_PER_TASK) {
+            tasks->push_back({id, begin, end, depth});
+            return;
+        }
+
+        const Bounds bounds = rangeBounds(begin, end, data);
+        nodes[id].bbox      = bounds.bbox;
+
+        uint mid = end;
+        if (count > BVH_MAX_LEAF_SIZE && depth < BVH_MAX_DEPTH)
+            mid = split(begin, end, bounds, data);
+
+        if (mid == end) { // leaf
+            nodes[id].first = begin;
+            nodes[id].count = count;
+            return;
+        }
+
+        const uint left = nodes.size();
+        nodes[id].first = left;
+        nodes[id].count = 0;
+        nodes.resize(left + 2);
+
+        buildNode(nodes, left, begin, mid, depth + 1, data, tasks);
+        buildNode(nodes, left + 1, mid, end, depth + 1, data, tasks);
+    }
+
+    /**
+     * Partitions the values in the range [begin, end) of data.indices using
+     * the binned Surface Area Heuristic, and returns the index of the first
+     * value of the second half.
+     */
+    uint split(uint begin, uint end, const Bounds& bounds, BuildData& data)
+        const
+    {
+        const uint      count = end - begin;
+        const BBoxType& cbb   = bounds.centroids;
+        const PointType csize = cbb.size();
+
+        // all the centroids are in the same position: split by count
+        if (csize.maxCoeff() <= 0)
+            return begin + count / 2;
+
+        PointType scale;
+        for (uint a = 0; a < 3; ++a)
+            scale[a] = csize[a] > 0 ? BVH_SAH_BINS / csize[a] : 0;
+
+        auto binOf = [&](uint v, uint a) {
+            uint b = (data.centroids[v][a] - cbb.min()[a]) * scale[a];
+            return std::min(b, BVH_SAH_BINS - 1);
+        };
+
+        const Bins bins = reduceChunks<Bins>(begin, end, [&](Bins& b, uint i) {
+            const uint v = data.indices[i];
+            for (uint a = 0; a < 3; ++a) {
+                Bin& bin = b.bins[a][binOf(v, a)];
+                grow(bin.bbox, data.boxes[v]);
+                bin.count++;
+            }
+        });
+
+        // cost of a split: number of values of each side weighted by the
+        // surface area of its bounding box
+        ScalarType bestCost = std::numeric_limits<ScalarType>::max();
+        uint       bestAxis = 0, bestBin = 0;
+        for (uint a = 0; a < 3; ++a) {
+            if (csize[a] <= 0)
+                continue;
+
+            // right[i]: area and count of bins [i, BVH_SAH_BINS)
+            std::array<ScalarType, BVH_SAH_BINS> rightArea;
+            std::array<uint, BVH_SAH_BINS>       rightCount;
+            BBoxType                             rbb;
+            uint                                 rc = 0;
+            for (uint i = BVH_SAH_BINS - 1; i > 0; --i) {
+                grow(rbb, bins.bins[a][i].bbox);
+                rc += bins.bins[a][i].count;
+                rightArea[i]  = halfArea(rbb);
+                rightCount[i] = rc;
+            }
+
+            BBoxType lbb;
+            uint     lc = 0;
+            for (uint i = 1; i < BVH_SAH_BINS; ++i) {
+                grow(lbb, bins.bins[a][i - 1].bbox);
+                lc += bins.bins[a][i - 1].count;
+                if (lc == 0 || rightCount[i] == 0)
+                    continue;
+                ScalarType cost =
+                    lc * halfArea(lbb) + rightCount[i] * rightArea[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = a;
+                    bestBin  = i;
+                }
+            }
+        }
+
+        if (bestBin == 0)
+            return begin + count / 2;
+
+        auto it = std::partition(
+            data.indices.begin() + begin,
+            data.indices.begin() + end,
+            [&](uint v) {
+                return binOf(v, bestAxis) < bestBin;
+            });
+        return it - data.indices.begin();
+    }
+
+    Bounds rangeBounds(uint begin, uint end, const BuildData& data) const
+    {
+        return reduceChunks<Bounds>(begin, end, [&](Bounds& b, uint i) {
+            const uint v = data.indices[i];
+            grow(b.bbox, data.boxes[v]);
+            grow(b.centroids, BBoxType(data.centroids[v]));
+        });
+    }
+
+    /**
+     * Accumulates the elements in the range [begin, end) in a T object using
+     * the given function. Large ranges are split in chunks that are
+     * accumulated in parallel, and then merged in chunk order.
+     */
+    template<typename T, typename F>
+    static T reduceChunks(uint begin, uint end, F&& f)
+    {
+        const uint nChunks =
+            (end - begin + BVH_VALUES_PER_TASK - 1) / BVH_VALUES_PER_TASK;
+
+        T res;
+        if (nChunks <= 1) {
+            for (uint i = begin; i < end; ++i)
+                f(res, i);
+            return res;
+        }
+
+        std::vector<T> partials(nChunks);
+        forEachChunk(begin, end, [&](uint b, uint e) {
+            T& p = partials[(b - begin) / BVH_VALUES_PER_TASK];
+            for (uint i = b; i < e; ++i)
+                f(p, i);
+        });
+        for (const T& p : partials)
+            res.merge(p);
+        return res;
+    }
+
+    /**
+     * Calls in parallel the given function on the chunks of
+     * BVH_VALUES_PER_TASK elements of the range [begin, end).
+     */
+    template<typename F>
+    static void forEachChunk(uint begin, uint end, F&& f)
+    {
+        const uint nChunks =
+            (end - begin + BVH_VALUES_PER_TASK - 1) / BVH_VALUES_PER_TASK;
+
+        std::vector<uint> chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        parallelFor(chunks, [&](uint c) {
+            uint b = begin + c * BVH_VALUES_PER_TASK;
+            f(b, std::min(end, b + BVH_VALUES_PER_TASK));
+        });
+    }
+
+    template<typename NodeTest, typename ValueTest>
+    void overlapQuery(
+        std::vector<ConstIterator>& resVec,
+        NodeTest&&                  nodeTest,
+        ValueTest&&                 valueTest) const
+    {
+        resVec.clear();
+        if (mNodes.empty())
+            return;
+
+        NodeStack stack;
+        uint      top = 0;
+        stack[top++]  = 0;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (!nodeTest(node.bbox))
+                continue;
+
+            if (node.isLeaf()) {
+                for (uint i = node.first; i < node.first + node.count; ++i) {
+                    if (valueTest(i))
+                        resVec.push_back(begin() + i);
+                }
+            }
+            else {
+                stack[top++] = node.first + 1;
+                stack[top++] = node.first;
+            }
+        }
+    }
+
+    PointType valuePosition(uint i) const
+    {
+        if constexpr (PointConcept<VT>)
+            return dereferencePtr(mValues[i]).template cast<ScalarType>();
+        else
+            return dereferencePtr(mValues[i])
+                .position()
+                .template cast<ScalarType>();
+    }
+
+    // expands b to contain o; unlike Box::add, it does not branch on null
+    // boxes, since a null box has min = max scalar and max = lowest scalar
+    static void grow(BBoxType& b, const BBoxType& o)
+    {
+        b.min() = b.min().cwiseMin(o.min());
+        b.max() = b.max().cwiseMax(o.max());
+    }
+
+    // half of the surface area of the box
+    static ScalarType halfArea(const BBoxType& b)
+    {
+        if (b.isNull())
+            return 0;
+        PointType s = b.size();
+        return s[0] * s[1] + s[1] * s[2] + s[2] * s[0];
+    }
+
+    // squared distance between two boxes, 0 if they overlap
+    static ScalarType sqDist(const BBoxType& b1, const BBoxType& b2)
+    {
+        ScalarType d = 0;
+        for (uint a = 0; a < 3; ++a) {
+            ScalarType g = std::max(
+                {b1.min()[a] - b2.max()[a],
+                 b2.min()[a] - b1.max()[a],
+                 ScalarType(0)});
+            d += g * g;
+        }
+        return d;
+    }
+
+    static ScalarType sqBound(ScalarType d)
+    {
+        if (d >= std::sqrt(std::numeric_limits<ScalarType>::max()))
+            return std::numeric_limits<ScalarType>::max();
+        return d * d;
+    }
+
+    // slab test: tests if the ray enters the box before tMax, and stores in
+    // tEnter the ray parameter of the entry point
+    static bool rayBox(
+        const PointType& origin,
+        const PointType& invDir,
+        const BBoxType&  b,
+        ScalarType       tMax,
+        ScalarType&      tEnter)
+    {
+        ScalarType t0 = 0, t1 = tMax;
+        for (uint a = 0; a < 3; ++a) {
+            ScalarType tn = (b.min()[a] - origin[a]) * invDir[a];
+            ScalarType tf = (b.max()[a] - origin[a]) * invDir[a];
+            if (tn > tf)
+                std::swap(tn, tf);
+            t0 = tn > t0 ? tn : t0;
+            t1 = tf < t1 ? tf : t1;
+        }
+        tEnter = t0;
+        return t0 <= t1;
+    }
+
+    // Moller-Trumbore ray-triangle intersection
+    static bool rayTriangle(
+        const PointType& origin,
+        const PointType& dir,
+        const PointType& p0,
+        const PointType& p1,
+        const PointType& p2,
+        ScalarType       tMax,
+        ScalarType&      t)
+    {
+        const PointType  e1  = p1 - p0;
+        const PointType  e2  = p2 - p0;
+        const PointType  pv  = dir.cross(e2);
+        const ScalarType det = e1.dot(pv);
+        if (det == 0)
+            return false;
+
+        const ScalarType invDet = 1 / det;
+        const PointType  tv     = origin - p0;
+        const ScalarType u      = tv.dot(pv) * invDet;
+        if (u < 0 || u > 1)
+            return false;
+
+        const PointType  qv = tv.cross(e1);
+        const ScalarType v  = dir.dot(qv) * invDet;
+        if (v < 0 || u + v > 1)
+            return false;
+
+        t = e2.dot(qv) * invDet;
+        return t >= 0 && t < tMax;
+    }
+
+    bool rayFace(
+        const PointType& origin,
+        const PointType& dir,
+        uint             i,
+        ScalarType       tMax,
+        ScalarType&      t) const
+    {
+        const VT& f   = dereferencePtr(mValues[i]);
+        auto      pos = [&](uint j) {
+            return f.vertex(j)->position().template cast<ScalarType>();
+        };
+
+        if (f.vertexNumber() == 3)
+            return rayTriangle(origin, dir, pos(0), pos(1), pos(2), tMax, t);
+
+        std::vector<uint> tris;
+        if (mTriangulation.empty()) // faces stored by value
+            tris = earCut(f);
+        std::span<const uint> tv =
+            mTriangulation.empty() ? tris : mTriangulation.triangles(i);
+
+        bool hit = false;
+        for (uint j = 0; j < tv.size(); j += 3) {
+            ScalarType tj;
+            if (rayTriangle(
+                    origin,
+                    dir,
+                    pos(tv[j]),
+                    pos(tv[j + 1]),
+                    pos(tv[j + 2]),
+                    tMax,
+                    tj)) {
+                hit  = true;
+                tMax = tj;
+                t    = tj;
+            }
+        }
+        return hit;
+    }
+};
+
+/* Deduction guides */
+
+template<FacePointerRangeConcept Rng>
+BVH(Rng) -> BVH<
+             typename std::ranges::iterator_t<Rng>::value_type,
+             typename RemovePtr<typename std::ranges::iterator_t<
+                 Rng>::value_type>::VertexType::PositionType::ScalarType>;
+
+template<FacePointerRangeConcept Rng>
+BVH(Rng, const FaceTriangulation&) -> BVH<
+             typename std::ranges::iterator_t<Rng>::value_type,
+             typename RemovePtr<typename std::ranges::iterator_t<
+                 Rng>::value_type>::VertexType::PositionType::ScalarType>;
+
+} // namespace vcl
+
+#endif // VCL_SPACE_COMPLEX_BVH_H
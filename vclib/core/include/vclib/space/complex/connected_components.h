@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_COMPLEX_CONNECTED_COMPONENTS_H
+#define VCL_SPACE_COMPLEX_CONNECTED_COMPONENTS_H
+
+#include <vclib/types.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief The ConnectedComponents class stores a partition of a set of elements
+ * (e.g. the faces of a mesh) in connected components.
+ *
+ * The class stores, for each element, the label of its component (or
+ * UINT_NULL if the element does not belong to any component, e.g. a deleted
+ * face), and the elements of each component in a single buffer, in which the
+ * elements of the i-th component are contiguous and sorted by index.
+ *
+ * Components are numbered in [0, componentNumber()) in the order of their
+ * smallest element.
+ *
+ * @ingroup space_complex
+ */
+class ConnectedComponents
+{
+    std::vector<uint> mLabels;
+    std::vector<uint> mOffsets; // number of components + 1
+    std::vector<uint> mElements;
+
+public:
+    /**
+     * @brief Creates an empty set of connected components.
+     */
+    ConnectedComponents() = default;
+
+    /**
+     * @brief Creates the connected components from the labels of the
+     * elements.
+     *
+     * @param[in] labels: a vector containing, for each element, the label of
+     * its component (labels must be numbered in the order of the smallest
+     * element of each component), or UINT_NULL if the element does not belong
+     * to any component.
+     */
+    explicit ConnectedComponents(std::vector<uint> labels) :
+            mLabels(std::move(labels))
+    {
+        uint nComps = 0;
+        for (uint l : mLabels) {
+            if (l != UINT_NULL) {
+                assert(l <= nComps);
+                nComps = std::max(nComps, l + 1);
+            }
+        }
+
+        mOffsets.assign(nComps + 1, 0);
+        for (uint l : mLabels) {
+            if (l != UINT_NULL)
+                ++mOffsets[l + 1];
+        }
+        std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+
+        std::vector<uint> pos(mOffsets.begin(), mOffsets.end() - 1);
+        mElements.resize(mOffsets.back());
+        for (uint i = 0; i < mLabels.size(); ++i) {
+            if (mLabels[i] != UINT_NULL)
+                mElements[pos[mLabels[i]]++] = i;
+        }
+    }
+
+    /**
+     * @brief Returns true if there are no connected components.
+     */
+    bool empty() const { return componentNumber() == 0; }
+
+    /**
+     * @brief Returns the number of connected components.
+     */
+    uint componentNumber() const
+    {
+        return mOffsets.empty() ? 0 : mOffsets.size() - 1;
+    }
+
+    /**
+     * @brief Returns the number of labeled elements (including the ones that
+     * do not belong to any component).
+     */
+    uint elementNumber() const { return mLabels.size(); }
+
+    /**
+     * @brief Returns the label of the component of the i-th element, or
+     * UINT_NULL if the element does not belong to any component.
+     */
+    uint component(uint i) const
+    {
+        assert(i < mLabels.size());
+        return mLabels[i];
+    }
+
+    /**
+     * @brief Returns the vector of the labels of the components of all the
+     * elements.
+     */
+    const std::vector<uint>& labels() const { return mLabels; }
+
+    /**
+     * @brief Returns the number of elements of the c-th component.
+     */
+    uint componentSize(uint c) const
+    {
+        assert(c < componentNumber());
+        return mOffsets[c + 1] - mOffsets[c];
+    }
+
+    /**
+     * @brief Returns the indices of the elements of the c-th component, sorted
+     * in ascending order.
+     */
+    std::span<const uint> elements(uint c) const
+    {
+        assert(c < componentNumber());
+        return std::span<const uint>(
+            mElements.data() + mOffsets[c], mOffsets[c + 1] - mOffsets[c]);
+    }
+
+    /**
+     * @brief Clears the connected components.
+     */
+    void clear()
+    {
+        mLabels.clear();
+        mOffsets.clear();
+        mElements.clear();
+    }
+};
+
+} // namespace vcl
+
+#endif // VCL_SPACE_COMPLEX_CONNECTED_COMPONENTS_H
@@ -0,0 +1,251 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_COMPLEX_FACE_TRIANGULATION_H
+#define VCL_SPACE_COMPLEX_FACE_TRIANGULATION_H
+
+#include <vclib/algorithms/core/polygon/ear_cut.h>
+#include <vclib/concepts/mesh.h>
+#include <vclib/concepts/ranges/mesh/face_range.h>
+#include <vclib/misc/parallel.h>
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief Number of faces triangulated by each parallel task when building a
+ * FaceTriangulation.
+ */
+inline constexpr uint FACE_TRIANGULATION_FACES_PER_CHUNK = 1024;
+
+/**
+ * @brief The FaceTriangulation class stores a precomputed triangulation of a
+ * set of faces, that can be shared among the algorithms that work on the
+ * triangles of polygonal faces (e.g. distance and intersection queries),
+ * instead of triangulating the same face at each call.
+ *
+ * For each face, the class stores the list of the triangles computed by the
+ * earCut function: each triangle is a triple of positions of vertices in the
+ * face (i.e. indices in [0, f.vertexNumber())). Triangles of all the faces are
+ * stored contiguously in a single buffer, and triangle faces do not require
+ * the ear-cut.
+ *
+ * The triangulation can be built:
+ * - from a mesh: faces are identified by their index in the face container
+ * (deleted faces have no triangles);
+ * - from a range of face pointers: faces are identified by their position in
+ * the range.
+ *
+ * The triangulation is built in parallel, and it must be rebuilt when the
+ * faces are modified.
+ *
+ * @ingroup space_complex
+ */
+class FaceTriangulation
+{
+    std::vector<uint> mOffsets; // number of faces + 1
+    std::vector<uint> mIndices;
+
+public:
+    /**
+     * @brief Creates an empty triangulation.
+     */
+    FaceTriangulation() = default;
+
+    /**
+     * @brief Triangulates the faces of the given mesh. Faces are identified by
+     * their index in the face container of the mesh.
+     *
+     * @param[in] m: the input mesh.
+     */
+    template<FaceMeshConcept MeshType>
+    explicit FaceTriangulation(const MeshType& m)
+    {
+        build(m.faceContainerSize(), [&](uint i) {
+            return m.face(i).deleted() ? nullptr : &m.face(i);
+        });
+    }
+
+    /**
+     * @brief Triangulates the faces of the given random access range of face
+     * pointers. Faces are identified by their position in the range, and null
+     * pointers have no triangles.
+     *
+     * @param[in] faces: the input range of face pointers.
+     */
+    template<FacePointerRangeConcept Rng>
+    explicit FaceTriangulation(Rng&& faces)
+        requires std::ranges::random_access_range<Rng>
+    {
+        auto begin = std::ranges::begin(faces);
+        build(std::ranges::size(faces), [&](uint i) {
+            return begin[i];
+        });
+    }
+
+    /**
+     * @brief Copies the triangles of some faces of the given triangulation,
+     * without triangulating them again: the i-th face of the new
+     * triangulation is the face having the i-th index of the given random
+     * access range in the given triangulation.
+     *
+     * This allows to reorder a triangulation built on a mesh, e.g. following
+     * the order in which the faces are stored in a spatial data structure.
+     *
+     * @param[in] other: the triangulation from which the triangles are copied.
+     * @param[in] faceIndices: the indices of the faces in other.
+     */
+    template<Range Rng>
+    FaceTriangulation(const FaceTriangulation& other, Rng&& faceIndices)
+        requires std::ranges::random_access_range<Rng>
+    {
+        const uint nFaces = std::ranges::size(faceIndices);
+        auto       begin  = std::ranges::begin(faceIndices);
+
+        mOffsets.assign(nFaces + 1, 0);
+        for (uint i = 0; i < nFaces; ++i)
+            mOffsets[i + 1] = mOffsets[i] + other.triangles(begin[i]).size();
+
+        const uint nChunks = (nFaces + FACE_TRIANGULATION_FACES_PER_CHUNK - 1) /
+                             FACE_TRIANGULATION_FACES_PER_CHUNK;
+        std::vector<uint> chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        mIndices.resize(mOffsets.back());
+        parallelFor(chunks, [&](uint c) {
+            uint end = std::min(
+                nFaces, (c + 1) * FACE_TRIANGULATION_FACES_PER_CHUNK);
+            for (uint i = c * FACE_TRIANGULATION_FACES_PER_CHUNK; i < end;
+                 ++i) {
+                std::span<const uint> t = other.triangles(begin[i]);
+                std::copy(t.begin(), t.end(), mIndices.begin() + mOffsets[i]);
+            }
+        });
+    }
+
+    /**
+     * @brief Returns true if the triangulation does not store any face.
+     */
+    bool empty() const { return mOffsets.size() < 2; }
+
+    /**
+     * @brief Returns the number of faces stored in the triangulation
+     * (including the deleted ones, if built from a mesh).
+     */
+    uint faceNumber() const { return empty() ? 0 : mOffsets.size() - 1; }
+
+    /**
+     * @brief Returns the total number of triangles of the triangulation.
+     */
+    uint triangleNumber() const { return mIndices.size() / 3; }
+
+    /**
+     * @brief Returns the number of triangles of the i-th face.
+     */
+    uint triangleNumber(uint i) const
+    {
+        assert(i + 1 < mOffsets.size());
+        return (mOffsets[i + 1] - mOffsets[i]) / 3;
+    }
+
+    /**
+     * @brief Returns the triangles of the i-th face, as a list of positions of
+     * vertices in the face, where each group of three positions represents a
+     * triangle.
+     */
+    std::span<const uint> triangles(uint i) const
+    {
+        assert(i + 1 < mOffsets.size());
+        return std::span<const uint>(
+            mIndices.data() + mOffsets[i], mOffsets[i + 1] - mOffsets[i]);
+    }
+
+    /**
+     * @brief Clears the triangulation.
+     */
+    void clear()
+    {
+        mOffsets.clear();
+        mIndices.clear();
+    }
+
+private:
+    /*
+     * Triangulates the nFaces faces returned by getFace(i), that may return
+     * a null pointer for faces that must be skipped.
+     */
+    template<typename GetFace>
+    void build(uint nFaces, GetFace&& getFace)
+    {
+        const uint nChunks = (nFaces + FACE_TRIANGULATION_FACES_PER_CHUNK - 1) /
+                             FACE_TRIANGULATION_FACES_PER_CHUNK;
+
+        std::vector<std::vector<uint>> chunkIndices(nChunks);
+        std::vector<uint>              chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        mOffsets.assign(nFaces + 1, 0);
+
+        parallelFor(chunks, [&](uint c) {
+            std::vector<uint>& ind = chunkIndices[c];
+
+            uint end = std::min(
+                nFaces, (c + 1) * FACE_TRIANGULATION_FACES_PER_CHUNK);
+            for (uint i = c * FACE_TRIANGULATION_FACES_PER_CHUNK; i < end;
+                 ++i) {
+                const auto* f = getFace(i);
+                if (f == nullptr)
+                    continue;
+
+                const uint first = ind.size();
+                if (f->vertexNumber() == 3) {
+                    ind.insert(ind.end(), {0, 1, 2});
+                }
+                else {
+                    std::vector<uint> tris = earCut(*f);
+                    ind.insert(ind.end(), tris.begin(), tris.end());
+                }
+                mOffsets[i + 1] = ind.size() - first;
+            }
+        });
+
+        std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+
+        mIndices.resize(mOffsets.back());
+        parallelFor(chunks, [&](uint c) {
+            std::copy(
+                chunkIndices[c].begin(),
+                chunkIndices[c].end(),
+                mIndices.begin() +
+                    mOffsets[c * FACE_TRIANGULATION_FACES_PER_CHUNK]);
+            chunkIndices[c] = std::vector<uint>();
+        });
+    }
+};
+
+} // namespace vcl
+
+#endif // VCL_SPACE_COMPLEX_FACE_TRIANGULATION_H
@@ -24,6 +24,7 @@
 #define VCL_SPACE_COMPLEX_GRID_H
 
 #include "grid/hash_table_grid.h"
+#include "grid/point_hash_grid.h"
 #include "grid/static_grid.h"
 
 #endif // VCL_SPACE_COMPLEX_GRID_H
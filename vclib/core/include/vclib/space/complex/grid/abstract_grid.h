@@ -29,10 +29,28 @@
 #include <vclib/misc/comparators.h>
 #include <vclib/space/core/sphere.h>
 
-#include <set>
+#include <algorithm>
+#include <concepts>
+#include <vector>
 
 namespace vcl {
 
+namespace detail {
+
+// a callable that takes as input a query value and a value stored in a grid and
+// returns their distance
+template<typename F, typename QueryValueType, typename ValueType>
+concept GridDistFunction =
+    std::invocable<F&, const QueryValueType&, const ValueType&>;
+
+// a callable that takes as input a query value, a value stored in a grid and
+// a maximum distance, and returns their distance
+template<typename F, typename QueryValueType, typename ValueType, typename S>
+concept GridBoundedDistFunction =
+    std::invocable<F&, const QueryValueType&, const ValueType&, S>;
+
+} // namespace detail
+
 /*
  * Developer Documentation
  * A class that derives from an AbstractGrid must store, in some way, an
@@ -106,6 +124,12 @@ namespace vcl {
 template<typename GridType, typename ValueType, typename DerivedGrid>
 class AbstractGrid : public GridType
 {
+    /* ValueType could be anything. We need to understand if it is a pointer, a
+       reference or not, in order to make proper optimized operations.
+       Therefore, we declare VT, that is used internally in this class. VT is
+       ValueType without pointers or references: */
+    using VT = RemoveCVRefAndPointer<ValueType>;
+
 public:
     /**
      * @brief The IntersectsCellFunction type is a std::function that takes as
@@ -133,6 +157,9 @@ public:
      * between the two values.
      *
      * It is used to customize the behavior of the grid when querying values.
+     * Query member functions accept any callable having the same signature:
+     * passing a lambda instead of a std::function allows the compiler to
+     * inline the distance computation.
      */
     template<typename QueryValueType>
     using QueryDistFunction = std::function<typename GridType::ScalarType(
@@ -157,6 +184,16 @@ public:
             const RemoveCVRefAndPointer<ValueType>&,
             typename GridType::ScalarType)>;
 
+    /**
+     * @brief The KClosestCandidates type is the buffer of (distance, iterator)
+     * pairs used by the kClosestValues member functions to store the candidate
+     * values of a query. It can be passed to kClosestValues and reused for
+     * several queries, to avoid an allocation for each query.
+     */
+    template<typename Iter>
+    using KClosestCandidates =
+        std::vector<std::pair<typename GridType::ScalarType, Iter>>;
+
     bool cellEmpty(const KeyType& k) const
     {
         auto p = derived()->valuesInCell(k);
@@ -182,50 +219,11 @@ public:
      */
     bool insert(const ValueType& v)
     {
-        const VT* vv = addressOfObj(v);
-
-        // if vv is a valid pointer (ValueType, or ValueType* if ValueType is
-        // not a pointer)
-        if (vv) {
-            // first and last cell where insert (could be the same)
-            KeyType bmin, bmax;
-
-            // if ValueType is Point, Point*, Vertex, Vertex*
-            if constexpr (PointConcept<VT> || VertexConcept<VT>) {
-                typename GridType::PointType p;
-                if constexpr (PointConcept<VT>)
-                    p = *vv;
-                else
-                    p = vv->position();
-                bmin = bmax = GridType::cell(p);
-            }
-            else { // else, call the boundingBox function
-                // bounding box of value
-                typename GridType::BBoxType bb = boundingBox(*vv);
-
-                bmin = GridType::cell(bb.min()); // first cell where insert
-                bmax = GridType::cell(bb.max()); // last cell where insert
-            }
-
-            bool ins = false;
-
-            // custom intersection function between cell and value
-            if (mIntersectsFun) {
-                for (const auto& cell : GridType::cells(bmin, bmax)) {
-                    if (mIntersectsFun(
-                            GridType::cellBox(cell), dereferencePtr(v))) {
-                        ins |= derived()->insertInCell(cell, v);
-                    }
-                }
-            }
-            else {
-                for (const auto& cell : GridType::cells(bmin, bmax)) {
-                    ins |= derived()->insertInCell(cell, v);
-                }
-            }
-            return ins;
-        }
-        return false;
+        bool ins = false;
+        forEachCellOfValue(v, [&](const KeyType& cell) {
+            ins |= derived()->insertInCell(cell, v);
+        });
+        return ins;
     }
 
     /**
@@ -311,15 +309,28 @@ public:
     // the iterator type)
     auto valuesInSphere(const Sphere<typename GridType::ScalarType>& s) const
     {
-        using Iter    = DerivedGrid::ConstIterator;
-        using IterSet = std::set<Iter, IterComparator<Iter>>;
-
-        // will use this set only if the value type is not a point -- that is
-        // when the value can occupy more than one single cell. We therefore
-        // push the results in a set in order to avoid possible duplicates
-        IterSet valuesSet;
+        std::vector<typename DerivedGrid::ConstIterator> resVec;
+        valuesInSphere(s, resVec);
+        return resVec;
+    }
 
-        std::vector<Iter> resVec;
+    /**
+     * @brief Fills the given vector with the iterators to the values that are
+     * inside the given sphere.
+     *
+     * The vector is cleared before being filled, but its capacity is kept:
+     * reusing the same vector for several queries avoids allocations.
+     *
+     * @param[in] s: the query sphere.
+     * @param[out] resVec: the iterators to the values inside the sphere.
+     */
+    template<typename Iter>
+    void valuesInSphere(
+        const Sphere<typename GridType::ScalarType>& s,
+        std::vector<Iter>&                           resVec) const
+        requires std::same_as<Iter, typename DerivedGrid::ConstIterator>
+    {
+        resVec.clear();
 
         // interval of cells containing the sphere
         KeyType first = GridType::cell(s.center() - s.radius());
@@ -332,22 +343,27 @@ public:
             // for each value contained in the cell
             for (auto it = p.first; it != p.second; ++it) {
                 if (valueIsInSpehere(it, s)) {
-                    if constexpr (!PointConcept<VT> && !VertexConcept<VT>) {
-                        valuesSet.insert(it);
-                    }
-                    else {
-                        resVec.push_back(it);
-                    }
+                    resVec.push_back(it);
                 }
             }
         }
 
-        // if the valuetype is a point (or vertex), we already pushed in resVec
-        // - faster than using set
+        // if the value type is not a point (or vertex), the value can occupy
+        // more than one single cell: we remove duplicates by sorting the
+        // iterators by value. The stable sort keeps the first iterator found
+        // for each value
         if constexpr (!PointConcept<VT> && !VertexConcept<VT>) {
-            resVec = std::vector<Iter>(valuesSet.begin(), valuesSet.end());
+            auto valueLess = [](const Iter& i1, const Iter& i2) {
+                return i1->second < i2->second;
+            };
+            auto valueEq = [](const Iter& i1, const Iter& i2) {
+                return i1->second == i2->second;
+            };
+            std::stable_sort(resVec.begin(), resVec.end(), valueLess);
+            resVec.erase(
+                std::unique(resVec.begin(), resVec.end(), valueEq),
+                resVec.end());
         }
-        return resVec;
     }
 
     void eraseInSphere(const Sphere<typename GridType::ScalarType>& s)
@@ -370,11 +386,16 @@ public:
     }
 
     // closest queries
-    template<typename QueryValueType>
+    template<typename QueryValueType, typename DistFunction>
     auto closestValue(
-        const QueryValueType&                    qv,
-        QueryBoundedDistFunction<QueryValueType> distFunction,
-        typename GridType::ScalarType&           dist) const
+        const QueryValueType&          qv,
+        DistFunction&&                 distFunction,
+        typename GridType::ScalarType& dist) const
+        requires detail::GridBoundedDistFunction<
+            DistFunction,
+            QueryValueType,
+            VT,
+            typename GridType::ScalarType>
     {
         using ScalarType = GridType::ScalarType;
         using PointType  = GridType::PointType;
@@ -473,28 +494,35 @@ public:
         return result;
     }
 
-    template<typename QueryValueType>
+    template<typename QueryValueType, typename DistFunction>
     auto closestValue(
-        const QueryValueType&             qv,
-        QueryDistFunction<QueryValueType> distFunction,
-        typename GridType::ScalarType&    dist) const
+        const QueryValueType&          qv,
+        DistFunction&&                 distFunction,
+        typename GridType::ScalarType& dist) const
+        requires detail::GridDistFunction<DistFunction, QueryValueType, VT>
     {
-        QueryBoundedDistFunction<QueryValueType> boundDistFun =
-            [&](const QueryValueType&                   q,
-                const RemoveCVRefAndPointer<ValueType>& v,
-                typename GridType::ScalarType) {
-                return distFunction(q, v);
-            };
+        auto boundDistFun = [&](const QueryValueType& q,
+                                const VT&             v,
+                                typename GridType::ScalarType) {
+            return distFunction(q, v);
+        };
 
         dist = std::numeric_limits<typename GridType::ScalarType>::max();
 
         return closestValue(qv, boundDistFun, dist);
     }
 
-    template<typename QueryValueType>
+    template<typename QueryValueType, typename DistFunction>
     auto closestValue(
-        const QueryValueType&             qv,
-        QueryDistFunction<QueryValueType> distFunction) const
+        const QueryValueType& qv,
+        DistFunction&&        distFunction) const
+        requires (
+            detail::GridDistFunction<DistFunction, QueryValueType, VT> ||
+            detail::GridBoundedDistFunction<
+                DistFunction,
+                QueryValueType,
+                VT,
+                typename GridType::ScalarType>)
     {
         typename GridType::ScalarType maxDist =
             std::numeric_limits<typename GridType::ScalarType>::max();
@@ -506,9 +534,9 @@ public:
         const QueryValueType&          qv,
         typename GridType::ScalarType& dist) const
     {
-        std::function f = boundedDistFunction<
+        auto f = boundedDistFunction<
             QueryValueType,
-            RemoveCVRefAndPointer<ValueType>,
+            VT,
             typename GridType::ScalarType>();
         return closestValue(qv, f, dist);
     }
@@ -516,37 +544,87 @@ public:
     template<typename QueryValueType>
     auto closestValue(const QueryValueType& qv) const
     {
-        std::function f = boundedDistFunction<
-            QueryValueType,
-            RemoveCVRefAndPointer<ValueType>,
-            typename GridType::ScalarType>();
         typename GridType::ScalarType maxDist =
             std::numeric_limits<typename GridType::ScalarType>::max();
-        return closestValue(qv, f, maxDist);
+        return closestValue(qv, maxDist);
     }
 
-    template<typename QueryValueType>
+    template<typename QueryValueType, typename DistFunction>
     auto kClosestValues(
-        const QueryValueType&             qv,
-        uint                              n,
-        QueryDistFunction<QueryValueType> distFunction) const
+        const QueryValueType& qv,
+        uint                  n,
+        DistFunction&&        distFunction) const
+        requires detail::GridDistFunction<DistFunction, QueryValueType, VT>
     {
-        using ResType = std::vector<typename DerivedGrid::ConstIterator>;
-        // KClosest Types
-        using KClosestPairType = std::pair<
-            typename GridType::ScalarType,
-            typename DerivedGrid::ConstIterator>;
-        using KClosestSet = std::
-            set<KClosestPairType, DistIterPairComparator<KClosestPairType>>;
+        std::vector<typename DerivedGrid::ConstIterator> vec;
+        kClosestValues(qv, n, distFunction, vec);
+        return vec;
+    }
+
+    /**
+     * @brief Fills the given vector with the iterators to the n values that
+     * are closest to the query value, sorted by distance.
+     *
+     * The vector is cleared before being filled, but its capacity is kept:
+     * reusing the same vector for several queries avoids allocations.
+     *
+     * @param[in] qv: the query value.
+     * @param[in] n: the number of values to search.
+     * @param[in] distFunction: the distance function between the query value
+     * and the values stored in the grid.
+     * @param[out] vec: the iterators to the closest values.
+     */
+    template<typename QueryValueType, typename DistFunction, typename Iter>
+    void kClosestValues(
+        const QueryValueType& qv,
+        uint                  n,
+        DistFunction&&        distFunction,
+        std::vector<Iter>&    vec) const
+        requires (
+            detail::GridDistFunction<DistFunction, QueryValueType, VT> &&
+            std::same_as<Iter, typename DerivedGrid::ConstIterator>)
+    {
+        KClosestCandidates<Iter> cand;
+        kClosestValues(qv, n, distFunction, vec, cand);
+    }
+
+    /**
+     * @brief Fills the given vector with the iterators to the n values that
+     * are closest to the query value, sorted by distance, using the given
+     * vector as storage for the candidate values.
+     *
+     * Both the vectors are cleared, but their capacity is kept: reusing the
+     * same vectors for several queries (e.g. one pair of vectors for each
+     * thread) avoids any allocation once they have grown enough.
+     *
+     * @param[in] qv: the query value.
+     * @param[in] n: the number of values to search.
+     * @param[in] distFunction: the distance function between the query value
+     * and the values stored in the grid.
+     * @param[out] vec: the iterators to the closest values.
+     * @param[in,out] cand: the buffer of (distance, iterator) pairs used to
+     * store the candidate values; its content after the call is unspecified.
+     */
+    template<typename QueryValueType, typename DistFunction, typename Iter>
+    void kClosestValues(
+        const QueryValueType&     qv,
+        uint                      n,
+        DistFunction&&            distFunction,
+        std::vector<Iter>&        vec,
+        KClosestCandidates<Iter>& cand) const
+        requires (
+            detail::GridDistFunction<DistFunction, QueryValueType, VT> &&
+            std::same_as<Iter, typename DerivedGrid::ConstIterator>)
+    {
+        vec.clear();
 
         Boxui ignore; // will contain the interval of cells already visited
 
-        KClosestSet set = valuesInCellNeighborhood(qv, n, distFunction, ignore);
+        valuesInCellNeighborhood(qv, n, distFunction, ignore, cand);
 
-        auto it = set.size() >= n ? std::next(set.begin(), n - 1) : set.end();
         // if we didn't found n values, it means that there aren't n values in
         // the grid - nothing to do
-        if (it != set.end()) {
+        if (n > 0 && cand.size() >= n) {
             using QVT      = RemoveCVRefAndPointer<QueryValueType>;
             const QVT* qvv = addressOfObj(qv);
 
@@ -556,8 +634,9 @@ public:
             // w.r.t. the n-th that we have already found by looking in the cell
             // neighborhood. we extend the bb with the distance of the n-th
             // closest found value
-            bb.min() -= it->first;
-            bb.max() += it->first;
+            const typename GridType::ScalarType nthDist = cand[n - 1].first;
+            bb.min() -= nthDist;
+            bb.max() += nthDist;
 
             // and we look in all of these cells
             Boxui currentIntervalBox;
@@ -575,23 +654,21 @@ public:
                     // for each value contained in the cell c
                     for (auto it = p.first; it != p.second; ++it) {
                         auto tmp = distFunction(qv, dereferencePtr(it->second));
-                        set.insert(std::make_pair(tmp, it));
+                        if (tmp <= nthDist)
+                            cand.emplace_back(tmp, it);
                     }
                 }
             }
+            sortAndRemoveDuplicates(cand);
         }
 
-        ResType vec;
-        // if there are more than n values in the set, we will return n values,
-        // otherwise set.size()
-        uint retNValues = std::min((uint) set.size(), n);
+        // if there are more than n values in the candidates, we will return n
+        // values, otherwise cand.size()
+        uint retNValues = std::min((uint) cand.size(), n);
         vec.reserve(retNValues);
-        it = set.begin();
         for (uint i = 0; i < retNValues; i++) {
-            vec.push_back(it->second);
-            it++;
+            vec.push_back(cand[i].second);
         }
-        return vec;
     }
 
     template<typename QueryValueType>
@@ -599,12 +676,77 @@ public:
     {
         // get the default dist function between the query value and the
         // elements of the grid
-        std::function f =
-            distFunction<QueryValueType, RemoveCVRefAndPointer<ValueType>>();
+        auto f = distFunction<QueryValueType, VT>();
         return kClosestValues(qv, n, f);
     }
 
 protected:
+    /**
+     * @brief Calls the given function for each cell of the grid where the
+     * given value must be stored.
+     *
+     * If the ValueType is Puntual (a Point or a Vertex), the function is
+     * called just once, for the cell that contains the point. Otherwise, the
+     * function is called for each cell where the bounding box of the value
+     * lies, that intersects the value according to the custom intersects
+     * function (if set).
+     *
+     * This function does not modify the grid, and therefore it can be called
+     * concurrently on several values by the derived classes that build their
+     * storage in parallel.
+     *
+     * @param[in] v: the value to be stored in the grid.
+     * @param[in] f: a callable that takes as input a KeyType (a cell).
+     * @return true if the value is valid (e.g. a non-null pointer), false
+     * otherwise.
+     */
+    template<typename F>
+    bool forEachCellOfValue(const ValueType& v, F&& f) const
+    {
+        const VT* vv = addressOfObj(v);
+
+        // if vv is a valid pointer (ValueType, or ValueType* if ValueType is
+        // not a pointer)
+        if (vv) {
+            // first and last cell where insert (could be the same)
+            KeyType bmin, bmax;
+
+            // if ValueType is Point, Point*, Vertex, Vertex*
+            if constexpr (PointConcept<VT> || VertexConcept<VT>) {
+                typename GridType::PointType p;
+                if constexpr (PointConcept<VT>)
+                    p = *vv;
+                else
+                    p = vv->position();
+                bmin = bmax = GridType::cell(p);
+            }
+            else { // else, call the boundingBox function
+                // bounding box of value
+                typename GridType::BBoxType bb = boundingBox(*vv);
+
+                bmin = GridType::cell(bb.min()); // first cell where insert
+                bmax = GridType::cell(bb.max()); // last cell where insert
+            }
+
+            // custom intersection function between cell and value
+            if (mIntersectsFun) {
+                for (const auto& cell : GridType::cells(bmin, bmax)) {
+                    if (mIntersectsFun(
+                            GridType::cellBox(cell), dereferencePtr(v))) {
+                        f(cell);
+                    }
+                }
+            }
+            else {
+                for (const auto& cell : GridType::cells(bmin, bmax)) {
+                    f(cell);
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
     /**
      * @brief Empty constructor, creates an usable AbstractGrid, since the Grid
      * is not initialized.
@@ -742,34 +884,37 @@ protected:
     }
 
 private:
-    /* ValueType could be anything. We need to understand if it is a pointer, a
-       reference or not, in order to make proper optimized operations.
-       Therefore, we declare VT, that is used internally in this class. VT is
-       ValueType without pointers or references: */
-    using VT = RemoveCVRefAndPointer<ValueType>;
-
     using Boxui = Box<Point<uint, GridType::DIM>>;
 
-    template<typename Iter>
-    struct IterComparator
-    {
-        bool operator()(const Iter& i1, const Iter& i2) const
-        {
-            return i1->second < i2->second;
-        }
-    };
-
-    template<typename Pair>
-    struct DistIterPairComparator
+    /**
+     * Sorts the given (distance, iterator) pairs by distance, and removes the
+     * pairs that refer to the same value (a value that is not a point can be
+     * stored in more than one cell). Pairs having the same distance are sorted
+     * by value.
+     */
+    template<typename PairType>
+    static void sortAndRemoveDuplicates(std::vector<PairType>& cand)
     {
-        bool operator()(const Pair& p1, const Pair& p2) const
-        {
-            if (p1.first == p2.first) {
-                return p1.second->second < p2.second->second;
-            }
-            return p1.first < p2.first;
+        std::sort(
+            cand.begin(),
+            cand.end(),
+            [](const PairType& p1, const PairType& p2) {
+                if (p1.first == p2.first) {
+                    return p1.second->second < p2.second->second;
+                }
+                return p1.first < p2.first;
+            });
+        if constexpr (!PointConcept<VT> && !VertexConcept<VT>) {
+            cand.erase(
+                std::unique(
+                    cand.begin(),
+                    cand.end(),
+                    [](const PairType& p1, const PairType& p2) {
+                        return p1.second->second == p2.second->second;
+                    }),
+                cand.end());
         }
-    };
+    }
 
     DerivedGrid* derived() { return static_cast<DerivedGrid*>(this); }
 
@@ -813,13 +958,13 @@ private:
      * AbstractGrid. Returns the closest Value (if any) to the given query value
      * contained in the given interval
      */
-    template<typename QueryValueType>
+    template<typename QueryValueType, typename DistFunction>
     auto closestInCells(
-        const QueryValueType&                    qv,
-        typename GridType::ScalarType&           dist,
-        const Boxui&                             interval,
-        QueryBoundedDistFunction<QueryValueType> distFunction,
-        const Boxui&                             ignore = Boxui()) const
+        const QueryValueType&          qv,
+        typename GridType::ScalarType& dist,
+        const Boxui&                   interval,
+        DistFunction&                  distFunction,
+        const Boxui&                   ignore = Boxui()) const
     {
         using ResType = DerivedGrid::ConstIterator;
         ResType res   = derived()->end();
@@ -844,21 +989,22 @@ private:
         return res;
     }
 
-    template<typename QueryValueType>
-    auto valuesInCellNeighborhood(
-        const QueryValueType&             qv,
-        uint                              n,
-        QueryDistFunction<QueryValueType> distFunction,
-        Boxui&                            ignore) const
+    /**
+     * This function is meant to be called by another function of the
+     * AbstractGrid. Visits the cells around the query value, in rings of
+     * increasing size, until at least n values are found, and fills res with
+     * the found values, sorted by distance and without duplicates. The ignore
+     * box is set to the interval of the visited cells.
+     */
+    template<typename QueryValueType, typename DistFunction, typename PairType>
+    void valuesInCellNeighborhood(
+        const QueryValueType&  qv,
+        uint                   n,
+        DistFunction&          distFunction,
+        Boxui&                 ignore,
+        std::vector<PairType>& res) const
     {
-        // types used for K closest neighbors queries
-        using KClosestPairType = std::pair<
-            typename GridType::ScalarType,
-            typename DerivedGrid::ConstIterator>;
-        using KClosestSet = std::
-            set<KClosestPairType, DistIterPairComparator<KClosestPairType>>;
-
-        KClosestSet res;
+        res.clear();
 
         using QVT      = RemoveCVRefAndPointer<QueryValueType>;
         const QVT* qvv = addressOfObj(qv);
@@ -884,10 +1030,15 @@ private:
                         for (auto it = p.first; it != p.second; ++it) {
                             auto tmp =
                                 distFunction(qv, dereferencePtr(it->second));
-                            res.emplace(tmp, it);
+                            res.emplace_back(tmp, it);
                         }
                     }
                 }
+                // values that are not points can be stored in more than one
+                // cell: duplicates must be removed to count the found values
+                if constexpr (!PointConcept<VT> && !VertexConcept<VT>) {
+                    sortAndRemoveDuplicates(res);
+                }
                 ignore = currentIntervalBox;
                 for (uint i = 0; i < currentIntervalBox.min().DIM; ++i) {
                     if (currentIntervalBox.min()(i) != 0)
@@ -897,9 +1048,10 @@ private:
                         currentIntervalBox.max()(i)++;
                 }
             }
+            if constexpr (PointConcept<VT> || VertexConcept<VT>) {
+                sortAndRemoveDuplicates(res);
+            }
         }
-
-        return res;
     }
 };
 
@@ -26,15 +26,28 @@
 #include <vclib/misc/pair.h>
 #include <vclib/space/core/point.h>
 
+#include <vector>
+
 namespace vcl {
 
+/*
+ * The StaticGrid stores its values in a CSR layout: a vector of values sorted
+ * by cell, and a vector of offsets, where the values of the i-th cell are in
+ * the range [offsets[i], offsets[i+1]). The iterators keep track of the cell
+ * of the current value, that is advanced (skipping empty cells) every time the
+ * iterator reaches the end of the range of the current cell.
+ */
+
 template<typename KeyType, typename ValueType, typename GridType>
 class StaticGridIterator
 {
-    using VecIt = std::vector<std::pair<uint, ValueType>>::iterator;
+    using VecIt = std::vector<ValueType>::iterator;
 
-    VecIt           mVecIt;
-    const GridType* mGrid = nullptr;
+    VecIt                    mVecIt;
+    uint                     mPos     = 0;
+    uint                     mCell    = 0;
+    const std::vector<uint>* mOffsets = nullptr;
+    const GridType*          mGrid    = nullptr;
 
 public:
     using T          = SecondRefPair<KeyType, ValueType>;
@@ -52,12 +65,20 @@ public:
 
     StaticGridIterator() = default;
 
-    StaticGridIterator(VecIt it, const GridType& g) : mVecIt(it), mGrid(&g) {}
+    StaticGridIterator(
+        VecIt                    it,
+        uint                     pos,
+        uint                     cell,
+        const std::vector<uint>& offsets,
+        const GridType&          g) :
+            mVecIt(it), mPos(pos), mCell(cell), mOffsets(&offsets), mGrid(&g)
+    {
+    }
 
     value_type operator*() const
     {
-        KeyType cell = mGrid->cellOfIndex(mVecIt->first);
-        return value_type(cell, mVecIt->second);
+        KeyType cell = mGrid->cellOfIndex(mCell);
+        return value_type(cell, *mVecIt);
     }
 
     ArrowHelper operator->() const { return **this; }
@@ -74,25 +95,38 @@ public:
 
     StaticGridIterator operator++()
     {
-        ++mVecIt;
+        increment();
         return *this;
     }
 
     StaticGridIterator operator++(int)
     {
         StaticGridIterator old = *this;
-        ++mVecIt;
+        increment();
         return old;
     }
+
+private:
+    void increment()
+    {
+        ++mVecIt;
+        ++mPos;
+        const uint lastCell = mOffsets->size() - 2;
+        while (mCell < lastCell && (*mOffsets)[mCell + 1] <= mPos)
+            ++mCell;
+    }
 };
 
 template<typename KeyType, typename ValueType, typename GridType>
 class ConstStaticGridIterator
 {
-    using VecIt = std::vector<std::pair<uint, ValueType>>::const_iterator;
+    using VecIt = std::vector<ValueType>::const_iterator;
 
-    VecIt           mVecIt;
-    const GridType* mGrid = nullptr;
+    VecIt                    mVecIt;
+    uint                     mPos     = 0;
+    uint                     mCell    = 0;
+    const std::vector<uint>* mOffsets = nullptr;
+    const GridType*          mGrid    = nullptr;
 
 public:
     using T          = SecondRefPair<KeyType, const ValueType>;
@@ -100,14 +134,20 @@ public:
 
     ConstStaticGridIterator() = default;
 
-    ConstStaticGridIterator(VecIt it, const GridType& g) : mVecIt(it), mGrid(&g)
+    ConstStaticGridIterator(
+        VecIt                    it,
+        uint                     pos,
+        uint                     cell,
+        const std::vector<uint>& offsets,
+        const GridType&          g) :
+            mVecIt(it), mPos(pos), mCell(cell), mOffsets(&offsets), mGrid(&g)
     {
     }
 
     value_type operator*() const
     {
-        KeyType cell = mGrid->cellOfIndex(mVecIt->first);
-        return value_type(cell, mVecIt->second);
+        KeyType cell = mGrid->cellOfIndex(mCell);
+        return value_type(cell, *mVecIt);
     }
 
     auto operator->() const { return FakePointerWithValue(**this); }
@@ -124,16 +164,26 @@ public:
 
     ConstStaticGridIterator operator++()
     {
-        ++mVecIt;
+        increment();
         return *this;
     }
 
     ConstStaticGridIterator operator++(int)
     {
         ConstStaticGridIterator old = *this;
-        ++mVecIt;
+        increment();
         return old;
     }
+
+private:
+    void increment()
+    {
+        ++mVecIt;
+        ++mPos;
+        const uint lastCell = mOffsets->size() - 2;
+        while (mCell < lastCell && (*mOffsets)[mCell + 1] <= mPos)
+            ++mCell;
+    }
 };
 
 } // namespace vcl
@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_COMPLEX_GRID_POINT_HASH_GRID_H
+#define VCL_SPACE_COMPLEX_GRID_POINT_HASH_GRID_H
+
+#include <vclib/concepts/range.h>
+#include <vclib/misc/radix_sort.h>
+#include <vclib/space/core/box.h>
+#include <vclib/space/core/point.h>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief The PointHashGrid class is a static spatial hash of a set of 3D
+ * points, that stores only the non-empty cells of an unbounded regular grid
+ * of cubic cells.
+ *
+ * Unlike HashTableGrid, that wraps an std::unordered_multimap, the grid is
+ * flat:
+ * - the indices of the points are stored in a single vector, sorted by cell
+ * (the points of each cell are sorted by index);
+ * - the non-empty cells are stored in a vector, and each cell refers to a
+ * contiguous range of point indices;
+ * - an open-addressing hash table with linear probing maps the packed
+ * coordinates of a cell to its index.
+ *
+ * The grid is built in parallel, sorting the packed cell coordinates of the
+ * points with a radix sort. The coordinates of the cells are packed using,
+ * for each axis, the number of bits required by the bounding box of the
+ * points, and each axis can contain up to 2^21 cells.
+ *
+ * The grid stores only the indices of the points in the input range, that
+ * must be kept by the user to access the points.
+ *
+ * @tparam ScalarType: the scalar type of the points.
+ *
+ * @ingroup space_complex
+ */
+template<typename ScalarType>
+class PointHashGrid
+{
+public:
+    using PointType = Point3<ScalarType>;
+    using CellPos   = Point3i;
+
+private:
+    static constexpr uint     MAX_AXIS_BITS = 21;
+    static constexpr uint64_t EMPTY_KEY     = ~uint64_t(0);
+
+    struct Slot
+    {
+        uint64_t key  = EMPTY_KEY;
+        uint     cell = UINT_NULL;
+    };
+
+    PointType  mOrigin;
+    ScalarType mCellSize = 1;
+
+    // number of cells of the grid for each axis, and bits used to store the
+    // coordinates of the cells for each axis in the packed keys
+    CellPos             mSize = CellPos(0, 0, 0);
+    std::array<uint, 3> mBits = {0, 0, 0};
+
+    // indices of the points, sorted by cell
+    std::vector<uint> mIndices;
+
+    // packed coordinates of the non-empty cells, sorted
+    std::vector<uint64_t> mCellKeys;
+    // the points of the i-th cell are in [mOffsets[i], mOffsets[i + 1])
+    std::vector<uint> mOffsets;
+
+    // open-addressing hash table, having a power of two size
+    std::vector<Slot> mTable;
+
+public:
+    /**
+     * @brief Creates an empty grid.
+     */
+    PointHashGrid() = default;
+
+    /**
+     * @brief Builds the grid of the given random access range of points,
+     * using cubic cells having the given size.
+     *
+     * @param[in] points: the input points.
+     * @param[in] cellSize: the length of the edge of the cells.
+     *
+     * @throws std::invalid_argument if the cell size is not positive, or if
+     * the bounding box of the points spans more than 2^21 cells along an axis.
+     */
+    template<std::ranges::random_access_range Rng>
+    PointHashGrid(Rng&& points, ScalarType cellSize) : mCellSize(cellSize)
+    {
+        if (!(cellSize > 0)) {
+            throw std::invalid_argument(
+                "PointHashGrid: the cell size must be positive.");
+        }
+
+        const uint n = std::ranges::size(points);
+        if (n == 0)
+            return;
+
+        auto begin = std::ranges::begin(points);
+
+        Box3<ScalarType> bb;
+        for (uint i = 0; i < n; ++i)
+            bb.add(begin[i].template cast<ScalarType>());
+        mOrigin = bb.min();
+
+        // the packed keys have MAX_AXIS_BITS bits per axis: the check is done
+        // on the scalars, before the cell coordinates are converted to int
+        for (uint i = 0; i < 3; ++i) {
+            if (!((bb.max()[i] - mOrigin[i]) / mCellSize <
+                  ScalarType(uint64_t(1) << MAX_AXIS_BITS))) {
+                throw std::invalid_argument(
+                    "PointHashGrid: the points span more than 2^" +
+                    std::to_string(MAX_AXIS_BITS) +
+                    " cells along an axis; use a larger cell size.");
+            }
+        }
+
+        const CellPos last = cell(bb.max());
+        for (uint i = 0; i < 3; ++i) {
+            mSize[i] = last[i] + 1;
+            mBits[i] = std::bit_width(uint(last[i]));
+        }
+
+        std::vector<std::pair<uint64_t, uint>> keys(n);
+        parallelFor(keys, [&](std::pair<uint64_t, uint>& k) {
+            const uint i = &k - keys.data();
+            k = {packCell(cell(begin[i].template cast<ScalarType>())), i};
+        });
+
+        radixSortByKey(keys, mBits[0] + mBits[1] + mBits[2]);
+
+        mIndices.resize(n);
+        for (uint i = 0; i < n; ++i) {
+            mIndices[i] = keys[i].second;
+            if (i == 0 || keys[i].first != keys[i - 1].first) {
+                mCellKeys.push_back(keys[i].first);
+                mOffsets.push_back(i);
+            }
+        }
+        mOffsets.push_back(n);
+
+        mTable.resize(std::bit_ceil(2 * mCellKeys.size()));
+        for (uint c = 0; c < mCellKeys.size(); ++c) {
+            uint s = slot(mCellKeys[c]);
+            while (mTable[s].key != EMPTY_KEY)
+                s = (s + 1) & (mTable.size() - 1);
+            mTable[s] = {mCellKeys[c], c};
+        }
+    }
+
+    /**
+     * @brief Returns the length of the edge of the cells.
+     */
+    ScalarType cellSize() const { return mCellSize; }
+
+    /**
+     * @brief Returns the number of non-empty cells of the grid.
+     */
+    uint cellNumber() const { return mCellKeys.size(); }
+
+    /**
+     * @brief Returns the number of points stored in the grid.
+     */
+    uint pointNumber() const { return mIndices.size(); }
+
+    /**
+     * @brief Returns the indices of the points, sorted by cell.
+     */
+    const std::vector<uint>& indices() const { return mIndices; }
+
+    /**
+     * @brief Returns the position in indices() of the first point of the
+     * i-th non-empty cell.
+     */
+    uint cellBegin(uint i) const { return mOffsets[i]; }
+
+    /**
+     * @brief Returns the position in indices() after the last point of the
+     * i-th non-empty cell.
+     */
+    uint cellEnd(uint i) const { return mOffsets[i + 1]; }
+
+    /**
+     * @brief Returns the indices of the points of the i-th non-empty cell.
+     */
+    std::span<const uint> cellPoints(uint i) const
+    {
+        return std::span<const uint>(
+            mIndices.data() + mOffsets[i], mOffsets[i + 1] - mOffsets[i]);
+    }
+
+    /**
+     * @brief Returns the position of the i-th non-empty cell in the grid.
+     */
+    CellPos cellPosition(uint i) const
+    {
+        const uint64_t k = mCellKeys[i];
+        return CellPos(
+            k >> (mBits[1] + mBits[2]),
+            (k >> mBits[2]) & ((uint64_t(1) << mBits[1]) - 1),
+            k & ((uint64_t(1) << mBits[2]) - 1));
+    }
+
+    /**
+     * @brief Returns the position of the cell that contains the given point.
+     */
+    CellPos cell(const PointType& p) const
+    {
+        CellPos c;
+        for (uint i = 0; i < 3; ++i)
+            c[i] = int(std::floor((p[i] - mOrigin[i]) / mCellSize));
+        return c;
+    }
+
+    /**
+     * @brief Returns the index of the cell having the given position, or
+     * UINT_NULL if the cell is empty.
+     */
+    uint cellIndex(const CellPos& c) const
+    {
+        if (mTable.empty() || c.x() < 0 || c.y() < 0 || c.z() < 0 ||
+            c.x() >= mSize.x() || c.y() >= mSize.y() || c.z() >= mSize.z())
+            return UINT_NULL;
+
+        const uint64_t key = packCell(c);
+        for (uint s = slot(key);; s = (s + 1) & (mTable.size() - 1)) {
+            if (mTable[s].key == key)
+                return mTable[s].cell;
+            if (mTable[s].key == EMPTY_KEY)
+                return UINT_NULL;
+        }
+    }
+
+    /**
+     * @brief Calls f(i) for each index i of the points stored in the cells
+     * that intersect the cube centered in the given point and having edge
+     * 2 * radius.
+     */
+    template<typename F>
+    void forEachPointNear(const PointType& p, ScalarType radius, F&& f) const
+    {
+        const CellPos min = cell(p - PointType(radius, radius, radius));
+        const CellPos max = cell(p + PointType(radius, radius, radius));
+        for (int x = min.x(); x <= max.x(); ++x) {
+            for (int y = min.y(); y <= max.y(); ++y) {
+                for (int z = min.z(); z <= max.z(); ++z) {
+                    const uint c = cellIndex(CellPos(x, y, z));
+                    if (c != UINT_NULL) {
+                        for (uint i : cellPoints(c))
+                            f(i);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    uint64_t packCell(const CellPos& c) const
+    {
+        assert(c.x() >= 0 && c.x() < mSize.x());
+        assert(c.y() >= 0 && c.y() < mSize.y());
+        assert(c.z() >= 0 && c.z() < mSize.z());
+        return (uint64_t(c.x()) << (mBits[1] + mBits[2])) |
+               (uint64_t(c.y()) << mBits[2]) | uint64_t(c.z());
+    }
+
+    // first slot of the probing sequence of the key (splitmix64 finalizer)
+    uint slot(uint64_t key) const
+    {
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+        return key & (mTable.size() - 1);
+    }
+};
+
+} // namespace vcl
+
+#endif // VCL_SPACE_COMPLEX_GRID_POINT_HASH_GRID_H
@@ -28,12 +28,37 @@
 #include "regular_grid.h"
 
 #include <vclib/concepts/ranges/mesh/vertex_range.h>
+#include <vclib/misc/parallel.h>
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <set>
 #include <vector>
 
 namespace vcl {
 
+// number of values processed by each task of the parallel build of the grid
+inline constexpr uint STATIC_GRID_VALUES_PER_CHUNK = 4096;
+
+/**
+ * @brief The StaticGrid class is a Spatial Data Structure that stores values
+ * on a regular grid, and that cannot be modified after it has been built.
+ *
+ * The values are stored in a compact CSR layout: a vector of values sorted by
+ * cell, and a vector of offsets, where the values of the i-th cell are stored
+ * in the range [offsets[i], offsets[i+1]) of the values vector.
+ *
+ * The grid is built in parallel using a counting sort over the cell indices:
+ * the cells of each value are computed in parallel, then the number of values
+ * of each cell is counted, the offsets are computed with a prefix sum and,
+ * finally, the values are scattered in their cells.
+ *
+ * Values inserted with the insert member functions are not available until
+ * the build() member function is called.
+ *
+ * @ingroup space_complex
+ */
 template<typename GridType, typename ValueType>
 class StaticGrid :
         public AbstractGrid<
@@ -44,21 +69,23 @@ class StaticGrid :
     using AbsGrid =
         AbstractGrid<GridType, ValueType, StaticGrid<GridType, ValueType>>;
 
-    using PairType       = std::pair<uint, ValueType>;
-    using PairComparator = FirstElementPairComparator<PairType>;
+    // [cell index - index of the value]
+    using EntryType = std::pair<uint, uint>;
 
     friend AbsGrid;
 
-    PairComparator mComparator = PairComparator();
+    // values sorted by cell: a value that lies in more than one cell is stored
+    // once for each cell
+    std::vector<ValueType> mValues;
 
-    // each value is stored as a pair: [cell index of the grid - value]
-    // when the grid is built, this vector is sorted by the cell indices
-    std::vector<PairType> mValues;
+    // for each cell of the grid, the index (in the values vector) of the first
+    // ValueType object contained in the cell; the last element is the size of
+    // the values vector. Empty if the grid has not been built yet
+    std::vector<uint> mOffsets;
 
-    // for each cell of the grid, we store the index (in the values vector ) of
-    // the first ValueType object contained in the cell, or values.size() if the
-    // cell is empty
-    std::vector<uint> mGrid;
+    // values inserted in the grid that have not been built yet, stored as
+    // pairs [cell index of the grid - value]
+    std::vector<std::pair<uint, ValueType>> mStagedValues;
 
 public:
     using KeyType                = AbsGrid::KeyType;
@@ -78,8 +105,11 @@ public:
         const IntersectsCellFunction& intersects = nullptr) :
             AbsGrid(begin, end, intersects)
     {
-        AbsGrid::insert(begin, end);
-        build();
+        std::vector<ValueType> values;
+        for (ObjIterator it = begin; it != end; ++it)
+            values.push_back(*it);
+
+        buildCSR(values, cellEntries(values));
     }
 
     template<Range Rng>
@@ -88,127 +118,87 @@ public:
     {
     }
 
+    /**
+     * @brief Builds the grid, making available all the values inserted after
+     * the last call of this function (or after the construction of the grid).
+     *
+     * If no value has been inserted since then, the grid is left untouched.
+     */
     void build()
     {
-        uint totCellNumber = 1;
-        for (uint i = 0; i < GridType::DIM; ++i) {
-            totCellNumber *= GridType::cellNumber(i);
-        }
-
-        mGrid.resize(totCellNumber);
+        if (mStagedValues.empty())
+            return;
 
-        std::sort(mValues.begin(), mValues.end(), mComparator);
+        const uint nValues = mValues.size();
 
-        // values[vi].first points to the next non empty cell in the grid
-        uint vi = 0;
+        std::vector<ValueType> values = std::move(mValues);
+        std::vector<EntryType> entries(nValues + mStagedValues.size());
 
-        // for each cell
-        for (uint ci = 0; ci < mGrid.size(); ++ci) {
-            // values[vi] is in the cell ci
-            if (vi < mValues.size() && mValues[vi].first == ci)
-                mGrid[ci] = vi;
-            else { // there are no values in this grid cell
-                mGrid[ci] = mValues.size(); // set the sentinel value
-            }
+        // values already stored in the grid
+        for (uint c = 0; c + 1 < mOffsets.size(); ++c) {
+            for (uint i = mOffsets[c]; i < mOffsets[c + 1]; ++i)
+                entries[i] = {c, i};
+        }
 
-            // move vi to the next non-empty cell
-            // skip all the values that are in the current cell ci
-            // won't increment vi if the values[vi].first is not equal to ci
-            while (vi < mValues.size() && mValues[vi].first == ci) {
-                vi++;
-            }
+        values.reserve(entries.size());
+        for (uint i = 0; const auto& [cell, v] : mStagedValues) {
+            values.push_back(v);
+            entries[nValues + i] = {cell, nValues + i};
+            ++i;
         }
+        mStagedValues.clear();
+        mStagedValues.shrink_to_fit();
+
+        buildCSR(values, entries);
     }
 
     bool empty() const { return mValues.empty(); }
 
-    bool cellEmpty(const KeyType& k) const
-    {
-        uint ind = GridType::indexOfCell(k);
-        return mGrid[ind] == mValues.size();
-    }
+    bool cellEmpty(const KeyType& k) const { return countInCell(k) == 0; }
 
     std::set<KeyType> nonEmptyCells() const
     {
         std::set<KeyType> keys;
-        uint              actualInd = mValues.size();
-        for (uint i = 0; i < mValues.size(); ++i) {
-            if (mValues[i].first != actualInd) {
-                actualInd = mValues[i].first;
-                keys.insert(GridType::cellOfIndex(actualInd));
-            }
+        for (uint i = 0; i + 1 < mOffsets.size(); ++i) {
+            if (mOffsets[i] != mOffsets[i + 1])
+                keys.insert(GridType::cellOfIndex(i));
         }
         return keys;
     }
 
     std::size_t countInCell(const KeyType& k) const
     {
+        if (mOffsets.empty())
+            return 0;
         uint ind = GridType::indexOfCell(k);
-        uint i   = mGrid[ind];
-        uint cnt = 0;
-
-        while (i < mValues.size() && mValues[i].first == ind) {
-            i++;
-            cnt++;
-        }
-        return cnt;
+        return mOffsets[ind + 1] - mOffsets[ind];
     }
 
     std::pair<Iterator, Iterator> valuesInCell(const KeyType& k)
     {
-        uint ind = GridType::indexOfCell(k);
-        uint i   = mGrid[ind];
-        if (i < mValues.size()) {
-            std::pair<Iterator, Iterator> p;
-            p.first = Iterator(mValues.begin() + i, (const GridType&) *this);
-            while (i < mValues.size() && mValues[i].first == ind) {
-                i++;
-            }
-            auto it  = i < mValues.size() ? mValues.begin() + i : mValues.end();
-            p.second = Iterator(it, (const GridType&) *this);
-            return p;
-        }
-        else {
+        if (mOffsets.empty())
             return std::make_pair(end(), end());
-        }
+        uint ind = GridType::indexOfCell(k);
+        return std::make_pair(
+            iterator(mOffsets[ind], ind), iterator(mOffsets[ind + 1], ind));
     }
 
     std::pair<ConstIterator, ConstIterator> valuesInCell(const KeyType& k) const
     {
-        uint ind = GridType::indexOfCell(k);
-        uint i   = mGrid[ind];
-        if (i < mValues.size()) {
-            std::pair<ConstIterator, ConstIterator> p;
-            p.first =
-                ConstIterator(mValues.begin() + i, (const GridType&) *this);
-            while (i < mValues.size() && mValues[i].first == ind) {
-                i++;
-            }
-            auto it  = i < mValues.size() ? mValues.begin() + i : mValues.end();
-            p.second = ConstIterator(it, (const GridType&) *this);
-            return p;
-        }
-        else {
+        if (mOffsets.empty())
             return std::make_pair(end(), end());
-        }
+        uint ind = GridType::indexOfCell(k);
+        return std::make_pair(
+            iterator(mOffsets[ind], ind), iterator(mOffsets[ind + 1], ind));
     }
 
-    Iterator begin()
-    {
-        return Iterator(mValues.begin(), (const GridType&) *this);
-    }
+    Iterator begin() { return iterator(0, firstNonEmptyCell()); }
 
-    ConstIterator begin() const
-    {
-        return ConstIterator(mValues.begin(), (const GridType&) *this);
-    }
+    ConstIterator begin() const { return iterator(0, firstNonEmptyCell()); }
 
-    Iterator end() { return Iterator(mValues.end(), (const GridType&) *this); }
+    Iterator end() { return iterator(mValues.size(), 0); }
 
-    ConstIterator end() const
-    {
-        return ConstIterator(mValues.end(), (const GridType&) *this);
-    }
+    ConstIterator end() const { return iterator(mValues.size(), 0); }
 
 private:
     // not available member functions
@@ -219,12 +209,167 @@ private:
     bool insertInCell(const KeyType& cell, const ValueType& v)
     {
         uint cellIndex = GridType::indexOfCell(cell);
-        mValues.emplace_back(cellIndex, v);
+        mStagedValues.emplace_back(cellIndex, v);
         return true;
     }
 
     // not allowing to erase
     bool eraseInCell(const KeyType&, const ValueType&) { return false; };
+
+    Iterator iterator(uint pos, uint cell)
+    {
+        return Iterator(
+            mValues.begin() + pos,
+            pos,
+            cell,
+            mOffsets,
+            (const GridType&) *this);
+    }
+
+    ConstIterator iterator(uint pos, uint cell) const
+    {
+        return ConstIterator(
+            mValues.begin() + pos,
+            pos,
+            cell,
+            mOffsets,
+            (const GridType&) *this);
+    }
+
+    uint firstNonEmptyCell() const
+    {
+        if (mValues.empty())
+            return 0;
+        // the first cell c having offsets[c + 1] > 0
+        auto it = std::upper_bound(mOffsets.begin(), mOffsets.end(), 0u);
+        return it - mOffsets.begin() - 1;
+    }
+
+    /**
+     * @brief Computes, in parallel, the cells where each one of the given
+     * values must be stored, and returns the list of [cell index - value
+     * index] entries, sorted by value index.
+     */
+    std::vector<EntryType> cellEntries(const std::vector<ValueType>& values)
+    {
+        const uint nChunks =
+            (values.size() + STATIC_GRID_VALUES_PER_CHUNK - 1) /
+            STATIC_GRID_VALUES_PER_CHUNK;
+
+        std::vector<std::vector<EntryType>> chunkEntries(nChunks);
+        std::vector<uint>                   chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        parallelFor(chunks, [&](uint c) {
+            std::vector<EntryType>& res = chunkEntries[c];
+
+            uint end = std::min<uint>(
+                values.size(), (c + 1) * STATIC_GRID_VALUES_PER_CHUNK);
+            for (uint i = c * STATIC_GRID_VALUES_PER_CHUNK; i < end; ++i) {
+                AbsGrid::forEachCellOfValue(values[i], [&](const KeyType& k) {
+                    res.emplace_back(GridType::indexOfCell(k), i);
+                });
+            }
+        });
+
+        // offset of each chunk in the entries vector
+        std::vector<uint> chunkOffsets(nChunks + 1, 0);
+        for (uint c = 0; c < nChunks; ++c)
+            chunkOffsets[c + 1] = chunkOffsets[c] + chunkEntries[c].size();
+
+        std::vector<EntryType> entries(chunkOffsets[nChunks]);
+        parallelFor(chunks, [&](uint c) {
+            std::copy(
+                chunkEntries[c].begin(),
+                chunkEntries[c].end(),
+                entries.begin() + chunkOffsets[c]);
+            chunkEntries[c] = std::vector<EntryType>();
+        });
+
+        return entries;
+    }
+
+    /**
+     * @brief Builds the CSR layout of the grid from the given values and
+     * [cell index - value index] entries, using a parallel counting sort over
+     * the cell indices.
+     *
+     * Inside each cell, values are stored in the same order of the entries.
+     */
+    void buildCSR(
+        const std::vector<ValueType>& values,
+        const std::vector<EntryType>& entries)
+    {
+        uint totCellNumber = 1;
+        for (uint i = 0; i < GridType::DIM; ++i) {
+            totCellNumber *= GridType::cellNumber(i);
+        }
+
+        const uint nEntries = entries.size();
+        const uint nChunks =
+            (nEntries + STATIC_GRID_VALUES_PER_CHUNK - 1) /
+            STATIC_GRID_VALUES_PER_CHUNK;
+
+        std::vector<uint> chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        // first pass: count the entries of each cell
+        std::vector<std::atomic<uint>> counters(totCellNumber);
+        parallelFor(chunks, [&](uint c) {
+            uint end =
+                std::min(nEntries, (c + 1) * STATIC_GRID_VALUES_PER_CHUNK);
+            for (uint i = c * STATIC_GRID_VALUES_PER_CHUNK; i < end; ++i)
+                counters[entries[i].first].fetch_add(
+                    1, std::memory_order_relaxed);
+        });
+
+        mOffsets.resize(totCellNumber + 1);
+        mOffsets[0] = 0;
+        for (uint ci = 0; ci < totCellNumber; ++ci) {
+            mOffsets[ci + 1] = mOffsets[ci] + counters[ci].load();
+            // the counter becomes the insertion cursor of the cell
+            counters[ci].store(mOffsets[ci], std::memory_order_relaxed);
+        }
+
+        // second pass: scatter the entries in their cells; the position of an
+        // entry inside its cell depends on the scheduling of the threads...
+        std::vector<uint> order(nEntries);
+        parallelFor(chunks, [&](uint c) {
+            uint end =
+                std::min(nEntries, (c + 1) * STATIC_GRID_VALUES_PER_CHUNK);
+            for (uint i = c * STATIC_GRID_VALUES_PER_CHUNK; i < end; ++i) {
+                uint p = counters[entries[i].first].fetch_add(
+                    1, std::memory_order_relaxed);
+                order[p] = i;
+            }
+        });
+
+        // ...therefore each cell is sorted to keep the order of the entries
+        const uint nCellChunks =
+            (totCellNumber + STATIC_GRID_VALUES_PER_CHUNK - 1) /
+            STATIC_GRID_VALUES_PER_CHUNK;
+        std::vector<uint> cellChunks(nCellChunks);
+        std::iota(cellChunks.begin(), cellChunks.end(), 0);
+        parallelFor(cellChunks, [&](uint c) {
+            uint end = std::min(
+                totCellNumber, (c + 1) * STATIC_GRID_VALUES_PER_CHUNK);
+            for (uint ci = c * STATIC_GRID_VALUES_PER_CHUNK; ci < end; ++ci) {
+                if (mOffsets[ci + 1] - mOffsets[ci] > 1) {
+                    std::sort(
+                        order.begin() + mOffsets[ci],
+                        order.begin() + mOffsets[ci + 1]);
+                }
+            }
+        });
+
+        mValues.resize(nEntries);
+        parallelFor(chunks, [&](uint c) {
+            uint end =
+                std::min(nEntries, (c + 1) * STATIC_GRID_VALUES_PER_CHUNK);
+            for (uint i = c * STATIC_GRID_VALUES_PER_CHUNK; i < end; ++i)
+                mValues[i] = values[entries[order[i]].second];
+        });
+    }
 };
 
 /* Specialization Aliases */
@@ -24,14 +24,20 @@
 #define VCL_SPACE_COMPLEX_KD_TREE_H
 
 #include <vclib/concepts/mesh.h>
+#include <vclib/misc/parallel.h>
 #include <vclib/space/core/box.h>
 
+#include <algorithm>
+#include <array>
 #include <numeric>
-#include <queue>
+#include <span>
 #include <vector>
 
 namespace vcl {
 
+// number of query points processed by each task of the parallel queries
+inline constexpr uint KDTREE_QUERIES_PER_CHUNK = 1024;
+
 template<PointConcept PointType>
 class KDTree
 {
@@ -69,14 +75,36 @@ class KDTree
         Scalar sq;     // squared distance to the next node
     };
 
-    // dummy values
-    inline static Scalar              dummyScalar;
-    inline static std::vector<Scalar> dummyScalars;
+    // a point found by a query: its position in mPoints and its squared
+    // distance from the query point
+    struct Neighbor
+    {
+        Scalar sqDist;
+        uint   pos;
+
+        bool operator<(const Neighbor& n) const
+        {
+            return sqDist < n.sqDist || (sqDist == n.sqDist && pos < n.pos);
+        }
+    };
+
+    // buffers used by the queries: they are reused by all the queries executed
+    // by the same task, to avoid allocations for each query
+    struct QueryScratch
+    {
+        std::vector<QueryNode> nodeStack;
+        std::vector<Neighbor>  neighbors;
+        std::vector<Scalar>    leafDists;
+    };
 
     std::vector<PointType> mPoints;
     std::vector<uint>      mIndices;
     std::vector<Node>      mNodes;
 
+    // coordinates of mPoints, stored one dimension after the other (first all
+    // the x, then all the y...), to allow a vectorized scan of the leaves
+    std::vector<Scalar> mCoords;
+
     uint mPointsPerCell = 16; // min number of point in a leaf
     uint mMaxDepth      = 64; // max tree depth
     uint mDepth         = 0;  // actual tree depth
@@ -97,6 +125,7 @@ public:
         mNodes.back().leaf = 0;
 
         mDepth = createTree(0, 0, points.size(), 1, balanced);
+        fillCoordinates();
     }
 
     /**
@@ -136,6 +165,7 @@ public:
         mNodes.back().leaf = 0;
 
         mDepth = createTree(0, 0, mPoints.size(), 1, balanced);
+        fillCoordinates();
     }
 
     /**
@@ -144,67 +174,61 @@ public:
      * The result of the query, the closest point to the query point, is the
      * index of the point and and the distance from the query point.
      */
-    uint nearestNeighborIndex(
-        const PointType& queryPoint,
-        Scalar&          dist = dummyScalar) const
+    uint nearestNeighborIndex(const PointType& queryPoint, Scalar& dist) const
     {
-        std::vector<QueryNode> mNodeStack(mDepth + 1);
-        mNodeStack[0].nodeId = 0;
-        mNodeStack[0].sq     = 0.;
-        unsigned int count   = 1;
+        QueryScratch s;
+        Neighbor     n = nearestSearch(queryPoint, s);
+        dist           = std::sqrt(n.sqDist);
+        return mIndices[n.pos];
+    }
 
-        int    minIndex = mIndices.size() / 2;
-        Scalar minDist  = queryPoint.squaredDist(mPoints[minIndex]);
-        minIndex        = mIndices[minIndex];
+    uint nearestNeighborIndex(const PointType& queryPoint) const
+    {
+        Scalar dist;
+        return nearestNeighborIndex(queryPoint, dist);
+    }
 
-        while (count) {
-            QueryNode&  qnode = mNodeStack[count - 1];
-            const Node& node  = mNodes[qnode.nodeId];
+    PointType nearestNeighbor(const PointType& queryPoint, Scalar& dist) const
+    {
+        QueryScratch s;
+        Neighbor     n = nearestSearch(queryPoint, s);
+        dist           = std::sqrt(n.sqDist);
+        return mPoints[n.pos];
+    }
 
-            if (qnode.sq < minDist) {
-                if (node.leaf) {
-                    --count; // pop
-                    uint end = node.start + node.size;
-                    for (uint i = node.start; i < end; ++i) {
-                        Scalar pointSquareDist =
-                            queryPoint.squaredDist(mPoints[i]);
-                        if (pointSquareDist < minDist) {
-                            minDist  = pointSquareDist;
-                            minIndex = mIndices[i];
-                        }
-                    }
-                }
-                else {
-                    // replace the stack top by the farthest and push the
-                    // closest
-                    Scalar new_off = queryPoint[node.dim] - node.splitValue;
-                    if (new_off < 0.) {
-                        mNodeStack[count].nodeId = node.firstChildId;
-                        qnode.nodeId             = node.firstChildId + 1;
-                    }
-                    else {
-                        mNodeStack[count].nodeId = node.firstChildId + 1;
-                        qnode.nodeId             = node.firstChildId;
-                    }
-                    mNodeStack[count].sq = qnode.sq;
-                    qnode.sq             = new_off * new_off;
-                    ++count;
-                }
-            }
-            else {
-                // pop
-                --count;
-            }
-        }
-        dist = std::sqrt(minDist);
-        return minIndex;
+    PointType nearestNeighbor(const PointType& queryPoint) const
+    {
+        Scalar dist;
+        return nearestNeighbor(queryPoint, dist);
     }
 
-    PointType nearestNeighbor(
-        const PointType& queryPoint,
-        Scalar&          dist = dummyScalar) const
+    /**
+     * @brief Searchs the closest point for each one of the given query points.
+     *
+     * The queries are executed in parallel, sorted by their Morton code to
+     * improve the locality of the visited nodes. The results are stored in the
+     * given output vectors (resized if necessary) in the same order of the
+     * query points: indices[i] is the index of the closest point to
+     * queryPoints[i], and distances[i] its distance.
+     *
+     * @param[in] queryPoints: the query points.
+     * @param[out] indices: the indices of the closest points.
+     * @param[out] distances: the distances of the closest points.
+     */
+    void nearestNeighborsIndices(
+        std::span<const PointType> queryPoints,
+        std::vector<uint>&         indices,
+        std::vector<Scalar>&       distances) const
     {
-        return mPoints[nearestNeighborIndex(queryPoint, dist)];
+        std::vector<uint> offsets;
+        bulkQuery(
+            queryPoints,
+            offsets,
+            indices,
+            distances,
+            [&](const PointType& p, QueryScratch& s, auto& res) {
+                res.push_back(nearestSearch(p, s));
+            });
     }
 
     /**
@@ -227,89 +251,354 @@ public:
     std::vector<uint> kNearestNeighborsIndices(
         const PointType&     queryPoint,
         uint                 k,
-        std::vector<Scalar>& distances = dummyScalars) const
+        std::vector<Scalar>& distances) const
     {
-        struct P
-        {
-            P(const PointType& p, int i) : p(p), i(i) {}
+        QueryScratch s;
+        kNearestSearch(queryPoint, k, s);
+
+        std::vector<uint> res(s.neighbors.size());
+        distances.resize(s.neighbors.size());
+        for (uint i = 0; const Neighbor& n : s.neighbors) {
+            res[i]       = mIndices[n.pos];
+            distances[i] = std::sqrt(n.sqDist);
+            ++i;
+        }
+        return res;
+    }
 
-            PointType p;
-            uint      i;
-        };
+    std::vector<uint> kNearestNeighborsIndices(
+        const PointType& queryPoint,
+        uint             k) const
+    {
+        std::vector<Scalar> distances;
+        return kNearestNeighborsIndices(queryPoint, k, distances);
+    }
 
-        struct Comparator
-        {
-            const PointType qp;
+    /**
+     * @brief Performs the k nearest neighbour query for each one of the given
+     * query points.
+     *
+     * The queries are executed in parallel, sorted by their Morton code to
+     * improve the locality of the visited nodes. The results are stored in a
+     * CSR layout: the neighbors of queryPoints[i] are stored in the range
+     * [offsets[i], offsets[i+1]) of the indices and distances vectors, sorted
+     * on order of neighborhood. The output vectors are resized if necessary,
+     * therefore they can be reused among several calls without allocations.
+     *
+     * @param[in] queryPoints: the query points.
+     * @param[in] k: the number of neighbors to search for each query point.
+     * @param[out] offsets: vector of size queryPoints.size() + 1, the offsets
+     * of the neighbors of each query point.
+     * @param[out] indices: the indices of the neighbors.
+     * @param[out] distances: the distances of the neighbors.
+     */
+    void kNearestNeighborsIndices(
+        std::span<const PointType> queryPoints,
+        uint                       k,
+        std::vector<uint>&         offsets,
+        std::vector<uint>&         indices,
+        std::vector<Scalar>&       distances) const
+    {
+        bulkQuery(
+            queryPoints,
+            offsets,
+            indices,
+            distances,
+            [&](const PointType& p, QueryScratch& s, auto& res) {
+                kNearestSearch(p, k, s);
+                res.insert(res.end(), s.neighbors.begin(), s.neighbors.end());
+            });
+    }
+
+    std::vector<PointType> kNearestNeighbors(
+        const PointType&     queryPoint,
+        uint                 k,
+        std::vector<Scalar>& distances) const
+    {
+        QueryScratch s;
+        kNearestSearch(queryPoint, k, s);
+
+        std::vector<PointType> res(s.neighbors.size());
+        distances.resize(s.neighbors.size());
+        for (uint i = 0; const Neighbor& n : s.neighbors) {
+            res[i]       = mPoints[n.pos];
+            distances[i] = std::sqrt(n.sqDist);
+            ++i;
+        }
+        return res;
+    }
 
-            Comparator(const PointType& qp) : qp(qp) {}
+    std::vector<PointType> kNearestNeighbors(
+        const PointType& queryPoint,
+        uint             k) const
+    {
+        std::vector<Scalar> distances;
+        return kNearestNeighbors(queryPoint, k, distances);
+    }
 
-            bool operator()(const P& p1, const P& p2)
-            {
-                if (qp.squaredDist(p1.p) > qp.squaredDist(p2.p))
-                    return true;
-                return false;
+    /**
+     * @brief Performs the distance query.
+     *
+     * The result of the query, all the points within the distance dist form the
+     * query point, is the vector of the indeces and the vector of the distances
+     * from the query point.
+     */
+    std::vector<uint> neighborsIndicesInDistance(
+        const PointType&     queryPoint,
+        Scalar               dist,
+        std::vector<Scalar>& distances) const
+    {
+        QueryScratch          s;
+        std::vector<Neighbor> neighbors;
+        radiusSearch(queryPoint, dist * dist, s, neighbors);
+
+        std::vector<uint> res(neighbors.size());
+        distances.resize(neighbors.size());
+        for (uint i = 0; const Neighbor& n : neighbors) {
+            res[i]       = mIndices[n.pos];
+            distances[i] = std::sqrt(n.sqDist);
+            ++i;
+        }
+        return res;
+    }
+
+    std::vector<uint> neighborsIndicesInDistance(
+        const PointType& queryPoint,
+        Scalar           dist) const
+    {
+        std::vector<Scalar> distances;
+        return neighborsIndicesInDistance(queryPoint, dist, distances);
+    }
+
+    /**
+     * @brief Performs the distance query for each one of the given query
+     * points.
+     *
+     * The queries are executed in parallel, sorted by their Morton code to
+     * improve the locality of the visited nodes. The results are stored in a
+     * CSR layout: the points within the distance dist from queryPoints[i] are
+     * stored in the range [offsets[i], offsets[i+1]) of the indices and
+     * distances vectors. The output vectors are resized if necessary,
+     * therefore they can be reused among several calls without allocations.
+     *
+     * @param[in] queryPoints: the query points.
+     * @param[in] dist: the maximum distance from the query points.
+     * @param[out] offsets: vector of size queryPoints.size() + 1, the offsets
+     * of the neighbors of each query point.
+     * @param[out] indices: the indices of the neighbors.
+     * @param[out] distances: the distances of the neighbors.
+     */
+    void neighborsIndicesInDistance(
+        std::span<const PointType> queryPoints,
+        Scalar                     dist,
+        std::vector<uint>&         offsets,
+        std::vector<uint>&         indices,
+        std::vector<Scalar>&       distances) const
+    {
+        const Scalar sqDist = dist * dist;
+        bulkQuery(
+            queryPoints,
+            offsets,
+            indices,
+            distances,
+            [&](const PointType& p, QueryScratch& s, auto& res) {
+                radiusSearch(p, sqDist, s, res);
+            });
+    }
+
+    std::vector<PointType> neighborsInDistance(
+        const PointType&     queryPoint,
+        Scalar               dist,
+        std::vector<Scalar>& distances) const
+    {
+        QueryScratch          s;
+        std::vector<Neighbor> neighbors;
+        radiusSearch(queryPoint, dist * dist, s, neighbors);
+
+        std::vector<PointType> res(neighbors.size());
+        distances.resize(neighbors.size());
+        for (uint i = 0; const Neighbor& n : neighbors) {
+            res[i]       = mPoints[n.pos];
+            distances[i] = std::sqrt(n.sqDist);
+            ++i;
+        }
+        return res;
+    }
+
+    std::vector<PointType> neighborsInDistance(
+        const PointType& queryPoint,
+        Scalar           dist) const
+    {
+        std::vector<Scalar> distances;
+        return neighborsInDistance(queryPoint, dist, distances);
+    }
+
+private:
+    /**
+     * @brief Computes the squared distances between the query point and all
+     * the points of the given leaf, and returns a pointer to them.
+     *
+     * The loop reads the coordinates from mCoords and has no branches, so that
+     * it can be vectorized by the compiler.
+     */
+    const Scalar* leafSquaredDists(
+        const PointType&     queryPoint,
+        const Node&          leaf,
+        std::vector<Scalar>& dists) const
+    {
+        const uint n = mPoints.size();
+        if (dists.size() < leaf.size)
+            dists.resize(leaf.size);
+
+        const uint    size = leaf.size;
+        const Scalar* c    = mCoords.data() + leaf.start;
+        Scalar*       d    = dists.data();
+
+        std::array<Scalar, PointType::DIM> q;
+        for (uint j = 0; j < PointType::DIM; ++j)
+            q[j] = queryPoint[j];
+
+        for (uint i = 0; i < size; ++i) {
+            Scalar sq = 0;
+            for (uint j = 0; j < PointType::DIM; ++j) {
+                const Scalar t = c[j * n + i] - q[j];
+                sq += t * t;
             }
-        };
+            d[i] = sq;
+        }
+        return d;
+    }
 
-        Comparator cmp(queryPoint);
+    /**
+     * @brief Given the current node of the stack, that is not a leaf, replaces
+     * the stack top by the farthest child and pushes the closest one.
+     */
+    void pushChildren(
+        const PointType&        queryPoint,
+        const Node&             node,
+        std::vector<QueryNode>& nodeStack,
+        uint&                   count) const
+    {
+        QueryNode& qnode = nodeStack[count - 1];
+
+        // the new offset is the distance between the searched point and the
+        // actual split coordinate
+        Scalar newOff = queryPoint[node.dim] - node.splitValue;
+
+        // left sub-tree
+        if (newOff < 0.) {
+            nodeStack[count].nodeId = node.firstChildId;
+            // in the father's nodeId we save the index of the other sub-tree
+            // (for backtracking)
+            qnode.nodeId = node.firstChildId + 1;
+        }
+        // right sub-tree (same as above)
+        else {
+            nodeStack[count].nodeId = node.firstChildId + 1;
+            qnode.nodeId            = node.firstChildId;
+        }
+        // distance is inherited from the father (while descending the tree
+        // it's equal to 0)
+        nodeStack[count].sq = qnode.sq;
+        // distance of the father is the squared distance from the split plane
+        qnode.sq = newOff * newOff;
+        ++count;
+    }
 
-        std::priority_queue<P, std::vector<P>, Comparator> neighborQueue(cmp);
+    Neighbor nearestSearch(const PointType& queryPoint, QueryScratch& s) const
+    {
+        s.nodeStack.resize(mDepth + 1);
+        s.nodeStack[0].nodeId = 0;
+        s.nodeStack[0].sq     = 0.;
+        uint count            = 1;
 
-        std::vector<QueryNode> mNodeStack(mDepth + 1);
-        mNodeStack[0].nodeId = 0;
-        mNodeStack[0].sq     = 0.;
-        unsigned int count   = 1;
+        Neighbor nearest;
+        nearest.pos    = mIndices.size() / 2;
+        nearest.sqDist = queryPoint.squaredDist(mPoints[nearest.pos]);
 
         while (count) {
-            // we select the last node (AABB) inserted in the stack
-            QueryNode& qnode = mNodeStack[count - 1];
+            const QueryNode& qnode = s.nodeStack[count - 1];
+            const Node&      node  = mNodes[qnode.nodeId];
 
+            if (qnode.sq < nearest.sqDist) {
+                if (node.leaf) {
+                    --count; // pop
+                    const Scalar* d =
+                        leafSquaredDists(queryPoint, node, s.leafDists);
+                    for (uint i = 0; i < node.size; ++i) {
+                        if (d[i] < nearest.sqDist) {
+                            nearest.sqDist = d[i];
+                            nearest.pos    = node.start + i;
+                        }
+                    }
+                }
+                else {
+                    pushChildren(queryPoint, node, s.nodeStack, count);
+                }
+            }
+            else {
+                // pop
+                --count;
+            }
+        }
+        return nearest;
+    }
+
+    /**
+     * @brief Searches the k nearest neighbors of the query point, and stores
+     * them in s.neighbors, sorted on order of neighborhood.
+     *
+     * The neighbors are collected in a max-heap of size k, whose top is the
+     * farthest neighbor found so far.
+     */
+    void kNearestSearch(
+        const PointType& queryPoint,
+        uint             k,
+        QueryScratch&    s) const
+    {
+        std::vector<Neighbor>& heap = s.neighbors;
+        heap.clear();
+        if (k == 0 || mPoints.empty())
+            return;
+
+        s.nodeStack.resize(mDepth + 1);
+        s.nodeStack[0].nodeId = 0;
+        s.nodeStack[0].sq     = 0.;
+        uint count            = 1;
+
+        while (count) {
+            // we select the last node (AABB) inserted in the stack
             // while going down the tree qnode.nodeId is the nearest sub-tree,
             // otherwise, in backtracking, qnode.nodeId is the other sub-tree
             // that will be visited iff the actual nearest node is further than
             // the split distance.
-            const Node& node = mNodes[qnode.nodeId];
+            const QueryNode& qnode = s.nodeStack[count - 1];
+            const Node&      node  = mNodes[qnode.nodeId];
 
             // if the distance is less than the top of the max-heap, it could be
             // one of the k-nearest neighbours
-            if (neighborQueue.size() < k ||
-                qnode.sq < queryPoint.squaredDist(neighborQueue.top().p)) {
+            if (heap.size() < k || qnode.sq < heap.front().sqDist) {
                 // when we arrive to a leaf
                 if (node.leaf) {
                     --count; // pop of the leaf
 
-                    // end is the index of the last element of the leaf in
-                    // mPoints
-                    unsigned int end = node.start + node.size;
-                    // adding the element of the leaf to the heap
-                    for (unsigned int i = node.start; i < end; ++i)
-                        neighborQueue.push(P(mPoints[i], mIndices[i]));
+                    const Scalar* d =
+                        leafSquaredDists(queryPoint, node, s.leafDists);
+                    for (uint i = 0; i < node.size; ++i) {
+                        if (heap.size() < k) {
+                            heap.push_back({d[i], node.start + i});
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                        else if (d[i] < heap.front().sqDist) {
+                            std::pop_heap(heap.begin(), heap.end());
+                            heap.back() = {d[i], node.start + i};
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
                 }
                 // otherwise, if we're not on a leaf
                 else {
-                    // the new offset is the distance between the searched point
-                    // and the actual split coordinate
-                    Scalar new_off = queryPoint[node.dim] - node.splitValue;
-
-                    // left sub-tree
-                    if (new_off < 0.) {
-                        mNodeStack[count].nodeId = node.firstChildId;
-                        // in the father's nodeId we save the index of the other
-                        // sub-tree (for backtracking)
-                        qnode.nodeId = node.firstChildId + 1;
-                    }
-                    // right sub-tree (same as above)
-                    else {
-                        mNodeStack[count].nodeId = node.firstChildId + 1;
-                        qnode.nodeId             = node.firstChildId;
-                    }
-                    // distance is inherited from the father (while descending
-                    // the tree it's equal to 0)
-                    mNodeStack[count].sq = qnode.sq;
-                    // distance of the father is the squared distance from the
-                    // split plane
-                    qnode.sq = new_off * new_off;
-                    ++count;
+                    pushChildren(queryPoint, node, s.nodeStack, count);
                 }
             }
             else {
@@ -317,86 +606,43 @@ public:
                 --count;
             }
         }
-        distances.clear();
-        std::vector<uint> res;
-
-        uint i = 0;
-        while (!neighborQueue.empty() && i < k) {
-            res.push_back(neighborQueue.top().i);
-            distances.push_back(queryPoint.dist(neighborQueue.top().p));
-            neighborQueue.pop();
-            i++;
-        }
-        return res;
-    }
-
-    std::vector<PointType> kNearestNeighbors(
-        const PointType&     queryPoint,
-        uint                 k,
-        std::vector<Scalar>& distances = dummyScalars) const
-    {
-        std::vector<uint> dists =
-            kNearestNeighborsIndices(queryPoint, k, distances);
-        std::vector<PointType> res;
-        res.reserve(dists.size());
-        for (uint k : dists) {
-            res.push_back(mPoints[k]);
-        }
-        return res;
+        std::sort_heap(heap.begin(), heap.end());
     }
 
     /**
-     * @brief Performs the distance query.
-     *
-     * The result of the query, all the points within the distance dist form the
-     * query point, is the vector of the indeces and the vector of the distances
-     * from the query point.
+     * @brief Searches all the points having squared distance less than sqDist
+     * from the query point, and appends them to the res vector.
      */
-    std::vector<uint> neighborsIndicesInDistance(
-        const PointType&     queryPoint,
-        Scalar               dist,
-        std::vector<Scalar>& distances = dummyScalars) const
+    void radiusSearch(
+        const PointType&       queryPoint,
+        Scalar                 sqDist,
+        QueryScratch&          s,
+        std::vector<Neighbor>& res) const
     {
-        std::vector<uint> queryPoints;
-        distances.clear();
-        std::vector<QueryNode> mNodeStack(mDepth + 1);
-        mNodeStack[0].nodeId = 0;
-        mNodeStack[0].sq     = 0.;
-        unsigned int count   = 1;
-
-        Scalar squareDist = dist * dist;
+        if (mPoints.empty())
+            return;
+
+        s.nodeStack.resize(mDepth + 1);
+        s.nodeStack[0].nodeId = 0;
+        s.nodeStack[0].sq     = 0.;
+        uint count            = 1;
+
         while (count) {
-            QueryNode&  qnode = mNodeStack[count - 1];
-            const Node& node  = mNodes[qnode.nodeId];
+            const QueryNode& qnode = s.nodeStack[count - 1];
+            const Node&      node  = mNodes[qnode.nodeId];
 
-            if (qnode.sq < squareDist) {
+            if (qnode.sq < sqDist) {
                 if (node.leaf) {
                     --count; // pop
-                    unsigned int end = node.start + node.size;
-                    for (unsigned int i = node.start; i < end; ++i) {
-                        Scalar pointSquareDist =
-                            queryPoint.squareDist(mPoints[i]);
-                        if (pointSquareDist < squareDist) {
-                            queryPoints.push_back(mIndices[i]);
-                            distances.push_back(queryPoint.dist(mPoints[i]));
-                        }
+                    const Scalar* d =
+                        leafSquaredDists(queryPoint, node, s.leafDists);
+                    for (uint i = 0; i < node.size; ++i) {
+                        if (d[i] < sqDist)
+                            res.push_back({d[i], node.start + i});
                     }
                 }
                 else {
-                    // replace the stack top by the farthest and push the
-                    // closest
-                    Scalar new_off = queryPoint[node.dim] - node.splitValue;
-                    if (new_off < 0.) {
-                        mNodeStack[count].nodeId = node.firstChildId;
-                        qnode.nodeId             = node.firstChildId + 1;
-                    }
-                    else {
-                        mNodeStack[count].nodeId = node.firstChildId + 1;
-                        qnode.nodeId             = node.firstChildId;
-                    }
-                    mNodeStack[count].sq = qnode.sq;
-                    qnode.sq             = new_off * new_off;
-                    ++count;
+                    pushChildren(queryPoint, node, s.nodeStack, count);
                 }
             }
             else {
@@ -404,22 +650,136 @@ public:
                 --count;
             }
         }
-        return queryPoints;
     }
 
-    std::vector<PointType> neighborsInDistance(
-        const PointType&     queryPoint,
-        Scalar               dist,
-        std::vector<Scalar>& distances = dummyScalars) const
+    /**
+     * @brief Executes the given query for each query point, in parallel, and
+     * stores the results in CSR layout in the output vectors.
+     *
+     * The query points are sorted by Morton code and split in chunks of
+     * KDTREE_QUERIES_PER_CHUNK consecutive points. Each chunk is a parallel
+     * task having its own scratch buffers and result vector; the results of
+     * the chunks are then scattered in the output vectors, in the order of the
+     * query points.
+     *
+     * The query function takes as input the query point, the scratch buffers
+     * and the vector of the neighbors of the chunk, to which it must append the
+     * neighbors of the query point.
+     */
+    template<typename QueryFunction>
+    void bulkQuery(
+        std::span<const PointType> queryPoints,
+        std::vector<uint>&         offsets,
+        std::vector<uint>&         indices,
+        std::vector<Scalar>&       distances,
+        QueryFunction&&            query) const
     {
-        std::vector<uint> dists =
-            neighborsIndicesInDistance(queryPoint, dist, distances);
-        std::vector<PointType> res;
-        res.reserve(dists.size());
-        for (uint k : dists) {
-            res.push_back(mPoints[k]);
+        const uint n = queryPoints.size();
+
+        offsets.assign(n + 1, 0);
+        if (n == 0 || mPoints.empty()) {
+            indices.clear();
+            distances.clear();
+            return;
+        }
+
+        const std::vector<uint> order = mortonOrder(queryPoints);
+
+        const uint nChunks =
+            (n + KDTREE_QUERIES_PER_CHUNK - 1) / KDTREE_QUERIES_PER_CHUNK;
+
+        std::vector<std::vector<Neighbor>> chunkResults(nChunks);
+        std::vector<uint>                  chunks(nChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        // offsets[q + 1] temporarily stores the number of neighbors of q
+        parallelFor(chunks, [&](uint c) {
+            QueryScratch           s;
+            std::vector<Neighbor>& res = chunkResults[c];
+
+            uint end = std::min(n, (c + 1) * KDTREE_QUERIES_PER_CHUNK);
+            for (uint j = c * KDTREE_QUERIES_PER_CHUNK; j < end; ++j) {
+                uint q     = order[j];
+                uint first = res.size();
+                query(queryPoints[q], s, res);
+                offsets[q + 1] = res.size() - first;
+            }
+        });
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        indices.resize(offsets[n]);
+        distances.resize(offsets[n]);
+
+        parallelFor(chunks, [&](uint c) {
+            const std::vector<Neighbor>& res = chunkResults[c];
+
+            uint r   = 0;
+            uint end = std::min(n, (c + 1) * KDTREE_QUERIES_PER_CHUNK);
+            for (uint j = c * KDTREE_QUERIES_PER_CHUNK; j < end; ++j) {
+                uint q = order[j];
+                for (uint i = offsets[q]; i < offsets[q + 1]; ++i, ++r) {
+                    indices[i]   = mIndices[res[r].pos];
+                    distances[i] = std::sqrt(res[r].sqDist);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the permutation of the query points that sorts them by
+     * their Morton code, computed in the bounding box of the query points.
+     *
+     * Consecutive query points in this order are close in space, and therefore
+     * visit mostly the same nodes of the tree.
+     */
+    static std::vector<uint> mortonOrder(std::span<const PointType> points)
+    {
+        constexpr uint BITS = 63 / PointType::DIM;
+        constexpr uint CELLS = (1u << std::min(BITS, 31u)) - 1;
+
+        Box<PointType> bb;
+        for (const PointType& p : points)
+            bb.add(p);
+        PointType size = bb.max() - bb.min();
+
+        std::vector<std::pair<uint64_t, uint>> codes(points.size());
+        for (uint i = 0; i < points.size(); ++i) {
+            std::array<uint64_t, PointType::DIM> cell;
+            for (uint j = 0; j < PointType::DIM; ++j) {
+                Scalar t = size[j] > 0 ? (points[i][j] - bb.min()[j]) / size[j] :
+                                         Scalar(0);
+                cell[j]  = uint64_t(t * CELLS);
+            }
+            uint64_t code = 0;
+            for (uint b = 0; b < BITS; ++b) {
+                for (uint j = 0; j < PointType::DIM; ++j) {
+                    code |= ((cell[j] >> b) & 1) << (b * PointType::DIM + j);
+                }
+            }
+            codes[i] = {code, i};
+        }
+        std::sort(codes.begin(), codes.end());
+
+        std::vector<uint> order(points.size());
+        for (uint i = 0; i < points.size(); ++i)
+            order[i] = codes[i].second;
+        return order;
+    }
+
+    /**
+     * @brief Fills the mCoords vector with the coordinates of mPoints, called
+     * after the tree has been built (and mPoints sorted).
+     */
+    void fillCoordinates()
+    {
+        const uint n = mPoints.size();
+        mCoords.resize(PointType::DIM * n);
+        for (uint j = 0; j < PointType::DIM; ++j) {
+            for (uint i = 0; i < n; ++i) {
+                mCoords[j * n + i] = mPoints[i][j];
+            }
         }
-        return res;
     }
 
 private:
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_COMPLEX_UNION_FIND_H
+#define VCL_SPACE_COMPLEX_UNION_FIND_H
+
+#include <vclib/types.h>
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief The ConcurrentUnionFind class is a lock-free disjoint-set forest over
+ * the indices [0, size()), that can be updated concurrently by several
+ * threads.
+ *
+ * Each set is represented by a tree of parent pointers, stored as atomic
+ * indices. The union of two sets always links the root having the larger index
+ * to the root having the smaller one with a compare-and-swap, retrying if one
+ * of the roots has been linked in the meantime by another thread; therefore
+ * the trees are always acyclic, and the root of each set is its smallest
+ * index. The find operation compresses the paths with path halving, using
+ * compare-and-swap operations that can fail harmlessly.
+ *
+ * The find and unite member functions can be called concurrently. The result
+ * of find is stable only when no unite is running: the typical usage is to
+ * perform all the unions in parallel, and then to query the roots.
+ *
+ * @ingroup space_complex
+ */
+class ConcurrentUnionFind
+{
+    std::vector<std::atomic<uint>> mParents;
+
+public:
+    /**
+     * @brief Creates an empty union-find structure.
+     */
+    ConcurrentUnionFind() = default;
+
+    /**
+     * @brief Creates a union-find structure of n singleton sets.
+     *
+     * @param[in] n: the number of elements.
+     */
+    explicit ConcurrentUnionFind(uint n) : mParents(n)
+    {
+        for (uint i = 0; i < n; ++i)
+            mParents[i].store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the number of elements of the structure.
+     */
+    uint size() const { return mParents.size(); }
+
+    /**
+     * @brief Returns the root of the set that contains the i-th element, that
+     * is the smallest index of the set.
+     *
+     * @param[in] i: the index of the element.
+     * @return the root of the set of i.
+     */
+    uint find(uint i)
+    {
+        assert(i < mParents.size());
+        uint p = mParents[i].load();
+        while (p != i) {
+            uint gp = mParents[p].load();
+            // path halving: if it fails, another thread already moved i
+            // closer to its root
+            if (gp != p)
+                mParents[i].compare_exchange_weak(p, gp);
+            i = gp;
+            p = mParents[i].load();
+        }
+        return i;
+    }
+
+    /**
+     * @brief Merges the sets that contain the elements i and j.
+     *
+     * @param[in] i: the index of the first element.
+     * @param[in] j: the index of the second element.
+     * @return true if the two elements were in different sets.
+     */
+    bool unite(uint i, uint j)
+    {
+        while (true) {
+            i = find(i);
+            j = find(j);
+            if (i == j)
+                return false;
+            if (i > j)
+                std::swap(i, j);
+            // link the larger root to the smaller one, if it is still a root
+            uint root = j;
+            if (mParents[j].compare_exchange_strong(root, i))
+                return true;
+        }
+    }
+
+    /**
+     * @brief Returns true if the elements i and j belong to the same set.
+     */
+    bool sameSet(uint i, uint j) { return find(i) == find(j); }
+};
+
+} // namespace vcl
+
+#endif // VCL_SPACE_COMPLEX_UNION_FIND_H
@@ -92,9 +92,9 @@ public:
         Scalar dmin = 0;
         for (uint i = 0; i < 3; i++) {
             if (mCenter[i] < b.min()[i])
-                dmin += std::sqrt(mCenter[i] - b.min()[i]);
+                dmin += std::pow(mCenter[i] - b.min()[i], 2);
             else if (mCenter[i] > b.max()[i])
-                dmin += std::sqrt(mCenter[i] - b.max()[i]);
+                dmin += std::pow(mCenter[i] - b.max()[i], 2);
         }
         if (dmin <= std::pow(mRadius, 2))
             return true;
@@ -0,0 +1,425 @@
+/*****************************************************************************
+ * VCLib                                                                     *
+ * Visual Computing Library                                                  *
+ *                                                                           *
+ * Copyright(C) 2021-2025                                                    *
+ * Visual Computing Lab                                                      *
+ * ISTI - Italian National Research Council                                  *
+ *                                                                           *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This program is free software; you can redistribute it and/or modify      *
+ * it under the terms of the Mozilla Public License Version 2.0 as published *
+ * by the Mozilla Foundation; either version 2 of the License, or            *
+ * (at your option) any later version.                                       *
+ *                                                                           *
+ * This program is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * Mozilla Public License Version 2.0                                        *
+ * (https://www.mozilla.org/en-US/MPL/2.0/) for more details.                *
+ ****************************************************************************/
+
+#ifndef VCL_SPACE_CORE_VECTOR_CHUNKED_VECTOR_H
+#define VCL_SPACE_CORE_VECTOR_CHUNKED_VECTOR_H
+
+#include <vclib/types.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace vcl {
+
+/**
+ * @brief The ChunkedVector class is a sequence container that stores its
+ * elements in fixed size chunks, and therefore it never moves its elements
+ * when it grows: pointers and references to the elements stay valid until the
+ * elements are removed from the container.
+ *
+ * Its interface is a subset of the interface of `std::vector` (random access,
+ * iterators, `push_back`, `emplace_back`, `resize`, `reserve`...), and it can
+ * be used as a drop-in replacement of `std::vector` when the addresses of the
+ * elements must be stable, e.g. when other objects store pointers to the
+ * elements of the container.
+ *
+ * Each chunk is a memory block of `CHUNK_BYTES` bytes, aligned to its size,
+ * that starts with a small header storing the index of the first element of
+ * the chunk. Therefore, the mapping between indices and elements is O(1) in
+ * both directions:
+ * - the element having index `i` is the element `i % CHUNK_SIZE` of the
+ *   chunk `i / CHUNK_SIZE`;
+ * - the index of an element can be computed just from its address (see the
+ *   static member function ChunkedVector::index), by rounding the address
+ *   down to the beginning of its chunk and reading the header.
+ *
+ * @note Unlike `std::vector`, the elements are not contiguous in memory: only
+ * the elements of the same chunk are contiguous.
+ *
+ * @tparam T: the type of the elements stored in the container.
+ *
+ * @ingroup space_core
+ */
+template<typename T>
+class ChunkedVector
+{
+    struct ChunkHeader
+    {
+        std::size_t first; // the index of the first element of the chunk
+    };
+
+    // offset of the first element of a chunk w.r.t. the beginning of the chunk
+    static constexpr std::size_t ELEMENTS_OFFSET =
+        (sizeof(ChunkHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    template<bool CNST>
+    class Iterator;
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using iterator        = Iterator<false>;
+    using const_iterator  = Iterator<true>;
+
+    /**
+     * @brief The size in bytes of each chunk: it is a power of two, and each
+     * chunk is aligned to its size.
+     */
+    static constexpr std::size_t CHUNK_BYTES = std::max<std::size_t>(
+        std::size_t(1) << 16,
+        std::bit_ceil(ELEMENTS_OFFSET + sizeof(T)));
+
+    /**
+     * @brief The number of elements stored in each chunk.
+     */
+    static constexpr std::size_t CHUNK_SIZE =
+        (CHUNK_BYTES - ELEMENTS_OFFSET) / sizeof(T);
+
+private:
+    // pointers to the first element of each allocated chunk
+    std::vector<T*> mChunks;
+
+    // the number of elements of the container
+    std::size_t mSize = 0;
+
+public:
+    /**
+     * @brief Creates an empty ChunkedVector.
+     */
+    ChunkedVector() = default;
+
+    /**
+     * @brief Creates a ChunkedVector having n default constructed elements.
+     * @param[in] n: the number of elements of the container.
+     */
+    explicit ChunkedVector(std::size_t n) { resize(n); }
+
+    ChunkedVector(const ChunkedVector& oth)
+    {
+        reserve(oth.mSize);
+        for (const T& e : oth)
+            push_back(e);
+    }
+
+    ChunkedVector(ChunkedVector&& oth) noexcept { swap(oth); }
+
+    ~ChunkedVector()
+    {
+        clear();
+        for (T* c : mChunks)
+            deallocateChunk(c);
+    }
+
+    ChunkedVector& operator=(ChunkedVector oth) noexcept
+    {
+        swap(oth);
+        return *this;
+    }
+
+    /**
+     * @brief Returns the index of the given element in the ChunkedVector that
+     * stores it, computed only from the address of the element.
+     *
+     * The element must be stored in a ChunkedVector<T>, that may be different
+     * from this one: this allows to compute, e.g., the index of an element of
+     * a container that has been copied into another one.
+     *
+     * @param[in] e: a pointer to an element stored in a ChunkedVector<T>.
+     * @return the index of the element in its container.
+     */
+    static std::size_t index(const T* e)
+    {
+        const std::uintptr_t chunk =
+            reinterpret_cast<std::uintptr_t>(e) & ~(CHUNK_BYTES - 1);
+        const ChunkHeader* h = reinterpret_cast<const ChunkHeader*>(chunk);
+        const T* first = reinterpret_cast<const T*>(chunk + ELEMENTS_OFFSET);
+        return h->first + (e - first);
+    }
+
+    std::size_t size() const { return mSize; }
+
+    bool empty() const { return mSize == 0; }
+
+    /**
+     * @brief Returns the number of elements that can be stored in the
+     * allocated chunks.
+     */
+    std::size_t capacity() const { return mChunks.size() * CHUNK_SIZE; }
+
+    /**
+     * @brief Returns a pointer to the first element of the container, or
+     * nullptr if the container is empty.
+     *
+     * Since the elements are not contiguous, the returned pointer cannot be
+     * used to access the other elements; it is stable, and it can be used to
+     * check whether the container has been (re)allocated.
+     */
+    T* data() { return mSize > 0 ? mChunks.front() : nullptr; }
+
+    const T* data() const { return mSize > 0 ? mChunks.front() : nullptr; }
+
+    T& operator[](std::size_t i)
+    {
+        assert(i < mSize);
+        return mChunks[i / CHUNK_SIZE][i % CHUNK_SIZE];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        assert(i < mSize);
+        return mChunks[i / CHUNK_SIZE][i % CHUNK_SIZE];
+    }
+
+    T& front() { return (*this)[0]; }
+
+    const T& front() const { return (*this)[0]; }
+
+    T& back() { return (*this)[mSize - 1]; }
+
+    const T& back() const { return (*this)[mSize - 1]; }
+
+    iterator begin() { return iterator(this, 0); }
+
+    iterator end() { return iterator(this, mSize); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const { return const_iterator(this, mSize); }
+
+    /**
+     * @brief Allocates the chunks needed to store n elements. The elements
+     * already stored in the container are never moved.
+     * @param[in] n: the number of elements to reserve.
+     */
+    void reserve(std::size_t n)
+    {
+        mChunks.reserve((n + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        while (capacity() < n)
+            mChunks.push_back(allocateChunk(mChunks.size() * CHUNK_SIZE));
+    }
+
+    void resize(std::size_t n)
+    {
+        if (n > mSize) {
+            reserve(n);
+            for (std::size_t i = mSize; i < n; ++i)
+                std::construct_at(address(i));
+            mSize = n;
+        }
+        else {
+            while (mSize > n)
+                pop_back();
+        }
+    }
+
+    void push_back(const T& v) { emplace_back(v); }
+
+    void push_back(T&& v) { emplace_back(std::move(v)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (mSize == capacity())
+            mChunks.push_back(allocateChunk(mSize));
+        T* e = std::construct_at(address(mSize), std::forward<Args>(args)...);
+        ++mSize;
+        return *e;
+    }
+
+    void pop_back()
+    {
+        assert(mSize > 0);
+        std::destroy_at(address(--mSize));
+    }
+
+    /**
+     * @brief Removes all the elements of the container. The allocated chunks
+     * are kept, and they will be reused by the next insertions.
+     */
+    void clear()
+    {
+        while (mSize > 0)
+            pop_back();
+    }
+
+    void swap(ChunkedVector& oth) noexcept
+    {
+        using std::swap;
+        swap(mChunks, oth.mChunks);
+        swap(mSize, oth.mSize);
+    }
+
+    friend void swap(ChunkedVector& a, ChunkedVector& b) noexcept
+    {
+        a.swap(b);
+    }
+
+private:
+    T* address(std::size_t i)
+    {
+        return mChunks[i / CHUNK_SIZE] + i % CHUNK_SIZE;
+    }
+
+    static T* allocateChunk(std::size_t first)
+    {
+        void* chunk =
+            ::operator new(CHUNK_BYTES, std::align_val_t(CHUNK_BYTES));
+        std::construct_at(static_cast<ChunkHeader*>(chunk), first);
+        return reinterpret_cast<T*>(
+            static_cast<std::byte*>(chunk) + ELEMENTS_OFFSET);
+    }
+
+    static void deallocateChunk(T* first)
+    {
+        ::operator delete(
+            reinterpret_cast<std::byte*>(first) - ELEMENTS_OFFSET,
+            CHUNK_BYTES,
+            std::align_val_t(CHUNK_BYTES));
+    }
+
+    /*
+     * Random access iterator of the ChunkedVector: it stores the container and
+     * the index of the pointed element.
+     */
+    template<bool CNST>
+    class Iterator
+    {
+        using Container =
+            std::conditional_t<CNST, const ChunkedVector, ChunkedVector>;
+
+        Container*  mVec   = nullptr;
+        std::size_t mIndex = 0;
+
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = T;
+        using reference         = std::conditional_t<CNST, const T&, T&>;
+        using pointer           = std::conditional_t<CNST, const T*, T*>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        Iterator() = default;
+
+        Iterator(Container* vec, std::size_t index) :
+                mVec(vec), mIndex(index)
+        {
+        }
+
+        // conversion from iterator to const_iterator
+        operator Iterator<true>() const requires (!CNST)
+        {
+            return Iterator<true>(mVec, mIndex);
+        }
+
+        reference operator*() const { return (*mVec)[mIndex]; }
+
+        pointer operator->() const { return &(*mVec)[mIndex]; }
+
+        reference operator[](difference_type i) const
+        {
+            return (*mVec)[mIndex + i];
+        }
+
+        auto operator<=>(const Iterator& oi) const
+        {
+            return mIndex <=> oi.mIndex;
+        }
+
+        bool operator==(const Iterator& oi) const
+        {
+            return mIndex == oi.mIndex;
+        }
+
+        Iterator& operator++()
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++mIndex;
+            return it;
+        }
+
+        Iterator& operator--()
+        {
+            --mIndex;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator it = *this;
+            --mIndex;
+            return it;
+        }
+
+        Iterator& operator+=(difference_type n)
+        {
+            mIndex += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+        {
+            mIndex -= n;
+            return *this;
+        }
+
+        Iterator operator+(difference_type n) const
+        {
+            return Iterator(mVec, mIndex + n);
+        }
+
+        friend Iterator operator+(difference_type n, const Iterator& it)
+        {
+            return it + n;
+        }
+
+        Iterator operator-(difference_type n) const
+        {
+            return Iterator(mVec, mIndex - n);
+        }
+
+        difference_type operator-(const Iterator& oi) const
+        {
+            return difference_type(mIndex) - difference_type(oi.mIndex);
+        }
+    };
+};
+
+} // namespace vcl
+
+#endif // VCL_SPACE_CORE_VECTOR_CHUNKED_VECTOR_H